@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ARPSnapshot.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace AppInstaller::Repository;
+
+namespace AppInstaller::CLI
+{
+    namespace
+    {
+        // 64-bit FNV-1a; the snapshot only needs a stable, well distributed value, not a cryptographic one.
+        constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+        constexpr uint64_t FnvPrime = 1099511628211ull;
+
+        uint64_t Hash(std::string_view value)
+        {
+            uint64_t hash = FnvOffsetBasis;
+
+            for (char c : value)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= FnvPrime;
+            }
+
+            return hash;
+        }
+    }
+
+    bool ARPSnapshot::Entry::operator<(const Entry& other) const
+    {
+        return std::tie(KeyHash, VersionHash, ProductCode, Version) < std::tie(other.KeyHash, other.VersionHash, other.ProductCode, other.Version);
+    }
+
+    bool ARPSnapshot::Entry::operator==(const Entry& other) const
+    {
+        return KeyHash == other.KeyHash && VersionHash == other.VersionHash && ProductCode == other.ProductCode && Version == other.Version;
+    }
+
+    ARPSnapshot::ARPSnapshot(std::vector<ARPEntryVersion> entries)
+    {
+        m_entries.reserve(entries.size());
+
+        for (auto& entry : entries)
+        {
+            Entry snapshotEntry;
+            snapshotEntry.KeyHash = Hash(entry.ProductCode);
+            snapshotEntry.VersionHash = Hash(entry.Version);
+            snapshotEntry.ProductCode = std::move(entry.ProductCode);
+            snapshotEntry.Version = std::move(entry.Version);
+
+            m_entries.emplace_back(std::move(snapshotEntry));
+        }
+
+        std::sort(m_entries.begin(), m_entries.end());
+    }
+
+    ARPSnapshot ARPSnapshot::Capture()
+    {
+        return ARPSnapshot{ GetARPEntryVersions() };
+    }
+
+    std::vector<std::string> ARPSnapshot::GetAddedOrChanged(const ARPSnapshot& current) const
+    {
+        std::vector<std::string> result;
+
+        auto baselineItr = m_entries.begin();
+        for (const auto& entry : current.m_entries)
+        {
+            while (baselineItr != m_entries.end() && *baselineItr < entry)
+            {
+                ++baselineItr;
+            }
+
+            if (baselineItr == m_entries.end() || *baselineItr != entry)
+            {
+                result.emplace_back(entry.ProductCode);
+            }
+        }
+
+        return result;
+    }
+}
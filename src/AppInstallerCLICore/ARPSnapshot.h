@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerRepositorySource.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AppInstaller::CLI
+{
+    // A lightweight inventory of the packages in ARP, used to detect the changes made by an installer.
+    // It is read directly from the registry rather than from the ARP source, and the entries are kept
+    // sorted by their hashes so that two snapshots can be compared with a single merge pass.
+    struct ARPSnapshot
+    {
+        // A single package in the snapshot.
+        struct Entry
+        {
+            // The hash of the product code.
+            uint64_t KeyHash = 0;
+            // The hash of the version of the installed package.
+            uint64_t VersionHash = 0;
+            // The product code, which is the package identifier in the ARP source.
+            std::string ProductCode;
+            // The version of the installed package.
+            std::string Version;
+
+            // Orders by the hashes, only comparing the values themselves when the hashes are equal.
+            bool operator<(const Entry& other) const;
+            bool operator==(const Entry& other) const;
+            bool operator!=(const Entry& other) const { return !operator==(other); }
+        };
+
+        ARPSnapshot() = default;
+
+        // Creates a snapshot from the given ARP entries.
+        explicit ARPSnapshot(std::vector<Repository::ARPEntryVersion> entries);
+
+        // Captures a snapshot of the current ARP entries.
+        static ARPSnapshot Capture();
+
+        // Gets the entries in the snapshot, sorted by their hashes.
+        const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+        // The number of entries in the snapshot.
+        size_t size() const { return m_entries.size(); }
+
+        // Determines whether the snapshot contains no entries.
+        bool empty() const { return m_entries.empty(); }
+
+        // Gets the product codes of the entries in current that were added or changed relative to this snapshot.
+        std::vector<std::string> GetAddedOrChanged(const ARPSnapshot& current) const;
+
+    private:
+        std::vector<Entry> m_entries;
+    };
+}
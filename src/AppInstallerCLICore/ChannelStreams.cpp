@@ -100,4 +100,70 @@ namespace AppInstaller::CLI::Execution
         m_out << f;
         return *this;
     }
+
+    DeferredOutputStream::DeferredOutputStream(std::ostream& target) :
+        std::ostream(&m_buffer), m_buffer(target) {}
+
+    void DeferredOutputStream::Release()
+    {
+        m_buffer.Release();
+    }
+
+    std::string DeferredOutputStream::ReleaseWithoutWriting()
+    {
+        return m_buffer.ReleaseWithoutWriting();
+    }
+
+    void DeferredOutputStream::Buffer::Release()
+    {
+        if (!m_released)
+        {
+            m_released = true;
+            m_target.write(m_held.data(), static_cast<std::streamsize>(m_held.size()));
+            m_target.flush();
+            m_held.clear();
+            m_held.shrink_to_fit();
+        }
+    }
+
+    std::string DeferredOutputStream::Buffer::ReleaseWithoutWriting()
+    {
+        m_released = true;
+        return std::exchange(m_held, {});
+    }
+
+    DeferredOutputStream::Buffer::int_type DeferredOutputStream::Buffer::overflow(int_type c)
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            char value = traits_type::to_char_type(c);
+            xsputn(&value, 1);
+        }
+
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize DeferredOutputStream::Buffer::xsputn(const char* s, std::streamsize count)
+    {
+        if (m_released)
+        {
+            m_target.write(s, count);
+        }
+        else
+        {
+            m_held.append(s, static_cast<size_t>(count));
+        }
+
+        return count;
+    }
+
+    int DeferredOutputStream::Buffer::sync()
+    {
+        if (m_released)
+        {
+            m_target.flush();
+        }
+
+        return 0;
+    }
 }
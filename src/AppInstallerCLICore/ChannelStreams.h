@@ -130,4 +130,43 @@ namespace AppInstaller::CLI::Execution
     private:
         BaseStream m_out;
     };
+
+    // Holds what is written to it until it is released, then writes that and everything written after it to the target stream.
+    // This lets work run on another thread without its output being interleaved with the output already going to the target.
+    struct DeferredOutputStream : public std::ostream
+    {
+        DeferredOutputStream(std::ostream& target);
+
+        DeferredOutputStream(const DeferredOutputStream&) = delete;
+        DeferredOutputStream& operator=(const DeferredOutputStream&) = delete;
+
+        // Writes the held output to the target; output after this goes straight to the target.
+        // Must not be called while the stream is being written to from another thread.
+        void Release();
+
+        // Stops holding output, as Release does, but returns the held output rather than writing it to the target.
+        // This lets the caller write something ahead of it. Must not be called while the stream is being written to from another thread.
+        std::string ReleaseWithoutWriting();
+
+    private:
+        struct Buffer : public std::streambuf
+        {
+            Buffer(std::ostream& target) : m_target(target) {}
+
+            void Release();
+            std::string ReleaseWithoutWriting();
+
+        protected:
+            int_type overflow(int_type c) override;
+            std::streamsize xsputn(const char* s, std::streamsize count) override;
+            int sync() override;
+
+        private:
+            std::ostream& m_target;
+            std::string m_held;
+            bool m_released = false;
+        };
+
+        Buffer m_buffer;
+    };
 }
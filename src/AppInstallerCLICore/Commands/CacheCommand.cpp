@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "CacheCommand.h"
+#include "Resources.h"
+#include "TableOutput.h"
+#include <AppInstallerDateTime.h>
+#include <winget/InstallerCache.h>
+
+namespace AppInstaller::CLI
+{
+    using namespace AppInstaller::CLI::Execution;
+    using namespace AppInstaller::Utility;
+
+    namespace
+    {
+        std::string FormatSize(uint64_t size)
+        {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(1) << static_cast<double>(size) / (1 << 20) << " MB";
+            return stream.str();
+        }
+
+        std::string FormatLastUsed(std::filesystem::file_time_type lastUsed)
+        {
+            // The file clock cannot be converted directly, so the time is taken relative to now on both clocks
+            auto systemTime = std::chrono::system_clock::now() -
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::filesystem::file_time_type::clock::now() - lastUsed);
+
+            std::ostringstream stream;
+            OutputTimePoint(stream, systemTime);
+            return stream.str();
+        }
+    }
+
+    std::vector<std::unique_ptr<Command>> CacheCommand::GetCommands() const
+    {
+        return InitializeFromMoveOnly<std::vector<std::unique_ptr<Command>>>({
+            std::make_unique<CacheListCommand>(FullName()),
+            std::make_unique<CacheClearCommand>(FullName()),
+            });
+    }
+
+    Resource::LocString CacheCommand::ShortDescription() const
+    {
+        return { Resource::String::CacheCommandShortDescription };
+    }
+
+    Resource::LocString CacheCommand::LongDescription() const
+    {
+        return { Resource::String::CacheCommandLongDescription };
+    }
+
+    void CacheCommand::ExecuteInternal(Context& context) const
+    {
+        OutputHelp(context.Reporter);
+    }
+
+    Resource::LocString CacheListCommand::ShortDescription() const
+    {
+        return { Resource::String::CacheListCommandShortDescription };
+    }
+
+    Resource::LocString CacheListCommand::LongDescription() const
+    {
+        return { Resource::String::CacheListCommandLongDescription };
+    }
+
+    void CacheListCommand::ExecuteInternal(Context& context) const
+    {
+        std::vector<InstallerCache::Entry> entries = InstallerCache::FromUserSettings().GetEntries();
+
+        if (entries.empty())
+        {
+            context.Reporter.Info() << Resource::String::CacheListEmpty << std::endl;
+            return;
+        }
+
+        Execution::TableOutput<3> table(context.Reporter, { Resource::String::CacheListHash, Resource::String::CacheListSize, Resource::String::CacheListLastUsed });
+
+        for (const auto& entry : entries)
+        {
+            table.OutputLine({ SHA256::ConvertToString(entry.Hash), FormatSize(entry.Size), FormatLastUsed(entry.LastUsed) });
+        }
+
+        table.Complete();
+    }
+
+    Resource::LocString CacheClearCommand::ShortDescription() const
+    {
+        return { Resource::String::CacheClearCommandShortDescription };
+    }
+
+    Resource::LocString CacheClearCommand::LongDescription() const
+    {
+        return { Resource::String::CacheClearCommandLongDescription };
+    }
+
+    void CacheClearCommand::ExecuteInternal(Context& context) const
+    {
+        size_t removed = InstallerCache::FromUserSettings().Clear();
+        context.Reporter.Info() << Resource::String::CacheCleared << ' ' << removed << std::endl;
+    }
+}
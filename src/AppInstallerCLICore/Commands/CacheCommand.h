@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include "Command.h"
+
+namespace AppInstaller::CLI
+{
+    struct CacheCommand final : public Command
+    {
+        CacheCommand(std::string_view parent) : Command("cache", parent) {}
+
+        std::vector<std::unique_ptr<Command>> GetCommands() const override;
+
+        Resource::LocString ShortDescription() const override;
+        Resource::LocString LongDescription() const override;
+
+    protected:
+        void ExecuteInternal(Execution::Context& context) const override;
+    };
+
+    struct CacheListCommand final : public Command
+    {
+        CacheListCommand(std::string_view parent) : Command("list", parent) {}
+
+        Resource::LocString ShortDescription() const override;
+        Resource::LocString LongDescription() const override;
+
+    protected:
+        void ExecuteInternal(Execution::Context& context) const override;
+    };
+
+    struct CacheClearCommand final : public Command
+    {
+        CacheClearCommand(std::string_view parent) : Command("clear", parent) {}
+
+        Resource::LocString ShortDescription() const override;
+        Resource::LocString LongDescription() const override;
+
+    protected:
+        void ExecuteInternal(Execution::Context& context) const override;
+    };
+}
@@ -130,13 +130,25 @@ namespace AppInstaller::CLI::Execution
     std::unique_ptr<Context> Context::Clone()
     {
         auto clone = std::make_unique<Context>(Reporter);
-        clone->m_flags = m_flags;
+        InitializeClone(*clone);
+        return clone;
+    }
+
+    std::unique_ptr<Context> Context::Clone(std::ostream& out)
+    {
+        auto clone = std::make_unique<Context>(Reporter, out);
+        InitializeClone(*clone);
+        return clone;
+    }
+
+    void Context::InitializeClone(Context& clone)
+    {
+        clone.m_flags = m_flags;
         // If the parent is hooked up to the CTRL signal, have the clone be as well
         if (m_disableCtrlHandlerOnExit)
         {
-            clone->EnableCtrlHandler();
+            clone.EnableCtrlHandler();
         }
-        return clone;
     }
 
     void Context::EnableCtrlHandler(bool enabled)
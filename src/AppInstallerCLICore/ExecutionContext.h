@@ -55,6 +55,9 @@ namespace AppInstaller::CLI::Execution
         // Clone the reporter for this constructor.
         Context(Execution::Reporter& reporter) : Reporter(reporter, Execution::Reporter::clone_t{}) {}
 
+        // Clone the reporter for this constructor, with its output written to the given stream instead.
+        Context(Execution::Reporter& reporter, std::ostream& out) : Reporter(reporter, out, Execution::Reporter::clone_t{}) {}
+
         virtual ~Context();
 
         // The path for console input/output for all functionality.
@@ -66,6 +69,9 @@ namespace AppInstaller::CLI::Execution
         // Creates a copy of this context as it was at construction.
         virtual std::unique_ptr<Context> Clone();
 
+        // Creates a copy of this context as it was at construction, with its output written to the given stream instead.
+        virtual std::unique_ptr<Context> Clone(std::ostream& out);
+
         // Enables reception of CTRL signals.
         // Only one context can be enabled to handle CTRL signals at a time.
         void EnableCtrlHandler(bool enabled = true);
@@ -113,6 +119,9 @@ namespace AppInstaller::CLI::Execution
 #endif
 
     private:
+        // Copies the state that a clone shares with this context.
+        void InitializeClone(Context& clone);
+
         DestructionToken m_disableCtrlHandlerOnExit = false;
         bool m_isTerminated = false;
         HRESULT m_terminationHR = S_OK;
@@ -4,6 +4,7 @@
 #include <AppInstallerRepositorySearch.h>
 #include <AppInstallerRepositorySource.h>
 #include <winget/Manifest.h>
+#include "ARPSnapshot.h"
 #include "CompletionData.h"
 #include "PackageCollection.h"
 #include "Workflows/WorkflowBase.h"
@@ -46,7 +47,10 @@ namespace AppInstaller::CLI::Execution
         PackagesToInstall,
         // On import: Sources for the imported packages
         Sources,
+        // The ARP entries before the installer is run
         ARPSnapshot,
+        // The ARP entries after the last completed install, to be used as the ARPSnapshot of the next one
+        ARPBaseline,
         Max
     };
 
@@ -181,8 +185,13 @@ namespace AppInstaller::CLI::Execution
         template <>
         struct DataMapping<Data::ARPSnapshot>
         {
-            // Contains the { Id, Version, Channel }
-            using value_t = std::vector<std::tuple<Utility::LocIndString, Utility::LocIndString, Utility::LocIndString>>;
+            using value_t = CLI::ARPSnapshot;
+        };
+
+        template <>
+        struct DataMapping<Data::ARPBaseline>
+        {
+            using value_t = CLI::ARPSnapshot;
         };
     }
 }
@@ -32,7 +32,12 @@ namespace AppInstaller::CLI::Execution
     }
 
     Reporter::Reporter(const Reporter& other, clone_t) :
-        Reporter(other.m_out, other.m_in)
+        Reporter(other, other.m_out, clone_t{})
+    {
+    }
+
+    Reporter::Reporter(const Reporter& other, std::ostream& outStream, clone_t) :
+        Reporter(outStream, other.m_in)
     {
         if (other.m_style.has_value())
         {
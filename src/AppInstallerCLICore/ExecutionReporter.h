@@ -13,6 +13,7 @@
 #include <atomic>
 #include <iomanip>
 #include <istream>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -53,6 +54,9 @@ namespace AppInstaller::CLI::Execution
         struct clone_t {};
         Reporter(const Reporter& other, clone_t);
 
+        // Request that a clone be constructed from the given reporter, writing its output to the given stream instead.
+        Reporter(const Reporter& other, std::ostream& outStream, clone_t);
+
         ~Reporter();
 
         // Get a stream for verbose output.
@@ -120,6 +124,12 @@ namespace AppInstaller::CLI::Execution
             m_progressSink = sink;
         }
 
+        // Creates a stream that holds what is written to it until it is released, and then writes it to the output of this reporter.
+        std::unique_ptr<DeferredOutputStream> CreateDeferredOutputStream() const
+        {
+            return std::make_unique<DeferredOutputStream>(m_out);
+        }
+
     private:
         // Gets whether VT is enabled for this reporter.
         bool IsVTEnabled() const;
@@ -27,6 +27,17 @@ namespace AppInstaller::CLI::Resource
         WINGET_DEFINE_RESOURCE_STRINGID(AvailableOptions);
         WINGET_DEFINE_RESOURCE_STRINGID(AvailableSubcommands);
         WINGET_DEFINE_RESOURCE_STRINGID(BothManifestAndSearchQueryProvided);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheClearCommandLongDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheClearCommandShortDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheCleared);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheCommandLongDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheCommandShortDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListCommandLongDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListCommandShortDescription);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListEmpty);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListHash);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListLastUsed);
+        WINGET_DEFINE_RESOURCE_STRINGID(CacheListSize);
         WINGET_DEFINE_RESOURCE_STRINGID(Cancelled);
         WINGET_DEFINE_RESOURCE_STRINGID(ChannelArgumentDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(Command);
@@ -245,6 +256,7 @@ namespace AppInstaller::CLI::Resource
         WINGET_DEFINE_RESOURCE_STRINGID(UpgradeCommandLongDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(UpgradeCommandShortDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(Usage);
+        WINGET_DEFINE_RESOURCE_STRINGID(UsingCachedInstaller);
         WINGET_DEFINE_RESOURCE_STRINGID(ValidateCommandLongDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(ValidateCommandShortDescription);
         WINGET_DEFINE_RESOURCE_STRINGID(ValidateManifestArgumentDescription);
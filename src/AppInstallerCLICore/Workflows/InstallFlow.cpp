@@ -8,6 +8,8 @@
 #include "MSStoreInstallerHandler.h"
 #include "WorkflowBase.h"
 
+#include <winget/InstallerCache.h>
+
 namespace AppInstaller::CLI::Workflow
 {
     using namespace winrt::Windows::ApplicationModel::Store::Preview::InstallControl;
@@ -76,17 +78,17 @@ namespace AppInstaller::CLI::Workflow
         case InstallerTypeEnum::Msi:
         case InstallerTypeEnum::Nullsoft:
         case InstallerTypeEnum::Wix:
-            context << DownloadInstallerFile << VerifyInstallerHash << UpdateInstallerFileMotwIfApplicable;
+            context << DownloadInstallerFile << VerifyInstallerHash << AddInstallerToCache << UpdateInstallerFileMotwIfApplicable;
             break;
         case InstallerTypeEnum::Msix:
             if (installer.SignatureSha256.empty())
             {
-                context << DownloadInstallerFile << VerifyInstallerHash << UpdateInstallerFileMotwIfApplicable;
+                context << DownloadInstallerFile << VerifyInstallerHash << AddInstallerToCache << UpdateInstallerFileMotwIfApplicable;
             }
             else
             {
                 // Signature hash provided. No download needed. Just verify signature hash.
-                context << GetMsixSignatureHash << VerifyInstallerHash << UpdateInstallerFileMotwIfApplicable;
+                context << GetMsixSignatureHash << VerifyInstallerHash << AddInstallerToCache << UpdateInstallerFileMotwIfApplicable;
             }
             break;
         case InstallerTypeEnum::MSStore:
@@ -112,6 +114,28 @@ namespace AppInstaller::CLI::Workflow
 
         AICLI_LOG(CLI, Info, << "Generated temp download path: " << tempInstallerPath);
 
+        // A cached installer is only used if its contents still have the expected hash
+        InstallerCache installerCache = InstallerCache::FromUserSettings();
+        if (!installer.Sha256.empty() && installerCache.CopyTo(installer.Sha256, tempInstallerPath))
+        {
+            SHA256::HashBuffer cachedHash;
+            {
+                std::ifstream cachedStream{ tempInstallerPath, std::ios_base::in | std::ios_base::binary };
+                cachedHash = SHA256::ComputeHash(cachedStream);
+            }
+
+            if (cachedHash == installer.Sha256)
+            {
+                context.Reporter.Info() << Resource::String::UsingCachedInstaller << ' ' << Execution::UrlEmphasis << installer.Url << std::endl;
+                context.Add<Execution::Data::HashPair>(std::make_pair(installer.Sha256, std::move(cachedHash)));
+                context.Add<Execution::Data::InstallerPath>(std::move(tempInstallerPath));
+                return;
+            }
+
+            AICLI_LOG(CLI, Warning, << "Cached installer does not match its hash and is being removed: " << SHA256::ConvertToString(installer.Sha256));
+            installerCache.Remove(installer.Sha256);
+        }
+
         context.Reporter.Info() << "Downloading " << Execution::UrlEmphasis << installer.Url << std::endl;
 
         std::optional<std::vector<BYTE>> hash;
@@ -248,6 +272,18 @@ namespace AppInstaller::CLI::Workflow
         }
     }
 
+    void AddInstallerToCache(Execution::Context& context)
+    {
+        // Only installers whose hash was verified are cached, since the hash is what identifies them
+        if (!context.Contains(Execution::Data::InstallerPath) || WI_IsFlagClear(context.GetFlags(), Execution::ContextFlag::InstallerHashMatched))
+        {
+            return;
+        }
+
+        const auto& hashPair = context.Get<Execution::Data::HashPair>();
+        InstallerCache::FromUserSettings().Add(hashPair.second, context.Get<Execution::Data::InstallerPath>());
+    }
+
     void UpdateInstallerFileMotwIfApplicable(Execution::Context& context)
     {
         if (context.Contains(Execution::Data::InstallerPath))
@@ -394,6 +430,12 @@ namespace AppInstaller::CLI::Workflow
             Workflow::ShowInstallationDisclaimer <<
             Workflow::ReportExecutionStage(ExecutionStage::Download) <<
             Workflow::DownloadInstaller <<
+            Workflow::InstallDownloadedInstaller;
+    }
+
+    void InstallDownloadedInstaller(Execution::Context& context)
+    {
+        context <<
             Workflow::ReportExecutionStage(ExecutionStage::PreExecution) <<
             Workflow::SnapshotARPEntries <<
             Workflow::ReportExecutionStage(ExecutionStage::Execution) <<
@@ -413,6 +455,15 @@ namespace AppInstaller::CLI::Workflow
 
     void InstallMultiple(Execution::Context& context)
     {
+        // Retrieve all of the manifests up front so that the requests to remote sources are made concurrently
+        std::vector<std::shared_ptr<IPackageVersion>> packageVersions;
+        for (const auto& package : context.Get<Execution::Data::PackagesToInstall>())
+        {
+            packageVersions.emplace_back(package.PackageVersion);
+        }
+
+        context.Reporter.ExecuteWithProgress(std::bind(Repository::PrefetchManifests, std::cref(packageVersions), std::placeholders::_1), true);
+
         bool allSucceeded = true;
         for (auto package : context.Get<Execution::Data::PackagesToInstall>())
         {
@@ -429,7 +480,21 @@ namespace AppInstaller::CLI::Workflow
             // TODO: In the future, it would be better to not have to convert back and forth from a string
             installContext.Args.AddArg(Execution::Args::Type::InstallScope, ScopeToString(package.PackageRequest.Scope));
 
+            // Hand down the ARP baseline from the previous install so that it need not be captured again
+            if (context.Contains(Execution::Data::ARPBaseline))
+            {
+                installContext.Add<Execution::Data::ARPBaseline>(std::move(context.Get<Execution::Data::ARPBaseline>()));
+                context.Remove(Execution::Data::ARPBaseline);
+            }
+
             installContext << InstallPackageVersion;
+
+            // Only a completed install leaves behind a baseline that reflects the current state of ARP
+            if (!installContext.IsTerminated() && installContext.Contains(Execution::Data::ARPBaseline))
+            {
+                context.Add<Execution::Data::ARPBaseline>(std::move(installContext.Get<Execution::Data::ARPBaseline>()));
+            }
+
             if (installContext.IsTerminated())
             {
                 if (context.IsTerminated() && context.GetTerminationHR() == E_ABORT)
@@ -457,29 +522,17 @@ namespace AppInstaller::CLI::Workflow
 
         if (installer && MightWriteToARP(installer->InstallerType))
         {
-            std::shared_ptr<ISource> arpSource = context.Reporter.ExecuteWithProgress(
-                [](IProgressCallback& progress)
-                {
-                    return Repository::OpenPredefinedSource(PredefinedSource::ARP, progress);
-                }, true);
-
-            std::vector<std::tuple<Utility::LocIndString, Utility::LocIndString, Utility::LocIndString>> entries;
-
-            for (const auto& entry : arpSource->Search({}).Matches)
+            // A baseline left by a previous install in the same invocation is still current.
+            // Installers that do not write to ARP leave it in place for the next one.
+            if (context.Contains(Execution::Data::ARPBaseline))
             {
-                auto installed = entry.Package->GetInstalledVersion();
-                if (installed)
-                {
-                    entries.emplace_back(std::make_tuple(
-                        entry.Package->GetProperty(PackageProperty::Id),
-                        installed->GetProperty(PackageVersionProperty::Version),
-                        installed->GetProperty(PackageVersionProperty::Channel)));
-                }
+                AICLI_LOG(CLI, Verbose, << "Reusing existing ARP snapshot with " << context.Get<Execution::Data::ARPBaseline>().size() << " entries");
+                context.Add<Execution::Data::ARPSnapshot>(std::move(context.Get<Execution::Data::ARPBaseline>()));
+                context.Remove(Execution::Data::ARPBaseline);
+                return;
             }
 
-            std::sort(entries.begin(), entries.end());
-
-            context.Add<Execution::Data::ARPSnapshot>(std::move(entries));
+            context.Add<Execution::Data::ARPSnapshot>(ARPSnapshot::Capture());
         }
     }
     CATCH_LOG()
@@ -488,9 +541,17 @@ namespace AppInstaller::CLI::Workflow
     {
         if (context.Contains(Execution::Data::ARPSnapshot))
         {
-            const auto& entries = context.Get<Execution::Data::ARPSnapshot>();
+            // Take the baseline out of the context so that a failure below cannot leave a stale one behind
+            ARPSnapshot baseline = std::move(context.Get<Execution::Data::ARPSnapshot>());
+            context.Remove(Execution::Data::ARPSnapshot);
+
+            ARPSnapshot current = ARPSnapshot::Capture();
+            std::vector<std::string> changedProductCodes = baseline.GetAddedOrChanged(current);
 
-            // Open it again to get the (potentially) changed ARP entries
+            // The current state becomes the baseline for any subsequent install
+            context.Add<Execution::Data::ARPBaseline>(std::move(current));
+
+            // The source is only needed for the details of the changed entries and for the entries that match the manifest
             std::shared_ptr<ISource> arpSource = context.Reporter.ExecuteWithProgress(
                 [](IProgressCallback& progress)
                 {
@@ -499,23 +560,15 @@ namespace AppInstaller::CLI::Workflow
 
             std::vector<ResultMatch> changes;
 
-            for (auto& entry : arpSource->Search({}).Matches)
+            if (!changedProductCodes.empty())
             {
-                auto installed = entry.Package->GetInstalledVersion();
-
-                if (installed)
+                SearchRequest changesRequest;
+                for (const auto& productCode : changedProductCodes)
                 {
-                    auto entryKey = std::make_tuple(
-                        entry.Package->GetProperty(PackageProperty::Id),
-                        installed->GetProperty(PackageVersionProperty::Version),
-                        installed->GetProperty(PackageVersionProperty::Channel));
-
-                    auto itr = std::lower_bound(entries.begin(), entries.end(), entryKey);
-                    if (itr == entries.end() || *itr != entryKey)
-                    {
-                        changes.emplace_back(std::move(entry));
-                    }
+                    changesRequest.Inclusions.emplace_back(PackageMatchFilter(PackageMatchField::Id, MatchType::Exact, productCode));
                 }
+
+                changes = arpSource->Search(changesRequest).Matches;
             }
 
             // Also attempt to find the entry based on the manifest data
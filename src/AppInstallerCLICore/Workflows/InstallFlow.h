@@ -29,7 +29,7 @@ namespace AppInstaller::CLI::Workflow
     // Outputs: None
     void DownloadInstaller(Execution::Context& context);
 
-    // Downloads the file referenced by the Installer.
+    // Downloads the file referenced by the Installer, or copies it from the installer cache.
     // Required Args: None
     // Inputs: Installer
     // Outputs: HashPair, InstallerPath
@@ -47,6 +47,12 @@ namespace AppInstaller::CLI::Workflow
     // Outputs: SourceList
     void VerifyInstallerHash(Execution::Context& context);
 
+    // Adds the downloaded installer to the installer cache if its hash was verified.
+    // Required Args: None
+    // Inputs: HashPair, InstallerPath?
+    // Outputs: None
+    void AddInstallerToCache(Execution::Context& context);
+
     // Update Motw of the downloaded installer if applicable
     // Required Args: None
     // Inputs: HashPair, InstallerPath?, SourceId?
@@ -83,6 +89,12 @@ namespace AppInstaller::CLI::Workflow
     // Outputs: None
     void InstallPackageInstaller(Execution::Context& context);
 
+    // Installs a specific package installer that has already been downloaded and verified.
+    // Required Args: None
+    // Inputs: Manifest, Installer, InstallerPath?
+    // Outputs: None
+    void InstallDownloadedInstaller(Execution::Context& context);
+
     // Installs a specific package version.
     // Required Args: None
     // Inputs: Manifest, PackageVersion, Source
@@ -95,15 +107,16 @@ namespace AppInstaller::CLI::Workflow
     // Outputs: None
     void InstallMultiple(Execution::Context& context);
 
-    // Stores the existing set of packages in ARP.
+    // Stores the existing set of packages in ARP if the installer might write to it; an existing ARPBaseline is used rather than capturing it again.
     // Required Args: None
-    // Inputs: Installer
-    // Outputs: ARPSnapshot
+    // Inputs: Installer, ARPBaseline?
+    // Outputs: ARPSnapshot?
     void SnapshotARPEntries(Execution::Context& context);
 
     // Reports on the changes between the stored ARPSnapshot and the current values.
+    // The current values are stored as the ARPBaseline for a subsequent install.
     // Required Args: None
     // Inputs: ARPSnapshot?, Manifest, PackageVersion
-    // Outputs: None
+    // Outputs: ARPBaseline?
     void ReportARPChanges(Execution::Context& context);
 }
@@ -6,6 +6,9 @@
 #include "InstallFlow.h"
 #include "UpdateFlow.h"
 #include "ManifestComparator.h"
+#include <winget/UserSettings.h>
+
+#include <deque>
 
 using namespace AppInstaller::Repository;
 
@@ -17,6 +20,96 @@ namespace AppInstaller::CLI::Workflow
         {
             return (installedVersion < updateVersion || updateVersion.IsLatest());
         }
+
+        // Discards progress, as the progress bar of a download running ahead would be written over the output of the install.
+        struct DiscardProgressSink : public IProgressSink
+        {
+            void OnProgress(uint64_t, uint64_t, ProgressType) override {}
+            void BeginProgress() override {}
+            void EndProgress(bool) override {}
+        };
+
+        // An update from UpdateAllApplicable, whose installer may be downloaded on another thread while an earlier update is installed.
+        // Only the download and hash verification run ahead; the update is still reported at its turn, and the output of the download is
+        // held back until then so that everything appears in the same order as it always has.
+        // All of the work for the update is logged to telemetry as a single sub execution, whichever thread does it.
+        struct PendingUpdate
+        {
+            PendingUpdate(Execution::Context& parent) :
+                m_output(parent.Reporter.CreateDeferredOutputStream()), m_context(parent.Clone(*m_output)),
+                m_subExecutionId(Logging::SubExecutionTelemetryScope::CreateSubExecutionId()) {}
+
+            PendingUpdate(const PendingUpdate&) = delete;
+            PendingUpdate& operator=(const PendingUpdate&) = delete;
+
+            ~PendingUpdate()
+            {
+                // Only an update that is abandoned can still be downloading; stop it rather than wait for it to complete
+                if (m_download.valid())
+                {
+                    m_context->Cancel();
+                }
+            }
+
+            Execution::Context& GetContext() { return *m_context; }
+
+            // Logs telemetry from the current thread as the sub execution of the update, for the lifetime of the result.
+            Logging::SubExecutionTelemetryScope EnterSubExecution() const { return Logging::SubExecutionTelemetryScope{ m_subExecutionId }; }
+
+            bool IsDownloadStarted() const { return m_download.valid(); }
+
+            // Starts downloading the installer on another thread.
+            void StartDownload()
+            {
+                m_context->Reporter.SetProgressSink(&m_discardProgress);
+                m_download = std::async(std::launch::async, [this]()
+                    {
+                        auto subExecution = EnterSubExecution();
+                        *m_context << Workflow::DownloadInstaller;
+                    });
+            }
+
+            // Reports the update and then completes its download, writing out the output of the download after the report,
+            // or downloads the installer now if it was not started ahead. Must be called with the sub execution of the update entered.
+            // Any exception from a download on another thread is rethrown here, where it would have been thrown without one.
+            void FinishDownload(Execution::Context& parent)
+            {
+                if (m_download.valid())
+                {
+                    {
+                        parent.Reporter.ShowIndefiniteProgress(true);
+                        auto hideProgress = wil::scope_exit([&]() { parent.Reporter.ShowIndefiniteProgress(false); });
+                        m_download.wait();
+                    }
+
+                    std::string downloadOutput = m_output->ReleaseWithoutWriting();
+                    m_context->Reporter.SetProgressSink(&m_context->Reporter);
+
+                    // Called directly, as a failed download has already terminated the context; the update is still reported ahead
+                    // of the failure, as it is when the download does not run ahead
+                    Workflow::ReportManifestIdentity(*m_context);
+                    Workflow::ShowInstallationDisclaimer(*m_context);
+                    *m_output << downloadOutput << std::flush;
+
+                    m_download.get();
+                }
+                else
+                {
+                    m_output->Release();
+                    *m_context <<
+                        Workflow::ReportManifestIdentity <<
+                        Workflow::ShowInstallationDisclaimer <<
+                        Workflow::DownloadInstaller;
+                }
+            }
+
+        private:
+            std::unique_ptr<Execution::DeferredOutputStream> m_output;
+            std::unique_ptr<Execution::Context> m_context;
+            uint32_t m_subExecutionId;
+            DiscardProgressSink m_discardProgress;
+            std::future<void> m_download;
+        };
     }
 
     void SelectLatestApplicableUpdate::operator()(Execution::Context& context) const
@@ -89,29 +182,97 @@ namespace AppInstaller::CLI::Workflow
         bool updateAllHasFailure = false;
         bool updateAllFoundUpdate = false;
 
+        // Retrieve the manifests of the likely updates up front so that the requests to remote sources are made concurrently
+        std::vector<std::shared_ptr<IPackageVersion>> updateVersions;
         for (const auto& match : matches)
         {
-            Logging::SubExecutionTelemetryScope subExecution;
+            auto installedVersion = match.Package->GetInstalledVersion();
+            if (!installedVersion)
+            {
+                continue;
+            }
+
+            // The version keys should have already been sorted by version; the latest is the one most likely to be installed.
+            // Only it is prefetched. Should it have no applicable installer, SelectLatestApplicableUpdate retrieves the manifests
+            // of the older versions one at a time, as it would without prefetching.
+            auto versionKeys = match.Package->GetAvailableVersionKeys();
+            if (!versionKeys.empty() &&
+                IsUpdateVersionApplicable(Utility::Version(installedVersion->GetProperty(PackageVersionProperty::Version)), Utility::Version(versionKeys.front().Version)))
+            {
+                updateVersions.emplace_back(match.Package->GetAvailableVersion(versionKeys.front()));
+            }
+        }
+
+        // This waits for all of the manifests, before the first update starts
+        context.Reporter.ExecuteWithProgress(std::bind(Repository::PrefetchManifests, std::cref(updateVersions), std::placeholders::_1), true);
+
+        // The installers of the next few updates are downloaded while an update is installed; the installs still run one at a time, in order
+        const size_t downloadAheadCount = Settings::User().Get<Settings::Setting::InstallDownloadAheadCount>();
+        std::deque<std::unique_ptr<PendingUpdate>> pendingUpdates;
+        size_t nextMatch = 0;
+
+        while (true)
+        {
+            // Find the update to install next, and the ones to download ahead of it
+            while (pendingUpdates.size() <= downloadAheadCount && nextMatch < matches.size())
+            {
+                // We want to do best effort to update all applicable updates regardless on previous update failure
+                auto pendingUpdate = std::make_unique<PendingUpdate>(context);
+                auto subExecution = pendingUpdate->EnterSubExecution();
+                Execution::Context& updateContext = pendingUpdate->GetContext();
+
+                updateContext.Add<Execution::Data::Package>(matches[nextMatch++].Package);
+
+                updateContext <<
+                    Workflow::GetInstalledPackageVersion <<
+                    Workflow::ReportExecutionStage(ExecutionStage::Discovery) <<
+                    SelectLatestApplicableUpdate(false);
 
-            // We want to do best effort to update all applicable updates regardless on previous update failure
-            auto updateContextPtr = context.Clone();
-            Execution::Context& updateContext = *updateContextPtr;
+                if (updateContext.GetTerminationHR() == APPINSTALLER_CLI_ERROR_UPDATE_NOT_APPLICABLE)
+                {
+                    continue;
+                }
 
-            updateContext.Add<Execution::Data::Package>(match.Package);
+                updateContext << Workflow::ReportExecutionStage(ExecutionStage::Download);
+                pendingUpdates.emplace_back(std::move(pendingUpdate));
+            }
 
-            updateContext <<
-                Workflow::GetInstalledPackageVersion <<
-                Workflow::ReportExecutionStage(ExecutionStage::Discovery) <<
-                SelectLatestApplicableUpdate(false);
+            if (pendingUpdates.empty())
+            {
+                break;
+            }
 
-            if (updateContext.GetTerminationHR() == APPINSTALLER_CLI_ERROR_UPDATE_NOT_APPLICABLE)
+            for (size_t i = 1; i < pendingUpdates.size(); ++i)
             {
-                continue;
+                if (!pendingUpdates[i]->IsDownloadStarted())
+                {
+                    pendingUpdates[i]->StartDownload();
+                }
             }
 
+            std::unique_ptr<PendingUpdate> pendingUpdate = std::move(pendingUpdates.front());
+            pendingUpdates.pop_front();
+
+            auto subExecution = pendingUpdate->EnterSubExecution();
+            Execution::Context& updateContext = pendingUpdate->GetContext();
+
             updateAllFoundUpdate = true;
+            pendingUpdate->FinishDownload(context);
+
+            // Hand down the ARP baseline from the previous update so that it need not be captured again
+            if (context.Contains(Execution::Data::ARPBaseline))
+            {
+                updateContext.Add<Execution::Data::ARPBaseline>(std::move(context.Get<Execution::Data::ARPBaseline>()));
+                context.Remove(Execution::Data::ARPBaseline);
+            }
 
-            updateContext << InstallPackageInstaller;
+            updateContext << InstallDownloadedInstaller;
+
+            // Only a completed update leaves behind a baseline that reflects the current state of ARP
+            if (!updateContext.IsTerminated() && updateContext.Contains(Execution::Data::ARPBaseline))
+            {
+                context.Add<Execution::Data::ARPBaseline>(std::move(updateContext.Get<Execution::Data::ARPBaseline>()));
+            }
 
             updateContext.Reporter.Info() << std::endl;
 
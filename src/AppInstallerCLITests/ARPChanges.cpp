@@ -104,9 +104,35 @@ struct TestContext : public Context
         Source = std::make_shared<TestSource>();
         Source->SearchFunction = [&](const SearchRequest& request)
         {
-            return request.IsForEverything() ? EverythingResult : MatchResult;
+            if (request.IsForEverything())
+            {
+                return EverythingResult;
+            }
+
+            // A search for the changed entries is made by their identifiers
+            if (std::all_of(request.Inclusions.begin(), request.Inclusions.end(), [](const PackageMatchFilter& filter) { return filter.Field == PackageMatchField::Id; }))
+            {
+                SearchResult result;
+                for (const auto& match : EverythingResult.Matches)
+                {
+                    for (const auto& inclusion : request.Inclusions)
+                    {
+                        if (match.Package->GetProperty(PackageProperty::Id).get() == inclusion.Value)
+                        {
+                            result.Matches.emplace_back(match);
+                            break;
+                        }
+                    }
+                }
+                return result;
+            }
+
+            return MatchResult;
         };
 
+        // The snapshots are read from the same entries as the source
+        TestHook_SetARPEntryVersionsOverride([this]() { return GetEntryVersions(); });
+
         // The package version is used to get the source identifier
         Add<Data::PackageVersion>(TestPackageVersion::Make(Get<Data::Manifest>(), Source));
 
@@ -118,9 +144,22 @@ struct TestContext : public Context
     ~TestContext()
     {
         TestHook_ClearSourceFactoryOverrides();
+        TestHook_SetARPEntryVersionsOverride({});
         TestHook_SetTelemetryOverride({});
     }
 
+    std::vector<ARPEntryVersion> GetEntryVersions() const
+    {
+        std::vector<ARPEntryVersion> result;
+        for (const auto& match : EverythingResult.Matches)
+        {
+            result.emplace_back(ARPEntryVersion{
+                match.Package->GetProperty(PackageProperty::Id).get(),
+                match.Package->GetInstalledVersion()->GetProperty(PackageVersionProperty::Version).get() });
+        }
+        return result;
+    }
+
     void AddEverythingResult(std::string_view id, std::string_view name, std::string_view publisher, std::string_view version)
     {
         AddResult(EverythingResult, id, name, publisher, version);
@@ -218,6 +257,23 @@ TEST_CASE("ARPChanges_MSIX_Ignored", "[ARPChanges][workflow]")
     REQUIRE(!context.Logger->WasLogSuccessfulInstallARPChangeCalled);
 }
 
+TEST_CASE("ARPChanges_MSIX_KeepsBaseline", "[ARPChanges][workflow]")
+{
+    TestContext context(Manifest::InstallerTypeEnum::Msix);
+    context.Add<Data::ARPBaseline>(ARPSnapshot::Capture());
+
+    context << SnapshotARPEntries;
+
+    // The baseline is left for the next installer that might write to ARP
+    REQUIRE(!context.Contains(Data::ARPSnapshot));
+    REQUIRE(context.Contains(Data::ARPBaseline));
+
+    context << ReportARPChanges;
+
+    REQUIRE(!context.Logger->WasLogSuccessfulInstallARPChangeCalled);
+    REQUIRE(context.Contains(Data::ARPBaseline));
+}
+
 TEST_CASE("ARPChanges_CheckSnapshot", "[ARPChanges][workflow]")
 {
     TestContext context;
@@ -226,30 +282,87 @@ TEST_CASE("ARPChanges_CheckSnapshot", "[ARPChanges][workflow]")
 
     REQUIRE(context.Contains(Data::ARPSnapshot));
 
-    auto snapshot = context.Get<Data::ARPSnapshot>();
+    const auto& snapshot = context.Get<Data::ARPSnapshot>();
 
     REQUIRE(context.EverythingResult.Matches.size() == snapshot.size());
 
-    // Destructively match
-    for (const auto& match : context.EverythingResult.Matches)
+    // Every match should be represented exactly once
+    std::vector<std::string> productCodes;
+    for (const auto& entry : snapshot.GetEntries())
     {
-        bool found = false;
-        for (auto itr = snapshot.begin(); itr != snapshot.end(); ++itr)
-        {
-            if (match.Package->GetProperty(PackageProperty::Id) == std::get<0>(*itr))
-            {
-                REQUIRE(match.Package->GetInstalledVersion()->GetProperty(PackageVersionProperty::Version) == std::get<1>(*itr));
-                REQUIRE(match.Package->GetInstalledVersion()->GetProperty(PackageVersionProperty::Channel) == std::get<2>(*itr));
-
-                snapshot.erase(itr);
-                found = true;
-                break;
-            }
-        }
-        REQUIRE(found);
+        productCodes.emplace_back(entry.ProductCode);
     }
+    std::sort(productCodes.begin(), productCodes.end());
+
+    REQUIRE(productCodes == std::vector<std::string>{ "Id1", "Id2" });
 
-    REQUIRE(snapshot.empty());
+    // A snapshot of the same state has no differences
+    REQUIRE(snapshot.GetAddedOrChanged(ARPSnapshot::Capture()).empty());
+}
+
+TEST_CASE("ARPChanges_SnapshotDiff", "[ARPChanges]")
+{
+    TestContext context;
+
+    ARPSnapshot baseline = ARPSnapshot::Capture();
+
+    // Add a new entry, and change the version of an existing one
+    context.AddEverythingResult("Id3", "Name3", "Publisher3", "3.0");
+    context.AddEverythingResult("Id1", "Name1", "Publisher1", "1.1");
+    context.EverythingResult.Matches.erase(context.EverythingResult.Matches.begin());
+
+    auto changes = baseline.GetAddedOrChanged(ARPSnapshot::Capture());
+    std::sort(changes.begin(), changes.end());
+
+    REQUIRE(changes == std::vector<std::string>{ "Id1", "Id3" });
+}
+
+TEST_CASE("ARPChanges_SnapshotComparesValues", "[ARPChanges]")
+{
+    ARPSnapshot::Entry first;
+    first.KeyHash = 1;
+    first.VersionHash = 2;
+    first.ProductCode = "ProductCode";
+    first.Version = "1.0";
+
+    // Entries with equal hashes are only the same if their values are too
+    ARPSnapshot::Entry second = first;
+    REQUIRE(first == second);
+
+    second.Version = "2.0";
+    REQUIRE(first != second);
+    REQUIRE(first < second);
+
+    second = first;
+    second.ProductCode = "OtherProductCode";
+    REQUIRE(first != second);
+    REQUIRE(second < first);
+}
+
+TEST_CASE("ARPChanges_SnapshotReplacedAfterReport", "[ARPChanges][workflow]")
+{
+    TestContext context;
+
+    context << SnapshotARPEntries;
+    REQUIRE(context.Contains(Data::ARPSnapshot));
+
+    context.AddEverythingResult("EverythingId1", "EverythingName1", "EverythingPublisher1", "EverythingVersion1");
+
+    context << ReportARPChanges;
+    context.ExpectEvent(1, 0, 0, context.EverythingResult.Matches.back().Package.get());
+
+    // The post install state is now the baseline, and it is reused rather than captured again
+    REQUIRE(!context.Contains(Data::ARPSnapshot));
+    REQUIRE(context.Contains(Data::ARPBaseline));
+    REQUIRE(context.Get<Data::ARPBaseline>().size() == context.EverythingResult.Matches.size());
+
+    context.AddEverythingResult("EverythingId2", "EverythingName2", "EverythingPublisher2", "EverythingVersion2");
+    context << SnapshotARPEntries;
+    REQUIRE(!context.Contains(Data::ARPBaseline));
+    REQUIRE(context.Get<Data::ARPSnapshot>().size() == context.EverythingResult.Matches.size() - 1);
+
+    context << ReportARPChanges;
+    context.ExpectEvent(1, 0, 0, context.EverythingResult.Matches.back().Package.get());
 }
 
 TEST_CASE("ARPChanges_NoChange_NoMatch", "[ARPChanges][workflow]")
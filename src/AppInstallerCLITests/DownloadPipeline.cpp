@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerSHA256.h>
+#include <DownloadPipeline.h>
+
+using namespace AppInstaller::Utility;
+
+namespace
+{
+    std::vector<BYTE> GetContents(size_t size)
+    {
+        std::vector<BYTE> result(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            result[i] = static_cast<BYTE>((i * 13) ^ (i >> 10));
+        }
+        return result;
+    }
+
+    // Passes the contents through a pipeline in chunks that do not fill the buffers, returning what was written.
+    std::vector<BYTE> RunPipeline(const std::vector<BYTE>& contents, SHA256* hashEngine, size_t bufferCount)
+    {
+        std::vector<BYTE> written;
+        DownloadPipeline pipeline{ [&](const BYTE* data, size_t size) { written.insert(written.end(), data, data + size); }, hashEngine, bufferCount, 4096 };
+
+        size_t offset = 0;
+        size_t size = 0;
+        do
+        {
+            BYTE* buffer = pipeline.AcquireBuffer();
+            size = std::min(pipeline.GetBufferSize() - 7, contents.size() - offset);
+            std::copy_n(contents.begin() + offset, size, buffer);
+            pipeline.Submit(size);
+            offset += size;
+        } while (size != 0);
+
+        pipeline.Complete();
+        return written;
+    }
+}
+
+TEST_CASE("DownloadPipeline_WritesAndHashesInOrder", "[Downloader]")
+{
+    std::vector<BYTE> contents = GetContents((1 << 20) + 5);
+    auto expectedHash = SHA256::ComputeHash(contents.data(), static_cast<uint32_t>(contents.size()));
+
+    for (size_t bufferCount : { 1, 2, 3, 8 })
+    {
+        INFO(bufferCount);
+
+        SHA256 hashEngine;
+        REQUIRE(RunPipeline(contents, &hashEngine, bufferCount) == contents);
+        REQUIRE(hashEngine.Get() == expectedHash);
+
+        REQUIRE(RunPipeline(contents, nullptr, bufferCount) == contents);
+    }
+}
+
+TEST_CASE("DownloadPipeline_WriteFailure", "[Downloader]")
+{
+    for (size_t bufferCount : { 1, 3 })
+    {
+        INFO(bufferCount);
+
+        DownloadPipeline pipeline{ [](const BYTE*, size_t) { THROW_HR(E_ACCESSDENIED); }, nullptr, bufferCount, 16 };
+
+        // The error is reported by a later call once the write stage has seen it
+        auto submitAll = [&]()
+        {
+            for (size_t i = 0; i < 10; ++i)
+            {
+                pipeline.AcquireBuffer();
+                pipeline.Submit(16);
+            }
+
+            pipeline.Complete();
+        };
+
+        REQUIRE_THROWS_HR(submitAll(), E_ACCESSDENIED);
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winget/DownloadScheduler.h>
+
+#include <future>
+
+using namespace AppInstaller;
+using namespace AppInstaller::Utility;
+using namespace std::chrono_literals;
+
+namespace
+{
+    DownloadScheduler::Options GetOptions(uint32_t maxConcurrentDownloads, uint64_t maxBytesPerSecond = 0)
+    {
+        DownloadScheduler::Options result;
+        result.MaxConcurrentDownloads = maxConcurrentDownloads;
+        result.MaxBytesPerSecond = maxBytesPerSecond;
+        return result;
+    }
+
+    void WaitForWaitingCount(const DownloadScheduler& scheduler, size_t count)
+    {
+        auto end = std::chrono::steady_clock::now() + 5s;
+        while (scheduler.GetWaitingCount() != count)
+        {
+            REQUIRE(std::chrono::steady_clock::now() < end);
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+}
+
+TEST_CASE("DownloadScheduler_ConcurrencyLimit", "[Downloader]")
+{
+    DownloadScheduler scheduler{ GetOptions(2) };
+    ProgressCallback progress;
+
+    auto first = scheduler.Acquire(DownloadType::Installer, progress);
+    auto second = scheduler.Acquire(DownloadType::Installer, progress);
+    REQUIRE(first);
+    REQUIRE(second);
+    REQUIRE(scheduler.GetRunningCount() == 2);
+
+    auto third = std::async(std::launch::async, [&]() { return scheduler.Acquire(DownloadType::Installer, progress); });
+    WaitForWaitingCount(scheduler, 1);
+    REQUIRE(third.wait_for(50ms) == std::future_status::timeout);
+
+    first.reset();
+    REQUIRE(third.get());
+    REQUIRE(scheduler.GetWaitingCount() == 0);
+    REQUIRE(scheduler.GetRunningCount() == 2);
+}
+
+TEST_CASE("DownloadScheduler_Priority", "[Downloader]")
+{
+    DownloadScheduler scheduler{ GetOptions(1) };
+    ProgressCallback progress;
+
+    auto running = scheduler.Acquire(DownloadType::Installer, progress);
+
+    std::mutex orderMutex;
+    std::vector<DownloadType> order;
+    auto acquire = [&](DownloadType type)
+    {
+        auto ticket = scheduler.Acquire(type, progress);
+        std::lock_guard<std::mutex> lock{ orderMutex };
+        order.push_back(type);
+    };
+
+    // The installer arrives first, but the manifest has a higher priority
+    auto installer = std::async(std::launch::async, acquire, DownloadType::Installer);
+    WaitForWaitingCount(scheduler, 1);
+    auto manifest = std::async(std::launch::async, acquire, DownloadType::Manifest);
+    WaitForWaitingCount(scheduler, 2);
+
+    running.reset();
+    installer.get();
+    manifest.get();
+
+    REQUIRE(order == std::vector<DownloadType>{ DownloadType::Manifest, DownloadType::Installer });
+}
+
+TEST_CASE("DownloadScheduler_CancelWhileWaiting", "[Downloader]")
+{
+    DownloadScheduler scheduler{ GetOptions(1) };
+    ProgressCallback progress;
+    ProgressCallback waitingProgress;
+
+    auto running = scheduler.Acquire(DownloadType::Installer, progress);
+
+    auto waiting = std::async(std::launch::async, [&]() { return scheduler.Acquire(DownloadType::Installer, waitingProgress); });
+    WaitForWaitingCount(scheduler, 1);
+
+    waitingProgress.Cancel();
+    REQUIRE_FALSE(waiting.get());
+    REQUIRE(scheduler.GetWaitingCount() == 0);
+    REQUIRE(scheduler.GetRunningCount() == 1);
+}
+
+TEST_CASE("DownloadScheduler_BandwidthLimit", "[Downloader]")
+{
+    DownloadScheduler scheduler{ GetOptions(0, 1 << 20) };
+    ProgressCallback progress;
+
+    auto ticket = scheduler.Acquire(DownloadType::Installer, progress);
+
+    // The bucket starts with a second of data, then the next half second must be waited for
+    ticket->OnBytesReceived(1 << 20);
+    REQUIRE(ticket->GetMetrics().ThrottledTime < 100ms);
+
+    ticket->OnBytesReceived(1 << 19);
+
+    DownloadMetrics metrics = ticket->GetMetrics();
+    REQUIRE(metrics.ThrottledTime >= 400ms);
+    REQUIRE(metrics.Bytes == (1 << 20) + (1 << 19));
+    REQUIRE(metrics.GetBytesPerSecond() <= (1 << 21));
+}
@@ -5,9 +5,82 @@
 #include "TestRestRequestHandler.h"
 #include <AppInstallerErrors.h>
 #include <Rest/HttpClientHelper.h>
+#include <cpprest/http_listener.h>
+
+#include <thread>
 
 using namespace AppInstaller::Repository::Rest;
 
+namespace
+{
+    constexpr std::wstring_view s_LocalServerUri = L"http://localhost:51871/";
+
+    // The gzip encoding of s_UncompressedBody.
+    const std::vector<unsigned char> s_CompressedBody =
+    {
+        0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xab, 0x56, 0x50, 0x72, 0x49, 0x2c, 0x49, 0x54, 0x52, 0xb0,
+        0x52, 0xa8, 0x56, 0x50, 0x0a, 0x4b, 0xcc, 0x29, 0x4d, 0x05, 0xb1, 0x95, 0x92, 0xf3, 0x73, 0x0b, 0x8a, 0x52, 0x8b, 0x8b,
+        0x53, 0x53, 0x14, 0x86, 0x1d, 0x53, 0x49, 0xa1, 0x56, 0xa1, 0x16, 0x00, 0x1f, 0x1f, 0x2a, 0x97, 0xf9, 0x00, 0x00, 0x00,
+    };
+
+    std::string GetUncompressedBody()
+    {
+        std::string result = R"({ "Data" : { "Value" : ")";
+        for (size_t i = 0; i < 20; ++i)
+        {
+            result += "compressed ";
+        }
+        result += R"(" } })";
+        return result;
+    }
+
+    // A local server that sends a gzip encoded body to requests that accept it, and the plain body otherwise.
+    struct CompressingServer
+    {
+        CompressingServer() : m_listener(utility::string_t{ s_LocalServerUri })
+        {
+            m_listener.support([this](web::http::http_request request)
+                {
+                    web::http::http_response response{ web::http::status_codes::OK };
+                    utility::string_t acceptEncoding;
+
+                    if (request.headers().match(web::http::header_names::accept_encoding, acceptEncoding) && acceptEncoding.find(L"gzip") != utility::string_t::npos)
+                    {
+                        ++CompressedResponses;
+                        response.set_body(s_CompressedBody);
+                        response.headers().add(web::http::header_names::content_encoding, L"gzip");
+                    }
+                    else
+                    {
+                        response.set_body(GetUncompressedBody());
+                    }
+
+                    response.headers().set_content_type(web::http::details::mime_types::application_json);
+                    request.reply(response);
+                });
+
+            m_listener.open().wait();
+        }
+
+        ~CompressingServer()
+        {
+            m_listener.close().wait();
+        }
+
+        std::atomic<size_t> CompressedResponses = 0;
+
+    private:
+        web::http::experimental::listener::http_listener m_listener;
+    };
+
+    HttpClientHelper::PoolOptions GetCompressionOptions(bool requestCompression)
+    {
+        HttpClientHelper::PoolOptions result;
+        result.RequestCompression = requestCompression;
+        return result;
+    }
+}
+
 TEST_CASE("ExtractJsonResponse_UnsupportedMimeType", "[RestSource][RestSearch]")
 {
     HttpClientHelper helper{ GetTestRestRequestHandler(web::http::status_codes::OK, L"", web::http::details::mime_types::text_plain) };
@@ -19,3 +92,88 @@ TEST_CASE("ValidateAndExtractResponse_ServiceUnavailable", "[RestSource]")
     HttpClientHelper helper{ GetTestRestRequestHandler(web::http::status_codes::ServiceUnavailable) };
     REQUIRE_THROWS_HR(helper.HandleGet(L"https://testUri"), MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, web::http::status_codes::ServiceUnavailable));
 }
+
+TEST_CASE("HttpClientHelper_ReusesClientPerServer", "[RestSource]")
+{
+    HttpClientHelper helper{ GetTestRestRequestHandler(web::http::status_codes::NoContent) };
+
+    helper.HandleGet(L"https://testUri/api/information");
+    helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Bar?Version=1.0");
+    helper.HandlePost(L"https://testUri/api/manifestSearch", web::json::value::object());
+    REQUIRE(helper.GetClientCreationCount() == 1);
+
+    // Copies share the same clients
+    HttpClientHelper copy = helper;
+    copy.HandleGet(L"https://testUri/api/information");
+    REQUIRE(helper.GetClientCreationCount() == 1);
+
+    // A different server, or a different port on the same server, needs its own client
+    helper.HandleGet(L"https://otherUri/api/information");
+    helper.HandleGet(L"https://testUri:8443/api/information");
+    REQUIRE(copy.GetClientCreationCount() == 3);
+}
+
+TEST_CASE("HttpClientHelper_IdleClientDiscarded", "[RestSource]")
+{
+    HttpClientHelper::PoolOptions options;
+    options.IdleTimeout = std::chrono::seconds(0);
+    HttpClientHelper helper{ GetTestRestRequestHandler(web::http::status_codes::NoContent), options };
+
+    helper.HandleGet(L"https://testUri/api/information");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    helper.HandleGet(L"https://testUri/api/information");
+
+    REQUIRE(helper.GetClientCreationCount() == 2);
+}
+
+TEST_CASE("HttpClientHelper_CompressedResponse", "[RestSource]")
+{
+    CompressingServer server;
+    HttpClientHelper helper{ {}, GetCompressionOptions(true) };
+
+    auto response = helper.HandleGet(std::wstring{ s_LocalServerUri } + L"api/information");
+    REQUIRE(response);
+    REQUIRE(response.value() == web::json::value::parse(utility::conversions::to_string_t(GetUncompressedBody())));
+    REQUIRE(server.CompressedResponses == 1);
+
+    auto bytesReceived = helper.GetBytesReceived();
+    REQUIRE(bytesReceived.Wire == s_CompressedBody.size());
+    REQUIRE(bytesReceived.Decoded == GetUncompressedBody().size());
+}
+
+TEST_CASE("HttpClientHelper_CompressionDisabled", "[RestSource]")
+{
+    CompressingServer server;
+    HttpClientHelper helper{ {}, GetCompressionOptions(false) };
+
+    auto response = helper.HandleGet(std::wstring{ s_LocalServerUri } + L"api/information");
+    REQUIRE(response);
+    REQUIRE(response.value() == web::json::value::parse(utility::conversions::to_string_t(GetUncompressedBody())));
+    REQUIRE(server.CompressedResponses == 0);
+
+    auto bytesReceived = helper.GetBytesReceived();
+    REQUIRE(bytesReceived.Wire == GetUncompressedBody().size());
+    REQUIRE(bytesReceived.Decoded == GetUncompressedBody().size());
+}
+
+TEST_CASE("HttpClientHelper_EncodedResponseWithoutContentLength", "[RestSource]")
+{
+    // The body is not actually compressed, as it never passes through WinHTTP; only the headers matter here
+    HttpClientHelper helper{ std::make_shared<TestRestRequestHandler>([](web::http::http_request) ->
+        pplx::task<web::http::http_response>
+        {
+            web::http::http_response response{ web::http::status_codes::OK };
+            response.set_body(GetUncompressedBody());
+            response.headers().set_content_type(web::http::details::mime_types::application_json);
+            response.headers().add(web::http::header_names::content_encoding, L"gzip");
+            response.headers().remove(web::http::header_names::content_length);
+            return pplx::task_from_result(response);
+        }) };
+
+    auto response = helper.HandleGet(L"https://testUri/api/information");
+    REQUIRE(response);
+
+    auto bytesReceived = helper.GetBytesReceived();
+    REQUIRE(bytesReceived.Wire == 0);
+    REQUIRE(bytesReceived.Decoded == 0);
+}
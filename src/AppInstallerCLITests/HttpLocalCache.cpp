@@ -0,0 +1,267 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winrt/Windows.Security.Cryptography.h>
+#include <winrt/Windows.Storage.Streams.h>
+#include <winrt/Windows.Web.Http.h>
+#include "HttpStream/HttpLocalCache.h"
+
+using namespace TestCommon;
+using namespace AppInstaller::Utility::HttpStream;
+using namespace winrt::Windows::Security::Cryptography;
+using namespace winrt::Windows::Storage::Streams;
+
+namespace
+{
+    constexpr UINT32 PageSize = HttpLocalCache::PAGE_SIZE;
+    constexpr std::string_view TestUri = "https://localhost/package.msix";
+
+    // Serves ranges of a file from memory, recording every range requested.
+    struct TestHttpClient : public HttpClientWrapper
+    {
+        TestHttpClient(size_t size) : Contents(size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                Contents[i] = static_cast<uint8_t>((i * 7) ^ (i >> 12));
+            }
+        }
+
+        std::future<IBuffer> DownloadRangeAsync(const ULONG64 startPosition, const UINT32 requestedSizeInBytes, const InputStreamOptions&) override
+        {
+            Requests.emplace_back(startPosition, requestedSizeInBytes);
+
+            std::promise<IBuffer> result;
+            result.set_value(CryptographicBuffer::CreateFromByteArray({ Contents.data() + startPosition, Contents.data() + startPosition + requestedSizeInBytes }));
+            return result.get_future();
+        }
+
+        unsigned long long GetFullFileSize() override
+        {
+            return Contents.size();
+        }
+
+        std::vector<uint8_t> Contents;
+        std::vector<std::pair<ULONG64, UINT32>> Requests;
+    };
+
+    // Reads from the cache and checks that the result matches the file.
+    IBuffer ReadAndVerify(HttpLocalCache& cache, TestHttpClient& client, ULONG64 position, UINT32 size, IBuffer destination = nullptr)
+    {
+        IBuffer result = cache.ReadFromCacheAndDownloadIfNecessaryAsync(position, size, &client, InputStreamOptions::None, destination).get();
+
+        winrt::com_array<uint8_t> bytes;
+        CryptographicBuffer::CopyToByteArray(result, bytes);
+
+        size_t expectedSize = std::min<size_t>(size, client.Contents.size() - static_cast<size_t>(position));
+        REQUIRE(bytes.size() == expectedSize);
+        REQUIRE(std::equal(bytes.begin(), bytes.end(), client.Contents.begin() + static_cast<size_t>(position)));
+
+        return result;
+    }
+
+    size_t CountFiles(const std::filesystem::path& directory)
+    {
+        return static_cast<size_t>(std::distance(std::filesystem::directory_iterator{ directory }, std::filesystem::directory_iterator{}));
+    }
+}
+
+TEST_CASE("HttpLocalCache_CoalescesMissingPages", "[HttpStream]")
+{
+    TestHttpClient client{ 8 * PageSize + 100 };
+    HttpLocalCache cache;
+
+    ReadAndVerify(cache, client, 10, 100);
+    REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { 0, PageSize } });
+    client.Requests.clear();
+
+    // The pages after the cached one are fetched together
+    ReadAndVerify(cache, client, 0, 4 * PageSize);
+    REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { PageSize, 3 * PageSize } });
+    client.Requests.clear();
+
+    // A cached page in the middle splits the missing pages into separate requests
+    ReadAndVerify(cache, client, 5 * PageSize + 1, 10);
+    client.Requests.clear();
+
+    ReadAndVerify(cache, client, 4 * PageSize + 5, 3 * PageSize - 10);
+    REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { 4 * PageSize, PageSize }, { 6 * PageSize, PageSize } });
+    client.Requests.clear();
+
+    // The last page is shorter than the others, and reads past the end of the file are cut short
+    ReadAndVerify(cache, client, 8 * PageSize - 50, 1000);
+    REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { 7 * PageSize, PageSize + 100 } });
+    client.Requests.clear();
+
+    ReadAndVerify(cache, client, 2 * PageSize - 3, 5 * PageSize);
+    REQUIRE(client.Requests.empty());
+}
+
+TEST_CASE("HttpLocalCache_UsesDestinationBuffer", "[HttpStream]")
+{
+    TestHttpClient client{ 3 * PageSize };
+    HttpLocalCache cache;
+
+    Buffer destination{ 2 * PageSize };
+    IBuffer result = ReadAndVerify(cache, client, PageSize / 2, PageSize, destination);
+    REQUIRE(result == destination);
+
+    // Too small to hold the result
+    Buffer smallDestination{ 10 };
+    result = ReadAndVerify(cache, client, 0, 100, smallDestination);
+    REQUIRE(result != smallDestination);
+}
+
+TEST_CASE("HttpLocalCache_EvictsLeastRecentlyUsed", "[HttpStream]")
+{
+    constexpr UINT32 pageCount = HttpLocalCache::MAX_PAGES + 10;
+    TestHttpClient client{ pageCount * PageSize };
+    HttpLocalCache cache;
+
+    // Read every page in reverse so that none of the reads look sequential
+    for (UINT32 i = pageCount; i > 0; --i)
+    {
+        ReadAndVerify(cache, client, (i - 1) * PageSize, PageSize);
+
+        // Use the first page again to keep it in the cache
+        if (i == pageCount / 2)
+        {
+            ReadAndVerify(cache, client, (pageCount - 1) * PageSize, 10);
+        }
+    }
+
+    REQUIRE(client.Requests.size() == pageCount);
+    REQUIRE(cache.GetPageCount() == HttpLocalCache::MAX_PAGES);
+
+    REQUIRE(cache.IsCached(0));
+    REQUIRE(cache.IsCached((pageCount - 1) * PageSize));
+    for (UINT32 i = 2; i <= 11; ++i)
+    {
+        INFO(i);
+        REQUIRE_FALSE(cache.IsCached((pageCount - i) * PageSize));
+    }
+    REQUIRE(cache.IsCached((pageCount - 12) * PageSize));
+}
+
+TEST_CASE("HttpLocalCache_SequentialReadahead", "[HttpStream]")
+{
+    constexpr UINT32 pageCount = 64;
+    TestHttpClient client{ pageCount * PageSize };
+
+    // Reads that jump around only fetch the pages they need
+    {
+        HttpLocalCache cache;
+        ReadAndVerify(cache, client, 10 * PageSize, PageSize / 2);
+        ReadAndVerify(cache, client, 20 * PageSize, PageSize / 2);
+        ReadAndVerify(cache, client, 30 * PageSize, PageSize / 2);
+        REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { 10 * PageSize, PageSize }, { 20 * PageSize, PageSize }, { 30 * PageSize, PageSize } });
+        client.Requests.clear();
+    }
+
+    // Reading the whole file in order fetches more with each request
+    HttpLocalCache cache;
+    for (ULONG64 position = 0; position < pageCount * PageSize; position += PageSize / 2)
+    {
+        ReadAndVerify(cache, client, position, PageSize / 2);
+    }
+
+    REQUIRE(client.Requests.size() < 10);
+    REQUIRE(client.Requests.front().second == PageSize);
+
+    UINT32 largestRequest = 0;
+    for (const auto& request : client.Requests)
+    {
+        largestRequest = std::max(largestRequest, request.second);
+    }
+    REQUIRE(largestRequest == (HttpLocalCache::MAX_READAHEAD_PAGES + 1) * PageSize);
+}
+
+TEST_CASE("HttpDiskCache_GetKey", "[HttpStream]")
+{
+    std::string key = HttpDiskCache::GetKey(TestUri, L"\"1\"", L"", 100);
+    REQUIRE(!key.empty());
+    REQUIRE(key == HttpDiskCache::GetKey(TestUri, L"\"1\"", L"", 100));
+
+    REQUIRE(key != HttpDiskCache::GetKey(TestUri, L"\"2\"", L"", 100));
+    REQUIRE(key != HttpDiskCache::GetKey(TestUri, L"\"1\"", L"", 101));
+    REQUIRE(key != HttpDiskCache::GetKey("https://localhost/other.msix", L"\"1\"", L"", 100));
+    REQUIRE(!HttpDiskCache::GetKey(TestUri, L"", L"Wed, 21 Oct 2015 07:28:00 GMT", 100).empty());
+
+    // Nothing to tell whether the file has changed
+    REQUIRE(HttpDiskCache::GetKey(TestUri, L"", L"", 100).empty());
+    REQUIRE(HttpDiskCache::GetKey(TestUri, L"W/\"1\"", L"", 100).empty());
+}
+
+TEST_CASE("HttpDiskCache_ReusedAcrossStreams", "[HttpStream]")
+{
+    TempDirectory cacheDirectory{ "HttpDiskCache" };
+    TestHttpClient client{ 4 * PageSize + 100 };
+    std::string key = HttpDiskCache::GetKey(TestUri, L"\"1\"", L"", client.GetFullFileSize());
+
+    {
+        HttpLocalCache cache;
+        cache.SetDiskCache(std::make_unique<HttpDiskCache>(cacheDirectory.GetPath(), 1 << 30, key, client.GetFullFileSize()));
+
+        ReadAndVerify(cache, client, 10, 100);
+        ReadAndVerify(cache, client, 3 * PageSize + 10, PageSize + 90);
+        REQUIRE(client.Requests.size() == 2);
+        client.Requests.clear();
+    }
+
+    // Only the page in between is downloaded
+    {
+        HttpLocalCache cache;
+        cache.SetDiskCache(std::make_unique<HttpDiskCache>(cacheDirectory.GetPath(), 1 << 30, key, client.GetFullFileSize()));
+
+        ReadAndVerify(cache, client, 5, 4 * PageSize + 95);
+        REQUIRE(client.Requests == std::vector<std::pair<ULONG64, UINT32>>{ { PageSize, 2 * PageSize } });
+        client.Requests.clear();
+    }
+
+    // A different version of the file does not use the pages
+    {
+        std::string otherKey = HttpDiskCache::GetKey(TestUri, L"\"2\"", L"", client.GetFullFileSize());
+
+        HttpLocalCache cache;
+        cache.SetDiskCache(std::make_unique<HttpDiskCache>(cacheDirectory.GetPath(), 1 << 30, otherKey, client.GetFullFileSize()));
+
+        ReadAndVerify(cache, client, 10, 100);
+        REQUIRE(client.Requests.size() == 1);
+    }
+}
+
+TEST_CASE("HttpDiskCache_MaximumSize", "[HttpStream]")
+{
+    TempDirectory cacheDirectory{ "HttpDiskCache" };
+    TestHttpClient client{ 8 * PageSize };
+    std::string key = HttpDiskCache::GetKey(TestUri, L"\"1\"", L"", client.GetFullFileSize());
+
+    {
+        HttpLocalCache cache;
+        cache.SetDiskCache(std::make_unique<HttpDiskCache>(cacheDirectory.GetPath(), 3 * PageSize, key, client.GetFullFileSize()));
+
+        ReadAndVerify(cache, client, 0, 8 * PageSize);
+        REQUIRE(CountFiles(cacheDirectory.GetPath()) == 8);
+    }
+
+    // The pages beyond the maximum size are removed when the stream is done
+    REQUIRE(CountFiles(cacheDirectory.GetPath()) == 3);
+
+    // A page truncated on disk is downloaded again
+    std::filesystem::path pagePath = std::filesystem::directory_iterator{ cacheDirectory.GetPath() }->path();
+    std::filesystem::resize_file(pagePath, 10);
+
+    HttpLocalCache cache;
+    cache.SetDiskCache(std::make_unique<HttpDiskCache>(cacheDirectory.GetPath(), 3 * PageSize, key, client.GetFullFileSize()));
+
+    client.Requests.clear();
+    ReadAndVerify(cache, client, 0, 8 * PageSize);
+
+    UINT32 downloadedSize = 0;
+    for (const auto& request : client.Requests)
+    {
+        downloadedSize += request.second;
+    }
+    REQUIRE(downloadedSize == 6 * PageSize);
+}
@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include "TestRestRequestHandler.h"
+#include <Rest/HttpClientHelper.h>
+#include <Rest/HttpResponseCache.h>
+
+#include <thread>
+
+using namespace TestCommon;
+using namespace AppInstaller::Repository::Rest;
+using namespace AppInstaller::Settings;
+
+namespace
+{
+    constexpr std::wstring_view s_TestETag = L"\"v1\"";
+
+    // A server that returns the same response with an ETag, or Not Modified when the request already has that ETag.
+    std::shared_ptr<TestRestRequestHandler> GetETagRequestHandler(std::atomic<size_t>& requestCount, std::atomic<size_t>& notModifiedCount)
+    {
+        return std::make_shared<TestRestRequestHandler>([&](web::http::http_request request)
+            {
+                ++requestCount;
+
+                web::http::http_response response;
+                utility::string_t etag;
+                if (request.headers().match(web::http::header_names::if_none_match, etag) && etag == s_TestETag)
+                {
+                    ++notModifiedCount;
+                    response.set_status_code(web::http::status_codes::NotModified);
+                }
+                else
+                {
+                    response.set_body(web::json::value::parse(LR"({ "Data" : { "Value" : "response" } })"));
+                    response.headers().set_content_type(web::http::details::mime_types::application_json);
+                    response.headers().add(web::http::header_names::etag, s_TestETag);
+                    response.set_status_code(web::http::status_codes::OK);
+                }
+
+                return pplx::task_from_result(response);
+            });
+    }
+
+    HttpResponseCache::Options GetTestOptions(std::chrono::seconds timeToLive)
+    {
+        HttpResponseCache::Options result;
+        result.TimeToLive = timeToLive;
+        result.MaxSizeInBytes = 1 << 20;
+        return result;
+    }
+}
+
+TEST_CASE("HttpResponseCache_FreshResponseSkipsServer", "[RestSource]")
+{
+    TempDirectory cacheDirectory{ "RestCache" };
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> notModifiedCount = 0;
+
+    HttpClientHelper helper{ GetETagRequestHandler(requestCount, notModifiedCount) };
+    auto cache = std::make_shared<HttpResponseCache>(cacheDirectory.GetPath(), GetTestOptions(std::chrono::hours(1)));
+    helper.SetResponseCache(cache);
+
+    auto first = helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Bar");
+    auto second = helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Bar");
+    REQUIRE(first);
+    REQUIRE(second);
+    REQUIRE(first.value() == second.value());
+    REQUIRE(requestCount == 1);
+
+    // A different request is not served from the cache
+    helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Baz");
+    REQUIRE(requestCount == 2);
+
+    auto statistics = cache->GetStatistics();
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 2);
+}
+
+TEST_CASE("HttpResponseCache_StaleResponseRevalidated", "[RestSource]")
+{
+    TempDirectory cacheDirectory{ "RestCache" };
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> notModifiedCount = 0;
+
+    HttpClientHelper helper{ GetETagRequestHandler(requestCount, notModifiedCount) };
+    auto cache = std::make_shared<HttpResponseCache>(cacheDirectory.GetPath(), GetTestOptions(std::chrono::seconds(0)));
+    helper.SetResponseCache(cache);
+
+    web::json::value body = web::json::value::object();
+    body[L"Query"] = web::json::value::string(L"Foo");
+
+    auto first = helper.HandlePost(L"https://testUri/api/manifestSearch", body);
+    auto second = helper.HandlePost(L"https://testUri/api/manifestSearch", body);
+    REQUIRE(first);
+    REQUIRE(second);
+    REQUIRE(first.value() == second.value());
+    REQUIRE(requestCount == 2);
+    REQUIRE(notModifiedCount == 1);
+    REQUIRE(cache->GetStatistics().Revalidations == 1);
+
+    // A different body is a different request
+    body[L"Query"] = web::json::value::string(L"Bar");
+    helper.HandlePost(L"https://testUri/api/manifestSearch", body);
+    REQUIRE(requestCount == 3);
+    REQUIRE(notModifiedCount == 1);
+}
+
+TEST_CASE("HttpResponseCache_Disabled", "[RestSource]")
+{
+    TempDirectory cacheDirectory{ "RestCache" };
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> notModifiedCount = 0;
+
+    HttpClientHelper helper{ GetETagRequestHandler(requestCount, notModifiedCount) };
+    HttpResponseCache::Options options = GetTestOptions(std::chrono::hours(1));
+    options.MaxSizeInBytes = 0;
+    helper.SetResponseCache(std::make_shared<HttpResponseCache>(cacheDirectory.GetPath(), options));
+
+    helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Bar");
+    helper.HandleGet(L"https://testUri/api/packageManifests/Foo.Bar");
+    REQUIRE(requestCount == 2);
+    REQUIRE(notModifiedCount == 0);
+    REQUIRE(std::filesystem::is_empty(cacheDirectory.GetPath()));
+}
+
+TEST_CASE("HttpResponseCache_EvictsLeastRecentlyUsed", "[RestSource]")
+{
+    TempDirectory cacheDirectory{ "RestCache" };
+
+    // Room for two responses, but not three
+    std::string body = '"' + std::string(1000, 'a') + '"';
+    HttpResponseCache::Options options = GetTestOptions(std::chrono::hours(1));
+    options.MaxSizeInBytes = 2500;
+    HttpResponseCache cache{ cacheDirectory.GetPath(), options };
+
+    std::string keyA = HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/a", {});
+    std::string keyB = HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/b", {});
+    std::string keyC = HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/c", {});
+
+    cache.Store(keyA, body, s_TestETag.data(), {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Store(keyB, body, s_TestETag.data(), {});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Using A makes B the least recently used
+    REQUIRE(cache.Find(keyA));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Store(keyC, body, s_TestETag.data(), {});
+
+    REQUIRE(cache.Find(keyA));
+    REQUIRE(!cache.Find(keyB));
+    REQUIRE(cache.Find(keyC));
+    REQUIRE(cache.GetStatistics().Evictions == 1);
+}
+
+TEST_CASE("HttpResponseCache_KeyIgnoresHeaderOrder", "[RestSource]")
+{
+    std::unordered_map<utility::string_t, utility::string_t> headers1{ { L"Version", L"1.0.0" }, { L"Accept-Language", L"en-US" } };
+    std::unordered_map<utility::string_t, utility::string_t> headers2{ { L"Accept-Language", L"en-US" }, { L"Version", L"1.0.0" } };
+
+    REQUIRE(HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/a", headers1) ==
+        HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/a", headers2));
+    REQUIRE(HttpResponseCache::GetKey(web::http::methods::GET, L"https://testUri/a", headers1) !=
+        HttpResponseCache::GetKey(web::http::methods::POST, L"https://testUri/a", headers1));
+}
+
+TEST_CASE("HttpResponseCache_OptionsMatchSourceNameCaseInsensitively", "[RestSource]")
+{
+    TestUserSettings settings;
+    settings.Set<Setting::NetworkRestCacheTimeToLiveInSeconds>(std::chrono::seconds(60));
+    settings.Set<Setting::NetworkRestCacheSourceTimeToLiveInSeconds>({ { "Contoso", std::chrono::seconds(5) } });
+    settings.Set<Setting::NetworkRestCompressionDisabledSources>({ "Contoso" });
+
+    REQUIRE(HttpResponseCache::Options::FromUserSettings("contoso").TimeToLive == std::chrono::seconds(5));
+    REQUIRE(HttpResponseCache::Options::FromUserSettings("Other").TimeToLive == std::chrono::seconds(60));
+
+    REQUIRE(!HttpClientHelper::PoolOptions::FromUserSettings("CONTOSO").RequestCompression);
+    REQUIRE(HttpClientHelper::PoolOptions::FromUserSettings("Other").RequestCompression);
+}
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winget/InstallerCache.h>
+
+#include <thread>
+
+using namespace TestCommon;
+using namespace AppInstaller::Utility;
+
+namespace
+{
+    // Writes a file with the given contents, returning the hash of the contents.
+    SHA256::HashBuffer WriteInstaller(const std::filesystem::path& path, const std::string& contents)
+    {
+        std::ofstream stream{ path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+        stream << contents;
+        return SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(contents.c_str()), static_cast<uint32_t>(contents.size()));
+    }
+
+    std::string ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream{ path, std::ios_base::in | std::ios_base::binary };
+        std::ostringstream result;
+        result << stream.rdbuf();
+        return result.str();
+    }
+}
+
+TEST_CASE("InstallerCache_AddAndCopy", "[InstallerCache]")
+{
+    TempDirectory cacheDirectory{ "InstallerCache" };
+    TempFile installer{ "Installer", ".exe" };
+    TempFile destination{ "CachedInstaller", ".exe" };
+
+    InstallerCache cache{ cacheDirectory.GetPath(), 1 << 20 };
+
+    SHA256::HashBuffer hash = WriteInstaller(installer, "installer contents");
+    REQUIRE(!cache.CopyTo(hash, destination));
+
+    cache.Add(hash, installer);
+    REQUIRE(cache.CopyTo(hash, destination));
+    REQUIRE(ReadFile(destination) == "installer contents");
+
+    auto entries = cache.GetEntries();
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].Hash == hash);
+    REQUIRE(entries[0].Size == 18);
+
+    // A different hash is not found
+    SHA256::HashBuffer otherHash = SHA256::ComputeHash(reinterpret_cast<const uint8_t*>("other"), 5);
+    REQUIRE(!cache.CopyTo(otherHash, destination));
+
+    cache.Remove(hash);
+    REQUIRE(!cache.CopyTo(hash, destination));
+    REQUIRE(cache.GetEntries().empty());
+}
+
+TEST_CASE("InstallerCache_Disabled", "[InstallerCache]")
+{
+    TempDirectory cacheDirectory{ "InstallerCache" };
+    TempFile installer{ "Installer", ".exe" };
+    TempFile destination{ "CachedInstaller", ".exe" };
+
+    InstallerCache cache{ cacheDirectory.GetPath(), 0 };
+
+    SHA256::HashBuffer hash = WriteInstaller(installer, "installer contents");
+    cache.Add(hash, installer);
+
+    REQUIRE(!cache.CopyTo(hash, destination));
+    REQUIRE(std::filesystem::is_empty(cacheDirectory.GetPath()));
+}
+
+TEST_CASE("InstallerCache_EvictsLeastRecentlyUsed", "[InstallerCache]")
+{
+    TempDirectory cacheDirectory{ "InstallerCache" };
+    TempFile installerA{ "InstallerA", ".exe" };
+    TempFile installerB{ "InstallerB", ".exe" };
+    TempFile installerC{ "InstallerC", ".exe" };
+    TempFile installerTooLarge{ "InstallerTooLarge", ".exe" };
+    TempFile destination{ "CachedInstaller", ".exe" };
+
+    // Room for two installers, but not three
+    InstallerCache cache{ cacheDirectory.GetPath(), 2500 };
+
+    SHA256::HashBuffer hashA = WriteInstaller(installerA, std::string(1000, 'a'));
+    SHA256::HashBuffer hashB = WriteInstaller(installerB, std::string(1000, 'b'));
+    SHA256::HashBuffer hashC = WriteInstaller(installerC, std::string(1000, 'c'));
+    SHA256::HashBuffer hashTooLarge = WriteInstaller(installerTooLarge, std::string(3000, 'd'));
+
+    cache.Add(hashA, installerA);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Add(hashB, installerB);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Using A makes B the least recently used
+    REQUIRE(cache.CopyTo(hashA, destination));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Add(hashC, installerC);
+
+    REQUIRE(cache.CopyTo(hashA, destination));
+    REQUIRE(!cache.CopyTo(hashB, destination));
+    REQUIRE(cache.CopyTo(hashC, destination));
+
+    // An installer larger than the cache is not added, and does not evict anything
+    cache.Add(hashTooLarge, installerTooLarge);
+    REQUIRE(!cache.CopyTo(hashTooLarge, destination));
+    REQUIRE(cache.GetEntries().size() == 2);
+}
+
+TEST_CASE("InstallerCache_Clear", "[InstallerCache]")
+{
+    TempDirectory cacheDirectory{ "InstallerCache" };
+    TempFile installerA{ "InstallerA", ".exe" };
+    TempFile installerB{ "InstallerB", ".exe" };
+
+    InstallerCache cache{ cacheDirectory.GetPath(), 1 << 20 };
+
+    cache.Add(WriteInstaller(installerA, "a"), installerA);
+    cache.Add(WriteInstaller(installerB, "b"), installerB);
+
+    // Files that are not entries are left alone
+    std::filesystem::path otherFile = cacheDirectory.GetPath() / "other.txt";
+    WriteInstaller(otherFile, "other");
+
+    REQUIRE(cache.GetEntries().size() == 2);
+    REQUIRE(cache.Clear() == 2);
+    REQUIRE(cache.GetEntries().empty());
+    REQUIRE(std::filesystem::exists(otherFile));
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerErrors.h>
+#include <Rest/Schema/JsonReader.h>
+
+using namespace std::string_view_literals;
+using namespace AppInstaller::Repository::Rest::Schema;
+
+namespace
+{
+    void SkipDocument(std::string_view json)
+    {
+        JsonReader reader{ json };
+        reader.SkipValue();
+        reader.EndDocument();
+    }
+}
+
+TEST_CASE("JsonReader_ReadsMembers", "[RestSource]")
+{
+    JsonReader reader{ R"({ "String": "value", "Skipped": [ 1, -2.5e3, true, false, null, { "Nested": [] } ], "Strings": [ "a", 1, "b" ], "Empty": {} })" };
+    std::string name;
+
+    REQUIRE(reader.PeekType() == JsonReader::ValueType::Object);
+    reader.BeginObject();
+
+    REQUIRE(reader.NextMember(name));
+    REQUIRE(name == "String");
+    REQUIRE(reader.ReadString() == "value");
+
+    REQUIRE(reader.NextMember(name));
+    REQUIRE(name == "Skipped");
+    REQUIRE(reader.PeekType() == JsonReader::ValueType::Array);
+    reader.SkipValue();
+
+    REQUIRE(reader.NextMember(name));
+    REQUIRE(name == "Strings");
+    REQUIRE(reader.ReadStringArray() == std::vector<std::string>{ "a", "b" });
+
+    REQUIRE(reader.NextMember(name));
+    REQUIRE(name == "Empty");
+    REQUIRE(!reader.ReadOptionalString());
+
+    REQUIRE(!reader.NextMember(name));
+    reader.EndDocument();
+}
+
+TEST_CASE("JsonReader_ReadsIntegers", "[RestSource]")
+{
+    JsonReader reader{ R"([ 0, -2147024891, 3010, 1.5, 1e3, "1", null, 99999999999999999999 ])" };
+    reader.BeginArray();
+
+    std::optional<int64_t> expected[] = { 0, -2147024891, 3010, {}, {}, {}, {}, {} };
+    for (const auto& value : expected)
+    {
+        REQUIRE(reader.NextElement());
+        REQUIRE(reader.ReadOptionalInteger() == value);
+    }
+
+    REQUIRE(!reader.NextElement());
+    reader.EndDocument();
+}
+
+TEST_CASE("JsonReader_Escapes", "[RestSource]")
+{
+    // Text that is not escaped is passed through as is
+    JsonReader reader{ "\"quote\\\" slash\\/ backslash\\\\ tab\\t e\\u00e9 emoji\\ud83d\\ude00 raw\xC3\xA9\"" };
+    REQUIRE(reader.ReadString() == "quote\" slash/ backslash\\ tab\t e\xC3\xA9 emoji\xF0\x9F\x98\x80 raw\xC3\xA9");
+    reader.EndDocument();
+}
+
+TEST_CASE("JsonReader_Invalid", "[RestSource]")
+{
+    std::string_view invalidDocuments[] =
+    {
+        R"([1,])"sv,
+        R"([1 2])"sv,
+        R"({ "a" 1 })"sv,
+        R"({ , })"sv,
+        R"("unterminated)"sv,
+        R"("\ud800")"sv,
+        R"("\x")"sv,
+        R"(01)"sv,
+        R"(-)"sv,
+        R"(tru)"sv,
+        R"([)"sv,
+        R"({} {})"sv,
+        ""sv,
+    };
+
+    for (std::string_view invalid : invalidDocuments)
+    {
+        INFO(invalid);
+        REQUIRE_THROWS_HR(SkipDocument(invalid), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+    }
+}
+
+TEST_CASE("JsonReader_TooDeep", "[RestSource]")
+{
+    std::string json = std::string(1000, '[') + std::string(1000, ']');
+    REQUIRE_THROWS_HR(SkipDocument(json), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+}
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <winget/ManifestBinarySerializer.h>
+#include <winget/ManifestYamlParser.h>
+
+#include <chrono>
+
+using namespace TestCommon;
+using namespace AppInstaller::Manifest;
+using namespace AppInstaller::Utility;
+using namespace std::string_view_literals;
+
+namespace
+{
+    // Gets every manifest in the test data that can be read.
+    std::vector<Manifest> GetTestDataManifests()
+    {
+        std::vector<Manifest> result;
+
+        for (const auto& file : std::filesystem::directory_iterator{ TestDataFile(".").GetPath() })
+        {
+            if (file.path().extension() != ".yaml")
+            {
+                continue;
+            }
+
+            try
+            {
+                result.emplace_back(YamlParser::CreateFromPath(file.path()));
+            }
+            catch (const ManifestException&)
+            {
+                // Only the manifests that can be read can be serialized
+            }
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("ManifestBinarySerializer_RoundTripTestData", "[ManifestBinarySerializer]")
+{
+    std::vector<Manifest> manifests = GetTestDataManifests();
+    REQUIRE(!manifests.empty());
+
+    for (auto& manifest : manifests)
+    {
+        INFO(manifest.Id);
+        manifest.ApplyLocale("en-GB");
+
+        std::string data = BinarySerializer::Serialize(manifest);
+        Manifest result = BinarySerializer::Deserialize(data);
+
+        RequireEqual(result, manifest);
+        REQUIRE(BinarySerializer::Serialize(result) == data);
+    }
+}
+
+TEST_CASE("ManifestBinarySerializer_RoundTripManifestVersionExtensions", "[ManifestBinarySerializer]")
+{
+    Manifest manifest = YamlParser::CreateFromPath(TestDataFile("InstallFlowTest_MSStore.yaml"));
+    REQUIRE(manifest.ManifestVersion.HasExtension("msstore"));
+
+    Manifest result = BinarySerializer::Deserialize(BinarySerializer::Serialize(manifest));
+
+    REQUIRE(result.ManifestVersion.ToStringWithExtensions() == "0.2.0-msstore");
+    REQUIRE(result.ManifestVersion.HasExtension("msstore"));
+    RequireEqual(result, manifest);
+}
+
+TEST_CASE("ManifestBinarySerializer_FormatIsStable", "[ManifestBinarySerializer]")
+{
+    // If this fails, the encoding has changed. Increment s_FormatVersion so that manifests stored in the old format are
+    // parsed again from their source rather than read wrongly, then update the version and the expected data here.
+    REQUIRE(BinarySerializer::s_FormatVersion == 2);
+
+    Manifest manifest;
+    manifest.Id = "Id";
+    manifest.Version = "1.0";
+    manifest.ManifestVersion = ManifestVer{ "1.0.0-msstore" };
+
+    ManifestInstaller installer;
+    installer.Arch = Architecture::X64;
+    installer.Url = "u";
+    installer.InstallerType = InstallerTypeEnum::MSStore;
+    installer.Switches[InstallerSwitchType::Silent] = "/s";
+    manifest.Installers.emplace_back(std::move(installer));
+
+    manifest.DefaultLocalization.Locale = "en-US";
+    manifest.DefaultLocalization.Add<Localization::PackageName>("Name");
+    manifest.DefaultLocalization.Add<Localization::Tags>({ "a", "b" });
+
+    constexpr std::string_view expected =
+        "WGMB\x02"
+        "\x02Id\x03" "1.0\x00\x00\x0d" "1.0.0-msstore"
+        "\xff\xff\xff\xff\x0f\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x01\x02\x01u\x00\x00\x00\x00\x00\x00\x09\x00\x00\x01\x01\x02/s\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x05" "en-US\x02\x05\x04Name\x0d\x02\x01" "a\x01" "b\x00"
+        "\x00\x00\x00"sv;
+
+    REQUIRE(BinarySerializer::Serialize(manifest) == expected);
+    RequireEqual(BinarySerializer::Deserialize(expected), manifest);
+}
+
+TEST_CASE("ManifestBinarySerializer_ReaderRefersToData", "[ManifestBinarySerializer]")
+{
+    Manifest manifest;
+    manifest.Id = "AppInstallerCliTest.TestInstaller";
+    manifest.Version = "1.0.0.0";
+
+    std::string data = BinarySerializer::Serialize(manifest);
+
+    BinarySerializer::Reader reader{ data };
+    reader.ReadHeader();
+
+    std::string_view id = reader.ReadString();
+    REQUIRE(id == "AppInstallerCliTest.TestInstaller");
+    REQUIRE(id.data() >= data.data());
+    REQUIRE(id.data() + id.size() <= data.data() + data.size());
+    REQUIRE(reader.ReadString() == "1.0.0.0");
+}
+
+TEST_CASE("ManifestBinarySerializer_RejectsInvalidData", "[ManifestBinarySerializer]")
+{
+    Manifest manifest = YamlParser::CreateFromPath(TestDataFile("ManifestV1-Singleton.yaml"));
+    std::string data = BinarySerializer::Serialize(manifest);
+
+    // Every truncation of the data is rejected, rather than read past its end
+    for (size_t size = 0; size < data.size(); ++size)
+    {
+        REQUIRE_THROWS_HR(BinarySerializer::Deserialize(std::string_view{ data }.substr(0, size)), HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+    }
+
+    REQUIRE_THROWS_HR(BinarySerializer::Deserialize(data + "extra"), HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+
+    // Data from another version of the format
+    std::string otherVersion = data;
+    otherVersion[4] = static_cast<char>(BinarySerializer::s_FormatVersion + 1);
+    REQUIRE_THROWS_HR(BinarySerializer::Deserialize(otherVersion), HRESULT_FROM_WIN32(ERROR_INVALID_DATA));
+}
+
+// Measures the throughput of encoding and decoding the test data manifests.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("ManifestBinarySerializer_Benchmark", "[.][manifestBinaryBenchmark]")
+{
+    constexpr size_t iterations = 200;
+
+    std::vector<Manifest> manifests = GetTestDataManifests();
+    REQUIRE(!manifests.empty());
+
+    std::vector<std::string> encoded;
+    size_t encodedSize = 0;
+    for (const auto& manifest : manifests)
+    {
+        encoded.emplace_back(BinarySerializer::Serialize(manifest));
+        encodedSize += encoded.back().size();
+    }
+
+    auto time = [&](const std::function<void()>& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            f();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    };
+
+    auto encodeTime = time([&]()
+        {
+            for (const auto& manifest : manifests)
+            {
+                BinarySerializer::Serialize(manifest);
+            }
+        });
+
+    auto decodeTime = time([&]()
+        {
+            for (const auto& data : encoded)
+            {
+                BinarySerializer::Deserialize(data);
+            }
+        });
+
+    auto manifestsPerSecond = [&](std::chrono::microseconds duration) { return duration.count() ? (iterations * manifests.size() * 1000000.0) / duration.count() : 0.0; };
+
+    WARN(manifests.size() << " manifests, " << encodedSize << " bytes encoded; encode: " << manifestsPerSecond(encodeTime) <<
+        " manifests/s, decode: " << manifestsPerSecond(decodeTime) << " manifests/s");
+}
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <Microsoft/ManifestCache.h>
+
+#include <thread>
+
+using namespace TestCommon;
+using namespace AppInstaller::Utility;
+using namespace AppInstaller::Repository::Microsoft;
+
+namespace
+{
+    SHA256::HashBuffer GetHash(const std::string& contents)
+    {
+        return SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(contents.c_str()), static_cast<uint32_t>(contents.size()));
+    }
+}
+
+TEST_CASE("ManifestCache_AddAndFind", "[ManifestCache]")
+{
+    TempDirectory cacheDirectory{ "ManifestCache" };
+    ManifestCache cache{ cacheDirectory.GetPath(), 1 << 20 };
+
+    std::string manifest = "PackageIdentifier: AppInstallerCliTest.TestInstaller\nPackageVersion: 1.0.0.0\n";
+    SHA256::HashBuffer hash = GetHash(manifest);
+    REQUIRE(!cache.Find(hash));
+
+    cache.Add(hash, manifest);
+    REQUIRE(cache.Find(hash) == manifest);
+
+    // Another instance sees the same entries
+    ManifestCache otherCache{ cacheDirectory.GetPath(), 1 << 20 };
+    REQUIRE(otherCache.Find(hash) == manifest);
+
+    REQUIRE(!cache.Find(GetHash("other")));
+    REQUIRE(!cache.Find({}));
+
+    cache.Remove(hash);
+    REQUIRE(!cache.Find(hash));
+}
+
+TEST_CASE("ManifestCache_Disabled", "[ManifestCache]")
+{
+    TempDirectory cacheDirectory{ "ManifestCache" };
+    ManifestCache cache{ cacheDirectory.GetPath(), 0 };
+
+    std::string manifest = "PackageIdentifier: AppInstallerCliTest.TestInstaller\n";
+    SHA256::HashBuffer hash = GetHash(manifest);
+    cache.Add(hash, manifest);
+
+    REQUIRE(!cache.Find(hash));
+    REQUIRE(std::filesystem::is_empty(cacheDirectory.GetPath()));
+}
+
+TEST_CASE("ManifestCache_EvictsLeastRecentlyUsed", "[ManifestCache]")
+{
+    TempDirectory cacheDirectory{ "ManifestCache" };
+
+    // Room for two manifests, but not three
+    ManifestCache cache{ cacheDirectory.GetPath(), 2500 };
+
+    std::string manifestA(1000, 'a');
+    std::string manifestB(1000, 'b');
+    std::string manifestC(1000, 'c');
+
+    cache.Add(GetHash(manifestA), manifestA);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Add(GetHash(manifestB), manifestB);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // Using A makes B the least recently used
+    REQUIRE(cache.Find(GetHash(manifestA)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    cache.Add(GetHash(manifestC), manifestC);
+
+    REQUIRE(cache.Find(GetHash(manifestA)) == manifestA);
+    REQUIRE(!cache.Find(GetHash(manifestB)));
+    REQUIRE(cache.Find(GetHash(manifestC)) == manifestC);
+}
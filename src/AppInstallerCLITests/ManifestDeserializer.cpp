@@ -0,0 +1,270 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerErrors.h>
+#include <Rest/Schema/1_0/Json/ManifestDeserializer.h>
+
+using namespace TestCommon;
+using namespace AppInstaller::Manifest;
+using namespace AppInstaller::Repository::Rest::Schema::V1_0::Json;
+
+namespace
+{
+    // Members are deliberately out of their usual order, and include values of unexpected types that are ignored.
+    constexpr std::string_view s_ManifestResponse = R"delimiter({
+        "Unknown": { "Nested": [ 1, 2.5, null ] },
+        "Data": {
+            "Versions": [
+                {
+                    "Installers": [
+                        {
+                            "InstallerSha256": "011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6",
+                            "InstallerUrl": "https://installer.example.com/foobar.exe",
+                            "Architecture": "x64",
+                            "InstallerLocale": "en-US",
+                            "Platform": [ "Windows.Desktop", 1 ],
+                            "MinimumOSVersion": "10.0.0.0",
+                            "InstallerType": "exe",
+                            "Scope": "user",
+                            "SignatureSha256": "011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6",
+                            "InstallModes": [ "interactive", "silent" ],
+                            "InstallerSwitches": {
+                                "Silent": "/s",
+                                "Log": "/l",
+                                "Custom": null
+                            },
+                            "InstallerSuccessCodes": [ 0, 3010, -2147024891, 1.5, "1" ],
+                            "UpgradeBehavior": "install",
+                            "Commands": [ "foo" ],
+                            "Protocols": [ "foo" ],
+                            "FileExtensions": [ ".foo", ".bar" ],
+                            "Dependencies": {
+                                "WindowsFeatures": [ "feature" ],
+                                "WindowsLibraries": [ "library" ],
+                                "PackageDependencies": [
+                                    { "PackageIdentifier": "Foo.Dependency", "MinimumVersion": "1.0" },
+                                    { "PackageIdentifier": "Foo.OtherDependency" },
+                                    { "MinimumVersion": "2.0" },
+                                    "Foo.NotAnObject"
+                                ],
+                                "ExternalDependencies": [ "external" ]
+                            },
+                            "PackageFamilyName": "Foo.Bar_8wekyb3d8bbwe",
+                            "ProductCode": "{00000000-0000-0000-0000-000000000000}",
+                            "Capabilities": [ "internetClient" ],
+                            "RestrictedCapabilities": [ "runFullTrust" ]
+                        },
+                        {
+                            "InstallerUrl": "https://installer.example.com/missingsha256.exe",
+                            "Architecture": "x86",
+                            "InstallerType": "exe"
+                        },
+                        {
+                            "InstallerSha256": "011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6",
+                            "InstallerUrl": "https://installer.example.com/foobar.msix",
+                            "Architecture": "arm64",
+                            "InstallerType": "msix",
+                            "InstallerSwitches": null,
+                            "Dependencies": null
+                        }
+                    ],
+                    "PackageVersion": "2.0.0",
+                    "Channel": "beta",
+                    "Locales": [
+                        {
+                            "PackageLocale": "fr-FR",
+                            "Publisher": "Foo \u00e9",
+                            "PackageName": "Bar",
+                            "ShortDescription": "Foo bar in French.",
+                            "Tags": [ "FooFr", 1, "BarFr" ]
+                        },
+                        {
+                            "PackageLocale": "de-DE",
+                            "PackageName": "Missing publisher"
+                        },
+                        null
+                    ],
+                    "DefaultLocale": {
+                        "Moniker": "foobar",
+                        "PackageLocale": "en-US",
+                        "Publisher": "Foo",
+                        "PublisherUrl": "https://publisher.example.com",
+                        "PublisherSupportUrl": "https://support.example.com",
+                        "PrivacyUrl": "https://privacy.example.com",
+                        "Author": "Foo Author",
+                        "PackageName": "Bar",
+                        "PackageUrl": "https://package.example.com",
+                        "License": "MIT",
+                        "LicenseUrl": "https://license.example.com",
+                        "Copyright": "Copyright Foo",
+                        "CopyrightUrl": "https://copyright.example.com",
+                        "ShortDescription": "Foo bar.",
+                        "Description": "Foo bar \"quoted\".",
+                        "Tags": [ "Foo", "Bar" ]
+                    }
+                },
+                {
+                    "PackageVersion": "1.0.0",
+                    "DefaultLocale": {
+                        "PackageLocale": "en-US",
+                        "Publisher": "Foo",
+                        "PackageName": "Bar",
+                        "ShortDescription": "Foo bar."
+                    },
+                    "Installers": [
+                        {
+                            "InstallerSha256": "011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6",
+                            "InstallerUrl": "https://installer.example.com/foobar-1.0.exe",
+                            "Architecture": "x64",
+                            "InstallerType": "exe"
+                        }
+                    ]
+                }
+            ],
+            "PackageIdentifier": "Foo.Bar"
+        }
+    })delimiter";
+
+    std::vector<Manifest> DeserializeFromText(std::string_view json)
+    {
+        ManifestDeserializer deserializer;
+        return deserializer.Deserialize(json);
+    }
+}
+
+TEST_CASE("ManifestDeserializer_Text", "[RestSource]")
+{
+    std::vector<Manifest> fromText = DeserializeFromText(s_ManifestResponse);
+    REQUIRE(fromText.size() == 2);
+
+    const Manifest& manifest = fromText[0];
+    REQUIRE(manifest.Id == "Foo.Bar");
+    REQUIRE(manifest.Version == "2.0.0");
+    REQUIRE(manifest.Channel == "beta");
+    REQUIRE(manifest.Moniker == "foobar");
+
+    REQUIRE(manifest.DefaultLocalization.Locale == "en-US");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::Publisher>() == "Foo");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::PublisherUrl>() == "https://publisher.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::PublisherSupportUrl>() == "https://support.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::PrivacyUrl>() == "https://privacy.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::Author>() == "Foo Author");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::PackageName>() == "Bar");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::PackageUrl>() == "https://package.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::License>() == "MIT");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::LicenseUrl>() == "https://license.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::Copyright>() == "Copyright Foo");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::CopyrightUrl>() == "https://copyright.example.com");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::ShortDescription>() == "Foo bar.");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::Description>() == "Foo bar \"quoted\".");
+    REQUIRE(manifest.DefaultLocalization.Get<Localization::Tags>() == std::vector<Manifest::string_t>{ "Foo", "Bar" });
+
+    // Locales without a publisher are left out
+    REQUIRE(manifest.Localizations.size() == 1);
+    REQUIRE(manifest.Localizations[0].Locale == "fr-FR");
+    REQUIRE(manifest.Localizations[0].Get<Localization::Publisher>() == "Foo \xC3\xA9");
+    REQUIRE(manifest.Localizations[0].Get<Localization::ShortDescription>() == "Foo bar in French.");
+    REQUIRE(manifest.Localizations[0].Get<Localization::Tags>() == std::vector<Manifest::string_t>{ "FooFr", "BarFr" });
+
+    // Installers without a SHA256 are left out
+    REQUIRE(manifest.Installers.size() == 2);
+
+    const ManifestInstaller& installer = manifest.Installers[0];
+    REQUIRE(installer.Sha256 == AppInstaller::Utility::SHA256::ConvertToBytes("011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6"));
+    REQUIRE(installer.SignatureSha256 == installer.Sha256);
+    REQUIRE(installer.Url == "https://installer.example.com/foobar.exe");
+    REQUIRE(installer.Arch == AppInstaller::Utility::Architecture::X64);
+    REQUIRE(installer.Locale == "en-US");
+    REQUIRE(installer.Platform == std::vector<PlatformEnum>{ PlatformEnum::Desktop });
+    REQUIRE(installer.MinOSVersion == "10.0.0.0");
+    REQUIRE(installer.InstallerType == InstallerTypeEnum::Exe);
+    REQUIRE(installer.Scope == ScopeEnum::User);
+    REQUIRE(installer.InstallModes == std::vector<InstallModeEnum>{ InstallModeEnum::Interactive, InstallModeEnum::Silent });
+    REQUIRE(installer.Switches.at(InstallerSwitchType::Silent) == "/s");
+    REQUIRE(installer.Switches.at(InstallerSwitchType::Log) == "/l");
+    REQUIRE(installer.Switches.at(InstallerSwitchType::Custom).empty());
+    REQUIRE(installer.InstallerSuccessCodes == std::vector<DWORD>{ 0, 3010, static_cast<DWORD>(-2147024891) });
+    REQUIRE(installer.UpdateBehavior == UpdateBehaviorEnum::Install);
+    REQUIRE(installer.Commands == std::vector<Manifest::string_t>{ "foo" });
+    REQUIRE(installer.Protocols == std::vector<Manifest::string_t>{ "foo" });
+    REQUIRE(installer.FileExtensions == std::vector<Manifest::string_t>{ ".foo", ".bar" });
+    REQUIRE(installer.PackageFamilyName == "Foo.Bar_8wekyb3d8bbwe");
+    REQUIRE(installer.ProductCode == "{00000000-0000-0000-0000-000000000000}");
+    REQUIRE(installer.Capabilities == std::vector<Manifest::string_t>{ "internetClient" });
+    REQUIRE(installer.RestrictedCapabilities == std::vector<Manifest::string_t>{ "runFullTrust" });
+
+    REQUIRE(installer.Dependencies.WindowsFeatures == std::vector<Manifest::string_t>{ "feature" });
+    REQUIRE(installer.Dependencies.WindowsLibraries == std::vector<Manifest::string_t>{ "library" });
+    REQUIRE(installer.Dependencies.ExternalDependencies == std::vector<Manifest::string_t>{ "external" });
+    REQUIRE(installer.Dependencies.PackageDependencies.size() == 2);
+    REQUIRE(installer.Dependencies.PackageDependencies[0].Id == "Foo.Dependency");
+    REQUIRE(installer.Dependencies.PackageDependencies[0].MinVersion == "1.0");
+    REQUIRE(installer.Dependencies.PackageDependencies[1].Id == "Foo.OtherDependency");
+
+    // Every switch is present when the switches are, even if they are null
+    REQUIRE(manifest.Installers[1].Arch == AppInstaller::Utility::Architecture::Arm64);
+    REQUIRE(manifest.Installers[1].InstallerType == InstallerTypeEnum::Msix);
+    REQUIRE(manifest.Installers[1].Switches.size() == 7);
+
+    const Manifest& other = fromText[1];
+    REQUIRE(other.Id == "Foo.Bar");
+    REQUIRE(other.Version == "1.0.0");
+    REQUIRE(other.Channel.empty());
+    REQUIRE(other.Installers.size() == 1);
+    REQUIRE(other.Installers[0].Url == "https://installer.example.com/foobar-1.0.exe");
+}
+
+TEST_CASE("ManifestDeserializer_TextNoData", "[RestSource]")
+{
+    std::string documents[] = { R"({})", R"({ "Data" : null })", R"([])" };
+
+    for (const std::string& json : documents)
+    {
+        INFO(json);
+        REQUIRE(DeserializeFromText(json).empty());
+    }
+}
+
+TEST_CASE("ManifestDeserializer_TextInvalid", "[RestSource]")
+{
+    constexpr std::string_view installers = R"("Installers": [ { "InstallerSha256": "011048877dfaef109801b3f3ab2b60afc74f3fc4f7b3430e0c897f5da1df84b6", "InstallerUrl": "https://installer.example.com/foobar.exe", "Architecture": "x64", "InstallerType": "exe" } ])";
+    constexpr std::string_view defaultLocale = R"("DefaultLocale": { "PackageLocale": "en-US", "Publisher": "Foo", "PackageName": "Bar", "ShortDescription": "Foo bar." })";
+
+    auto version = [&](std::string_view members) { return R"({ "Data" : { "PackageIdentifier": "Foo.Bar", "Versions": [ { )" + std::string{ members } + " } ] } }"; };
+
+    std::string documents[] =
+    {
+        // Missing identifier
+        R"({ "Data" : { "Versions": [] } })",
+        // No versions
+        R"({ "Data" : { "PackageIdentifier": "Foo.Bar" } })",
+        R"({ "Data" : { "PackageIdentifier": "Foo.Bar", "Versions": [] } })",
+        // Version without a version
+        version(std::string{ defaultLocale } + ", " + std::string{ installers }),
+        // Missing default locale
+        version(R"("PackageVersion": "1.0", )" + std::string{ installers }),
+        version(R"("PackageVersion": "1.0", "DefaultLocale": null, )" + std::string{ installers }),
+        // No valid installers
+        version(R"("PackageVersion": "1.0", )" + std::string{ defaultLocale }),
+        version(R"("PackageVersion": "1.0", )" + std::string{ defaultLocale } + R"(, "Installers": [ { "InstallerUrl": "https://installer.example.com/foobar.exe" } ])"),
+        // Not an object
+        R"({ "Data" : [ "Foo.Bar" ] })",
+        // Missing json object
+        R"(null)",
+    };
+
+    for (const std::string& json : documents)
+    {
+        INFO(json);
+        REQUIRE_THROWS_HR(DeserializeFromText(json), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+    }
+}
+
+TEST_CASE("ManifestDeserializer_TextMalformed", "[RestSource]")
+{
+    std::string json{ s_ManifestResponse };
+    json.pop_back();
+
+    REQUIRE_THROWS_HR(DeserializeFromText(json), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+}
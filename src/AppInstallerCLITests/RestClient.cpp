@@ -5,6 +5,7 @@
 #include "TestRestRequestHandler.h"
 #include <Rest/RestClient.h>
 #include <Rest/Schema/IRestClient.h>
+#include <Rest/Schema/CommonRestConstants.h>
 #include <AppInstallerVersions.h>
 #include <set>
 #include <AppInstallerErrors.h>
@@ -16,6 +17,34 @@ using namespace AppInstaller::Repository::Rest::Schema;
 
 const utility::string_t TestRestUri = L"http://restsource.net";
 
+namespace
+{
+    // An interface that counts the manifests requested from it.
+    struct CountingRestClient : public IRestClient
+    {
+        CountingRestClient(std::atomic<size_t>& requestCount) : m_requestCount(requestCount) {}
+
+        Version GetVersion() const override { return Version_1_0_0; }
+
+        SearchResult Search(const AppInstaller::Repository::SearchRequest&) const override { return {}; }
+
+        std::optional<AppInstaller::Manifest::Manifest> GetManifestByVersion(const std::string& packageId, const std::string& version, const std::string&) const override
+        {
+            ++m_requestCount;
+
+            AppInstaller::Manifest::Manifest manifest;
+            manifest.Id = packageId;
+            manifest.Version = version;
+            return manifest;
+        }
+
+        std::vector<AppInstaller::Manifest::Manifest> GetManifests(const std::string&, const std::map<std::string_view, std::string>&) const override { return {}; }
+
+    private:
+        std::atomic<size_t>& m_requestCount;
+    };
+}
+
 TEST_CASE("GetLatestCommonVersion", "[RestSource]")
 {
     std::set<AppInstaller::Utility::Version> wingetSupportedContracts = { Version {"1.0.0"}, Version {"1.2.0"} };
@@ -94,3 +123,52 @@ TEST_CASE("RestClientCreate_Success", "[RestSource]")
     RestClient client = RestClient::Create(utility::conversions::to_utf8string(TestRestUri), std::move(helper));
     REQUIRE(client.GetSourceIdentifier() == "Source123");
 }
+
+TEST_CASE("RestClient_PrefetchManifests", "[RestSource]")
+{
+    std::atomic<size_t> requestCount = 0;
+    RestClient client{ std::make_unique<CountingRestClient>(requestCount), "Source123" };
+
+    std::vector<RestClient::ManifestKey> manifests;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        manifests.emplace_back(RestClient::ManifestKey{ "Package." + std::to_string(i), "1.0.0", "" });
+    }
+
+    // Duplicates are only requested once
+    manifests.emplace_back(manifests.front());
+
+    TestCommon::TestProgress progress;
+    client.PrefetchManifests(manifests, progress);
+    REQUIRE(requestCount == 10);
+
+    // Prefetched manifests are not requested again
+    client.PrefetchManifests(manifests, progress);
+    auto manifest = client.GetManifestByVersion("Package.3", "1.0.0", "");
+    REQUIRE(manifest);
+    REQUIRE(manifest->Id == "Package.3");
+    REQUIRE(requestCount == 10);
+
+    // Others still are
+    manifest = client.GetManifestByVersion("Package.3", "2.0.0", "");
+    REQUIRE(manifest);
+    REQUIRE(manifest->Version == "2.0.0");
+    REQUIRE(requestCount == 11);
+}
+
+TEST_CASE("RestClient_PrefetchManifests_Cancelled", "[RestSource]")
+{
+    std::atomic<size_t> requestCount = 0;
+    RestClient client{ std::make_unique<CountingRestClient>(requestCount), "Source123" };
+
+    ProgressCallback progress;
+    progress.Cancel();
+    client.PrefetchManifests({ { "Package.1", "1.0.0", "" }, { "Package.2", "1.0.0", "" } }, progress);
+    REQUIRE(requestCount == 0);
+
+    // Manifests that were not prefetched are requested when needed
+    auto manifest = client.GetManifestByVersion("Package.1", "1.0.0", "");
+    REQUIRE(manifest);
+    REQUIRE(manifest->Id == "Package.1");
+    REQUIRE(requestCount == 1);
+}
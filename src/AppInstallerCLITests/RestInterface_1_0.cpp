@@ -377,6 +377,111 @@ TEST_CASE("Search_ContinuationToken", "[RestSource]")
     REQUIRE(resultsWithSize1.Matches.size() == requestWithSize1.MaximumResults);
 }
 
+TEST_CASE("Search_ContinuationToken_RequestCount", "[RestSource]")
+{
+    // Every page has two packages; the first five pages have a continuation token
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> unexpectedTokenCount = 0;
+    HttpClientHelper helper{ std::make_shared<TestRestRequestHandler>([&](web::http::http_request request)
+        {
+            size_t page = requestCount++;
+            if ((page == 0) == request.headers().has(L"ContinuationToken"))
+            {
+                ++unexpectedTokenCount;
+            }
+
+            std::wostringstream body;
+            body << LR"({ "Data" : [)";
+            for (size_t i = 0; i < 2; ++i)
+            {
+                body << (i ? L"," : L"") << LR"({ "PackageIdentifier": "package.)" << page << L'.' << i <<
+                    LR"(", "PackageName": "package", "Publisher": "publisher", "Versions": [ { "PackageVersion": "1.0.0" } ] })";
+            }
+            body << L"]";
+            if (page < 5)
+            {
+                body << LR"(, "ContinuationToken" : "ct)" << page << L'"';
+            }
+            body << L"}";
+
+            web::http::http_response response;
+            response.set_body(web::json::value::parse(body.str()));
+            response.headers().set_content_type(web::http::details::mime_types::application_json);
+            response.set_status_code(web::http::status_codes::OK);
+            return pplx::task_from_result(response);
+        }) };
+    Interface v1{ TestRestUriString, helper };
+
+    SECTION("All pages")
+    {
+        REQUIRE(v1.Search({}).Matches.size() == 12);
+        REQUIRE(requestCount == 6);
+    }
+    SECTION("Maximum on a page boundary")
+    {
+        SearchRequest request{};
+        request.MaximumResults = 6;
+        REQUIRE(v1.Search(request).Matches.size() == 6);
+        REQUIRE(requestCount == 3);
+    }
+    SECTION("Maximum within a page")
+    {
+        SearchRequest request{};
+        request.MaximumResults = 5;
+        REQUIRE(v1.Search(request).Matches.size() == 5);
+        REQUIRE(requestCount == 3);
+    }
+
+    REQUIRE(unexpectedTokenCount == 0);
+}
+
+TEST_CASE("Search_ContinuationToken_ReusesClient", "[RestSource]")
+{
+    utility::string_t sample = _XPLATSTR(
+        R"delimiter({
+            "Data" : [
+               {
+              "PackageIdentifier": "git.package",
+              "PackageName": "package",
+              "Publisher": "git",
+              "Versions": [
+                {   "PackageVersion": "1.0.0" }]
+            }],
+           "ContinuationToken" : "abcd-ct="
+        })delimiter");
+
+    // Searches get a page of results, manifest requests find nothing
+    HttpClientHelper helper{ std::make_shared<TestRestRequestHandler>([&sample](web::http::http_request request)
+        {
+            web::http::http_response response;
+            if (request.method() == web::http::methods::POST)
+            {
+                response.set_body(web::json::value::parse(sample));
+                response.headers().set_content_type(web::http::details::mime_types::application_json);
+                response.set_status_code(web::http::status_codes::OK);
+            }
+            else
+            {
+                response.set_status_code(web::http::status_codes::NotFound);
+            }
+
+            return pplx::task_from_result(response);
+        }) };
+    Interface v1{ TestRestUriString, helper };
+
+    // Ten pages of results, followed by a batch of manifest requests, should all go through a single client
+    SearchRequest request{};
+    request.MaximumResults = 10;
+    REQUIRE(v1.Search(request).Matches.size() == request.MaximumResults);
+
+    for (size_t i = 0; i < 50; ++i)
+    {
+        v1.GetManifestByVersion("git.package", "1.0.0", "");
+    }
+
+    REQUIRE(helper.GetClientCreationCount() == 1);
+}
+
 TEST_CASE("Search_BadResponse_NoVersions", "[RestSource]")
 {
     utility::string_t sample = _XPLATSTR(
@@ -489,3 +594,193 @@ TEST_CASE("GetManifests_NotFoundCode", "[RestSource]")
     std::vector<Manifest> manifests = v1.GetManifests("Foo.Bar");
     REQUIRE(manifests.empty());
 }
+
+namespace
+{
+    // How a test server treats the inclusions of a search.
+    enum class InclusionBehavior
+    {
+        Union,
+        FirstOnly,
+        Ignored,
+    };
+
+    // A server with ten packages, "package.N" with the product code "pcN", that counts its search requests.
+    std::shared_ptr<TestRestRequestHandler> GetCorrelationRequestHandler(InclusionBehavior behavior, std::atomic<size_t>& requestCount, std::atomic<size_t>& maximumInclusions)
+    {
+        return std::make_shared<TestRestRequestHandler>([behavior, &requestCount, &maximumInclusions](web::http::http_request request)
+            {
+                ++requestCount;
+
+                std::set<std::wstring> productCodes;
+                web::json::value body = request.extract_json().get();
+                if (body.has_array_field(L"Inclusions"))
+                {
+                    const auto& inclusions = body.at(L"Inclusions").as_array();
+                    maximumInclusions = std::max<size_t>(maximumInclusions, inclusions.size());
+
+                    for (const auto& inclusion : inclusions)
+                    {
+                        if (inclusion.at(L"PackageMatchField").as_string() == L"ProductCode")
+                        {
+                            productCodes.emplace(inclusion.at(L"RequestMatch").at(L"KeyWord").as_string());
+                        }
+
+                        if (behavior == InclusionBehavior::FirstOnly)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                std::wostringstream responseBody;
+                responseBody << LR"({ "Data" : [)";
+                bool first = true;
+                for (size_t i = 0; i < 10; ++i)
+                {
+                    std::wstring productCode = L"pc" + std::to_wstring(i);
+                    if (behavior == InclusionBehavior::Ignored || productCodes.count(productCode))
+                    {
+                        responseBody << (first ? L"" : L",") << LR"({ "PackageIdentifier": "package.)" << i <<
+                            LR"(", "PackageName": "package", "Publisher": "publisher", "Versions": [ { "PackageVersion": "1.0.0", "ProductCodes": [ ")" <<
+                            productCode << LR"(" ] } ] })";
+                        first = false;
+                    }
+                }
+                responseBody << L"] }";
+
+                web::http::http_response response;
+                response.set_body(web::json::value::parse(responseBody.str()));
+                response.headers().set_content_type(web::http::details::mime_types::application_json);
+                response.set_status_code(web::http::status_codes::OK);
+                return pplx::task_from_result(response);
+            });
+    }
+
+    SearchRequest GetCorrelationRequest(std::string_view productCode)
+    {
+        SearchRequest result;
+        result.Inclusions.emplace_back(PackageMatchField::ProductCode, MatchType::Exact, productCode);
+        return result;
+    }
+}
+
+TEST_CASE("SearchMultiple_CombinesCorrelations", "[RestSource]")
+{
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> maximumInclusions = 0;
+    Interface v1{ TestRestUriString, GetCorrelationRequestHandler(InclusionBehavior::Union, requestCount, maximumInclusions) };
+
+    std::vector<SearchRequest> requests;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        requests.emplace_back(GetCorrelationRequest("pc" + std::to_string(i)));
+    }
+    requests.emplace_back(GetCorrelationRequest("missing"));
+
+    auto results = v1.SearchMultiple(requests);
+    REQUIRE(requestCount == 1);
+    REQUIRE(results.size() == requests.size());
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        REQUIRE(results[i].Matches.size() == 1);
+        REQUIRE(results[i].Matches[0].PackageInformation.PackageIdentifier == "package." + std::to_string(i));
+    }
+    REQUIRE(results[5].Matches.empty());
+
+    // A request that also looks for a name is searched as a whole when its product code finds nothing
+    SearchRequest withName = GetCorrelationRequest("missing");
+    withName.Inclusions.emplace_back(PackageMatchField::NormalizedNameAndPublisher, MatchType::Exact, "name", "publisher");
+    requests.emplace_back(std::move(withName));
+
+    // Other searches are made as they are
+    SearchRequest query;
+    query.Query = RequestMatch{ MatchType::Substring, "package" };
+    requests.emplace_back(std::move(query));
+
+    requestCount = 0;
+    results = v1.SearchMultiple(requests);
+    REQUIRE(requestCount == 3);
+    REQUIRE(results[0].Matches.size() == 1);
+    REQUIRE(results[6].Matches.empty());
+}
+
+TEST_CASE("SearchMultiple_Chunked", "[RestSource]")
+{
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> maximumInclusions = 0;
+    Interface v1{ TestRestUriString, GetCorrelationRequestHandler(InclusionBehavior::Union, requestCount, maximumInclusions) };
+
+    std::vector<SearchRequest> requests;
+    for (size_t i = 0; i < 120; ++i)
+    {
+        requests.emplace_back(GetCorrelationRequest("pc" + std::to_string(i)));
+    }
+
+    auto results = v1.SearchMultiple(requests);
+    REQUIRE(requestCount == 3);
+    REQUIRE(maximumInclusions == 50);
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        REQUIRE(results[i].Matches.size() == (i < 10 ? 1 : 0));
+    }
+}
+
+TEST_CASE("SearchMultiple_InconclusiveCheckIsSettled", "[RestSource]")
+{
+    std::atomic<size_t> requestCount = 0;
+    std::atomic<size_t> maximumInclusions = 0;
+    Interface v1{ TestRestUriString, GetCorrelationRequestHandler(InclusionBehavior::Union, requestCount, maximumInclusions) };
+
+    // A single match cannot show that the server takes the union of the inclusions
+    std::vector<SearchRequest> requests;
+    requests.emplace_back(GetCorrelationRequest("pc0"));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        requests.emplace_back(GetCorrelationRequest("missing" + std::to_string(i)));
+    }
+
+    auto results = v1.SearchMultiple(requests);
+    REQUIRE(requestCount == 1 + requests.size());
+    REQUIRE(results[0].Matches.size() == 1);
+
+    // The check is not repeated
+    requestCount = 0;
+    results = v1.SearchMultiple(requests);
+    REQUIRE(requestCount == requests.size());
+    REQUIRE(results[0].Matches.size() == 1);
+}
+
+TEST_CASE("SearchMultiple_FallsBackWhenInclusionsNotCombined", "[RestSource]")
+{
+    InclusionBehavior behaviors[] = { InclusionBehavior::FirstOnly, InclusionBehavior::Ignored };
+
+    for (InclusionBehavior behavior : behaviors)
+    {
+        INFO(static_cast<int>(behavior));
+
+        std::atomic<size_t> requestCount = 0;
+        std::atomic<size_t> maximumInclusions = 0;
+        Interface v1{ TestRestUriString, GetCorrelationRequestHandler(behavior, requestCount, maximumInclusions) };
+
+        std::vector<SearchRequest> requests;
+        for (size_t i = 0; i < 5; ++i)
+        {
+            requests.emplace_back(GetCorrelationRequest("pc" + std::to_string(i)));
+        }
+
+        auto results = v1.SearchMultiple(requests);
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            auto individualResult = v1.Search(requests[i]);
+            REQUIRE(results[i].Matches.size() == individualResult.Matches.size());
+        }
+
+        // Once found not to work, searches are no longer combined
+        requestCount = 0;
+        results = v1.SearchMultiple(requests);
+        REQUIRE(requestCount == requests.size());
+    }
+}
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerSHA256.h>
+#include <ResumableDownloader.h>
+#include <cpprest/http_listener.h>
+#include <cpprest/producerconsumerstream.h>
+
+using namespace AppInstaller;
+using namespace AppInstaller::Utility;
+using namespace std::string_literals;
+
+namespace
+{
+    constexpr std::wstring_view s_LocalServerUri = L"http://localhost:51873/";
+    constexpr std::string_view s_InstallerUrl = "http://localhost:51873/installer.exe";
+
+    std::vector<unsigned char> GetInstallerContents()
+    {
+        std::vector<unsigned char> result((1 << 20) + 321);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = static_cast<unsigned char>((i * 17) ^ (i >> 9));
+        }
+        return result;
+    }
+
+    // A local server for a single file, that can drop the connection partway through the first response
+    // and answers a Range request for the rest of the file only if its If-Range matches the current ETag.
+    struct DroppingServer
+    {
+        DroppingServer() : m_contents(GetInstallerContents()), m_listener(utility::string_t{ s_LocalServerUri })
+        {
+            m_listener.support([this](web::http::http_request request)
+                {
+                    utility::string_t etag;
+                    {
+                        std::lock_guard<std::mutex> lock{ m_mutex };
+                        etag = ETag;
+                    }
+
+                    web::http::http_response response{ web::http::status_codes::OK };
+                    response.headers().add(web::http::header_names::etag, etag);
+
+                    utility::string_t range;
+                    utility::string_t ifRange;
+                    if (request.headers().match(web::http::header_names::range, range) &&
+                        request.headers().match(web::http::header_names::if_range, ifRange) && ifRange == etag)
+                    {
+                        // Only the "bytes=first-" form is used by the downloader
+                        uint64_t first = std::stoull(range.substr(6));
+                        ResumedFrom = first;
+
+                        response.set_status_code(web::http::status_codes::PartialContent);
+                        response.set_body(std::vector<unsigned char>{ m_contents.begin() + first, m_contents.end() });
+                        response.headers().add(web::http::header_names::content_range,
+                            L"bytes " + std::to_wstring(first) + L'-' + std::to_wstring(m_contents.size() - 1) + L'/' + std::to_wstring(m_contents.size()));
+                        response.headers().set_content_type(L"application/octet-stream");
+                        request.reply(response);
+                        return;
+                    }
+
+                    ++FullRequests;
+
+                    if (DropNext.exchange(false))
+                    {
+                        // Send half of the file, then fail the body so that the connection is closed early
+                        concurrency::streams::producer_consumer_buffer<uint8_t> buffer;
+                        buffer.putn_nocopy(m_contents.data(), m_contents.size() / 2).wait();
+
+                        response.set_body(buffer.create_istream(), m_contents.size(), L"application/octet-stream");
+                        request.reply(response);
+
+                        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                        buffer.close(std::ios_base::out, std::make_exception_ptr(std::runtime_error("dropped"))).wait();
+                        return;
+                    }
+
+                    response.set_body(m_contents);
+                    response.headers().set_content_type(L"application/octet-stream");
+                    request.reply(response);
+                });
+
+            m_listener.open().wait();
+        }
+
+        ~DroppingServer()
+        {
+            m_listener.close().wait();
+        }
+
+        void SetETag(utility::string_t etag)
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            ETag = std::move(etag);
+        }
+
+        SHA256::HashBuffer GetHash() const
+        {
+            return SHA256::ComputeHash(m_contents.data(), static_cast<uint32_t>(m_contents.size()));
+        }
+
+        bool Matches(const std::filesystem::path& file) const
+        {
+            std::ifstream stream{ file, std::ios_base::in | std::ios_base::binary };
+            std::vector<unsigned char> contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+            return contents == m_contents;
+        }
+
+        std::atomic<bool> DropNext = false;
+        std::atomic<size_t> FullRequests = 0;
+        std::atomic<uint64_t> ResumedFrom = 0;
+
+    private:
+        std::mutex m_mutex;
+        utility::string_t ETag = L"\"v1\"";
+        std::vector<unsigned char> m_contents;
+        web::http::experimental::listener::http_listener m_listener;
+    };
+
+    struct SidecarRemover
+    {
+        SidecarRemover(std::filesystem::path path) : m_path(std::move(path)) {}
+
+        ~SidecarRemover()
+        {
+            std::error_code error;
+            std::filesystem::remove(m_path, error);
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+}
+
+TEST_CASE("ResumableDownload_ResumesAfterDrop", "[Downloader]")
+{
+    DroppingServer server;
+    TestCommon::TempFile tempFile("resumable_test"s, ".test"s);
+    std::filesystem::path sidecar = GetResumeSidecarPath(tempFile.GetPath());
+    SidecarRemover remover{ sidecar };
+
+    server.DropNext = true;
+    ProgressCallback callback;
+    REQUIRE_THROWS(ResumableDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true));
+    REQUIRE(std::filesystem::exists(sidecar));
+
+    auto result = ResumableDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true);
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+    REQUIRE(server.FullRequests == 1);
+    REQUIRE(server.ResumedFrom > 0);
+    REQUIRE_FALSE(std::filesystem::exists(sidecar));
+}
+
+TEST_CASE("ResumableDownload_ChangedFileRestarts", "[Downloader]")
+{
+    DroppingServer server;
+    TestCommon::TempFile tempFile("resumable_test"s, ".test"s);
+    std::filesystem::path sidecar = GetResumeSidecarPath(tempFile.GetPath());
+    SidecarRemover remover{ sidecar };
+
+    server.DropNext = true;
+    ProgressCallback callback;
+    REQUIRE_THROWS(ResumableDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true));
+
+    // The If-Range no longer matches, so the server sends the entire file
+    server.SetETag(L"\"v2\"");
+    auto result = ResumableDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true);
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+    REQUIRE(server.FullRequests == 2);
+    REQUIRE(server.ResumedFrom == 0);
+}
+
+TEST_CASE("ResumableDownload_SidecarForOtherUrlIgnored", "[Downloader]")
+{
+    DroppingServer server;
+    TestCommon::TempFile tempFile("resumable_test"s, ".test"s);
+    std::filesystem::path sidecar = GetResumeSidecarPath(tempFile.GetPath());
+    SidecarRemover remover{ sidecar };
+
+    {
+        std::ofstream stream{ tempFile.GetPath(), std::ios_base::out | std::ios_base::binary };
+        stream << std::string(4096, 'x');
+    }
+
+    {
+        std::ofstream stream{ sidecar, std::ios_base::out | std::ios_base::binary };
+        stream << R"({"Url":"http://localhost:51873/other.exe","Validator":"\"v1\"","Length":4096})";
+    }
+
+    ProgressCallback callback;
+    auto result = ResumableDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true);
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+    REQUIRE(server.ResumedFrom == 0);
+}
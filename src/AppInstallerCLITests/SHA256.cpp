@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include "TestHooks.h"
+#include <AppInstallerSHA256.h>
+
+#include <chrono>
+
+using namespace AppInstaller::Utility;
+
+namespace
+{
+    // Forces the processor instructions or the platform implementation for the lifetime of the object.
+    struct ForceImplementation
+    {
+        ForceImplementation(bool processorInstructions) { TestHook_ForceSHA256Implementation(processorInstructions); }
+        ~ForceImplementation() { TestHook_ForceSHA256Implementation(std::nullopt); }
+    };
+
+    std::vector<uint8_t> GetData(size_t size)
+    {
+        std::vector<uint8_t> result(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            result[i] = static_cast<uint8_t>((i * 131) ^ (i >> 7));
+        }
+        return result;
+    }
+
+    // Adds the data in chunks of varying size, so that blocks are split across calls.
+    SHA256::HashBuffer ComputeHashInChunks(const std::vector<uint8_t>& data)
+    {
+        SHA256 hasher;
+        size_t offset = 0;
+        for (size_t chunk = 1; offset < data.size(); chunk = chunk * 3 + 1)
+        {
+            size_t size = std::min(chunk % 200, data.size() - offset);
+            hasher.Add(data.data() + offset, size);
+            offset += size;
+        }
+        return hasher.Get();
+    }
+}
+
+TEST_CASE("SHA256_KnownValues", "[sha256]")
+{
+    std::pair<std::string, std::string> values[] =
+    {
+        { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+        { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+        { std::string(1000000, 'a'), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+    };
+
+    std::vector<bool> implementations{ false };
+    if (TestHook_HasSHA256ProcessorInstructions())
+    {
+        implementations.push_back(true);
+    }
+
+    for (bool processorInstructions : implementations)
+    {
+        ForceImplementation force{ processorInstructions };
+
+        for (const auto& [input, expected] : values)
+        {
+            INFO(processorInstructions << ", " << input.size());
+            auto hash = SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(input.data()), static_cast<uint32_t>(input.size()));
+            REQUIRE(SHA256::ConvertToString(hash) == expected);
+        }
+    }
+}
+
+TEST_CASE("SHA256_MatchesPlatform", "[sha256]")
+{
+    // This version of Catch has no way to mark a test as skipped
+    if (!TestHook_HasSHA256ProcessorInstructions())
+    {
+        WARN("Skipped; the processor has no SHA instructions");
+        return;
+    }
+
+    for (size_t size = 0; size < 1000; size += (size < 200 ? 1 : 37))
+    {
+        INFO(size);
+        std::vector<uint8_t> data = GetData(size);
+
+        SHA256::HashBuffer expected;
+        {
+            ForceImplementation force{ false };
+            expected = SHA256::ComputeHash(data.data(), static_cast<uint32_t>(data.size()));
+        }
+
+        ForceImplementation force{ true };
+        REQUIRE(SHA256::ComputeHash(data.data(), static_cast<uint32_t>(data.size())) == expected);
+        REQUIRE(ComputeHashInChunks(data) == expected);
+    }
+}
+
+// Compares the throughput of the processor specific and platform implementations for inputs from 1 KB to 1 GB.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("SHA256_Benchmark", "[.][sha256Benchmark]")
+{
+    if (!TestHook_HasSHA256ProcessorInstructions())
+    {
+        WARN("Skipped; the processor has no SHA instructions");
+        return;
+    }
+
+    constexpr size_t chunkSize = 1 << 20;
+    std::vector<uint8_t> chunk = GetData(chunkSize);
+
+    // Returns the throughput in MB/s of hashing the given number of bytes, added in chunks of up to 1 MB.
+    auto measure = [&](size_t size)
+    {
+        size_t iterations = std::max<size_t>(1, (64 << 20) / size);
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            SHA256 hasher;
+            for (size_t offset = 0; offset < size; offset += chunkSize)
+            {
+                hasher.Add(chunk.data(), std::min(chunkSize, size - offset));
+            }
+            hasher.Get();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(size) * iterations / elapsed.count() / (1 << 20);
+    };
+
+    for (size_t size = 1 << 10; size <= (static_cast<size_t>(1) << 30); size <<= 4)
+    {
+        double accelerated = 0;
+        {
+            ForceImplementation force{ true };
+            accelerated = measure(size);
+        }
+
+        double platform = 0;
+        {
+            ForceImplementation force{ false };
+            platform = measure(size);
+        }
+
+        WARN(size << " bytes; accelerated: " << accelerated << " MB/s, platform: " << platform << " MB/s");
+    }
+}
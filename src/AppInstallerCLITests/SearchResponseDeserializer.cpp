@@ -0,0 +1,179 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerErrors.h>
+#include <Rest/Schema/1_0/Json/SearchResponseDeserializer.h>
+
+#include <chrono>
+
+using namespace AppInstaller::Repository::Rest::Schema;
+using namespace AppInstaller::Repository::Rest::Schema::V1_0::Json;
+
+namespace
+{
+    constexpr std::string_view s_PackageTemplate = R"delimiter({
+        "PackageIdentifier": "git.package.#",
+        "PackageName": "package \"#\"",
+        "Publisher": "git",
+        "Unknown": { "Nested": [ 1, 2.5, null ] },
+        "Versions": [
+            {
+                "PackageVersion": "1.0.#",
+                "Channel": "beta",
+                "PackageFamilyNames" : [ "pfn1", "pfn2", "pfn2" ],
+                "ProductCodes" : [ "pc1", "pc2" ]
+            },
+            {
+                "PackageVersion": "2.0.#",
+                "ProductCodes" : [ "pc\u00e9" ]
+            }]
+        })delimiter";
+
+    // Builds a page with the given number of packages, each with two versions.
+    std::string GetSearchResponse(size_t packageCount, std::string_view continuationToken = {})
+    {
+        std::string result = R"({ "Data" : [)";
+
+        for (size_t i = 0; i < packageCount; ++i)
+        {
+            if (i)
+            {
+                result += ',';
+            }
+
+            std::string package{ s_PackageTemplate };
+            for (size_t pos = package.find('#'); pos != std::string::npos; pos = package.find('#', pos))
+            {
+                package.replace(pos, 1, std::to_string(i));
+            }
+
+            result += package;
+        }
+
+        result += ']';
+
+        if (!continuationToken.empty())
+        {
+            result += R"(, "ContinuationToken" : ")";
+            result += continuationToken;
+            result += '"';
+        }
+
+        result += '}';
+        return result;
+    }
+
+    IRestClient::SearchResult DeserializeFromText(const std::string& json)
+    {
+        SearchResponseDeserializer deserializer;
+        return deserializer.Deserialize(std::string_view{ json });
+    }
+}
+
+TEST_CASE("SearchResponseDeserializer_Text", "[RestSource]")
+{
+    std::string json = GetSearchResponse(5);
+
+    IRestClient::SearchResult fromText = DeserializeFromText(json);
+    REQUIRE(fromText.Matches.size() == 5);
+
+    for (size_t i = 0; i < fromText.Matches.size(); ++i)
+    {
+        const auto& package = fromText.Matches[i];
+        std::string index = std::to_string(i);
+
+        REQUIRE(package.PackageInformation.PackageIdentifier == "git.package." + index);
+        REQUIRE(package.PackageInformation.PackageName == "package \"" + index + '"');
+        REQUIRE(package.PackageInformation.Publisher == "git");
+        REQUIRE(package.Versions.size() == 2);
+
+        REQUIRE(package.Versions[0].VersionAndChannel.GetVersion().ToString() == "1.0." + index);
+        REQUIRE(package.Versions[0].VersionAndChannel.GetChannel().ToString() == "beta");
+        REQUIRE(package.Versions[0].PackageFamilyNames == std::vector<std::string>{ "pfn1", "pfn2" });
+        REQUIRE(package.Versions[0].ProductCodes == std::vector<std::string>{ "pc1", "pc2" });
+
+        REQUIRE(package.Versions[1].VersionAndChannel.GetVersion().ToString() == "2.0." + index);
+        REQUIRE(package.Versions[1].VersionAndChannel.GetChannel().ToString().empty());
+        REQUIRE(package.Versions[1].PackageFamilyNames.empty());
+        REQUIRE(package.Versions[1].ProductCodes == std::vector<std::string>{ "pc\xC3\xA9" });
+    }
+}
+
+TEST_CASE("SearchResponseDeserializer_TextNoData", "[RestSource]")
+{
+    std::string documents[] = { R"({})", R"({ "Data" : [] })", R"({ "Data" : null })", R"([])" };
+
+    for (const std::string& json : documents)
+    {
+        INFO(json);
+        REQUIRE(DeserializeFromText(json).Matches.empty());
+    }
+}
+
+TEST_CASE("SearchResponseDeserializer_TextInvalid", "[RestSource]")
+{
+    std::string documents[] =
+    {
+        // No versions
+        R"({ "Data" : [ { "PackageIdentifier": "id", "PackageName": "name", "Publisher": "publisher" } ] })",
+        // Missing publisher
+        R"({ "Data" : [ { "PackageIdentifier": "id", "PackageName": "name", "Versions": [ { "PackageVersion": "1.0" } ] } ] })",
+        // Version without a version
+        R"({ "Data" : [ { "PackageIdentifier": "id", "PackageName": "name", "Publisher": "publisher", "Versions": [ { "Channel": "beta" } ] } ] })",
+        // Not an object
+        R"({ "Data" : [ "id" ] })",
+        // Missing json object
+        R"(null)",
+    };
+
+    for (const std::string& json : documents)
+    {
+        INFO(json);
+        REQUIRE_THROWS_HR(DeserializeFromText(json), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+    }
+}
+
+TEST_CASE("SearchResponseDeserializer_TextMalformed", "[RestSource]")
+{
+    std::string json = GetSearchResponse(2);
+    json.pop_back();
+
+    REQUIRE_THROWS_HR(DeserializeFromText(json), APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA);
+}
+
+TEST_CASE("SearchResponseDeserializer_GetPageInfo", "[RestSource]")
+{
+    SearchResponseDeserializer deserializer;
+
+    auto pageInfo = deserializer.GetPageInfo(GetSearchResponse(7, "token"));
+    REQUIRE(pageInfo.DataCount == 7);
+    REQUIRE(pageInfo.ContinuationToken == "token");
+
+    pageInfo = deserializer.GetPageInfo(GetSearchResponse(3));
+    REQUIRE(pageInfo.DataCount == 3);
+    REQUIRE(pageInfo.ContinuationToken.empty());
+}
+
+// Compares the time taken to deserialize a large page with the time that building a web::json::value from it alone takes.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("SearchResponseDeserializer_Benchmark", "[.][RestSourceBenchmark]")
+{
+    constexpr size_t iterations = 20;
+    std::string json = GetSearchResponse(1000, "token");
+
+    auto time = [&](const std::function<void()>& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            f();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start) / iterations;
+    };
+
+    auto valueTime = time([&]() { web::json::value::parse(utility::conversions::to_string_t(json)); });
+    auto textTime = time([&]() { REQUIRE(DeserializeFromText(json).Matches.size() == 1000); });
+
+    WARN("Page of " << json.size() << " bytes; web::json::value::parse: " << valueTime.count() << "us, text: " << textTime.count() << "us");
+}
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerSHA256.h>
+#include <SegmentedDownloader.h>
+#include <cpprest/http_listener.h>
+
+using namespace AppInstaller;
+using namespace AppInstaller::Utility;
+using namespace std::string_literals;
+
+namespace
+{
+    constexpr std::wstring_view s_LocalServerUri = L"http://localhost:51872/";
+    constexpr std::string_view s_InstallerUrl = "http://localhost:51872/installer.exe";
+
+    std::vector<unsigned char> GetInstallerContents()
+    {
+        std::vector<unsigned char> result((1 << 20) + 123);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = static_cast<unsigned char>((i * 31) ^ (i >> 8));
+        }
+        return result;
+    }
+
+    // A local server for a single file, that responds to requests for a range with only that range if ranges are supported.
+    struct RangeServer
+    {
+        RangeServer(bool supportRanges) : m_contents(GetInstallerContents()), m_listener(utility::string_t{ s_LocalServerUri })
+        {
+            m_listener.support([this, supportRanges](web::http::http_request request)
+                {
+                    ++Requests;
+
+                    web::http::http_response response{ web::http::status_codes::OK };
+                    utility::string_t range;
+
+                    if (supportRanges && request.headers().match(web::http::header_names::range, range))
+                    {
+                        ++RangeRequests;
+
+                        // Only the "bytes=first-last" form is used by the downloader
+                        size_t dash = range.find(L'-');
+                        uint64_t first = std::stoull(range.substr(6, dash - 6));
+                        uint64_t last = std::min<uint64_t>(std::stoull(range.substr(dash + 1)), m_contents.size() - 1);
+
+                        response.set_status_code(web::http::status_codes::PartialContent);
+                        response.set_body(std::vector<unsigned char>{ m_contents.begin() + first, m_contents.begin() + last + 1 });
+                        response.headers().add(web::http::header_names::content_range,
+                            L"bytes " + std::to_wstring(first) + L'-' + std::to_wstring(last) + L'/' + std::to_wstring(m_contents.size()));
+                    }
+                    else
+                    {
+                        response.set_body(m_contents);
+                    }
+
+                    response.headers().set_content_type(L"application/octet-stream");
+                    request.reply(response);
+                });
+
+            m_listener.open().wait();
+        }
+
+        ~RangeServer()
+        {
+            m_listener.close().wait();
+        }
+
+        SHA256::HashBuffer GetHash() const
+        {
+            return SHA256::ComputeHash(m_contents.data(), static_cast<uint32_t>(m_contents.size()));
+        }
+
+        bool Matches(const std::filesystem::path& file) const
+        {
+            std::ifstream stream{ file, std::ios_base::in | std::ios_base::binary };
+            std::vector<unsigned char> contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+            return contents == m_contents;
+        }
+
+        std::atomic<size_t> Requests = 0;
+        std::atomic<size_t> RangeRequests = 0;
+
+    private:
+        std::vector<unsigned char> m_contents;
+        web::http::experimental::listener::http_listener m_listener;
+    };
+
+    DWORD GetConnectionsPerServer()
+    {
+        DWORD result = 0;
+        DWORD cbResult = sizeof(result);
+        REQUIRE(InternetQueryOptionA(NULL, INTERNET_OPTION_MAX_CONNS_PER_SERVER, &result, &cbResult));
+        return result;
+    }
+
+    SegmentedDownloadOptions GetTestOptions(uint64_t minimumSegmentSize)
+    {
+        SegmentedDownloadOptions result;
+        result.SegmentCount = 4;
+        result.MinimumSegmentSize = minimumSegmentSize;
+        return result;
+    }
+}
+
+TEST_CASE("SegmentedDownload_Ranges", "[Downloader]")
+{
+    RangeServer server{ true };
+    TestCommon::TempFile tempFile("segmented_test"s, ".test"s);
+
+    DWORD connectionsPerServer = GetConnectionsPerServer();
+
+    ProgressCallback callback;
+    auto result = SegmentedDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true, GetTestOptions(64 << 10));
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+
+    // The probe for the first byte, then one request for each segment
+    REQUIRE(server.RangeRequests == 5);
+
+    // The process wide connection limit is only raised for the duration of the download
+    REQUIRE(GetConnectionsPerServer() == connectionsPerServer);
+}
+
+TEST_CASE("SegmentedDownload_RangesNotSupported", "[Downloader]")
+{
+    RangeServer server{ false };
+    TestCommon::TempFile tempFile("segmented_test"s, ".test"s);
+
+    // A larger existing file is overwritten
+    {
+        std::ofstream stream{ tempFile.GetPath(), std::ios_base::out | std::ios_base::binary };
+        stream << std::string(2 << 20, 'x');
+    }
+
+    ProgressCallback callback;
+    auto result = SegmentedDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true, GetTestOptions(64 << 10));
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+
+    // The response to the probe is the entire file, so it is used directly
+    REQUIRE(server.Requests == 1);
+}
+
+TEST_CASE("SegmentedDownload_SmallFileNotSplit", "[Downloader]")
+{
+    RangeServer server{ true };
+    TestCommon::TempFile tempFile("segmented_test"s, ".test"s);
+
+    ProgressCallback callback;
+    auto result = SegmentedDownload(std::string{ s_InstallerUrl }, tempFile.GetPath(), callback, true, GetTestOptions(16 << 20));
+
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == server.GetHash());
+    REQUIRE(server.Matches(tempFile.GetPath()));
+
+    REQUIRE(server.RangeRequests == 1);
+    REQUIRE(server.Requests == 2);
+}
@@ -915,3 +915,36 @@ TEST_CASE("RepoSources_GroupPolicy_AllowedSources", "[sources][groupPolicy]")
         }
     }
 }
+
+TEST_CASE("RepoSources_PrefetchManifests", "[sources]")
+{
+    // Records the versions that each source is asked to prefetch
+    struct PrefetchTestSource : public TestSource
+    {
+        void PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>& versions, IProgressCallback&) const override
+        {
+            Calls.emplace_back(versions.size());
+        }
+
+        mutable std::vector<size_t> Calls;
+    };
+
+    auto first = std::make_shared<PrefetchTestSource>();
+    auto second = std::make_shared<PrefetchTestSource>();
+
+    Manifest::Manifest manifest;
+    std::vector<std::shared_ptr<IPackageVersion>> versions = {
+        TestPackageVersion::Make(manifest, first),
+        TestPackageVersion::Make(manifest, second),
+        nullptr,
+        TestPackageVersion::Make(manifest),
+        TestPackageVersion::Make(manifest, first),
+    };
+
+    ProgressCallback progress;
+    PrefetchManifests(versions, progress);
+
+    // Each source is asked once, with all of its versions; those without a source are left out
+    REQUIRE(first->Calls == std::vector<size_t>{ 2 });
+    REQUIRE(second->Calls == std::vector<size_t>{ 1 });
+}
@@ -4,8 +4,11 @@
 #include "TestCommon.h"
 #include "TestHooks.h"
 #include "winget/GroupPolicy.h"
+#include "winget/Manifest.h"
 #include "winget/UserSettings.h"
 
+using namespace AppInstaller::Manifest;
+
 namespace TestCommon
 {
     namespace
@@ -22,6 +25,87 @@ namespace TestCommon
             return randStart++;
         }
 
+        void RequireEqual(const std::vector<string_t>& actual, const std::vector<string_t>& expected)
+        {
+            REQUIRE(actual.size() == expected.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                REQUIRE(actual[i] == expected[i]);
+            }
+        }
+
+        void RequireEqual(const ManifestInstaller& actual, const ManifestInstaller& expected)
+        {
+            REQUIRE(actual.Arch == expected.Arch);
+            REQUIRE(actual.Url == expected.Url);
+            REQUIRE(actual.Sha256 == expected.Sha256);
+            REQUIRE(actual.SignatureSha256 == expected.SignatureSha256);
+            REQUIRE(actual.ProductId == expected.ProductId);
+            REQUIRE(actual.Locale == expected.Locale);
+            REQUIRE(actual.Platform == expected.Platform);
+            REQUIRE(actual.MinOSVersion == expected.MinOSVersion);
+            REQUIRE(actual.InstallerType == expected.InstallerType);
+            REQUIRE(actual.Scope == expected.Scope);
+            REQUIRE(actual.InstallModes == expected.InstallModes);
+
+            REQUIRE(actual.Switches.size() == expected.Switches.size());
+            for (const auto& installerSwitch : expected.Switches)
+            {
+                auto itr = actual.Switches.find(installerSwitch.first);
+                REQUIRE(itr != actual.Switches.end());
+                REQUIRE(itr->second == installerSwitch.second);
+            }
+
+            REQUIRE(actual.InstallerSuccessCodes == expected.InstallerSuccessCodes);
+            REQUIRE(actual.UpdateBehavior == expected.UpdateBehavior);
+            RequireEqual(actual.Commands, expected.Commands);
+            RequireEqual(actual.Protocols, expected.Protocols);
+            RequireEqual(actual.FileExtensions, expected.FileExtensions);
+            REQUIRE(actual.PackageFamilyName == expected.PackageFamilyName);
+            REQUIRE(actual.ProductCode == expected.ProductCode);
+            RequireEqual(actual.Capabilities, expected.Capabilities);
+            RequireEqual(actual.RestrictedCapabilities, expected.RestrictedCapabilities);
+
+            RequireEqual(actual.Dependencies.WindowsFeatures, expected.Dependencies.WindowsFeatures);
+            RequireEqual(actual.Dependencies.WindowsLibraries, expected.Dependencies.WindowsLibraries);
+            RequireEqual(actual.Dependencies.ExternalDependencies, expected.Dependencies.ExternalDependencies);
+            REQUIRE(actual.Dependencies.PackageDependencies.size() == expected.Dependencies.PackageDependencies.size());
+            for (size_t i = 0; i < expected.Dependencies.PackageDependencies.size(); ++i)
+            {
+                REQUIRE(actual.Dependencies.PackageDependencies[i].Id == expected.Dependencies.PackageDependencies[i].Id);
+                REQUIRE(actual.Dependencies.PackageDependencies[i].MinVersion == expected.Dependencies.PackageDependencies[i].MinVersion);
+            }
+        }
+
+        void RequireEqualValue(const string_t& actual, const string_t& expected)
+        {
+            REQUIRE(actual == expected);
+        }
+
+        void RequireEqualValue(const std::vector<string_t>& actual, const std::vector<string_t>& expected)
+        {
+            RequireEqual(actual, expected);
+        }
+
+        template <Localization L>
+        void RequireEqualEntry(const ManifestLocalization& actual, const ManifestLocalization& expected)
+        {
+            REQUIRE(actual.Contains(L) == expected.Contains(L));
+            RequireEqualValue(actual.Get<L>(), expected.Get<L>());
+        }
+
+        template <size_t... I>
+        void RequireEqual(const ManifestLocalization& actual, const ManifestLocalization& expected, std::index_sequence<I...>)
+        {
+            REQUIRE(actual.Locale == expected.Locale);
+            (RequireEqualEntry<static_cast<Localization>(I)>(actual, expected), ...);
+        }
+
+        void RequireEqual(const ManifestLocalization& actual, const ManifestLocalization& expected)
+        {
+            RequireEqual(actual, expected, std::make_index_sequence<static_cast<size_t>(Localization::Max)>());
+        }
+
         inline std::filesystem::path GetTempFilePath(const std::string& baseName, const std::string& baseExt)
         {
             std::filesystem::path tempFilePath = std::filesystem::temp_directory_path();
@@ -200,6 +284,32 @@ namespace TestCommon
         THROW_IF_WIN32_ERROR(RegSetValueExW(key, name.c_str(), 0, REG_DWORD, reinterpret_cast<const BYTE*>(&value), sizeof(DWORD)));
     }
 
+    void RequireEqual(const Manifest& actual, const Manifest& expected)
+    {
+        REQUIRE(actual.Id == expected.Id);
+        REQUIRE(actual.Version == expected.Version);
+        REQUIRE(actual.Channel == expected.Channel);
+        REQUIRE(actual.Moniker == expected.Moniker);
+        REQUIRE(actual.ManifestVersion.ToStringWithExtensions() == expected.ManifestVersion.ToStringWithExtensions());
+
+        RequireEqual(actual.DefaultInstallerInfo, expected.DefaultInstallerInfo);
+        REQUIRE(actual.Installers.size() == expected.Installers.size());
+        for (size_t i = 0; i < expected.Installers.size(); ++i)
+        {
+            RequireEqual(actual.Installers[i], expected.Installers[i]);
+        }
+
+        RequireEqual(actual.DefaultLocalization, expected.DefaultLocalization);
+        REQUIRE(actual.Localizations.size() == expected.Localizations.size());
+        for (size_t i = 0; i < expected.Localizations.size(); ++i)
+        {
+            RequireEqual(actual.Localizations[i], expected.Localizations[i]);
+        }
+
+        RequireEqual(actual.CurrentLocalization, expected.CurrentLocalization);
+        REQUIRE(actual.StreamSha256 == expected.StreamSha256);
+    }
+
     TestUserSettings::TestUserSettings(bool keepFileSettings)
     {
         if (!keepFileSettings)
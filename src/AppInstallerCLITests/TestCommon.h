@@ -12,6 +12,11 @@
 
 #define REQUIRE_THROWS_HR(_expr_, _hr_)     REQUIRE_THROWS_MATCHES(_expr_, wil::ResultException, ::TestCommon::ResultExceptionHRMatcher(_hr_))
 
+namespace AppInstaller::Manifest
+{
+    struct Manifest;
+}
+
 namespace TestCommon
 {
     enum class TempFileDestructionBehavior
@@ -116,6 +121,9 @@ namespace TestCommon
     void SetRegistryValue(HKEY key, const std::wstring& name, const std::vector<BYTE>& value, DWORD type = REG_BINARY);
     void SetRegistryValue(HKEY key, const std::wstring& name, DWORD value);
 
+    // Requires that every field of the manifests, including those of each installer and localization, is the same.
+    void RequireEqual(const AppInstaller::Manifest::Manifest& actual, const AppInstaller::Manifest::Manifest& expected);
+
     // Override UserSettings using this class.
     // Automatically overrides the user settings for the lifetime of this object.
     // DOES NOT SUPPORT NESTED USE
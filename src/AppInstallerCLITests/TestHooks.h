@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <AppInstallerTelemetry.h>
@@ -27,6 +28,15 @@ namespace AppInstaller
     {
         void TestHook_SetSourceFactoryOverride(const std::string& type, std::function<std::unique_ptr<ISourceFactory>()>&& factory);
         void TestHook_ClearSourceFactoryOverrides();
+        void TestHook_SetARPEntryVersionsOverride(std::function<std::vector<ARPEntryVersion>()>&& entryVersions);
+    }
+
+    namespace Utility
+    {
+        // Forces hashes to use the SHA instructions of the processor (true) or the platform implementation (false),
+        // or restores the default choice between them (nullopt).
+        void TestHook_ForceSHA256Implementation(std::optional<bool> processorInstructions);
+        bool TestHook_HasSHA256ProcessorInstructions();
     }
 
     namespace Logging
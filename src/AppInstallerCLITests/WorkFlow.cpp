@@ -28,6 +28,8 @@
 #include <Resources.h>
 #include <AppInstallerFileLogger.h>
 
+#include <mutex>
+
 using namespace winrt::Windows::Foundation;
 using namespace winrt::Windows::Management::Deployment;
 using namespace TestCommon;
@@ -269,7 +271,13 @@ namespace
             }
             else
             {
-                itr->Used = true;
+                {
+                    // Clones may run tasks on other threads, such as the downloads of upgrade --all
+                    static std::mutex s_usedLock;
+                    std::lock_guard<std::mutex> lock{ s_usedLock };
+                    itr->Used = true;
+                }
+
                 itr->Override(*this);
                 return false;
             }
@@ -287,6 +295,13 @@ namespace
             return clone;
         }
 
+        std::unique_ptr<Context> Clone(std::ostream& out) override
+        {
+            auto clone = std::make_unique<TestContext>(out, m_in, m_overrides);
+            clone->SetFlags(this->GetFlags());
+            return clone;
+        }
+
     private:
         std::shared_ptr<std::vector<WorkflowTaskOverride>> m_overrides;
         std::ostream& m_out;
@@ -1036,6 +1051,177 @@ TEST_CASE("UpdateFlow_UpdateAllApplicable", "[UpdateFlow][workflow]")
     REQUIRE(std::filesystem::exists(updateMSStoreResultPath.GetPath()));
 }
 
+TEST_CASE("UpdateFlow_UpdateAllApplicable_DownloadAhead", "[UpdateFlow][workflow]")
+{
+    constexpr size_t updateCount = 4;
+
+    // Only bounds the waits in case of bugs; the test does not depend on how long anything takes
+    constexpr DWORD waitTimeout = 30000;
+
+    auto source = std::make_shared<WorkflowTestCompositeSource>();
+    auto installedManifest = YamlParser::CreateFromPath(TestDataFile("InstallFlowTest_Exe.yaml"));
+    auto updateManifest = YamlParser::CreateFromPath(TestDataFile("UpdateFlowTest_Exe.yaml"));
+
+    std::vector<std::string> expectedIds;
+    SearchResult searchResult;
+    for (size_t i = 0; i < updateCount; ++i)
+    {
+        std::string id = "AppInstallerCliTest.TestExeInstaller" + std::to_string(i);
+        installedManifest.Id = id;
+        updateManifest.Id = id;
+        expectedIds.emplace_back(id);
+
+        searchResult.Matches.emplace_back(
+            ResultMatch(
+                TestPackage::Make(
+                    installedManifest,
+                    TestPackage::MetadataMap{ { PackageVersionMetadata::InstalledType, "Exe" } },
+                    std::vector<Manifest>{ updateManifest, installedManifest },
+                    source
+                ),
+                PackageMatchFilter(PackageMatchField::Id, MatchType::Exact, id)));
+    }
+
+    auto getIndex = [&](TestContext& updateContext)
+    {
+        const auto& id = updateContext.Get<Execution::Data::Manifest>().Id;
+        return static_cast<size_t>(std::find(expectedIds.begin(), expectedIds.end(), id) - expectedIds.begin());
+    };
+
+    // Runs the updates, recording the order in which downloads start and installs start and end.
+    // When downloading ahead, the first install waits for the second download to start, and the second download waits for the
+    // third to start, so the updates only complete if downloads overlap both the install and each other.
+    auto updateAll = [&](uint32_t downloadAheadCount)
+    {
+        TestUserSettings settings;
+        settings.Set<AppInstaller::Settings::Setting::InstallDownloadAheadCount>(std::move(downloadAheadCount));
+
+        std::ostringstream updateOutput;
+        TestContext context{ updateOutput, std::cin };
+        context.Add<Execution::Data::SearchResult>(searchResult);
+
+        std::mutex eventsLock;
+        std::vector<std::string> events;
+        auto record = [&](std::string event)
+        {
+            std::lock_guard<std::mutex> lock{ eventsLock };
+            events.emplace_back(std::move(event));
+        };
+
+        std::vector<wil::unique_event> downloadStarted(updateCount);
+        for (auto& downloadStartedEvent : downloadStarted)
+        {
+            downloadStartedEvent.create(wil::EventOptions::ManualReset);
+        }
+
+        context.Override({ DownloadInstallerFile, [&](TestContext& updateContext)
+        {
+            size_t index = getIndex(updateContext);
+            record("Download " + std::to_string(index));
+            downloadStarted[index].SetEvent();
+
+            if (downloadAheadCount > 1 && index == 1 && !downloadStarted[2].wait(waitTimeout))
+            {
+                record("Timed out waiting for download 2");
+            }
+
+            updateContext.Reporter.Info() << "Downloaded " << expectedIds[index] << '.' << std::endl;
+            updateContext.Add<Data::HashPair>({ {}, {} });
+            updateContext.Add<Data::InstallerPath>(TestDataFile("AppInstallerTestExeInstaller.exe"));
+        } });
+
+        context.Override({ ShellExecuteInstallImpl, [&](TestContext& updateContext)
+        {
+            size_t index = getIndex(updateContext);
+            record("Install " + std::to_string(index));
+
+            if (downloadAheadCount > 0 && index == 0 && !downloadStarted[1].wait(waitTimeout))
+            {
+                record("Timed out waiting for download 1");
+            }
+
+            record("Installed " + std::to_string(index));
+        } });
+
+        context.Override({ RenameDownloadedInstaller, [](TestContext&) {} });
+        context.Override({ SnapshotARPEntries, [](TestContext&) {} });
+        context.Override({ ReportARPChanges, [](TestContext&) {} });
+        OverrideForUpdateInstallerMotw(context);
+
+        context << UpdateAllApplicable;
+        INFO(updateOutput.str());
+        REQUIRE(!context.IsTerminated());
+
+        // Each update is reported before the output of its download, even when the download ran ahead
+        std::string output = updateOutput.str();
+        size_t position = 0;
+        for (const auto& id : expectedIds)
+        {
+            size_t identity = output.find(id, position);
+            REQUIRE(identity != std::string::npos);
+            size_t downloaded = output.find("Downloaded " + id + '.', identity + id.size());
+            REQUIRE(downloaded != std::string::npos);
+            position = downloaded;
+        }
+
+        return events;
+    };
+
+    auto indexOf = [](const std::vector<std::string>& events, const std::string& event)
+    {
+        auto itr = std::find(events.begin(), events.end(), event);
+        REQUIRE(itr != events.end());
+        return itr - events.begin();
+    };
+
+    auto describe = [](const std::vector<std::string>& events)
+    {
+        std::ostringstream result;
+        for (const auto& event : events)
+        {
+            result << event << "; ";
+        }
+        return result.str();
+    };
+
+    SECTION("Sequential")
+    {
+        std::vector<std::string> events = updateAll(0);
+        INFO(describe(events));
+
+        std::vector<std::string> expected;
+        for (size_t i = 0; i < updateCount; ++i)
+        {
+            expected.emplace_back("Download " + std::to_string(i));
+            expected.emplace_back("Install " + std::to_string(i));
+            expected.emplace_back("Installed " + std::to_string(i));
+        }
+
+        REQUIRE(events == expected);
+    }
+    SECTION("DownloadAhead")
+    {
+        std::vector<std::string> events = updateAll(2);
+        INFO(describe(events));
+
+        REQUIRE(std::find_if(events.begin(), events.end(), [](const std::string& event) { return event.rfind("Timed out", 0) == 0; }) == events.end());
+
+        // The downloads overlap the first install, and the installs still run one at a time, in the order of the matches
+        REQUIRE(indexOf(events, "Download 1") < indexOf(events, "Installed 0"));
+        REQUIRE(indexOf(events, "Download 2") < indexOf(events, "Installed 0"));
+
+        for (size_t i = 0; i < updateCount; ++i)
+        {
+            REQUIRE(indexOf(events, "Download " + std::to_string(i)) < indexOf(events, "Install " + std::to_string(i)));
+
+            if (i > 0)
+            {
+                REQUIRE(indexOf(events, "Installed " + std::to_string(i - 1)) < indexOf(events, "Install " + std::to_string(i)));
+            }
+        }
+    }
+}
+
 TEST_CASE("UninstallFlow_UninstallExe", "[UninstallFlow][workflow]")
 {
     TestCommon::TempFile uninstallResultPath("TestExeUninstalled.txt");
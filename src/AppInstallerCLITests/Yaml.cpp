@@ -0,0 +1,261 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "TestCommon.h"
+#include <AppInstallerErrors.h>
+#include <winget/ManifestYamlParser.h>
+#include <winget/Yaml.h>
+
+#include <chrono>
+
+using namespace AppInstaller;
+using namespace std::string_view_literals;
+
+namespace
+{
+    constexpr std::string_view s_ManifestHeader = R"(
+Id: microsoft.msixsdk
+Name: MSIX SDK
+Version: 1.07.32-beta
+Publisher: Microsoft
+InstallerType: Zip
+License: Test
+Description: The MSIX SDK project is an effort to enable developers on a variety of platforms to pack and unpack packages.
+Tags: "msix,appx"
+Installers:
+)";
+
+    constexpr std::string_view s_InstallerTemplate = R"(  - Arch: x86
+    Url: https://example.com/msixsdk-#.zip
+    Sha256: 98B67758CEAFFCBB3FE47838FD0A8D7BD581C2650842D6B2B0E0D49A23270CCD
+    Language: en-US
+    Switches:
+      Custom: /custom #
+      Silent: /s
+)";
+
+    // Builds a manifest with the given number of installers.
+    std::string GetManifest(size_t installerCount)
+    {
+        std::string result{ s_ManifestHeader };
+
+        for (size_t i = 0; i < installerCount; ++i)
+        {
+            std::string installer{ s_InstallerTemplate };
+            for (size_t pos = installer.find('#'); pos != std::string::npos; pos = installer.find('#', pos))
+            {
+                installer.replace(pos, 1, std::to_string(i));
+            }
+
+            result += installer;
+        }
+
+        result += "ManifestVersion: 0.1.0\n";
+        return result;
+    }
+
+    std::vector<std::string> GetKeys(const YAML::Node& node)
+    {
+        std::vector<std::string> result;
+        for (const auto& entry : node.Mapping())
+        {
+            result.emplace_back(entry.first.as<std::string>());
+        }
+        return result;
+    }
+}
+
+TEST_CASE("YamlNode_MappingOrderedByKey", "[yaml]")
+{
+    YAML::Node root = YAML::Load("c: 3\na: 1\nb: [ x, y ]\n"sv);
+
+    REQUIRE(root.IsMap());
+    REQUIRE(root.size() == 3);
+    REQUIRE(GetKeys(root) == std::vector<std::string>{ "a", "b", "c" });
+
+    REQUIRE(root["a"sv].as<int>() == 1);
+    REQUIRE(root["c"sv].as<std::string_view>() == "3"sv);
+    REQUIRE(!root["d"sv]);
+    REQUIRE(root["d"sv].IsNull());
+
+    YAML::Node sequence = root["b"sv];
+    REQUIRE(sequence.IsSequence());
+    REQUIRE(sequence.size() == 2);
+    REQUIRE(sequence[1].as<std::string>() == "y");
+    REQUIRE(sequence[1].Mark().line == 3);
+
+    std::vector<std::string> values;
+    for (const auto& value : sequence.Sequence())
+    {
+        values.emplace_back(value.as<std::string>());
+    }
+    REQUIRE(values == std::vector<std::string>{ "x", "y" });
+}
+
+TEST_CASE("YamlNode_DuplicateAndInvalidKeys", "[yaml]")
+{
+    YAML::Node root = YAML::Load("b: 1\na: 2\nb: 3\n"sv);
+
+    REQUIRE(root.size() == 3);
+    REQUIRE(root["a"sv].as<int>() == 2);
+    REQUIRE_THROWS_HR(root["b"sv], APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY);
+
+    // Entries with the same key stay in document order
+    std::vector<int> values;
+    for (const auto& entry : root.Mapping())
+    {
+        values.emplace_back(entry.second.as<int>());
+    }
+    REQUIRE(values == std::vector<int>{ 2, 1, 3 });
+
+    REQUIRE_THROWS_HR(YAML::Load("[ a ]: 1\n"sv), APPINSTALLER_CLI_ERROR_YAML_INVALID_MAPPING_KEY);
+}
+
+TEST_CASE("YamlNode_AddNodesFromOtherDocuments", "[yaml]")
+{
+    YAML::Node root = YAML::Load("b: 1\nd: 4\n"sv);
+
+    {
+        YAML::Node other = YAML::Load("c: { x: [ 1, 2 ] }\na: 0\n"sv);
+        for (const auto& entry : other.Mapping())
+        {
+            root.AddMappingNode(entry.first, entry.second);
+        }
+    }
+
+    // The copies must not refer to the other document, which is gone
+    REQUIRE(GetKeys(root) == std::vector<std::string>{ "a", "b", "c", "d" });
+    REQUIRE(root["c"sv]["x"sv][1].as<int>() == 2);
+
+    YAML::Node list{ YAML::Node::Type::Sequence, "", YAML::Mark() };
+    YAML::Node item{ YAML::Node::Type::Scalar, "", YAML::Mark() };
+    item.SetScalar("first");
+    list.AddSequenceNode(item);
+    list.AddSequenceNode(root["c"sv]);
+
+    // Handles share their node, but added nodes are copies
+    root["b"sv].SetScalar("changed");
+    item.SetScalar("second");
+
+    REQUIRE(root["b"sv].as<std::string>() == "changed");
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[0].as<std::string>() == "first");
+    REQUIRE(list[1]["x"sv][0].as<int>() == 1);
+}
+
+TEST_CASE("YamlNode_Clone", "[yaml]")
+{
+    YAML::Node root = YAML::Load("a: [ 1, 2 ]\nb: 3\n"sv);
+    YAML::Node handle = root;
+    YAML::Node clone = root.Clone();
+
+    // A copied handle changes the same node, but a clone is independent of it
+    handle["b"sv].SetScalar("changed");
+    clone["a"sv][0].SetScalar("cloned");
+
+    REQUIRE(root["b"sv].as<std::string>() == "changed");
+    REQUIRE(root["a"sv][0].as<int>() == 1);
+    REQUIRE(clone["b"sv].as<int>() == 3);
+    REQUIRE(clone["a"sv][0].as<std::string>() == "cloned");
+    REQUIRE(!YAML::Node{}.Clone());
+}
+
+TEST_CASE("YamlNode_AddToSeveralContainers", "[yaml]")
+{
+    YAML::Node root{ YAML::Node::Type::Mapping, "", YAML::Mark() };
+    YAML::Node key{ YAML::Node::Type::Scalar, "", YAML::Mark() };
+    key.SetScalar("first");
+    YAML::Node first = root.AddMappingNode(key, YAML::Node::Type::Sequence, "", YAML::Mark());
+    key.SetScalar("second");
+    YAML::Node second = root.AddMappingNode(key, YAML::Node::Type::Mapping, "", YAML::Mark());
+
+    // Alternating between the containers moves their children each time they run out of room
+    for (int i = 0; i < 100; ++i)
+    {
+        YAML::Node item{ YAML::Node::Type::Scalar, "", YAML::Mark() };
+        item.SetScalar(std::to_string(i));
+        first.AddSequenceNode(item);
+
+        key.SetScalar(std::to_string(99 - i));
+        second.AddMappingNode(key, item);
+    }
+
+    REQUIRE(first.size() == 100);
+    REQUIRE(second.size() == 100);
+    REQUIRE(GetKeys(root) == std::vector<std::string>{ "first", "second" });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        REQUIRE(first[static_cast<size_t>(i)].as<int>() == i);
+        REQUIRE(second[std::to_string(99 - i)].as<int>() == i);
+    }
+
+    // Entries are kept ordered by key as they are added, with later entries for the same key after earlier ones
+    std::vector<std::string> keys = GetKeys(second);
+    REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+
+    key.SetScalar("50");
+    YAML::Node item{ YAML::Node::Type::Scalar, "", YAML::Mark() };
+    item.SetScalar("duplicate");
+    second.AddMappingNode(key, item);
+
+    std::vector<std::string> values;
+    for (const auto& entry : second.Mapping())
+    {
+        if (entry.first.as<std::string>() == "50")
+        {
+            values.emplace_back(entry.second.as<std::string>());
+        }
+    }
+    REQUIRE(values == std::vector<std::string>{ "49", "duplicate" });
+}
+
+TEST_CASE("YamlNode_LoadAliases", "[yaml]")
+{
+    std::string_view yaml = "b: &x { c: [ 1, 2 ], a: \"\\u00e9\" }\na: *x\nd:\n  - *x\n  - |\n    text\n---\ne: 1\n"sv;
+    YAML::Node root = YAML::Load(yaml);
+
+    // Only the first document is loaded, and entries are found regardless of the order they were written in
+    REQUIRE(GetKeys(root) == std::vector<std::string>{ "a", "b", "d" });
+    REQUIRE(root["b"sv]["a"sv].as<std::string>() == "\xC3\xA9");
+    REQUIRE(root["a"sv]["c"sv][1].as<int>() == 2);
+    REQUIRE(root["d"sv][0]["c"sv][0].as<int>() == 1);
+    REQUIRE(root["d"sv][1].as<std::string>() == "text\n");
+
+    // Aliases are copies of the anchored node, as yaml_parser_load makes them
+    root["a"sv]["c"sv][0].SetScalar("changed");
+    REQUIRE(root["b"sv]["c"sv][0].as<int>() == 1);
+    REQUIRE(root["d"sv][0]["c"sv][0].as<int>() == 1);
+
+    REQUIRE(!YAML::Load(""sv));
+    REQUIRE_THROWS_HR(YAML::Load("[ a ]: 1\n"sv), APPINSTALLER_CLI_ERROR_YAML_INVALID_MAPPING_KEY);
+    REQUIRE_THROWS_AS(YAML::Load("a: *y\n"sv), YAML::Exception);
+    REQUIRE_THROWS_AS(YAML::Load("a: &r [ *r ]\n"sv), YAML::Exception);
+}
+
+// Measures the throughput of loading a large manifest, and of creating a Manifest from it.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("YamlNode_Benchmark", "[.][yamlBenchmark]")
+{
+    constexpr size_t iterations = 20;
+    constexpr size_t installerCount = 2000;
+    std::string yaml = GetManifest(installerCount);
+
+    auto time = [&](const std::function<void()>& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            f();
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start) / iterations;
+    };
+
+    auto loadTime = time([&]() { REQUIRE(YAML::Load(yaml)["Installers"sv].size() == installerCount); });
+    auto createTime = time([&]() { REQUIRE(Manifest::YamlParser::Create(yaml).Installers.size() == installerCount); });
+
+    auto megabytesPerSecond = [&](std::chrono::microseconds duration) { return duration.count() ? static_cast<double>(yaml.size()) / duration.count() : 0.0; };
+
+    WARN("Manifest of " << yaml.size() << " bytes; load: " << loadTime.count() << "us (" << megabytesPerSecond(loadTime) << " MB/s), create: " <<
+        createTime.count() << "us (" << megabytesPerSecond(createTime) << " MB/s)");
+}
@@ -3,9 +3,12 @@
 #include "pch.h"
 #include "TestCommon.h"
 #include <AppInstallerSHA256.h>
+#include <winget/ManifestSchemaValidation.h>
 #include <winget/ManifestYamlParser.h>
 #include <winget/Yaml.h>
 
+#include <chrono>
+
 using namespace TestCommon;
 using namespace AppInstaller::Manifest;
 using namespace AppInstaller::Manifest::YamlParser;
@@ -493,6 +496,58 @@ TEST_CASE("ValidateV1GoodManifestAndVerifyContents", "[ManifestValidation]")
     VerifyV1ManifestContent(mergedManifest, false);
 }
 
+TEST_CASE("ReadMultiFileManifestWithManyLocales", "[ManifestValidation]")
+{
+    TempDirectory multiFileDirectory{ "MultiFileManifest" };
+    CopyTestDataFilesToFolder({
+        "ManifestV1-MultiFile-Version.yaml",
+        "ManifestV1-MultiFile-Installer.yaml",
+        "ManifestV1-MultiFile-DefaultLocale.yaml" }, multiFileDirectory);
+
+    std::string localeManifest;
+    {
+        std::ifstream stream{ TestDataFile("ManifestV1-MultiFile-Locale.yaml").GetPath(), std::ios_base::in | std::ios_base::binary };
+        localeManifest = ReadEntireStream(stream);
+    }
+
+    auto writeLocaleManifest = [&](const std::string& fileName, const std::string& locale)
+    {
+        std::string content = localeManifest;
+        content.replace(content.find("en-GB"), 5, locale);
+
+        std::ofstream stream{ multiFileDirectory.GetPath() / fileName, std::ios_base::out | std::ios_base::binary };
+        stream << content;
+    };
+
+    const std::vector<std::string> locales = { "en-GB", "fr-FR", "de-DE", "es-ES", "it-IT", "ja-JP", "ko-KR", "nl-NL", "pl-PL", "pt-BR", "ru-RU", "sv-SE", "tr-TR", "zh-CN", "zh-TW", "cs-CZ" };
+    for (const auto& locale : locales)
+    {
+        writeLocaleManifest("Locale." + locale + ".yaml", locale);
+    }
+
+    Manifest manifest = YamlParser::CreateFromPath(multiFileDirectory);
+    REQUIRE(manifest.Id == "microsoft.msixsdk");
+    REQUIRE(manifest.DefaultLocalization.Locale == "en-US");
+    REQUIRE(manifest.Localizations.size() == locales.size());
+
+    std::vector<std::string> manifestLocales;
+    for (const auto& localization : manifest.Localizations)
+    {
+        REQUIRE(localization.Get<Localization::Publisher>() == "Microsoft UK");
+        manifestLocales.emplace_back(localization.Locale);
+    }
+
+    std::sort(manifestLocales.begin(), manifestLocales.end());
+    std::vector<std::string> expectedLocales = locales;
+    std::sort(expectedLocales.begin(), expectedLocales.end());
+    REQUIRE(manifestLocales == expectedLocales);
+
+    // A locale that appears twice is reported however the files were loaded
+    writeLocaleManifest("Locale.duplicate.yaml", "ja-JP");
+
+    REQUIRE_THROWS_MATCHES(YamlParser::CreateFromPath(multiFileDirectory), ManifestException, ManifestExceptionMatcher("The multi file manifest contains duplicate PackageLocale. Field: PackageLocale Value: ja-JP"));
+}
+
 YamlManifestInfo CreateYamlManifestInfo(std::string testDataFile)
 {
     YamlManifestInfo result;
@@ -549,6 +604,7 @@ TEST_CASE("MultifileManifestInputValidation", "[ManifestValidation]")
     {
         // default locale not match
         auto defaultLocaleManifestCopy = v1DefaultLocaleManifest;
+        defaultLocaleManifestCopy.Root = v1DefaultLocaleManifest.Root.Clone();
         defaultLocaleManifestCopy.Root["PackageLocale"].SetScalar("fr-fr");
         std::vector<YamlManifestInfo> input = { v1VersionManifest, v1InstallerManifest, defaultLocaleManifestCopy, v1LocaleManifest };
         REQUIRE_THROWS_MATCHES(YamlParser::ParseManifest(input), ManifestException, ManifestExceptionMatcher("DefaultLocale value in version manifest does not match PackageLocale value in defaultLocale manifest"));
@@ -557,6 +613,7 @@ TEST_CASE("MultifileManifestInputValidation", "[ManifestValidation]")
     {
         // Package Id does not match
         auto installerManifestCopy = v1InstallerManifest;
+        installerManifestCopy.Root = v1InstallerManifest.Root.Clone();
         installerManifestCopy.Root["PackageIdentifier"].SetScalar("Another.Identifier");
         std::vector<YamlManifestInfo> input = { v1VersionManifest, installerManifestCopy, v1DefaultLocaleManifest, v1LocaleManifest };
         REQUIRE_THROWS_MATCHES(YamlParser::ParseManifest(input), ManifestException, ManifestExceptionMatcher("The multi file manifest has inconsistent field values. Field: PackageIdentifier Value: Another.Identifier"));
@@ -565,6 +622,7 @@ TEST_CASE("MultifileManifestInputValidation", "[ManifestValidation]")
     {
         // Package Version does not match
         auto installerManifestCopy = v1InstallerManifest;
+        installerManifestCopy.Root = v1InstallerManifest.Root.Clone();
         installerManifestCopy.Root["PackageVersion"].SetScalar("Another.Version");
         std::vector<YamlManifestInfo> input = { v1VersionManifest, installerManifestCopy, v1DefaultLocaleManifest, v1LocaleManifest };
         REQUIRE_THROWS_MATCHES(YamlParser::ParseManifest(input), ManifestException, ManifestExceptionMatcher("The multi file manifest has inconsistent field values. Field: PackageVersion Value: Another.Version"));
@@ -604,4 +662,84 @@ TEST_CASE("ManifestApplyLocale", "[ManifestValidation]")
     REQUIRE(manifest.CurrentLocalization.Locale == "fr-FR");
     REQUIRE(manifest.CurrentLocalization.Get<Localization::PackageName>() == "fr-FR package name");
     REQUIRE(manifest.CurrentLocalization.Get<Localization::Publisher>() == "es-MX publisher");
-}
\ No newline at end of file
+}
+
+// Measures how many of the good test manifests can be created per second.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("ManifestCreation_Benchmark", "[.][yamlBenchmark]")
+{
+    constexpr size_t iterations = 200;
+
+    std::vector<std::string> manifests;
+    for (const auto& file : std::filesystem::directory_iterator{ TestDataFile(".").GetPath() })
+    {
+        std::string fileName = file.path().filename().u8string();
+        if (fileName.rfind("Manifest-Good", 0) == 0 || fileName == "ManifestV1-Singleton.yaml")
+        {
+            std::ifstream stream{ file.path(), std::ios_base::in | std::ios_base::binary };
+            manifests.emplace_back(ReadEntireStream(stream));
+        }
+    }
+
+    REQUIRE(!manifests.empty());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        for (const auto& manifest : manifests)
+        {
+            YamlParser::Create(manifest);
+        }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    double manifestsPerSecond = duration.count() ? (iterations * manifests.size() * 1000000.0) / duration.count() : 0.0;
+    WARN(manifests.size() << " manifests; " << manifestsPerSecond << " manifests/s");
+}
+
+TEST_CASE("ManifestSchema_CompiledOnce", "[ManifestValidation]")
+{
+    const auto& singletonSchema = YamlParser::GetManifestSchema(ManifestVer{ s_ManifestVersionV1 }, ManifestTypeEnum::Singleton);
+    REQUIRE(&singletonSchema == &YamlParser::GetManifestSchema(ManifestVer{ "1.0.0"sv }, ManifestTypeEnum::Singleton));
+    REQUIRE(&singletonSchema != &YamlParser::GetManifestSchema(ManifestVer{ s_ManifestVersionV1 }, ManifestTypeEnum::Installer));
+
+    // Preview manifests have a single schema for every type
+    REQUIRE(&YamlParser::GetManifestSchema(ManifestVer{ "0.1.0"sv }, ManifestTypeEnum::Preview) ==
+        &YamlParser::GetManifestSchema(ManifestVer{ "0.1.0"sv }, ManifestTypeEnum::Singleton));
+}
+
+TEST_CASE("ManifestSchema_ValidatesYamlAsJson", "[ManifestValidation]")
+{
+    // Empty scalars are null, and a repeated key has its last value, as when manifests were converted to json to be validated
+    YamlManifestInfo manifest;
+    manifest.Root = AppInstaller::YAML::Load("PackageIdentifier:\nPackageVersion: 1.0\nPackageVersion: \"\"\nDefaultLocale: en-US\nManifestType: version\nManifestVersion: 1.0.0\n"sv);
+    manifest.ManifestType = ManifestTypeEnum::Version;
+    manifest.FileName = "ManifestV1-Version.yaml";
+
+    auto errors = YamlParser::ValidateAgainstSchema({ manifest }, ManifestVer{ s_ManifestVersionV1 });
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].Message.find("Error context: <root>[PackageIdentifier] Description: Value type not permitted by 'type' constraint.") != std::string::npos);
+    REQUIRE(errors[0].Message.find("Error context: <root>[PackageVersion] Description: Value type not permitted by 'type' constraint.") != std::string::npos);
+}
+
+// Measures the throughput of validating manifests against the schema, one manifest per call as when reading a source.
+// Not run by default; run with the tag to see the results.
+TEST_CASE("ManifestSchemaValidation_Benchmark", "[.][yamlBenchmark]")
+{
+    constexpr size_t iterations = 500;
+
+    auto singletonManifest = CreateYamlManifestInfo("ManifestV1-Singleton.yaml");
+    singletonManifest.ManifestType = ManifestTypeEnum::Singleton;
+    std::vector<YamlManifestInfo> input = { singletonManifest };
+    ManifestVer manifestVersion{ s_ManifestVersionV1 };
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        REQUIRE(YamlParser::ValidateAgainstSchema(input, manifestVersion).empty());
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    double manifestsPerSecond = duration.count() ? (iterations * 1000000.0) / duration.count() : 0.0;
+    WARN(iterations << " manifests; " << manifestsPerSecond << " manifests/s");
+}
@@ -49,6 +49,14 @@ namespace AppInstaller::Logging
 
         std::atomic_uint32_t s_subExecutionId{ s_RootExecutionId };
 
+        // Takes precedence over s_subExecutionId on the thread that set it; see SubExecutionTelemetryScope.
+        thread_local uint32_t s_threadSubExecutionId = s_RootExecutionId;
+
+        uint32_t GetSubExecutionId()
+        {
+            return s_threadSubExecutionId != s_RootExecutionId ? s_threadSubExecutionId : s_subExecutionId.load();
+        }
+
         constexpr std::wstring_view s_UserProfileReplacement = L"%USERPROFILE%"sv;
 
         void __stdcall wilResultLoggingCallback(const wil::FailureInfo& info) noexcept
@@ -149,7 +157,7 @@ namespace AppInstaller::Logging
 
             AICLI_TraceLoggingWriteActivity(
                 "FailureInfo",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TraceLoggingHResult(failure.hr, "HResult"),
                 AICLI_TraceLoggingWStringView(anonMessage, "Message"),
                 TraceLoggingString(failure.pszModule, "Module"),
@@ -236,7 +244,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "CommandTermination",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TraceLoggingHResult(hr, "HResult"),
                 AICLI_TraceLoggingStringView(file, "File"),
                 TraceLoggingUInt64(static_cast<UINT64>(line), "Line"),
@@ -256,7 +264,7 @@ namespace AppInstaller::Logging
 
             AICLI_TraceLoggingWriteActivity(
                 "Exception",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(commandName, "Command"),
                 AICLI_TraceLoggingStringView(type, "Type"),
                 AICLI_TraceLoggingWStringView(anonMessage, "Message"),
@@ -274,7 +282,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "GetManifest",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TraceLoggingBool(isLocalManifest, "IsManifestLocal"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
                 TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA));
@@ -287,7 +295,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "ManifestFields",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(id, "Id"),
                 AICLI_TraceLoggingStringView(name, "Name"),
                 AICLI_TraceLoggingStringView(version, "Version"),
@@ -304,7 +312,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "NoAppMatch",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
                 TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA));
         }
@@ -318,7 +326,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "MultiAppMatch",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
                 TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA));
         }
@@ -332,7 +340,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "AppFound",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(name, "Name"),
                 AICLI_TraceLoggingStringView(id, "Id"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
@@ -348,7 +356,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "SelectedInstaller",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TraceLoggingInt32(arch, "Arch"),
                 AICLI_TraceLoggingStringView(url, "Url"),
                 AICLI_TraceLoggingStringView(installerType, "InstallerType"),
@@ -381,7 +389,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "SearchRequest",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(type, "Type"),
                 AICLI_TraceLoggingStringView(query, "Query"),
                 AICLI_TraceLoggingStringView(id, "Id"),
@@ -402,7 +410,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "SearchResultCount",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 TraceLoggingUInt64(resultCount, "ResultCount"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
                 TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA));
@@ -421,7 +429,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "HashMismatch",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(id, "Id"),
                 AICLI_TraceLoggingStringView(version, "Version"),
                 AICLI_TraceLoggingStringView(channel, "Channel"),
@@ -446,7 +454,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "InstallerFailure",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(id, "Id"),
                 AICLI_TraceLoggingStringView(version, "Version"),
                 AICLI_TraceLoggingStringView(channel, "Channel"),
@@ -465,7 +473,7 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "UninstallerFailure",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(id, "Id"),
                 AICLI_TraceLoggingStringView(version, "Version"),
                 AICLI_TraceLoggingStringView(type, "Type"),
@@ -503,7 +511,7 @@ namespace AppInstaller::Logging
 
             AICLI_TraceLoggingWriteActivity(
                 "InstallARPChange",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(sourceIdentifier, "SourceIdentifier"),
                 AICLI_TraceLoggingStringView(packageIdentifier, "PackageIdentifier"),
                 AICLI_TraceLoggingStringView(packageVersion, "PackageVersion"),
@@ -538,13 +546,32 @@ namespace AppInstaller::Logging
         {
             AICLI_TraceLoggingWriteActivity(
                 "NonFatalDOError",
-                TraceLoggingUInt32(s_subExecutionId, "SubExecutionId"),
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
                 AICLI_TraceLoggingStringView(url, "Url"),
                 TraceLoggingHResult(hr, "HResult"),
                 TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
         }
     }
 
+    void TelemetryTraceLogger::LogRestResponseCacheSummary(std::string_view sourceName, size_t hits, size_t revalidations, size_t misses, size_t evictions) const noexcept
+    {
+        if (IsTelemetryEnabled())
+        {
+            AICLI_TraceLoggingWriteActivity(
+                "RestResponseCacheSummary",
+                TraceLoggingUInt32(GetSubExecutionId(), "SubExecutionId"),
+                AICLI_TraceLoggingStringView(sourceName, "SourceName"),
+                TraceLoggingUInt64(static_cast<UINT64>(hits), "Hits"),
+                TraceLoggingUInt64(static_cast<UINT64>(revalidations), "Revalidations"),
+                TraceLoggingUInt64(static_cast<UINT64>(misses), "Misses"),
+                TraceLoggingUInt64(static_cast<UINT64>(evictions), "Evictions"),
+                TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+        }
+
+        AICLI_LOG(Repo, Info, << "REST response cache for source '" << sourceName << "': " << hits << " hits, " << revalidations << " revalidations, "
+            << misses << " misses, " << evictions << " evictions");
+    }
+
     bool TelemetryTraceLogger::IsTelemetryEnabled() const noexcept
     {
         return g_IsTelemetryProviderEnabled && m_isSettingEnabled && m_isRuntimeEnabled;
@@ -605,13 +632,33 @@ namespace AppInstaller::Logging
     SubExecutionTelemetryScope::SubExecutionTelemetryScope()
     {
         auto expected = s_RootExecutionId;
-        THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), !s_subExecutionId.compare_exchange_strong(expected, ++m_sessionId),
+        THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_INVALID_STATE),
+            s_threadSubExecutionId != s_RootExecutionId || !s_subExecutionId.compare_exchange_strong(expected, ++m_sessionId),
             "Cannot create a sub execution telemetry session when a previous session exists.");
     }
 
+    SubExecutionTelemetryScope::SubExecutionTelemetryScope(uint32_t subExecutionId) : m_currentThreadOnly(true)
+    {
+        THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), s_threadSubExecutionId != s_RootExecutionId,
+            "Cannot create a sub execution telemetry session when a previous session exists.");
+        s_threadSubExecutionId = subExecutionId;
+    }
+
     SubExecutionTelemetryScope::~SubExecutionTelemetryScope()
     {
-        s_subExecutionId = s_RootExecutionId;
+        if (m_currentThreadOnly)
+        {
+            s_threadSubExecutionId = s_RootExecutionId;
+        }
+        else
+        {
+            s_subExecutionId = s_RootExecutionId;
+        }
+    }
+
+    uint32_t SubExecutionTelemetryScope::CreateSubExecutionId()
+    {
+        return ++m_sessionId;
     }
 
 #ifndef AICLI_DISABLE_TEST_HOOKS
@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "DownloadPipeline.h"
+
+namespace AppInstaller::Utility
+{
+    DownloadPipeline::DownloadPipeline(WriteFunction write, SHA256* hashEngine, size_t bufferCount, size_t bufferSize) :
+        m_write(std::move(write)), m_hashEngine(hashEngine), m_bufferSize(bufferSize)
+    {
+        THROW_HR_IF(E_INVALIDARG, bufferCount == 0 || bufferSize == 0);
+
+        m_chunks.resize(bufferCount);
+        for (auto& chunk : m_chunks)
+        {
+            chunk.Data = std::make_unique<BYTE[]>(bufferSize);
+            m_free.push_back(&chunk);
+        }
+
+        if (bufferCount > 1)
+        {
+            // Stop any stage that started if a later one cannot
+            auto stopOnFailure = wil::scope_exit([this]() { Stop(); });
+
+            m_threads.emplace_back([this]() { RunStage(Stage::Write); });
+
+            if (m_hashEngine)
+            {
+                m_threads.emplace_back([this]() { RunStage(Stage::Hash); });
+            }
+
+            stopOnFailure.release();
+        }
+    }
+
+    DownloadPipeline::~DownloadPipeline()
+    {
+        Flush();
+        Stop();
+    }
+
+    BYTE* DownloadPipeline::AcquireBuffer()
+    {
+        THROW_HR_IF(E_UNEXPECTED, m_acquired != nullptr);
+
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        m_changed.wait(lock, [this]() { return !m_free.empty() || m_error; });
+
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+
+        m_acquired = m_free.front();
+        m_free.pop_front();
+        return m_acquired->Data.get();
+    }
+
+    void DownloadPipeline::Submit(size_t size)
+    {
+        THROW_HR_IF(E_UNEXPECTED, m_acquired == nullptr);
+        THROW_HR_IF(E_INVALIDARG, size > m_bufferSize);
+
+        Chunk* chunk = std::exchange(m_acquired, nullptr);
+        chunk->Size = size;
+
+        if (m_threads.empty())
+        {
+            auto releaseChunk = wil::scope_exit([&]()
+                {
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    m_free.push_back(chunk);
+                });
+
+            Process(Stage::Hash, *chunk);
+            Process(Stage::Write, *chunk);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+
+            chunk->PendingStages = 1;
+            m_writeQueue.push_back(chunk);
+
+            if (m_hashEngine)
+            {
+                ++chunk->PendingStages;
+                m_hashQueue.push_back(chunk);
+            }
+
+            ++m_inFlight;
+        }
+
+        m_changed.notify_all();
+    }
+
+    void DownloadPipeline::Flush()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        m_changed.wait(lock, [this]() { return m_inFlight == 0; });
+    }
+
+    void DownloadPipeline::Complete()
+    {
+        Flush();
+
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+    void DownloadPipeline::Process(Stage stage, const Chunk& chunk)
+    {
+        if (stage == Stage::Hash)
+        {
+            if (m_hashEngine)
+            {
+                m_hashEngine->Add(chunk.Data.get(), chunk.Size);
+            }
+        }
+        else
+        {
+            m_write(chunk.Data.get(), chunk.Size);
+        }
+    }
+
+    void DownloadPipeline::RunStage(Stage stage)
+    {
+        std::deque<Chunk*>& queue = (stage == Stage::Hash ? m_hashQueue : m_writeQueue);
+
+        for (;;)
+        {
+            Chunk* chunk = nullptr;
+            bool failed = false;
+
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_changed.wait(lock, [&]() { return !queue.empty() || m_stopping; });
+
+                if (queue.empty())
+                {
+                    return;
+                }
+
+                chunk = queue.front();
+                queue.pop_front();
+                failed = static_cast<bool>(m_error);
+            }
+
+            // After a failure the remaining chunks are only released, so that waiting for them ends
+            if (!failed)
+            {
+                try
+                {
+                    Process(stage, *chunk);
+                }
+                catch (...)
+                {
+                    LOG_CAUGHT_EXCEPTION();
+
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    if (!m_error)
+                    {
+                        m_error = std::current_exception();
+                    }
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                if (--chunk->PendingStages == 0)
+                {
+                    m_free.push_back(chunk);
+                    --m_inFlight;
+                }
+            }
+
+            m_changed.notify_all();
+        }
+    }
+
+    void DownloadPipeline::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            m_stopping = true;
+        }
+
+        m_changed.notify_all();
+
+        for (auto& thread : m_threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerSHA256.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AppInstaller::Utility
+{
+    // Overlaps the stages of a download. The caller reads each chunk from the network into a buffer, while the
+    // chunks before it are hashed and written on their own threads. The buffers come from a small pool, so when
+    // hashing or writing falls behind the reader waits for a buffer rather than using more memory.
+    struct DownloadPipeline
+    {
+        // Writes a chunk to the destination; always called in order, on a single thread.
+        using WriteFunction = std::function<void(const BYTE* data, size_t size)>;
+
+        constexpr static size_t DefaultBufferCount = 3;
+        constexpr static size_t DefaultBufferSize = 1024 * 1024; // 1MB
+
+        // hashEngine: Optional. Given every chunk, in order.
+        // bufferCount: The number of buffers in the pool. With a single buffer there is nothing to overlap, so every stage runs on the calling thread.
+        DownloadPipeline(WriteFunction write, SHA256* hashEngine, size_t bufferCount = DefaultBufferCount, size_t bufferSize = DefaultBufferSize);
+
+        DownloadPipeline(const DownloadPipeline&) = delete;
+        DownloadPipeline& operator=(const DownloadPipeline&) = delete;
+
+        DownloadPipeline(DownloadPipeline&&) = delete;
+        DownloadPipeline& operator=(DownloadPipeline&&) = delete;
+
+        // Waits for the submitted chunks to be processed.
+        ~DownloadPipeline();
+
+        // Gets an unused buffer to read the next chunk into, waiting for one if all are in use.
+        // Throws the error from hashing or writing, if either has failed.
+        BYTE* AcquireBuffer();
+
+        // Gets the size of every buffer.
+        size_t GetBufferSize() const { return m_bufferSize; }
+
+        // Passes the chunk in the most recently acquired buffer on to be hashed and written.
+        void Submit(size_t size);
+
+        // Waits until every submitted chunk has been hashed and written, or abandoned after an error. Does not throw.
+        void Flush();
+
+        // Waits until every submitted chunk has been hashed and written, throwing the error from hashing or writing, if either has failed.
+        void Complete();
+
+    private:
+        enum class Stage
+        {
+            Hash,
+            Write,
+        };
+
+        struct Chunk
+        {
+            std::unique_ptr<BYTE[]> Data;
+            size_t Size = 0;
+            size_t PendingStages = 0;
+        };
+
+        void Process(Stage stage, const Chunk& chunk);
+        void RunStage(Stage stage);
+        void Stop();
+
+        WriteFunction m_write;
+        SHA256* m_hashEngine = nullptr;
+        size_t m_bufferSize = 0;
+
+        std::vector<Chunk> m_chunks;
+        Chunk* m_acquired = nullptr;
+
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::deque<Chunk*> m_free;
+        std::deque<Chunk*> m_hashQueue;
+        std::deque<Chunk*> m_writeQueue;
+        size_t m_inFlight = 0;
+        bool m_stopping = false;
+        std::exception_ptr m_error;
+
+        std::vector<std::thread> m_threads;
+    };
+}
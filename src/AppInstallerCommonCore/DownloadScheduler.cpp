@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/AppInstallerLogging.h"
+#include "Public/winget/DownloadScheduler.h"
+#include "Public/winget/UserSettings.h"
+
+#include <cmath>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace AppInstaller::Utility
+{
+    namespace
+    {
+        // How often waiting is interrupted to check for cancellation
+        constexpr std::chrono::milliseconds s_CancellationCheckInterval = 100ms;
+
+        std::string_view ToString(DownloadType type)
+        {
+            switch (type)
+            {
+            case DownloadType::Index: return "Index";
+            case DownloadType::Manifest: return "Manifest";
+            case DownloadType::WinGetUtil: return "WinGetUtil";
+            case DownloadType::Installer: return "Installer";
+            }
+
+            return "Unknown";
+        }
+
+        DownloadScheduler::Options GetOptionsFromUserSettings()
+        {
+            DownloadScheduler::Options result;
+            result.MaxConcurrentDownloads = Settings::User().Get<Settings::Setting::NetworkMaxConcurrentDownloads>();
+            result.MaxBytesPerSecond = static_cast<uint64_t>(Settings::User().Get<Settings::Setting::NetworkMaxDownloadRateInKBps>()) * 1024;
+            return result;
+        }
+    }
+
+    uint64_t DownloadMetrics::GetBytesPerSecond() const
+    {
+        if (Bytes == 0)
+        {
+            return 0;
+        }
+
+        // Treat anything faster than the clock can measure as taking a millisecond
+        auto milliseconds = std::max<int64_t>(TransferTime.count(), 1);
+        return Bytes * 1000 / static_cast<uint64_t>(milliseconds);
+    }
+
+    DownloadScheduler::Ticket::Ticket(DownloadScheduler& scheduler, DownloadType type, IProgressCallback& progress, std::chrono::milliseconds queueTime) :
+        m_scheduler(scheduler), m_type(type), m_progress(progress), m_queueTime(queueTime), m_start(std::chrono::steady_clock::now()) {}
+
+    DownloadScheduler::Ticket::~Ticket()
+    {
+        DownloadMetrics metrics = GetMetrics();
+        AICLI_LOG(Core, Info, << ToString(m_type) << " download finished; queued " << metrics.QueueTime.count() << "ms, transferred " << metrics.Bytes <<
+            " bytes in " << metrics.TransferTime.count() << "ms (" << metrics.GetBytesPerSecond() << " bytes/s), throttled " << metrics.ThrottledTime.count() << "ms");
+
+        m_scheduler.Release();
+    }
+
+    void DownloadScheduler::Ticket::OnBytesReceived(size_t bytes)
+    {
+        m_bytes += bytes;
+
+        std::chrono::milliseconds wait = m_scheduler.Reserve(bytes);
+        if (wait <= 0ms)
+        {
+            return;
+        }
+
+        // Wait in short steps so that cancellation is not delayed by a low limit
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + wait;
+        for (auto now = start; now < end && !m_progress.IsCancelled(); now = std::chrono::steady_clock::now())
+        {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(end - now, s_CancellationCheckInterval));
+        }
+
+        m_throttledMilliseconds += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    DownloadMetrics DownloadScheduler::Ticket::GetMetrics() const
+    {
+        DownloadMetrics result;
+        result.QueueTime = m_queueTime;
+        result.TransferTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start);
+        result.ThrottledTime = std::chrono::milliseconds{ m_throttledMilliseconds.load() };
+        result.Bytes = m_bytes;
+        return result;
+    }
+
+    DownloadScheduler::DownloadScheduler(Options options) :
+        m_options(options), m_tokens(static_cast<double>(options.MaxBytesPerSecond)), m_lastRefill(std::chrono::steady_clock::now()) {}
+
+    DownloadScheduler& DownloadScheduler::Instance()
+    {
+        static DownloadScheduler s_instance{ GetOptionsFromUserSettings() };
+        return s_instance;
+    }
+
+    uint32_t DownloadScheduler::GetPriority(DownloadType type)
+    {
+        switch (type)
+        {
+        case DownloadType::Manifest: return 3;
+        case DownloadType::Index: return 2;
+        case DownloadType::WinGetUtil: return 1;
+        case DownloadType::Installer: return 0;
+        }
+
+        return 0;
+    }
+
+    std::unique_ptr<DownloadScheduler::Ticket> DownloadScheduler::Acquire(DownloadType type, IProgressCallback& progress)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock{ m_mutex };
+
+        Waiter self{ GetPriority(type), m_nextSequence++ };
+        m_waiting.push_back(self);
+
+        auto removeSelf = [&]()
+        {
+            m_waiting.erase(std::find_if(m_waiting.begin(), m_waiting.end(), [&](const Waiter& w) { return w.Sequence == self.Sequence; }));
+        };
+
+        while (!CanStart(self))
+        {
+            if (progress.IsCancelled())
+            {
+                removeSelf();
+                lock.unlock();
+                m_changed.notify_all();
+                return {};
+            }
+
+            m_changed.wait_for(lock, s_CancellationCheckInterval);
+        }
+
+        removeSelf();
+        ++m_running;
+        lock.unlock();
+
+        // Another waiter may be next in line if there are still slots
+        m_changed.notify_all();
+
+        auto queueTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        if (queueTime > 0ms)
+        {
+            AICLI_LOG(Core, Verbose, << ToString(type) << " download waited " << queueTime.count() << "ms to start");
+        }
+
+        return std::unique_ptr<Ticket>{ new Ticket{ *this, type, progress, queueTime } };
+    }
+
+    size_t DownloadScheduler::GetRunningCount() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_running;
+    }
+
+    size_t DownloadScheduler::GetWaitingCount() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_waiting.size();
+    }
+
+    bool DownloadScheduler::CanStart(const Waiter& waiter) const
+    {
+        if (m_options.MaxConcurrentDownloads != 0 && m_running >= m_options.MaxConcurrentDownloads)
+        {
+            return false;
+        }
+
+        return std::none_of(m_waiting.begin(), m_waiting.end(), [&](const Waiter& other)
+            {
+                return other.Priority > waiter.Priority || (other.Priority == waiter.Priority && other.Sequence < waiter.Sequence);
+            });
+    }
+
+    void DownloadScheduler::Release()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            --m_running;
+        }
+
+        m_changed.notify_all();
+    }
+
+    std::chrono::milliseconds DownloadScheduler::Reserve(size_t bytes)
+    {
+        if (m_options.MaxBytesPerSecond == 0)
+        {
+            return 0ms;
+        }
+
+        double rate = static_cast<double>(m_options.MaxBytesPerSecond);
+
+        std::lock_guard<std::mutex> lock{ m_bucketMutex };
+
+        // The bucket refills at the limit, and holds at most a second of data so that an idle period does not allow a long burst
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed = now - m_lastRefill;
+        m_lastRefill = now;
+        m_tokens = std::min(rate, m_tokens + elapsed.count() * rate);
+
+        // Data has already been received when it is reported, so the bucket may go into debt; the wait pays it back
+        m_tokens -= static_cast<double>(bytes);
+        if (m_tokens >= 0)
+        {
+            return 0ms;
+        }
+
+        return std::chrono::milliseconds{ static_cast<int64_t>(std::ceil(-m_tokens / rate * 1000)) };
+    }
+}
@@ -8,8 +8,12 @@
 #include "Public/AppInstallerStrings.h"
 #include "Public/AppInstallerLogging.h"
 #include "Public/AppInstallerTelemetry.h"
+#include "Public/winget/DownloadScheduler.h"
 #include "Public/winget/UserSettings.h"
 #include "DODownloader.h"
+#include "DownloadPipeline.h"
+#include "ResumableDownloader.h"
+#include "SegmentedDownloader.h"
 
 using namespace AppInstaller::Runtime;
 using namespace AppInstaller::Settings;
@@ -20,7 +24,8 @@ namespace AppInstaller::Utility
         const std::string& url,
         std::ostream& dest,
         IProgressCallback& progress,
-        bool computeHash)
+        bool computeHash,
+        DownloadScheduler::Ticket* ticket)
     {
         AICLI_LOG(Core, Info, << "WinINet downloading from url: " << url);
 
@@ -74,8 +79,12 @@ namespace AppInstaller::Utility
         // Setup hash engine
         SHA256 hashEngine;
 
-        const int bufferSize = 1024 * 1024; // 1MB
-        auto buffer = std::make_unique<BYTE[]>(bufferSize);
+        // Each chunk is hashed and written while the next one is read, unless the response fits in a single chunk
+        size_t bufferCount = (contentLength > 0 && static_cast<ULONGLONG>(contentLength) <= DownloadPipeline::DefaultBufferSize) ? 1 : DownloadPipeline::DefaultBufferCount;
+        DownloadPipeline pipeline{
+            [&dest](const BYTE* data, size_t size) { dest.write(reinterpret_cast<const char*>(data), size); },
+            computeHash ? &hashEngine : nullptr,
+            bufferCount };
 
         BOOL readSuccess = true;
         DWORD bytesRead = 0;
@@ -89,17 +98,18 @@ namespace AppInstaller::Utility
                 return {};
             }
 
-            readSuccess = InternetReadFile(urlFile.get(), buffer.get(), bufferSize, &bytesRead);
+            BYTE* buffer = pipeline.AcquireBuffer();
+            readSuccess = InternetReadFile(urlFile.get(), buffer, static_cast<DWORD>(pipeline.GetBufferSize()), &bytesRead);
 
             THROW_LAST_ERROR_IF_MSG(!readSuccess, "InternetReadFile() failed.");
 
-            if (computeHash)
+            pipeline.Submit(bytesRead);
+
+            if (ticket)
             {
-                hashEngine.Add(buffer.get(), bytesRead);
+                ticket->OnBytesReceived(bytesRead);
             }
 
-            dest.write((char*)buffer.get(), bytesRead);
-
             bytesDownloaded += bytesRead;
 
             if (bytesRead != 0)
@@ -109,6 +119,7 @@ namespace AppInstaller::Utility
 
         } while (bytesRead != 0);
 
+        pipeline.Complete();
         dest.flush();
 
         // Check download size matches if content length is provided in response header
@@ -132,13 +143,21 @@ namespace AppInstaller::Utility
     std::optional<std::vector<BYTE>> DownloadToStream(
         const std::string& url,
         std::ostream& dest,
-        DownloadType,
+        DownloadType type,
         IProgressCallback& progress,
         bool computeHash,
         std::optional<DownloadInfo>)
     {
         THROW_HR_IF(E_INVALIDARG, url.empty());
-        return WinINetDownloadToStream(url, dest, progress, computeHash);
+
+        auto ticket = DownloadScheduler::Instance().Acquire(type, progress);
+        if (!ticket)
+        {
+            AICLI_LOG(Core, Info, << "Download cancelled while waiting to start.");
+            return {};
+        }
+
+        return WinINetDownloadToStream(url, dest, progress, computeHash, ticket.get());
     }
 
     std::optional<std::vector<BYTE>> Download(
@@ -156,6 +175,14 @@ namespace AppInstaller::Utility
 
         std::filesystem::create_directories(dest.parent_path());
 
+        // Every download waits for its turn, and then shares the bandwidth limit with the others that are running
+        auto ticket = DownloadScheduler::Instance().Acquire(type, progress);
+        if (!ticket)
+        {
+            AICLI_LOG(Core, Info, << "Download cancelled while waiting to start.");
+            return {};
+        }
+
         // Only Installers should be downloaded with DO currently, as:
         //  - Index :: Constantly changing blob at same location is not what DO is for
         //  - Manifest :: DO overhead is not needed for small files
@@ -165,6 +192,18 @@ namespace AppInstaller::Utility
             // Determine whether to try DO first or not, as this is the only choice currently supported.
             InstallerDownloader setting = User().Get<Setting::NetworkDownloader>();
 
+            if (setting == InstallerDownloader::Segmented)
+            {
+                std::ofstream emptyDestFile(dest);
+                emptyDestFile.close();
+                ApplyMotwIfApplicable(dest, URLZONE_INTERNET);
+
+                // The file is written in place, so the motw applied to it is kept.
+                SegmentedDownloadOptions options;
+                options.SegmentCount = User().Get<Setting::NetworkDownloadSegmentCount>();
+                return SegmentedDownload(url, dest, progress, computeHash, options, ticket.get());
+            }
+
             if (setting == InstallerDownloader::Default ||
                 setting == InstallerDownloader::DeliveryOptimization)
             {
@@ -203,6 +242,9 @@ namespace AppInstaller::Utility
                     std::filesystem::remove(dest);
                 }
             }
+
+            // Installers are large enough that an interrupted download is worth continuing rather than starting over.
+            return ResumableDownload(url, dest, progress, computeHash, ticket.get());
         }
 
         std::ofstream emptyDestFile(dest);
@@ -212,7 +254,7 @@ namespace AppInstaller::Utility
         // Use std::ofstream::app to append to previous empty file so that it will not
         // create a new file and clear motw.
         std::ofstream outfile(dest, std::ofstream::binary | std::ofstream::app);
-        return WinINetDownloadToStream(url, outfile, progress, computeHash);
+        return WinINetDownloadToStream(url, outfile, progress, computeHash, ticket.get());
     }
 
     using namespace std::string_view_literals;
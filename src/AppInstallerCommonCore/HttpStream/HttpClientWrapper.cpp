@@ -67,6 +67,17 @@ namespace AppInstaller::Utility::HttpStream
             response.Content().Headers().Lookup(L"Content-Type")
             : L"";
 
+        // Keep the validators so that the cached pages of a changed file are not used
+        if (response.Headers().HasKey(L"ETag"))
+        {
+            m_etagHeader = response.Headers().Lookup(L"ETag");
+        }
+
+        if (response.Content().Headers().HasKey(L"Last-Modified"))
+        {
+            m_lastModifiedHeader = response.Content().Headers().Lookup(L"Last-Modified");
+        }
+
         // If the size wasn't resolved try with a GET 0-0 request
         if (m_sizeInBytes == 0)
         {
@@ -91,12 +102,14 @@ namespace AppInstaller::Utility::HttpStream
         HttpRequestMessage request(HttpMethod::Get(), m_requestUri);
         request.Headers().Append(L"Range", rangeHeaderValue);
 
-        if (!Utility::IsEmptyOrWhitespace(m_etagHeader))
+        // If-Match uses the strong comparison, which a weak ETag never passes, so only a strong one is sent.
+        // The server ignores If-Unmodified-Since when there is an If-Match.
+        bool hasStrongETag = !Utility::IsEmptyOrWhitespace(m_etagHeader) && m_etagHeader.rfind(L"W/", 0) != 0;
+        if (hasStrongETag)
         {
             request.Headers().Append(L"If-Match", m_etagHeader);
         }
-
-        if (!Utility::IsEmptyOrWhitespace(m_lastModifiedHeader))
+        else if (!Utility::IsEmptyOrWhitespace(m_lastModifiedHeader))
         {
             request.Headers().Append(L"If-Unmodified-Since", m_lastModifiedHeader);
         }
@@ -104,6 +117,13 @@ namespace AppInstaller::Utility::HttpStream
         HttpResponseMessage response = co_await m_httpClient.SendRequestAsync(request, HttpCompletionOption::ResponseHeadersRead);
         HttpContentHeaderCollection contentHeaders = response.Content().Headers();
 
+        // The file has changed since the first request, so the ranges already read are of a different version of it.
+        // This is reported as an HTTP error rather than a lack of range support, so that callers download the whole file
+        // again without conditions instead of mixing the versions.
+        THROW_HR_IF(
+            MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, HttpStatusCode::PreconditionFailed),
+            response.StatusCode() == HttpStatusCode::PreconditionFailed);
+
         if (response.StatusCode() != HttpStatusCode::PartialContent && startPosition != 0)
         {
             // throw HRESULT used for range-request error
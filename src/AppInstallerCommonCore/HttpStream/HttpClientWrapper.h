@@ -13,12 +13,14 @@ namespace AppInstaller::Utility::HttpStream
     public:
         static std::future<std::shared_ptr<HttpClientWrapper>> CreateAsync(const winrt::Windows::Foundation::Uri& uri);
 
-        std::future<winrt::Windows::Storage::Streams::IBuffer> DownloadRangeAsync(
+        virtual ~HttpClientWrapper() = default;
+
+        virtual std::future<winrt::Windows::Storage::Streams::IBuffer> DownloadRangeAsync(
             const ULONG64 startPosition,
             const UINT32 requestedSizeInBytes,
             const winrt::Windows::Storage::Streams::InputStreamOptions& options);
 
-        unsigned long long GetFullFileSize()
+        virtual unsigned long long GetFullFileSize()
         {
             return m_sizeInBytes;
         }
@@ -33,6 +35,16 @@ namespace AppInstaller::Utility::HttpStream
             return m_contentType;
         }
 
+        std::wstring GetETag()
+        {
+            return m_etagHeader;
+        }
+
+        std::wstring GetLastModified()
+        {
+            return m_lastModifiedHeader;
+        }
+
     private:
         winrt::Windows::Web::Http::HttpClient m_httpClient;
         winrt::Windows::Foundation::Uri m_requestUri = nullptr;
@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "pch.h"
+#include "Public/AppInstallerLogging.h"
+#include "Public/AppInstallerRuntime.h"
+#include "Public/AppInstallerSHA256.h"
+#include "Public/AppInstallerStrings.h"
+#include "Public/winget/UserSettings.h"
+#include "HttpDiskCache.h"
+
+#include <map>
+
+using namespace std::string_view_literals;
+
+// Note: this class is used by the HttpRandomAccessStream which is passed to the AppxPackaging COM API
+// All exceptions thrown across dll boundaries should be WinRT exception not custom exceptions.
+// Nothing is thrown from here; a page that cannot be read from or written to disk is simply downloaded.
+namespace AppInstaller::Utility::HttpStream
+{
+    namespace
+    {
+        constexpr std::string_view s_CacheDirectoryName = "PackageStreamCache"sv;
+        constexpr std::string_view s_PageExtension = ".page"sv;
+
+        // The total size of the pages in each cache directory, once it has been read. It is shared by the caches of every
+        // stream in the process and kept up to date by their writes, so the directory is only walked again when it is too large.
+        struct DirectorySizes
+        {
+            std::mutex Lock;
+            std::map<std::filesystem::path, uint64_t> Totals;
+        };
+
+        DirectorySizes& GetDirectorySizes()
+        {
+            static DirectorySizes s_directorySizes;
+            return s_directorySizes;
+        }
+    }
+
+    HttpDiskCache::HttpDiskCache(std::filesystem::path directory, uint64_t maxSizeInBytes, std::string key, ULONG64 fileSize) :
+        m_directory(std::move(directory)), m_maxSizeInBytes(maxSizeInBytes), m_key(std::move(key)), m_fileSize(fileSize) {}
+
+    HttpDiskCache::~HttpDiskCache()
+    {
+        AICLI_LOG(Core, Verbose, << "Package stream cache read " << m_pagesRead << " pages and stored " << m_pagesWritten << " pages");
+
+        if (m_pagesWritten != 0)
+        {
+            try
+            {
+                EnforceMaximumSize();
+            }
+            CATCH_LOG();
+        }
+    }
+
+    std::unique_ptr<HttpDiskCache> HttpDiskCache::Create(const winrt::Windows::Foundation::Uri& uri, HttpClientWrapper& httpClientWrapper)
+    {
+        uint64_t maxSizeInBytes = static_cast<uint64_t>(Settings::User().Get<Settings::Setting::NetworkPackageStreamCacheMaxSizeInMB>()) << 20;
+        if (maxSizeInBytes == 0)
+        {
+            return {};
+        }
+
+        std::string key = GetKey(
+            Utility::ConvertToUTF8(uri.AbsoluteUri()),
+            httpClientWrapper.GetETag(),
+            httpClientWrapper.GetLastModified(),
+            httpClientWrapper.GetFullFileSize());
+
+        if (key.empty())
+        {
+            return {};
+        }
+
+        return std::make_unique<HttpDiskCache>(GetDefaultDirectory(), maxSizeInBytes, std::move(key), httpClientWrapper.GetFullFileSize());
+    }
+
+    std::filesystem::path HttpDiskCache::GetDefaultDirectory()
+    {
+        return Runtime::GetPathTo(Runtime::PathName::LocalState) / s_CacheDirectoryName;
+    }
+
+    std::string HttpDiskCache::GetKey(std::string_view uri, std::wstring_view etag, std::wstring_view lastModified, ULONG64 fileSize)
+    {
+        // A weak ETag only promises equivalent contents, not the same bytes
+        if (etag.rfind(L"W/", 0) == 0)
+        {
+            etag = {};
+        }
+
+        if (fileSize == 0 || (Utility::IsEmptyOrWhitespace(etag) && Utility::IsEmptyOrWhitespace(lastModified)))
+        {
+            return {};
+        }
+
+        std::ostringstream stream;
+        stream << uri << '\n' << Utility::ConvertToUTF8(etag) << '\n' << Utility::ConvertToUTF8(lastModified) << '\n' << fileSize;
+
+        std::string keyData = stream.str();
+        auto hash = SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(keyData.c_str()), static_cast<uint32_t>(keyData.size()));
+        return SHA256::ConvertToString(hash);
+    }
+
+    std::optional<std::vector<BYTE>> HttpDiskCache::ReadPage(ULONG64 pageOffset, UINT32 pageSize)
+    {
+        if (pageOffset >= m_fileSize)
+        {
+            return {};
+        }
+
+        try
+        {
+            std::filesystem::path pagePath = GetPagePath(pageOffset);
+
+            std::ifstream stream{ pagePath, std::ios_base::in | std::ios_base::binary };
+            if (!stream)
+            {
+                return {};
+            }
+
+            // Every page is full except the one that ends the file
+            size_t expectedSize = static_cast<size_t>(std::min<ULONG64>(pageSize, m_fileSize - pageOffset));
+
+            std::vector<BYTE> result(expectedSize);
+            stream.read(reinterpret_cast<char*>(result.data()), expectedSize);
+            if (static_cast<size_t>(stream.gcount()) != expectedSize || stream.peek() != std::ifstream::traits_type::eof())
+            {
+                AICLI_LOG(Core, Warning, << "Ignoring package stream cache page of unexpected size: " << pagePath);
+                return {};
+            }
+
+            stream.close();
+
+            // Mark the page as recently used so that it is the last to be evicted
+            std::error_code error;
+            std::filesystem::last_write_time(pagePath, std::filesystem::file_time_type::clock::now(), error);
+
+            ++m_pagesRead;
+            return result;
+        }
+        CATCH_LOG();
+
+        return {};
+    }
+
+    void HttpDiskCache::WritePage(ULONG64 pageOffset, const BYTE* data, UINT32 size)
+    {
+        try
+        {
+            std::filesystem::create_directories(m_directory);
+
+            // The temporary name is unique to this process so that concurrent readers of the same file do not collide
+            std::filesystem::path pagePath = GetPagePath(pageOffset);
+            std::filesystem::path tempPath = pagePath;
+            tempPath += "." + std::to_string(GetCurrentProcessId());
+            tempPath += ".tmp";
+
+            {
+                std::ofstream stream{ tempPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+                THROW_LAST_ERROR_IF(!stream);
+                stream.write(reinterpret_cast<const char*>(data), size);
+                stream.flush();
+                THROW_LAST_ERROR_IF(!stream);
+            }
+
+            std::error_code error;
+            uint64_t previousSize = std::filesystem::file_size(pagePath, error);
+            if (error)
+            {
+                previousSize = 0;
+            }
+
+            // Publish the page in a single step so that other processes never observe a partially written page
+            std::filesystem::rename(tempPath, pagePath, error);
+            if (error)
+            {
+                std::filesystem::remove(tempPath, error);
+                return;
+            }
+
+            ++m_pagesWritten;
+
+            DirectorySizes& directorySizes = GetDirectorySizes();
+            std::lock_guard<std::mutex> lock{ directorySizes.Lock };
+
+            auto itr = directorySizes.Totals.find(m_directory);
+            if (itr != directorySizes.Totals.end())
+            {
+                uint64_t totalSize = itr->second + size;
+                itr->second = totalSize > previousSize ? totalSize - previousSize : 0;
+            }
+        }
+        CATCH_LOG();
+    }
+
+    std::filesystem::path HttpDiskCache::GetPagePath(ULONG64 pageOffset) const
+    {
+        std::filesystem::path result = m_directory / (m_key + '-' + std::to_string(pageOffset));
+        result += s_PageExtension;
+        return result;
+    }
+
+    void HttpDiskCache::EnforceMaximumSize()
+    {
+        struct FileInfo
+        {
+            std::filesystem::path Path;
+            std::filesystem::file_time_type LastUsed;
+            uint64_t Size;
+        };
+
+        DirectorySizes& directorySizes = GetDirectorySizes();
+        std::lock_guard<std::mutex> lock{ directorySizes.Lock };
+
+        auto itr = directorySizes.Totals.find(m_directory);
+        if (itr != directorySizes.Totals.end() && itr->second <= m_maxSizeInBytes)
+        {
+            return;
+        }
+
+        std::vector<FileInfo> files;
+        uint64_t totalSize = 0;
+
+        for (const auto& file : std::filesystem::directory_iterator{ m_directory })
+        {
+            if (file.is_regular_file() && file.path().extension() == s_PageExtension)
+            {
+                files.emplace_back(FileInfo{ file.path(), file.last_write_time(), file.file_size() });
+                totalSize += files.back().Size;
+            }
+        }
+
+        // Other processes share the directory, so the walk also corrects any drift in the running total
+        directorySizes.Totals[m_directory] = totalSize;
+
+        if (totalSize <= m_maxSizeInBytes)
+        {
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.LastUsed < b.LastUsed; });
+
+        size_t evictions = 0;
+        for (const auto& file : files)
+        {
+            if (totalSize <= m_maxSizeInBytes)
+            {
+                break;
+            }
+
+            std::error_code error;
+            if (std::filesystem::remove(file.Path, error))
+            {
+                totalSize -= file.Size;
+                ++evictions;
+            }
+        }
+
+        directorySizes.Totals[m_directory] = totalSize;
+
+        AICLI_LOG(Core, Verbose, << "Evicted " << evictions << " pages from the package stream cache");
+    }
+}
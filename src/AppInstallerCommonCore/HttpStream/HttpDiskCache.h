@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "HttpClientWrapper.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace AppInstaller::Utility::HttpStream
+{
+    // An on-disk cache of the pages read from a file by the HttpLocalCache, shared by every process.
+    // The pages are keyed by the URL of the file and the validators the server returned for it, so a file that
+    // changes on the server is read again rather than mixed with pages of the old one. The cache is kept within its
+    // maximum size by removing the least recently used pages. Failures to read or write the cache are logged and
+    // otherwise ignored; the cache is only an optimization.
+    class HttpDiskCache
+    {
+    public:
+        HttpDiskCache(std::filesystem::path directory, uint64_t maxSizeInBytes, std::string key, ULONG64 fileSize);
+
+        HttpDiskCache(const HttpDiskCache&) = delete;
+        HttpDiskCache& operator=(const HttpDiskCache&) = delete;
+
+        HttpDiskCache(HttpDiskCache&&) = delete;
+        HttpDiskCache& operator=(HttpDiskCache&&) = delete;
+
+        // Removes the least recently used pages if the cache has grown too large.
+        ~HttpDiskCache();
+
+        // Creates the cache for the file the client reads, as configured in the user settings.
+        // Returns null if the cache is disabled or the server gave nothing to tell whether the file has changed.
+        static std::unique_ptr<HttpDiskCache> Create(const winrt::Windows::Foundation::Uri& uri, HttpClientWrapper& httpClientWrapper);
+
+        // Gets the directory where pages are cached.
+        static std::filesystem::path GetDefaultDirectory();
+
+        // Gets the key identifying a version of a file, or an empty string if there is no strong validator to tell versions apart.
+        static std::string GetKey(std::string_view uri, std::wstring_view etag, std::wstring_view lastModified, ULONG64 fileSize);
+
+        // Gets the contents of the page at the given offset, if it is cached.
+        std::optional<std::vector<BYTE>> ReadPage(ULONG64 pageOffset, UINT32 pageSize);
+
+        // Stores the contents of the page at the given offset.
+        void WritePage(ULONG64 pageOffset, const BYTE* data, UINT32 size);
+
+    private:
+        std::filesystem::path GetPagePath(ULONG64 pageOffset) const;
+        void EnforceMaximumSize();
+
+        std::filesystem::path m_directory;
+        uint64_t m_maxSizeInBytes = 0;
+        std::string m_key;
+        ULONG64 m_fileSize = 0;
+
+        size_t m_pagesRead = 0;
+        size_t m_pagesWritten = 0;
+    };
+}
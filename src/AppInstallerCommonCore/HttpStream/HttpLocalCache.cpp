@@ -6,26 +6,40 @@
 
 using namespace Windows::Storage::Streams;
 using namespace winrt::Windows::Storage::Streams;
-using namespace winrt::Windows::Security::Cryptography;
 
 // Note: this class is used by the HttpRandomAccessStream which is passed to the AppxPackaging COM API
 // All exceptions thrown across dll boundaries should be WinRT exception not custom exceptions.
 // The HRESULTs will be mapped to UI error code by the appropriate component
 namespace AppInstaller::Utility::HttpStream
 {
+    namespace
+    {
+        // Gets the bytes backing the given buffer.
+        byte* GetBufferBytes(const IBuffer& buffer)
+        {
+            Microsoft::WRL::ComPtr<IBufferByteAccess> bufferByteAccess;
+            ::IInspectable* bufferAbi = (::IInspectable*)winrt::get_abi(buffer);
+            winrt::check_hresult(bufferAbi->QueryInterface(IID_PPV_ARGS(&bufferByteAccess)));
+            byte* byteBuffer = nullptr;
+            winrt::check_hresult(bufferByteAccess->Buffer(&byteBuffer));
+            return byteBuffer;
+        }
+    }
+
     std::future<IBuffer> HttpLocalCache::ReadFromCacheAndDownloadIfNecessaryAsync(
         const ULONG64 requestedPosition,
         const UINT32 requestedSize,
         HttpClientWrapper* httpClientWrapper,
-        InputStreamOptions httpInputStreamOptions)
+        InputStreamOptions httpInputStreamOptions,
+        IBuffer destination)
     {
-        // Increment cache access counter user for implementing LRU replacement
-        m_accessCounter++;
-
         // Find all the pages for the given request, and the pages that are missing
         std::vector<ULONG64> allPages;
         std::vector<ULONG64> unsatisfiablePages;
-        FindCachePages(requestedPosition, requestedSize, allPages, unsatisfiablePages);
+        ULONG64 fileSize = httpClientWrapper->GetFullFileSize();
+        FindCachePages(requestedPosition, requestedSize, fileSize, allPages, unsatisfiablePages);
+
+        AddReadaheadPages(requestedPosition, requestedSize, fileSize, unsatisfiablePages);
 
         // download the missing pages
         co_await DownloadAndSaveToCacheAysnc(
@@ -34,21 +48,7 @@ namespace AppInstaller::Utility::HttpStream
             httpInputStreamOptions);
 
         // At this point, everything should be in the cache
-        IBuffer constructedBuffer = {};
-
-        for (UINT32 i = 0; i < allPages.size(); i++)
-        {
-            UINT64 pageOffset = allPages[i];
-            IBuffer cachedPageBuffer = ReadPageFromCache(pageOffset);
-            constructedBuffer = ConcatenateBuffers(constructedBuffer, cachedPageBuffer);
-        }
-
-        // trim buffer to match requested range
-        IBuffer requestedBuffer = TrimBufferToSatisfyRequest(
-            constructedBuffer,
-            requestedPosition,
-            requestedSize,
-            allPages);
+        IBuffer requestedBuffer = AssembleRequestedBuffer(requestedPosition, requestedSize, allPages, destination);
 
         VacateStaleEntriesFromCache();
 
@@ -58,6 +58,7 @@ namespace AppInstaller::Utility::HttpStream
     void HttpLocalCache::FindCachePages(
         ULONG64 requestedPosition,
         UINT32 requestedSize,
+        ULONG64 fileSize,
         std::vector<ULONG64>& allPages,
         std::vector<ULONG64>& unsatisfiablePages)
     {
@@ -71,7 +72,7 @@ namespace AppInstaller::Utility::HttpStream
         {
             allPages.push_back(currentPageOffset);
 
-            if (m_localCache.find(currentPageOffset) == m_localCache.end())
+            if (m_localCache.find(currentPageOffset) == m_localCache.end() && !LoadPageFromDiskCache(currentPageOffset, fileSize))
             {
                 unsatisfiablePages.push_back(currentPageOffset);
             }
@@ -81,26 +82,67 @@ namespace AppInstaller::Utility::HttpStream
         } while (currentPageOffset < requestedEndPosition);
     }
 
+    // A read that starts where the previous one ended is likely to be followed by another, so the pages after it
+    // are downloaded with it. The readahead doubles with every sequential read up to MAX_READAHEAD_PAGES, and stops
+    // as soon as the reads jump elsewhere. It only extends a request that has to go to the network anyway.
+    void HttpLocalCache::AddReadaheadPages(
+        const ULONG64 requestedPosition,
+        const UINT32 requestedSize,
+        const ULONG64 fileSize,
+        std::vector<ULONG64>& unsatisfiablePages)
+    {
+        if (requestedPosition != 0 && requestedPosition == m_sequentialPosition)
+        {
+            m_readaheadPages = std::clamp(m_readaheadPages * 2, 1U, MAX_READAHEAD_PAGES);
+        }
+        else
+        {
+            m_readaheadPages = 0;
+        }
+
+        winrt::check_hresult(ULong64Add(requestedPosition, requestedSize, &m_sequentialPosition));
+
+        if (unsatisfiablePages.empty() || m_readaheadPages == 0)
+        {
+            return;
+        }
+
+        // Start from the page after the last one in the request
+        ULONG64 currentPageOffset;
+        winrt::check_hresult(ULong64Add(m_sequentialPosition, PAGE_SIZE - 1, &currentPageOffset));
+        currentPageOffset = (currentPageOffset / PAGE_SIZE) * PAGE_SIZE;
+
+        for (UINT32 i = 0; i < m_readaheadPages && currentPageOffset < fileSize; i++)
+        {
+            if (m_localCache.find(currentPageOffset) == m_localCache.end() && !LoadPageFromDiskCache(currentPageOffset, fileSize))
+            {
+                unsatisfiablePages.push_back(currentPageOffset);
+            }
+
+            winrt::check_hresult(ULong64Add(currentPageOffset, PAGE_SIZE, &currentPageOffset));
+        }
+    }
+
     // Breaks the provided buffer into smaller buffers and saves them to the cache at the corresponding 
     // page offset position, starting at firstPageOffset. The smaller buffers are all PAGE_SIZE bytes,
     // except for the one corresponding to the last page in the file
     void HttpLocalCache::SaveBufferToCache(const IBuffer& buffer, const ULONG64 firstPageOffset)
     {
+        const byte* bufferBytes = GetBufferBytes(buffer);
         UINT32 remainingBufferSize = buffer.Length();
         UINT32 currentBufferIndex = 0;
         ULONG64 currentPageOffset = firstPageOffset;
 
         while (remainingBufferSize > 0)
         {
-            // Extract the sub-buffer
+            // Copy the sub-buffer into the cache
             UINT32 currentPageSize = std::min(remainingBufferSize, PAGE_SIZE);
-            IBuffer currentPageBuffer = CreateTrimmedBuffer(buffer, currentBufferIndex, currentPageSize);
+            AddPage(currentPageOffset, bufferBytes + currentBufferIndex, currentPageSize);
 
-            // Add it to the cache
-            CachedPage currentPage;
-            currentPage.lastAccessCounter = m_accessCounter;
-            currentPage.buffer = currentPageBuffer;
-            m_localCache[currentPageOffset] = currentPage;
+            if (m_diskCache)
+            {
+                m_diskCache->WritePage(currentPageOffset, bufferBytes + currentBufferIndex, currentPageSize);
+            }
 
             // update loop vars
             winrt::check_hresult(UInt32Sub(remainingBufferSize, currentPageSize, &remainingBufferSize));
@@ -109,135 +151,204 @@ namespace AppInstaller::Utility::HttpStream
         }
     }
 
-    IBuffer HttpLocalCache::ReadPageFromCache(const ULONG64 pageOffset)
+    bool HttpLocalCache::LoadPageFromDiskCache(const ULONG64 pageOffset, const ULONG64 fileSize)
     {
-        if (!(m_localCache.find(pageOffset) != m_localCache.end()))
+        if (!m_diskCache || pageOffset >= fileSize)
         {
-            THROW_HR(E_INVALIDARG);
+            return false;
         }
 
-        CachedPage& page = m_localCache[pageOffset];
-        page.lastAccessCounter = m_accessCounter;
+        auto pageContents = m_diskCache->ReadPage(pageOffset, PAGE_SIZE);
+        if (!pageContents)
+        {
+            return false;
+        }
 
-        return page.buffer;
+        AddPage(pageOffset, pageContents->data(), static_cast<UINT32>(pageContents->size()));
+        return true;
     }
 
-    // Trims a buffer that was constructed (by fetching pages from cache and downloading missing pages)
-    // in order to satisfy a request and return the exact buffer the consumer asked for.
-    IBuffer HttpLocalCache::TrimBufferToSatisfyRequest(
-        const IBuffer& constructedBuffer,
-        const ULONG64 requestedPosition,
-        const UINT32 requestedSize,
-        const std::vector<ULONG64> allPages)
+    void HttpLocalCache::AddPage(const ULONG64 pageOffset, const BYTE* data, const UINT32 size)
     {
-        ULONG64 fullBufferStartOffset = allPages[0];
+        winrt::Windows::Storage::Streams::Buffer pageBuffer{ size };
+        memcpy(GetBufferBytes(pageBuffer), data, size);
+        pageBuffer.Length(size);
 
-        ULONG64 trimmedBufferStartRelativeIndex;
-        winrt::check_hresult(ULong64Sub(requestedPosition, fullBufferStartOffset, &trimmedBufferStartRelativeIndex));
+        CachedPage& page = m_localCache[pageOffset];
+        page.offset = pageOffset;
+        page.buffer = pageBuffer;
+        MarkAsNewest(page);
+    }
 
-        IBuffer requestedBuffer = CreateTrimmedBuffer(
-            constructedBuffer,
-            (UINT32)trimmedBufferStartRelativeIndex, // Conversion is safe as buffer size is a UINT32.
-            requestedSize);
+    IBuffer HttpLocalCache::ReadPageFromCache(const ULONG64 pageOffset)
+    {
+        auto pageIter = m_localCache.find(pageOffset);
+        if (pageIter == m_localCache.end())
+        {
+            THROW_HR(E_INVALIDARG);
+        }
 
-        return requestedBuffer;
+        MarkAsNewest(pageIter->second);
+
+        return pageIter->second.buffer;
     }
 
-    // Downloads a chunk of the file, saves it to the cache, and returns the corresponding buffer
-    // If the requested size is 0, this method returns an empty buffer without making HTTP calls
-    std::future<void> HttpLocalCache::DownloadAndSaveToCacheAysnc(
-        const std::vector<ULONG64> unsatisfiablePages,
-        HttpClientWrapper* httpClientWrapper,
-        InputStreamOptions httpInputStreamOptions)
+    // Moves the page to the front of the list of pages in order of use.
+    void HttpLocalCache::MarkAsNewest(CachedPage& page)
     {
-        // Determine the download job
-        // To make things easy, we will download the contiguous range that includes all the unsatisfiable ranges.
-        // Note that in theory, this may include cached pages. However, this situation is rarely expected to happen,
-        // if at all. The package reader usually reads things in chunks of 64 KB or less, so, we should expect to 
-        // always have up to two satisfiable and unsatisfiable pages in total.
-        UINT64 fileSize = httpClientWrapper->GetFullFileSize();
-        ULONG64 downloadJobStartPosition = 0U;
-        ULONG64 downloadJobEndPosition = 0U;
-        ULONG64 downloadJobSize = 0U;
-        if (unsatisfiablePages.size() > 0U)
+        if (m_newest == &page)
         {
-            downloadJobStartPosition = unsatisfiablePages[0];
-            ULONG64 lastUnsatisfiableJob = unsatisfiablePages[unsatisfiablePages.size() - 1];
-            winrt::check_hresult(ULong64Add(lastUnsatisfiableJob, PAGE_SIZE, &downloadJobEndPosition));
-
-            // make sure to not overflow file size
-            downloadJobEndPosition = std::min(downloadJobEndPosition, fileSize);
-            winrt::check_hresult(ULong64Sub(downloadJobEndPosition, downloadJobStartPosition, &downloadJobSize));
+            return;
         }
 
-        if (downloadJobSize != 0U)
+        Unlink(page);
+
+        page.older = m_newest;
+        if (m_newest)
         {
-            // start download job
-            IBuffer downloadedBuffer = co_await httpClientWrapper->DownloadRangeAsync(
-                downloadJobStartPosition,
-                (UINT32)downloadJobSize,
-                httpInputStreamOptions);
+            m_newest->newer = &page;
+        }
 
-            SaveBufferToCache(downloadedBuffer, downloadJobStartPosition);
+        m_newest = &page;
+        if (!m_oldest)
+        {
+            m_oldest = &page;
         }
     }
 
-    void HttpLocalCache::VacateStaleEntriesFromCache()
+    void HttpLocalCache::Unlink(CachedPage& page)
     {
-        // Copy page offsets into vector and sort by the access counter
-        std::vector<std::pair<UINT64, int>> orderedPageOffsets;
-        for (auto pageIter = m_localCache.begin(); pageIter != m_localCache.end(); pageIter++)
+        if (page.newer)
         {
-            orderedPageOffsets.push_back(std::pair<UINT64, int>(pageIter->first, pageIter->second.lastAccessCounter));
+            page.newer->older = page.older;
+        }
+        else if (m_newest == &page)
+        {
+            m_newest = page.older;
         }
 
-        // Compare function to sort by access counter
-        auto cmp = [](std::pair<UINT64, int> const & a, std::pair<UINT64, int> const & b)
+        if (page.older)
+        {
+            page.older->newer = page.newer;
+        }
+        else if (m_oldest == &page)
         {
-            return a.second != b.second ? a.second < b.second : a.first < b.first;
-        };
+            m_oldest = page.newer;
+        }
 
-        std::sort(orderedPageOffsets.begin(), orderedPageOffsets.end(), cmp);
+        page.newer = nullptr;
+        page.older = nullptr;
+    }
 
-        for (auto pageIter = orderedPageOffsets.begin(); pageIter != orderedPageOffsets.end(); pageIter++)
+    // Builds the buffer for the request from the cached pages, copying each byte once.
+    // The caller's buffer is used if it is large enough. A request for exactly one whole page
+    // with no buffer to fill is given the cached page itself.
+    IBuffer HttpLocalCache::AssembleRequestedBuffer(
+        const ULONG64 requestedPosition,
+        const UINT32 requestedSize,
+        const std::vector<ULONG64>& allPages,
+        IBuffer destination)
+    {
+        if (!destination && allPages.size() == 1 && allPages[0] == requestedPosition)
         {
-            if (m_localCache.size() > MAX_PAGES)
+            IBuffer pageBuffer = ReadPageFromCache(allPages[0]);
+            if (pageBuffer.Length() == requestedSize)
             {
-                m_localCache.erase(pageIter->first);
+                return pageBuffer;
             }
-            else
+        }
+
+        IBuffer requestedBuffer = destination;
+        if (!requestedBuffer || requestedBuffer.Capacity() < requestedSize)
+        {
+            requestedBuffer = winrt::Windows::Storage::Streams::Buffer{ requestedSize };
+        }
+
+        byte* requestedBytes = GetBufferBytes(requestedBuffer);
+        UINT32 copiedSize = 0;
+        ULONG64 currentPosition = requestedPosition;
+
+        for (ULONG64 pageOffset : allPages)
+        {
+            IBuffer cachedPageBuffer = ReadPageFromCache(pageOffset);
+
+            // Only the first page may start before the request, and a page that ends the file may fall short of it
+            UINT32 indexInPage = static_cast<UINT32>(currentPosition - pageOffset);
+            if (indexInPage >= cachedPageBuffer.Length())
             {
                 break;
             }
+
+            UINT32 sizeFromPage = std::min(cachedPageBuffer.Length() - indexInPage, requestedSize - copiedSize);
+            memcpy(requestedBytes + copiedSize, GetBufferBytes(cachedPageBuffer) + indexInPage, sizeFromPage);
+
+            winrt::check_hresult(UInt32Add(copiedSize, sizeFromPage, &copiedSize));
+            winrt::check_hresult(ULong64Add(currentPosition, sizeFromPage, &currentPosition));
         }
+
+        requestedBuffer.Length(copiedSize);
+        return requestedBuffer;
     }
 
-    IBuffer HttpLocalCache::CreateTrimmedBuffer(
-        const IBuffer& originalBuffer,
-        UINT32 trimStartIndex,
-        UINT32 size)
+    // Downloads the missing pages and saves them to the cache.
+    // Pages that are next to each other are downloaded with a single request, and all of the requests are
+    // started before waiting on any of them. If there are no missing pages, no HTTP calls are made.
+    std::future<void> HttpLocalCache::DownloadAndSaveToCacheAysnc(
+        const std::vector<ULONG64> unsatisfiablePages,
+        HttpClientWrapper* httpClientWrapper,
+        InputStreamOptions httpInputStreamOptions)
     {
-        originalBuffer.as<::IInspectable>();
+        UINT64 fileSize = httpClientWrapper->GetFullFileSize();
+
+        std::vector<ULONG64> sortedPages = unsatisfiablePages;
+        std::sort(sortedPages.begin(), sortedPages.end());
+
+        std::vector<std::pair<ULONG64, std::future<IBuffer>>> downloadJobs;
+
+        for (size_t i = 0; i < sortedPages.size();)
+        {
+            // Extend the job over every page that directly follows it
+            ULONG64 downloadJobStartPosition = sortedPages[i];
+            ULONG64 downloadJobEndPosition;
+            winrt::check_hresult(ULong64Add(downloadJobStartPosition, PAGE_SIZE, &downloadJobEndPosition));
+
+            for (++i; i < sortedPages.size() && sortedPages[i] <= downloadJobEndPosition; ++i)
+            {
+                winrt::check_hresult(ULong64Add(sortedPages[i], PAGE_SIZE, &downloadJobEndPosition));
+            }
 
-        // Get the byte array from the IBuffer object
-        Microsoft::WRL::ComPtr<IBufferByteAccess> bufferByteAccess;
-        ::IInspectable* bufferAbi = (::IInspectable*)winrt::get_abi(originalBuffer);
-        bufferAbi->QueryInterface(IID_PPV_ARGS(&bufferByteAccess));
-        byte* byteBuffer = nullptr;
-        bufferByteAccess->Buffer(&byteBuffer);
+            // make sure to not overflow file size
+            downloadJobEndPosition = std::min(downloadJobEndPosition, fileSize);
+            if (downloadJobEndPosition <= downloadJobStartPosition)
+            {
+                continue;
+            }
 
-        // Create the array of bytes holding the trimmed bytes
-        IBuffer trimmedBuffer = CryptographicBuffer::CreateFromByteArray(
-            { byteBuffer + trimStartIndex, byteBuffer + trimStartIndex + size });
+            ULONG64 downloadJobSize;
+            winrt::check_hresult(ULong64Sub(downloadJobEndPosition, downloadJobStartPosition, &downloadJobSize));
 
-        return trimmedBuffer;
+            // start download job
+            downloadJobs.emplace_back(downloadJobStartPosition, httpClientWrapper->DownloadRangeAsync(
+                downloadJobStartPosition,
+                (UINT32)downloadJobSize,
+                httpInputStreamOptions));
+        }
+
+        for (auto& downloadJob : downloadJobs)
+        {
+            IBuffer downloadedBuffer = co_await std::move(downloadJob.second);
+            SaveBufferToCache(downloadedBuffer, downloadJob.first);
+        }
     }
 
-    IBuffer HttpLocalCache::ConcatenateBuffers(const IBuffer& buffer1, const IBuffer& buffer2)
+    // Removes the least recently used pages until the cache is within its maximum size.
+    void HttpLocalCache::VacateStaleEntriesFromCache()
     {
-        DataWriter writer;
-        writer.WriteBuffer(buffer1);
-        writer.WriteBuffer(buffer2);
-        return writer.DetachBuffer();
+        while (m_localCache.size() > MAX_PAGES && m_oldest)
+        {
+            CachedPage* page = m_oldest;
+            Unlink(*page);
+            m_localCache.erase(page->offset);
+        }
     }
-}
\ No newline at end of file
+}
@@ -4,47 +4,91 @@
 #pragma once
 
 #include "HttpClientWrapper.h"
+#include "HttpDiskCache.h"
+
+#include <unordered_map>
 
 namespace AppInstaller::Utility::HttpStream
 {
     // Represents an entry in the cache.
+    // The entries are also linked together in order of use, most recent first, so that the least recently used can be found directly.
     struct CachedPage
     {
-        int lastAccessCounter = 0;
+        ULONG64 offset = 0;
         winrt::Windows::Storage::Streams::IBuffer buffer;
+        CachedPage* newer = nullptr;
+        CachedPage* older = nullptr;
     };
 
     // A cache used internally by the custom HttpRandomAccessStream to reduce round-trips
     class HttpLocalCache
     {
     public:
-        const UINT32 PAGE_SIZE = 2 << 16;   // each entry in the cache is 64 KB
-        const UINT32 MAX_PAGES = 200;       // cache size capped at 12.5 MB (200 * 64KB)
+        static constexpr UINT32 PAGE_SIZE = 2 << 16;   // each entry in the cache is 128 KB
+        static constexpr UINT32 MAX_PAGES = 200;       // cache size capped at 25 MB (200 * 128KB)
+
+        // The most pages read beyond a request when reads are sequential; the amount doubles with each sequential read.
+        static constexpr UINT32 MAX_READAHEAD_PAGES = 16;
 
         // Returns a buffer matching the requested range by reading the parts of the range that are cached
-        // and downloading the rest using the provided httpClientWrapper object
+        // and downloading the rest using the provided httpClientWrapper object.
+        // Missing pages that are next to each other are downloaded with a single request. The result is written
+        // to the given buffer if it has the capacity, otherwise to a new buffer.
         std::future<winrt::Windows::Storage::Streams::IBuffer> ReadFromCacheAndDownloadIfNecessaryAsync(
             const ULONG64 requestedPosition,
             const UINT32 requestedSize,
             HttpClientWrapper* httpClientWrapper,
-            winrt::Windows::Storage::Streams::InputStreamOptions httpInputStreamOptions);
+            winrt::Windows::Storage::Streams::InputStreamOptions httpInputStreamOptions,
+            winrt::Windows::Storage::Streams::IBuffer destination = nullptr);
+
+        // Sets the cache on disk that pages are read from before they are downloaded, and written to after.
+        void SetDiskCache(std::unique_ptr<HttpDiskCache> diskCache) { m_diskCache = std::move(diskCache); }
+
+        // Gets the number of pages in the cache.
+        size_t GetPageCount() const { return m_localCache.size(); }
+
+        // Determines whether the page that contains the given position is cached.
+        bool IsCached(ULONG64 position) const { return m_localCache.find(position / PAGE_SIZE * PAGE_SIZE) != m_localCache.end(); }
 
     private:
-        std::map<ULONG64, CachedPage> m_localCache;
-        UINT32 m_accessCounter = 0U;
+        std::unordered_map<ULONG64, CachedPage> m_localCache;
+        CachedPage* m_newest = nullptr;
+        CachedPage* m_oldest = nullptr;
+        std::unique_ptr<HttpDiskCache> m_diskCache;
+
+        // The position just after the end of the previous read, and how far ahead to read if the next one starts there.
+        ULONG64 m_sequentialPosition = 0;
+        UINT32 m_readaheadPages = 0;
 
         // Returns a vector of all pages corresponding to a range, and another (subset)
         // vector of the pages missing from the cache.
         void FindCachePages(
             const ULONG64 requestedPosition,
             const UINT32 requestedSize,
+            const ULONG64 fileSize,
             std::vector<ULONG64>& allPages,
             std::vector<ULONG64>& unsatisfiablePages);
 
+        // Adds the pages that follow the request to those to download, if reads have been sequential.
+        void AddReadaheadPages(
+            const ULONG64 requestedPosition,
+            const UINT32 requestedSize,
+            const ULONG64 fileSize,
+            std::vector<ULONG64>& unsatisfiablePages);
+
         void SaveBufferToCache(const winrt::Windows::Storage::Streams::IBuffer& buffer, const ULONG64 firstPageOffset);
 
+        // Adds the page to the cache from the disk cache, returning false if it is not there.
+        bool LoadPageFromDiskCache(const ULONG64 pageOffset, const ULONG64 fileSize);
+
+        void AddPage(const ULONG64 pageOffset, const BYTE* data, const UINT32 size);
+
         winrt::Windows::Storage::Streams::IBuffer ReadPageFromCache(const ULONG64 pageOffset);
 
+        void MarkAsNewest(CachedPage& page);
+
+        void Unlink(CachedPage& page);
+
         void VacateStaleEntriesFromCache();
 
         std::future<void> DownloadAndSaveToCacheAysnc(
@@ -52,19 +96,10 @@ namespace AppInstaller::Utility::HttpStream
             HttpClientWrapper* httpClientWrapper,
             const winrt::Windows::Storage::Streams::InputStreamOptions httpInputStreamOptions);
 
-        winrt::Windows::Storage::Streams::IBuffer TrimBufferToSatisfyRequest(
-            const winrt::Windows::Storage::Streams::IBuffer& constructedBuffer,
+        winrt::Windows::Storage::Streams::IBuffer AssembleRequestedBuffer(
             const ULONG64 requestedPosition,
             const UINT32 requestedSize,
-            const std::vector<ULONG64> allPages);
-
-        winrt::Windows::Storage::Streams::IBuffer CreateTrimmedBuffer(
-            const winrt::Windows::Storage::Streams::IBuffer& originalBuffer,
-            UINT32 trimStartIndex,
-            UINT32 size);
-
-        winrt::Windows::Storage::Streams::IBuffer ConcatenateBuffers(
-            const winrt::Windows::Storage::Streams::IBuffer& buffer1,
-            const winrt::Windows::Storage::Streams::IBuffer& buffer2);
+            const std::vector<ULONG64>& allPages,
+            winrt::Windows::Storage::Streams::IBuffer destination);
     };
-}
\ No newline at end of file
+}
@@ -19,6 +19,7 @@ namespace AppInstaller::Utility::HttpStream
         stream->m_httpHelper = co_await HttpClientWrapper::CreateAsync(uri);
         stream->m_size = stream->m_httpHelper->GetFullFileSize();
         stream->m_httpLocalCache = std::make_unique<HttpLocalCache>();
+        stream->m_httpLocalCache->SetDiskCache(HttpDiskCache::Create(uri, *stream->m_httpHelper));
 
         co_return stream.as<IRandomAccessStream>();
 
@@ -81,7 +82,8 @@ namespace AppInstaller::Utility::HttpStream
             m_requestedPosition,
             count,
             m_httpHelper.get(),
-            options);
+            options,
+            buffer);
         winrt::check_hresult(ULong64Add(m_requestedPosition, result.Length(), &m_requestedPosition));
 
         co_return result;
@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/AppInstallerLogging.h"
+#include "Public/AppInstallerRuntime.h"
+#include "Public/winget/InstallerCache.h"
+#include "Public/winget/UserSettings.h"
+
+#include <optional>
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Utility
+{
+    namespace
+    {
+        constexpr std::string_view s_CacheDirectoryName = "InstallerCache"sv;
+        constexpr std::string_view s_EntryExtension = ".installer"sv;
+        constexpr std::string_view s_TempExtension = ".tmp"sv;
+
+        // Gets the hash that names an entry file, if the file is an entry.
+        std::optional<SHA256::HashBuffer> GetEntryHash(const std::filesystem::path& path)
+        {
+            if (path.extension() != s_EntryExtension)
+            {
+                return {};
+            }
+
+            std::string stem = path.stem().u8string();
+            if (stem.size() != SHA256::HashStringSizeInChars ||
+                !std::all_of(stem.begin(), stem.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; }))
+            {
+                return {};
+            }
+
+            return SHA256::ConvertToBytes(stem);
+        }
+    }
+
+    InstallerCache::InstallerCache(std::filesystem::path directory, uint64_t maxSizeInBytes) :
+        m_directory(std::move(directory)), m_maxSizeInBytes(maxSizeInBytes) {}
+
+    InstallerCache InstallerCache::FromUserSettings()
+    {
+        return { GetDefaultDirectory(), static_cast<uint64_t>(Settings::User().Get<Settings::Setting::NetworkInstallerCacheMaxSizeInMB>()) << 20 };
+    }
+
+    std::filesystem::path InstallerCache::GetDefaultDirectory()
+    {
+        return Runtime::GetPathTo(Runtime::PathName::LocalState) / s_CacheDirectoryName;
+    }
+
+    bool InstallerCache::CopyTo(const SHA256::HashBuffer& hash, const std::filesystem::path& destination)
+    {
+        if (!IsEnabled() || hash.size() != SHA256::HashBufferSizeInBytes)
+        {
+            return false;
+        }
+
+        try
+        {
+            std::filesystem::path entryPath = GetEntryPath(hash);
+
+            std::error_code error;
+            if (!std::filesystem::is_regular_file(entryPath, error))
+            {
+                return false;
+            }
+
+            std::filesystem::copy_file(entryPath, destination, std::filesystem::copy_options::overwrite_existing);
+
+            // Mark the entry as recently used so that it is the last to be evicted
+            std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+
+            AICLI_LOG(Core, Info, << "Copied cached installer " << entryPath << " to " << destination);
+            return true;
+        }
+        CATCH_LOG();
+
+        return false;
+    }
+
+    void InstallerCache::Add(const SHA256::HashBuffer& hash, const std::filesystem::path& file)
+    {
+        if (!IsEnabled() || hash.size() != SHA256::HashBufferSizeInBytes)
+        {
+            return;
+        }
+
+        try
+        {
+            std::filesystem::path entryPath = GetEntryPath(hash);
+
+            std::error_code error;
+            if (std::filesystem::is_regular_file(entryPath, error))
+            {
+                std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+                return;
+            }
+
+            // An installer that could never fit would only evict everything else
+            if (std::filesystem::file_size(file) > m_maxSizeInBytes)
+            {
+                AICLI_LOG(Core, Info, << "Installer is larger than the installer cache: " << file);
+                return;
+            }
+
+            std::filesystem::create_directories(m_directory);
+
+            // The temporary name is unique to this thread so that concurrent publishers of the same installer do not collide
+            std::filesystem::path tempPath = entryPath;
+            tempPath += "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId());
+            tempPath += s_TempExtension;
+
+            std::filesystem::copy_file(file, tempPath, std::filesystem::copy_options::overwrite_existing);
+            std::filesystem::last_write_time(tempPath, std::filesystem::file_time_type::clock::now(), error);
+
+            // Publish the entry in a single step so that other processes never observe a partially written installer
+            std::filesystem::rename(tempPath, entryPath, error);
+            if (error)
+            {
+                std::filesystem::remove(tempPath, error);
+                return;
+            }
+
+            AICLI_LOG(Core, Info, << "Added installer to the cache: " << entryPath);
+
+            EnforceMaximumSize();
+        }
+        CATCH_LOG();
+    }
+
+    void InstallerCache::Remove(const SHA256::HashBuffer& hash)
+    {
+        if (hash.size() != SHA256::HashBufferSizeInBytes)
+        {
+            return;
+        }
+
+        std::error_code error;
+        if (std::filesystem::remove(GetEntryPath(hash), error))
+        {
+            AICLI_LOG(Core, Info, << "Removed installer from the cache: " << SHA256::ConvertToString(hash));
+        }
+    }
+
+    std::vector<InstallerCache::Entry> InstallerCache::GetEntries() const
+    {
+        std::vector<Entry> result;
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(m_directory, error))
+        {
+            return result;
+        }
+
+        for (const auto& file : std::filesystem::directory_iterator{ m_directory })
+        {
+            if (!file.is_regular_file())
+            {
+                continue;
+            }
+
+            auto hash = GetEntryHash(file.path());
+            if (hash)
+            {
+                result.emplace_back(Entry{ std::move(hash).value(), file.path(), file.file_size(), file.last_write_time() });
+            }
+        }
+
+        std::sort(result.begin(), result.end(), [](const Entry& a, const Entry& b) { return a.LastUsed > b.LastUsed; });
+        return result;
+    }
+
+    size_t InstallerCache::Clear()
+    {
+        size_t result = 0;
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(m_directory, error))
+        {
+            return result;
+        }
+
+        for (const auto& file : std::filesystem::directory_iterator{ m_directory })
+        {
+            if (!file.is_regular_file())
+            {
+                continue;
+            }
+
+            // Temporary files left behind by an interrupted publish are removed as well, but not counted
+            bool isEntry = GetEntryHash(file.path()).has_value();
+            if (!isEntry && file.path().extension() != s_TempExtension)
+            {
+                continue;
+            }
+
+            if (std::filesystem::remove(file.path(), error) && isEntry)
+            {
+                ++result;
+            }
+        }
+
+        AICLI_LOG(Core, Info, << "Removed " << result << " installers from the cache");
+        return result;
+    }
+
+    std::filesystem::path InstallerCache::GetEntryPath(const SHA256::HashBuffer& hash) const
+    {
+        std::filesystem::path result = m_directory / SHA256::ConvertToString(hash);
+        result += s_EntryExtension;
+        return result;
+    }
+
+    void InstallerCache::EnforceMaximumSize()
+    {
+        std::vector<Entry> entries = GetEntries();
+
+        uint64_t totalSize = 0;
+        for (const auto& entry : entries)
+        {
+            totalSize += entry.Size;
+        }
+
+        // Entries are ordered most recently used first, so evict from the back
+        while (totalSize > m_maxSizeInBytes && !entries.empty())
+        {
+            const Entry& entry = entries.back();
+
+            std::error_code error;
+            if (std::filesystem::remove(entry.Path, error))
+            {
+                AICLI_LOG(Core, Info, << "Evicted installer from the cache: " << entry.Path);
+                totalSize -= entry.Size;
+            }
+
+            entries.pop_back();
+        }
+    }
+}
@@ -67,5 +67,28 @@ namespace AppInstaller::Utility
 
         return std::nullopt;
     }
-}
 
+    template<>
+    std::optional<std::map<std::string, uint32_t>> GetValue(const Json::Value& node)
+    {
+        std::map<std::string, uint32_t> result;
+
+        if (node.isObject())
+        {
+            for (const auto& name : node.getMemberNames())
+            {
+                const Json::Value& entry = node[name];
+                if (!entry.isUInt())
+                {
+                    return std::nullopt;
+                }
+
+                result.emplace(name, entry.asUInt());
+            }
+
+            return result;
+        }
+
+        return std::nullopt;
+    }
+}
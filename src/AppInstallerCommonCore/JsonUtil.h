@@ -4,6 +4,7 @@
 #pragma once
 #include <json.h>
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,4 +25,7 @@ namespace AppInstaller::Utility
 
     template<>
     std::optional<std::vector<std::string>> GetValue<std::vector<std::string>>(const Json::Value& node);
+
+    template<>
+    std::optional<std::map<std::string, uint32_t>> GetValue<std::map<std::string, uint32_t>>(const Json::Value& node);
 }
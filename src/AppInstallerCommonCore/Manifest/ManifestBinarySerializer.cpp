@@ -0,0 +1,417 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "winget/ManifestBinarySerializer.h"
+
+namespace AppInstaller::Manifest::BinarySerializer
+{
+    namespace
+    {
+        constexpr std::string_view s_Magic = "WGMB"sv;
+
+        struct Writer
+        {
+            void WriteVarint(uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    m_data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                    value >>= 7;
+                }
+
+                m_data.push_back(static_cast<char>(value));
+            }
+
+            template <typename E>
+            void WriteEnum(E value)
+            {
+                WriteVarint(static_cast<uint32_t>(static_cast<int32_t>(value)));
+            }
+
+            void WriteString(std::string_view value)
+            {
+                WriteVarint(value.size());
+                m_data.append(value);
+            }
+
+            void WriteBytes(const std::vector<BYTE>& value)
+            {
+                WriteString({ reinterpret_cast<const char*>(value.data()), value.size() });
+            }
+
+            void WriteStrings(const std::vector<string_t>& values)
+            {
+                WriteVarint(values.size());
+                for (const auto& value : values)
+                {
+                    WriteString(value);
+                }
+            }
+
+            template <typename E>
+            void WriteEnums(const std::vector<E>& values)
+            {
+                WriteVarint(values.size());
+                for (E value : values)
+                {
+                    WriteEnum(value);
+                }
+            }
+
+            std::string& GetData() { return m_data; }
+
+        private:
+            std::string m_data;
+        };
+
+        // The text was normalized before it was encoded, so it is copied as is rather than normalized again.
+        string_t ReadNormalizedString(Reader& reader)
+        {
+            string_t result;
+            static_cast<std::string&>(result).assign(reader.ReadString());
+            return result;
+        }
+
+        std::vector<BYTE> ReadBytes(Reader& reader)
+        {
+            std::string_view value = reader.ReadString();
+            return { reinterpret_cast<const BYTE*>(value.data()), reinterpret_cast<const BYTE*>(value.data() + value.size()) };
+        }
+
+        // Reads the count of a list. Lists are read an item at a time rather than reserved up front, so a corrupt count
+        // fails once the data runs out instead of allocating for it.
+        size_t ReadCount(Reader& reader)
+        {
+            return static_cast<size_t>(reader.ReadVarint());
+        }
+
+        std::vector<string_t> ReadStrings(Reader& reader)
+        {
+            std::vector<string_t> result;
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                result.emplace_back(ReadNormalizedString(reader));
+            }
+            return result;
+        }
+
+        template <typename E>
+        std::vector<E> ReadEnums(Reader& reader)
+        {
+            std::vector<E> result;
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                result.emplace_back(reader.ReadEnum<E>());
+            }
+            return result;
+        }
+
+        void WriteDependency(Writer& writer, const Dependency& dependency)
+        {
+            writer.WriteStrings(dependency.WindowsFeatures);
+            writer.WriteStrings(dependency.WindowsLibraries);
+
+            writer.WriteVarint(dependency.PackageDependencies.size());
+            for (const auto& packageDependency : dependency.PackageDependencies)
+            {
+                writer.WriteString(packageDependency.Id);
+                writer.WriteString(packageDependency.MinVersion);
+            }
+
+            writer.WriteStrings(dependency.ExternalDependencies);
+        }
+
+        Dependency ReadDependency(Reader& reader)
+        {
+            Dependency result;
+            result.WindowsFeatures = ReadStrings(reader);
+            result.WindowsLibraries = ReadStrings(reader);
+
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                PackageDependency packageDependency;
+                packageDependency.Id = ReadNormalizedString(reader);
+                packageDependency.MinVersion = ReadNormalizedString(reader);
+                result.PackageDependencies.emplace_back(std::move(packageDependency));
+            }
+
+            result.ExternalDependencies = ReadStrings(reader);
+            return result;
+        }
+
+        void WriteInstaller(Writer& writer, const ManifestInstaller& installer)
+        {
+            writer.WriteEnum(installer.Arch);
+            writer.WriteString(installer.Url);
+            writer.WriteBytes(installer.Sha256);
+            writer.WriteBytes(installer.SignatureSha256);
+            writer.WriteString(installer.ProductId);
+            writer.WriteString(installer.Locale);
+            writer.WriteEnums(installer.Platform);
+            writer.WriteString(installer.MinOSVersion);
+            writer.WriteEnum(installer.InstallerType);
+            writer.WriteEnum(installer.Scope);
+            writer.WriteEnums(installer.InstallModes);
+
+            writer.WriteVarint(installer.Switches.size());
+            for (const auto& installerSwitch : installer.Switches)
+            {
+                writer.WriteEnum(installerSwitch.first);
+                writer.WriteString(installerSwitch.second);
+            }
+
+            writer.WriteVarint(installer.InstallerSuccessCodes.size());
+            for (DWORD code : installer.InstallerSuccessCodes)
+            {
+                writer.WriteVarint(code);
+            }
+
+            writer.WriteEnum(installer.UpdateBehavior);
+            writer.WriteStrings(installer.Commands);
+            writer.WriteStrings(installer.Protocols);
+            writer.WriteStrings(installer.FileExtensions);
+            writer.WriteString(installer.PackageFamilyName);
+            writer.WriteString(installer.ProductCode);
+            writer.WriteStrings(installer.Capabilities);
+            writer.WriteStrings(installer.RestrictedCapabilities);
+            WriteDependency(writer, installer.Dependencies);
+        }
+
+        ManifestInstaller ReadInstaller(Reader& reader)
+        {
+            ManifestInstaller result;
+            result.Arch = reader.ReadEnum<Utility::Architecture>();
+            result.Url = ReadNormalizedString(reader);
+            result.Sha256 = ReadBytes(reader);
+            result.SignatureSha256 = ReadBytes(reader);
+            result.ProductId = ReadNormalizedString(reader);
+            result.Locale = ReadNormalizedString(reader);
+            result.Platform = ReadEnums<PlatformEnum>(reader);
+            result.MinOSVersion = ReadNormalizedString(reader);
+            result.InstallerType = reader.ReadEnum<InstallerTypeEnum>();
+            result.Scope = reader.ReadEnum<ScopeEnum>();
+            result.InstallModes = ReadEnums<InstallModeEnum>(reader);
+
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                InstallerSwitchType type = reader.ReadEnum<InstallerSwitchType>();
+                result.Switches[type] = ReadNormalizedString(reader);
+            }
+
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                result.InstallerSuccessCodes.emplace_back(reader.ReadUInt32());
+            }
+
+            result.UpdateBehavior = reader.ReadEnum<UpdateBehaviorEnum>();
+            result.Commands = ReadStrings(reader);
+            result.Protocols = ReadStrings(reader);
+            result.FileExtensions = ReadStrings(reader);
+            result.PackageFamilyName = ReadNormalizedString(reader);
+            result.ProductCode = ReadNormalizedString(reader);
+            result.Capabilities = ReadStrings(reader);
+            result.RestrictedCapabilities = ReadStrings(reader);
+            result.Dependencies = ReadDependency(reader);
+            return result;
+        }
+
+        void WriteLocalizationValue(Writer& writer, const string_t& value)
+        {
+            writer.WriteString(value);
+        }
+
+        void WriteLocalizationValue(Writer& writer, const std::vector<string_t>& value)
+        {
+            writer.WriteStrings(value);
+        }
+
+        void ReadLocalizationValue(Reader& reader, string_t& value)
+        {
+            value = ReadNormalizedString(reader);
+        }
+
+        void ReadLocalizationValue(Reader& reader, std::vector<string_t>& value)
+        {
+            value = ReadStrings(reader);
+        }
+
+        template <Localization L>
+        void WriteLocalizationEntry(Writer& writer, const ManifestLocalization& localization)
+        {
+            if (localization.Contains(L))
+            {
+                writer.WriteEnum(L);
+                WriteLocalizationValue(writer, localization.Get<L>());
+            }
+        }
+
+        template <Localization L>
+        void ReadLocalizationEntry(Reader& reader, ManifestLocalization& localization)
+        {
+            typename details::LocalizationMapping<L>::value_t value;
+            ReadLocalizationValue(reader, value);
+            localization.Add<L>(std::move(value));
+        }
+
+        template <size_t... I>
+        void WriteLocalizationEntries(Writer& writer, const ManifestLocalization& localization, std::index_sequence<I...>)
+        {
+            (WriteLocalizationEntry<static_cast<Localization>(I)>(writer, localization), ...);
+        }
+
+        template <size_t... I>
+        void ReadLocalizationEntryByKey(Reader& reader, ManifestLocalization& localization, Localization key, std::index_sequence<I...>)
+        {
+            using ReadEntry = void(*)(Reader&, ManifestLocalization&);
+            static constexpr ReadEntry s_readers[] = { &ReadLocalizationEntry<static_cast<Localization>(I)>... };
+
+            size_t index = static_cast<size_t>(key);
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), index >= std::size(s_readers));
+            s_readers[index](reader, localization);
+        }
+
+        void WriteLocalization(Writer& writer, const ManifestLocalization& localization)
+        {
+            using Indices = std::make_index_sequence<static_cast<size_t>(Localization::Max)>;
+
+            writer.WriteString(localization.Locale);
+
+            size_t count = 0;
+            for (size_t i = 0; i < static_cast<size_t>(Localization::Max); ++i)
+            {
+                count += localization.Contains(static_cast<Localization>(i)) ? 1 : 0;
+            }
+
+            writer.WriteVarint(count);
+            WriteLocalizationEntries(writer, localization, Indices{});
+        }
+
+        ManifestLocalization ReadLocalization(Reader& reader)
+        {
+            using Indices = std::make_index_sequence<static_cast<size_t>(Localization::Max)>;
+
+            ManifestLocalization result;
+            result.Locale = ReadNormalizedString(reader);
+
+            for (size_t count = ReadCount(reader); count > 0; --count)
+            {
+                ReadLocalizationEntryByKey(reader, result, reader.ReadEnum<Localization>(), Indices{});
+            }
+
+            return result;
+        }
+    }
+
+    uint64_t Reader::ReadVarint()
+    {
+        uint64_t result = 0;
+
+        for (uint32_t shift = 0; ; shift += 7)
+        {
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), m_position >= m_data.size() || shift >= 64);
+
+            uint8_t byte = static_cast<uint8_t>(m_data[m_position++]);
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    uint32_t Reader::ReadUInt32()
+    {
+        uint64_t result = ReadVarint();
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), result > std::numeric_limits<uint32_t>::max());
+        return static_cast<uint32_t>(result);
+    }
+
+    std::string_view Reader::ReadString()
+    {
+        uint64_t size = ReadVarint();
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), size > m_data.size() - m_position);
+
+        std::string_view result = m_data.substr(m_position, static_cast<size_t>(size));
+        m_position += static_cast<size_t>(size);
+        return result;
+    }
+
+    void Reader::ReadHeader()
+    {
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), m_data.substr(0, s_Magic.size()) != s_Magic);
+        m_position = s_Magic.size();
+
+        uint64_t formatVersion = ReadVarint();
+        THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), formatVersion != s_FormatVersion, "Unsupported manifest binary format version: %llu", formatVersion);
+    }
+
+    std::string Serialize(const Manifest& manifest)
+    {
+        Writer writer;
+        writer.GetData().append(s_Magic);
+        writer.WriteVarint(s_FormatVersion);
+
+        writer.WriteString(manifest.Id);
+        writer.WriteString(manifest.Version);
+        writer.WriteString(manifest.Channel);
+        writer.WriteString(manifest.Moniker);
+        writer.WriteString(manifest.ManifestVersion.ToStringWithExtensions());
+
+        WriteInstaller(writer, manifest.DefaultInstallerInfo);
+        writer.WriteVarint(manifest.Installers.size());
+        for (const auto& installer : manifest.Installers)
+        {
+            WriteInstaller(writer, installer);
+        }
+
+        WriteLocalization(writer, manifest.DefaultLocalization);
+        writer.WriteVarint(manifest.Localizations.size());
+        for (const auto& localization : manifest.Localizations)
+        {
+            WriteLocalization(writer, localization);
+        }
+
+        WriteLocalization(writer, manifest.CurrentLocalization);
+        writer.WriteBytes(manifest.StreamSha256);
+
+        return std::move(writer.GetData());
+    }
+
+    Manifest Deserialize(std::string_view data)
+    {
+        Reader reader{ data };
+        reader.ReadHeader();
+
+        Manifest result;
+        result.Id = ReadNormalizedString(reader);
+        result.Version = ReadNormalizedString(reader);
+        result.Channel = ReadNormalizedString(reader);
+        result.Moniker = ReadNormalizedString(reader);
+
+        std::string_view manifestVersion = reader.ReadString();
+        if (!manifestVersion.empty())
+        {
+            result.ManifestVersion = ManifestVer{ manifestVersion };
+        }
+
+        result.DefaultInstallerInfo = ReadInstaller(reader);
+        for (size_t count = ReadCount(reader); count > 0; --count)
+        {
+            result.Installers.emplace_back(ReadInstaller(reader));
+        }
+
+        result.DefaultLocalization = ReadLocalization(reader);
+        for (size_t count = ReadCount(reader); count > 0; --count)
+        {
+            result.Localizations.emplace_back(ReadLocalization(reader));
+        }
+
+        result.CurrentLocalization = ReadLocalization(reader);
+        result.StreamSha256 = ReadBytes(reader);
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), !reader.AtEnd());
+
+        return result;
+    }
+}
@@ -117,6 +117,19 @@ namespace AppInstaller::Manifest
         return false;
     }
 
+    std::string ManifestVer::ToStringWithExtensions() const
+    {
+        std::string result = ToString();
+
+        for (const Version& ext : m_extensions)
+        {
+            result += '-';
+            result += ext.ToString();
+        }
+
+        return result;
+    }
+
     InstallerTypeEnum ConvertToInstallerTypeEnum(const std::string& in)
     {
         std::string inStrLower = Utility::ToLower(in);
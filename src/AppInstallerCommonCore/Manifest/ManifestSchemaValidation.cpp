@@ -6,6 +6,7 @@
 #include "winget/ManifestCommon.h"
 #include "winget/ManifestSchemaValidation.h"
 #include "winget/ManifestYamlParser.h"
+#include "ManifestYamlAdapter.h"
 
 #include <ManifestSchema.h>
 
@@ -15,135 +16,90 @@ namespace AppInstaller::Manifest::YamlParser
 
     namespace
     {
-        enum class YamlScalarType
-        {
-            String,
-            Int
-        };
-
         // List of fields that use non string scalar types
         const std::map<std::string_view, YamlScalarType> ManifestFieldTypes=
         {
             { "InstallerSuccessCodes"sv, YamlScalarType::Int }
         };
 
-        YamlScalarType GetManifestScalarValueType(const std::string& key)
-        {
-            auto iter = ManifestFieldTypes.find(key);
-            if (iter != ManifestFieldTypes.end())
-            {
-                return iter->second;
-            }
-
-            return YamlScalarType::String;
-        }
-
-        Json::Value YamlScalarNodeToJson(const YAML::Node& scalarNode, YamlScalarType scalarType)
-        {
-            if (scalarType == YamlScalarType::Int)
-            {
-                return Json::Value(scalarNode.as<int>());
-            }
-            else
-            {
-                return Json::Value(scalarNode.as<std::string>());
-            }
-        }
-
-        Json::Value ManifestYamlNodeToJson(const YAML::Node& rootNode, YamlScalarType scalarType = YamlScalarType::String)
+        // Gets the resource that holds the schema for the manifest type.
+        int GetSchemaResourceId(const ManifestVer& manifestVersion, ManifestTypeEnum manifestType)
         {
-            Json::Value result;
-
-            if (rootNode.IsNull())
-            {
-                result = Json::Value::nullSingleton();
-            }
-            else if (rootNode.IsMap())
+            if (manifestVersion >= ManifestVer{ s_ManifestVersionV1 })
             {
-                for (auto const& keyValuePair : rootNode.Mapping())
+                switch (manifestType)
                 {
-                    // We only support string type as key in our manifest
-                    auto key = keyValuePair.first.as<std::string>();
-                    result[keyValuePair.first.as<std::string>()] = ManifestYamlNodeToJson(keyValuePair.second, GetManifestScalarValueType(key));
+                case AppInstaller::Manifest::ManifestTypeEnum::Singleton:
+                    return IDX_MANIFEST_SCHEMA_V1_SINGLETON;
+                case AppInstaller::Manifest::ManifestTypeEnum::Version:
+                    return IDX_MANIFEST_SCHEMA_V1_VERSION;
+                case AppInstaller::Manifest::ManifestTypeEnum::Installer:
+                    return IDX_MANIFEST_SCHEMA_V1_INSTALLER;
+                case AppInstaller::Manifest::ManifestTypeEnum::DefaultLocale:
+                    return IDX_MANIFEST_SCHEMA_V1_DEFAULTLOCALE;
+                case AppInstaller::Manifest::ManifestTypeEnum::Locale:
+                    return IDX_MANIFEST_SCHEMA_V1_LOCALE;
+                default:
+                    THROW_HR(HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
                 }
             }
-            else if (rootNode.IsSequence())
-            {
-                for (auto const& value : rootNode.Sequence())
-                {
-                    result.append(ManifestYamlNodeToJson(value, scalarType));
-                }
-            }
-            else if (rootNode.IsScalar())
-            {
-                result = YamlScalarNodeToJson(rootNode, scalarType);
-            }
             else
             {
-                THROW_HR(E_UNEXPECTED);
+                return IDX_MANIFEST_SCHEMA_PREVIEW;
             }
+        }
+    }
 
-            return result;
+    YamlScalarType GetManifestScalarValueType(std::string_view key)
+    {
+        auto iter = ManifestFieldTypes.find(key);
+        if (iter != ManifestFieldTypes.end())
+        {
+            return iter->second;
         }
+
+        return YamlScalarType::String;
     }
 
     Json::Value LoadSchemaDoc(const ManifestVer& manifestVersion, ManifestTypeEnum manifestType)
     {
-        std::string schemaStr;
+        return JsonSchema::LoadResourceAsSchemaDoc(MAKEINTRESOURCE(GetSchemaResourceId(manifestVersion, manifestType)), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
+    }
 
-        if (manifestVersion >= ManifestVer{ s_ManifestVersionV1 })
-        {
-            switch (manifestType)
-            {
-            case AppInstaller::Manifest::ManifestTypeEnum::Singleton:
-                schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_V1_SINGLETON), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
-                break;
-            case AppInstaller::Manifest::ManifestTypeEnum::Version:
-                schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_V1_VERSION), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
-                break;
-            case AppInstaller::Manifest::ManifestTypeEnum::Installer:
-                schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_V1_INSTALLER), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
-                break;
-            case AppInstaller::Manifest::ManifestTypeEnum::DefaultLocale:
-                schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_V1_DEFAULTLOCALE), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
-                break;
-            case AppInstaller::Manifest::ManifestTypeEnum::Locale:
-                schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_V1_LOCALE), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
-                break;
-            default:
-                THROW_HR(HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED));
-            }
-        }
-        else
+    const valijson::Schema& GetManifestSchema(const ManifestVer& manifestVersion, ManifestTypeEnum manifestType)
+    {
+        // Every version and type that uses the same schema resource shares a single compiled schema
+        static std::mutex s_mutex;
+        static std::map<int, std::unique_ptr<valijson::Schema>> s_schemas;
+
+        int resourceId = GetSchemaResourceId(manifestVersion, manifestType);
+
+        std::lock_guard<std::mutex> lock{ s_mutex };
+
+        auto& schema = s_schemas[resourceId];
+        if (!schema)
         {
-            schemaStr = JsonSchema::LoadResourceAsString(MAKEINTRESOURCE(IDX_MANIFEST_SCHEMA_PREVIEW), MAKEINTRESOURCE(MANIFESTSCHEMA_RESOURCE_TYPE));
+            // Copy constructor of valijson::Schema was private
+            auto newSchema = std::make_unique<valijson::Schema>();
+            JsonSchema::PopulateSchema(LoadSchemaDoc(manifestVersion, manifestType), *newSchema);
+            schema = std::move(newSchema);
         }
 
-        return JsonSchema::LoadSchemaDoc(schemaStr);
+        return *schema;
     }
 
     std::vector<ValidationError> ValidateAgainstSchema(const std::vector<YamlManifestInfo>& manifestList, const ManifestVer& manifestVersion)
     {
         std::vector<ValidationError> errors;
-        // A list of schema validator to avoid multiple loadings of same schema
-        std::map<ManifestTypeEnum, valijson::Schema> schemaList;
 
         for (const auto& entry : manifestList)
         {
-            if (schemaList.find(entry.ManifestType) == schemaList.end())
-            {
-                // Copy constructor of valijson::Schema was private
-                valijson::Schema& newSchema = schemaList.emplace(
-                    std::piecewise_construct, std::make_tuple(entry.ManifestType), std::make_tuple()).first->second;
-                Json::Value schemaJson = LoadSchemaDoc(manifestVersion, entry.ManifestType);
-                JsonSchema::PopulateSchema(schemaJson, newSchema);
-            }
-
-            const auto& schema = schemaList.find(entry.ManifestType)->second;
-            Json::Value manifestJson = ManifestYamlNodeToJson(entry.Root);
+            const auto& schema = GetManifestSchema(manifestVersion, entry.ManifestType);
+            valijson::Validator schemaValidator;
             valijson::ValidationResults results;
 
-            if (!JsonSchema::Validate(schema, manifestJson, results))
+            // The manifest is read in place rather than converted to json first
+            if (!schemaValidator.validate(schema, ManifestYamlAdapter{ entry.Root }, &results))
             {
                 errors.emplace_back(ValidationError::MessageWithFile(JsonSchema::GetErrorStringFromResults(results), entry.FileName));
             }
@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "ManifestYamlAdapter.h"
+
+namespace AppInstaller::Manifest::YamlParser
+{
+    ManifestYamlArrayValueIterator ManifestYamlArray::begin() const
+    {
+        return { m_node, 0, m_scalarType };
+    }
+
+    ManifestYamlArrayValueIterator ManifestYamlArray::end() const
+    {
+        return { m_node, m_node.size(), m_scalarType };
+    }
+
+    ManifestYamlObjectMemberIterator ManifestYamlObject::begin() const
+    {
+        return { m_node, 0 };
+    }
+
+    ManifestYamlObjectMemberIterator ManifestYamlObject::end() const
+    {
+        return { m_node, m_node.size() };
+    }
+
+    ManifestYamlObjectMemberIterator ManifestYamlObject::find(const std::string& propertyName) const
+    {
+        // The entries are ordered by key, so the last entry with the key is the one before the first greater key
+        size_t low = 0;
+        size_t high = m_node.size();
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (ManifestYamlObjectMemberIterator::GetKey(m_node, middle) <= propertyName)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if (low > 0 && ManifestYamlObjectMemberIterator::GetKey(m_node, low - 1) == propertyName)
+        {
+            return { m_node, low - 1 };
+        }
+
+        return end();
+    }
+
+    size_t ManifestYamlObject::size() const
+    {
+        size_t result = 0;
+        for (auto itr = begin(), last = end(); itr != last; ++itr)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    ManifestYamlValue::ManifestYamlValue(const YAML::Node& node, YamlScalarType scalarType) :
+        m_node(node), m_scalarType(scalarType)
+    {
+        if (node.IsNull())
+        {
+            m_kind = Kind::Null;
+        }
+        else if (node.IsMap())
+        {
+            m_kind = node.size() == 0 ? Kind::Null : Kind::Object;
+        }
+        else if (node.IsSequence())
+        {
+            m_kind = node.size() == 0 ? Kind::Null : Kind::Array;
+        }
+        else if (node.IsScalar())
+        {
+            if (scalarType == YamlScalarType::Int)
+            {
+                m_kind = Kind::Int;
+                m_int = node.as<int>();
+            }
+            else
+            {
+                m_kind = Kind::String;
+            }
+        }
+        else
+        {
+            THROW_HR(E_UNEXPECTED);
+        }
+    }
+
+    valijson::adapters::FrozenValue* ManifestYamlValue::freeze() const
+    {
+        return new ManifestYamlFrozenValue(*this);
+    }
+
+    opt::optional<ManifestYamlArray> ManifestYamlValue::getArrayOptional() const
+    {
+        if (m_kind == Kind::Array)
+        {
+            return ManifestYamlArray{ m_node, m_scalarType };
+        }
+
+        return {};
+    }
+
+    bool ManifestYamlValue::getArraySize(size_t& result) const
+    {
+        if (m_kind == Kind::Array)
+        {
+            result = m_node.size();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ManifestYamlValue::getDouble(double& result) const
+    {
+        if (m_kind == Kind::Int)
+        {
+            result = static_cast<double>(m_int);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ManifestYamlValue::getInteger(int64_t& result) const
+    {
+        if (m_kind == Kind::Int)
+        {
+            result = m_int;
+            return true;
+        }
+
+        return false;
+    }
+
+    opt::optional<ManifestYamlObject> ManifestYamlValue::getObjectOptional() const
+    {
+        if (m_kind == Kind::Object)
+        {
+            return ManifestYamlObject{ m_node };
+        }
+
+        return {};
+    }
+
+    bool ManifestYamlValue::getObjectSize(size_t& result) const
+    {
+        if (m_kind == Kind::Object)
+        {
+            result = ManifestYamlObject{ m_node }.size();
+            return true;
+        }
+
+        return false;
+    }
+
+    bool ManifestYamlValue::getString(std::string& result) const
+    {
+        if (m_kind == Kind::String)
+        {
+            result = m_node.as<std::string>();
+            return true;
+        }
+
+        return false;
+    }
+
+    ManifestYamlObjectMemberIterator::ManifestYamlObjectMemberIterator(const YAML::Node& node, size_t position) :
+        m_node(node), m_position(position), m_size(node.size())
+    {
+        SkipRepeatedKeys();
+    }
+
+    ManifestYamlObjectMember ManifestYamlObjectMemberIterator::operator*() const
+    {
+        YAML::NodeChildRange<std::pair<YAML::Node, YAML::Node>>::iterator entry{ m_node, m_position, m_size };
+        std::string_view key = entry->first.as<std::string_view>();
+        return { std::string{ key }, ManifestYamlValue{ entry->second, GetManifestScalarValueType(key) } };
+    }
+
+    ManifestYamlObjectMemberIterator& ManifestYamlObjectMemberIterator::operator++()
+    {
+        ++m_position;
+        SkipRepeatedKeys();
+        return *this;
+    }
+
+    std::string_view ManifestYamlObjectMemberIterator::GetKey(const YAML::Node& node, size_t position)
+    {
+        // We only support string type as key in our manifest
+        YAML::NodeChildRange<std::pair<YAML::Node, YAML::Node>>::iterator entry{ node, position, node.size() };
+        return entry->first.as<std::string_view>();
+    }
+
+    void ManifestYamlObjectMemberIterator::SkipRepeatedKeys()
+    {
+        while (m_position + 1 < m_size && GetKey(m_node, m_position) == GetKey(m_node, m_position + 1))
+        {
+            ++m_position;
+        }
+    }
+}
@@ -0,0 +1,256 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include "winget/Yaml.h"
+
+#include <valijson/adapters/adapter.hpp>
+#include <valijson/adapters/basic_adapter.hpp>
+#include <valijson/adapters/frozen_value.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+// A valijson adapter that reads manifest YAML nodes in place, rather than from a copy of them as Json::Value.
+// A manifest node is seen exactly as the Json::Value it used to be converted to, so that validation results do not change:
+//  - Scalars are strings, except for the values of the fields in ManifestFieldTypes, which are integers.
+//  - Null scalars, and mappings or sequences without children, are null.
+//  - A key that appears more than once in a mapping has its last value.
+namespace AppInstaller::Manifest::YamlParser
+{
+    // The type of the scalars in a manifest field.
+    enum class YamlScalarType
+    {
+        String,
+        Int
+    };
+
+    // Gets the type of the scalars in the value of the given manifest field.
+    YamlScalarType GetManifestScalarValueType(std::string_view key);
+
+    class ManifestYamlAdapter;
+    class ManifestYamlArrayValueIterator;
+    class ManifestYamlObjectMemberIterator;
+
+    using ManifestYamlObjectMember = std::pair<std::string, ManifestYamlAdapter>;
+
+    // A sequence node with at least one child.
+    class ManifestYamlArray
+    {
+    public:
+        using const_iterator = ManifestYamlArrayValueIterator;
+        using iterator = ManifestYamlArrayValueIterator;
+
+        // An empty array.
+        ManifestYamlArray() = default;
+
+        ManifestYamlArray(const YAML::Node& node, YamlScalarType scalarType) : m_node(node), m_scalarType(scalarType) {}
+
+        ManifestYamlArrayValueIterator begin() const;
+        ManifestYamlArrayValueIterator end() const;
+
+        size_t size() const { return m_node.size(); }
+
+    private:
+        YAML::Node m_node;
+        YamlScalarType m_scalarType = YamlScalarType::String;
+    };
+
+    // A mapping node with at least one child.
+    class ManifestYamlObject
+    {
+    public:
+        using const_iterator = ManifestYamlObjectMemberIterator;
+        using iterator = ManifestYamlObjectMemberIterator;
+
+        // An empty object.
+        ManifestYamlObject() = default;
+
+        ManifestYamlObject(const YAML::Node& node) : m_node(node) {}
+
+        ManifestYamlObjectMemberIterator begin() const;
+        ManifestYamlObjectMemberIterator end() const;
+
+        // Finds the member with the given name, or returns end() if there is none.
+        ManifestYamlObjectMemberIterator find(const std::string& propertyName) const;
+
+        // Gets the number of distinct keys.
+        size_t size() const;
+
+    private:
+        YAML::Node m_node;
+    };
+
+    // A manifest node, and the type of the scalars it holds.
+    class ManifestYamlValue
+    {
+    public:
+        // An empty object.
+        ManifestYamlValue() = default;
+
+        ManifestYamlValue(const YAML::Node& node, YamlScalarType scalarType);
+
+        valijson::adapters::FrozenValue* freeze() const;
+
+        opt::optional<ManifestYamlArray> getArrayOptional() const;
+        bool getArraySize(size_t& result) const;
+        bool getBool(bool&) const { return false; }
+        bool getDouble(double& result) const;
+        bool getInteger(int64_t& result) const;
+        opt::optional<ManifestYamlObject> getObjectOptional() const;
+        bool getObjectSize(size_t& result) const;
+        bool getString(std::string& result) const;
+
+        static bool hasStrictTypes() { return true; }
+
+        bool isArray() const { return m_kind == Kind::Array; }
+        bool isBool() const { return false; }
+        bool isDouble() const { return m_kind == Kind::Int; }
+        bool isInteger() const { return m_kind == Kind::Int; }
+        bool isNull() const { return m_kind == Kind::Null; }
+        bool isNumber() const { return m_kind == Kind::Int; }
+        bool isObject() const { return m_kind == Kind::Object; }
+        bool isString() const { return m_kind == Kind::String; }
+
+    private:
+        enum class Kind
+        {
+            Null,
+            String,
+            Int,
+            Array,
+            Object,
+        };
+
+        YAML::Node m_node;
+        YamlScalarType m_scalarType = YamlScalarType::String;
+        Kind m_kind = Kind::Object;
+        int m_int = 0;
+    };
+
+    // The adapter given to the valijson validator.
+    class ManifestYamlAdapter :
+        public valijson::adapters::BasicAdapter<ManifestYamlAdapter, ManifestYamlArray, ManifestYamlObjectMember, ManifestYamlObject, ManifestYamlValue>
+    {
+    public:
+        ManifestYamlAdapter() = default;
+
+        ManifestYamlAdapter(const ManifestYamlValue& value) : BasicAdapter(value) {}
+
+        // The adapter for a manifest root node.
+        ManifestYamlAdapter(const YAML::Node& node) : BasicAdapter(ManifestYamlValue{ node, YamlScalarType::String }) {}
+    };
+
+    // A copy of a value that does not depend on the adapter it came from; the nodes of the document are kept alive by it.
+    class ManifestYamlFrozenValue : public valijson::adapters::FrozenValue
+    {
+    public:
+        explicit ManifestYamlFrozenValue(const ManifestYamlValue& value) : m_value(value) {}
+
+        FrozenValue* clone() const override { return new ManifestYamlFrozenValue(m_value); }
+
+        bool equalTo(const valijson::adapters::Adapter& other, bool strict) const override
+        {
+            return ManifestYamlAdapter(m_value).equalTo(other, strict);
+        }
+
+    private:
+        ManifestYamlValue m_value;
+    };
+
+    // Visits the children of a sequence.
+    class ManifestYamlArrayValueIterator
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ManifestYamlAdapter;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ManifestYamlAdapter*;
+        using reference = ManifestYamlAdapter&;
+
+        ManifestYamlArrayValueIterator(const YAML::Node& node, size_t position, YamlScalarType scalarType) :
+            m_node(node), m_position(position), m_scalarType(scalarType) {}
+
+        ManifestYamlAdapter operator*() const { return ManifestYamlValue{ m_node[m_position], m_scalarType }; }
+
+        valijson::adapters::DerefProxy<ManifestYamlAdapter> operator->() const
+        {
+            return valijson::adapters::DerefProxy<ManifestYamlAdapter>(**this);
+        }
+
+        bool operator==(const ManifestYamlArrayValueIterator& other) const { return m_position == other.m_position; }
+        bool operator!=(const ManifestYamlArrayValueIterator& other) const { return m_position != other.m_position; }
+
+        ManifestYamlArrayValueIterator& operator++()
+        {
+            ++m_position;
+            return *this;
+        }
+
+        ManifestYamlArrayValueIterator operator++(int)
+        {
+            ManifestYamlArrayValueIterator result = *this;
+            ++m_position;
+            return result;
+        }
+
+        ManifestYamlArrayValueIterator& operator--()
+        {
+            --m_position;
+            return *this;
+        }
+
+        void advance(std::ptrdiff_t n)
+        {
+            m_position += n;
+        }
+
+    private:
+        YAML::Node m_node;
+        size_t m_position;
+        YamlScalarType m_scalarType;
+    };
+
+    // Visits the members of a mapping in key order, skipping all but the last entry of a repeated key.
+    class ManifestYamlObjectMemberIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ManifestYamlObjectMember;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ManifestYamlObjectMember*;
+        using reference = ManifestYamlObjectMember&;
+
+        ManifestYamlObjectMemberIterator(const YAML::Node& node, size_t position);
+
+        ManifestYamlObjectMember operator*() const;
+
+        valijson::adapters::DerefProxy<ManifestYamlObjectMember> operator->() const
+        {
+            return valijson::adapters::DerefProxy<ManifestYamlObjectMember>(**this);
+        }
+
+        bool operator==(const ManifestYamlObjectMemberIterator& other) const { return m_position == other.m_position; }
+        bool operator!=(const ManifestYamlObjectMemberIterator& other) const { return m_position != other.m_position; }
+
+        ManifestYamlObjectMemberIterator& operator++();
+
+        ManifestYamlObjectMemberIterator operator++(int)
+        {
+            ManifestYamlObjectMemberIterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        // Gets the key of the entry at the given position in the mapping.
+        static std::string_view GetKey(const YAML::Node& node, size_t position);
+
+    private:
+        // Moves to the last entry with the key at the current position.
+        void SkipRepeatedKeys();
+
+        YAML::Node m_node;
+        size_t m_position;
+        size_t m_size;
+    };
+}
@@ -4,12 +4,39 @@
 #include "AppInstallerSHA256.h"
 #include "winget/ManifestYamlPopulator.h"
 
+#include <bitset>
+
 namespace AppInstaller::Manifest
 {
     using ValidationErrors = std::vector<ValidationError>;
 
     namespace
     {
+        // Folds the case of a character the same way that Utility::CaseInsensitiveEquals does, without allocating.
+        char FoldCase(char c)
+        {
+            return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        bool FoldedEquals(std::string_view a, std::string_view b)
+        {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return FoldCase(x) == FoldCase(y); });
+        }
+
+        // FNV-1a of the case folded name, varied by the seed so that a seed without collisions can be searched for.
+        uint32_t FoldedHash(std::string_view name, uint32_t seed)
+        {
+            uint32_t result = 2166136261u ^ (seed * 0x9E3779B9u);
+
+            for (char c : name)
+            {
+                result ^= static_cast<uint8_t>(FoldCase(c));
+                result *= 16777619u;
+            }
+
+            return result ^ (result >> 16);
+        }
+
         // Only used in preview manifest
         std::vector<Manifest::string_t> SplitMultiValueField(const std::string& input)
         {
@@ -103,15 +130,99 @@ namespace AppInstaller::Manifest
         }
     }
 
+    ManifestYamlPopulator::FieldProcessTable::FieldProcessTable(std::vector<FieldProcessInfo> fieldInfos)
+    {
+        // Only the first of the fields with the same name could ever be found
+        for (const auto& fieldInfo : fieldInfos)
+        {
+            if (std::none_of(m_fieldInfos.begin(), m_fieldInfos.end(), [&](const FieldProcessInfo& f) { return FoldedEquals(f.Name, fieldInfo.Name); }))
+            {
+                m_fieldInfos.emplace_back(fieldInfo);
+            }
+        }
+
+        THROW_HR_IF(E_UNEXPECTED, m_fieldInfos.size() > MaxFieldCount);
+
+        // Search for a seed that gives every field its own slot, growing the table if one is not found quickly
+        size_t slotCount = 1;
+        while (slotCount < m_fieldInfos.size() * 2)
+        {
+            slotCount *= 2;
+        }
+
+        for (;; slotCount *= 2)
+        {
+            for (m_seed = 0; m_seed < 1000; ++m_seed)
+            {
+                m_slots.assign(slotCount, 0);
+                bool collision = false;
+
+                for (size_t i = 0; i < m_fieldInfos.size() && !collision; ++i)
+                {
+                    uint8_t& slot = m_slots[FoldedHash(m_fieldInfos[i].Name, m_seed) & (slotCount - 1)];
+                    collision = (slot != 0);
+                    slot = static_cast<uint8_t>(i + 1);
+                }
+
+                if (!collision)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    size_t ManifestYamlPopulator::FieldProcessTable::Find(std::string_view key) const
+    {
+        uint8_t slot = m_slots[FoldedHash(key, m_seed) & (m_slots.size() - 1)];
+
+        if (slot == 0 || !FoldedEquals(m_fieldInfos[slot - 1].Name, key))
+        {
+            return npos;
+        }
+
+        return slot - 1;
+    }
+
+    ManifestYamlPopulator::FieldProcessTables::FieldProcessTables(const ManifestVer& manifestVersion) :
+        Root(GetRootFieldProcessInfo(manifestVersion)),
+        Installer(GetInstallerFieldProcessInfo(manifestVersion)),
+        Switches(GetSwitchesFieldProcessInfo(manifestVersion)),
+        Dependencies(GetDependenciesFieldProcessInfo(manifestVersion)),
+        PackageDependencies(GetPackageDependenciesFieldProcessInfo(manifestVersion)),
+        Localization(GetLocalizationFieldProcessInfo(manifestVersion))
+    {
+    }
+
+    const ManifestYamlPopulator::FieldProcessTables& ManifestYamlPopulator::GetFieldProcessTables(const ManifestVer& manifestVersion)
+    {
+        // The tables only depend on the version and on the extensions that add fields
+        using Key = std::pair<std::string, bool>;
+        static std::mutex s_mutex;
+        static std::map<Key, std::unique_ptr<FieldProcessTables>> s_tables;
+
+        Key key{ manifestVersion.ToString(), manifestVersion.HasExtension(s_MSStoreExtension) };
+
+        std::lock_guard<std::mutex> lock{ s_mutex };
+
+        auto& tables = s_tables[key];
+        if (!tables)
+        {
+            tables = std::make_unique<FieldProcessTables>(manifestVersion);
+        }
+
+        return *tables;
+    }
+
     std::vector<ManifestYamlPopulator::FieldProcessInfo> ManifestYamlPopulator::GetRootFieldProcessInfo(const ManifestVer& manifestVersion)
     {
         // Common fields across versions
         std::vector<FieldProcessInfo> result =
         {
-            { "ManifestVersion", [](const YAML::Node&)->ValidationErrors { /* ManifestVersion already populated. Field listed here for duplicate and PascalCase check */ return {}; } },
-            { "Installers", [this](const YAML::Node& value)->ValidationErrors { m_p_installersNode = &value; return {}; } },
-            { "Localization", [this](const YAML::Node& value)->ValidationErrors { m_p_localizationsNode = &value; return {}; } },
-            { "Channel", [this](const YAML::Node& value)->ValidationErrors { m_p_manifest->Channel = Utility::Trim(value.as<std::string>()); return {}; } },
+            { "ManifestVersion", [](ManifestYamlPopulator&, const YAML::Node&)->ValidationErrors { /* ManifestVersion already populated. Field listed here for duplicate and PascalCase check */ return {}; } },
+            { "Installers", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_installersNode = value; return {}; } },
+            { "Localization", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_localizationsNode = value; return {}; } },
+            { "Channel", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_manifest->Channel = Utility::Trim(value.as<std::string>()); return {}; } },
         };
 
         // Additional version specific fields
@@ -119,9 +230,9 @@ namespace AppInstaller::Manifest
         {
             std::vector<FieldProcessInfo> previewRootFields
             {
-                { "Id", [this](const YAML::Node& value)->ValidationErrors { m_p_manifest->Id = Utility::Trim(value.as<std::string>()); return {}; } },
-                { "Version", [this](const YAML::Node& value)->ValidationErrors { m_p_manifest->Version = Utility::Trim(value.as<std::string>()); return {}; } },
-                { "AppMoniker", [this](const YAML::Node& value)->ValidationErrors {  m_p_manifest->Moniker = Utility::Trim(value.as<std::string>()); return {}; } },
+                { "Id", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_manifest->Id = Utility::Trim(value.as<std::string>()); return {}; } },
+                { "Version", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_manifest->Version = Utility::Trim(value.as<std::string>()); return {}; } },
+                { "AppMoniker", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors {  populator.m_p_manifest->Moniker = Utility::Trim(value.as<std::string>()); return {}; } },
             };
 
             std::move(previewRootFields.begin(), previewRootFields.end(), std::inserter(result, result.end()));
@@ -133,10 +244,10 @@ namespace AppInstaller::Manifest
             {
                 std::vector<FieldProcessInfo> v1RootFields
                 {
-                    { "PackageIdentifier", [this](const YAML::Node& value)->ValidationErrors { m_p_manifest->Id = Utility::Trim(value.as<std::string>()); return {}; } },
-                    { "PackageVersion", [this](const YAML::Node& value)->ValidationErrors { m_p_manifest->Version = Utility::Trim(value.as<std::string>()); return {}; } },
-                    { "Moniker", [this](const YAML::Node& value)->ValidationErrors {  m_p_manifest->Moniker = Utility::Trim(value.as<std::string>()); return {}; } },
-                    { "ManifestType", [](const YAML::Node&)->ValidationErrors { /* ManifestType already checked. Field listed here for duplicate and PascalCase check */ return {}; } },
+                    { "PackageIdentifier", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_manifest->Id = Utility::Trim(value.as<std::string>()); return {}; } },
+                    { "PackageVersion", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_manifest->Version = Utility::Trim(value.as<std::string>()); return {}; } },
+                    { "Moniker", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors {  populator.m_p_manifest->Moniker = Utility::Trim(value.as<std::string>()); return {}; } },
+                    { "ManifestType", [](ManifestYamlPopulator&, const YAML::Node&)->ValidationErrors { /* ManifestType already checked. Field listed here for duplicate and PascalCase check */ return {}; } },
                 };
 
                 std::move(v1RootFields.begin(), v1RootFields.end(), std::inserter(result, result.end()));
@@ -158,9 +269,9 @@ namespace AppInstaller::Manifest
         // Common fields across versions
         std::vector<FieldProcessInfo> result =
         {
-            { "InstallerType", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->InstallerType = ConvertToInstallerTypeEnum(value.as<std::string>()); return {}; } },
-            { "PackageFamilyName", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->PackageFamilyName = value.as<std::string>(); return {}; } },
-            { "ProductCode", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->ProductCode = value.as<std::string>(); return {}; } },
+            { "InstallerType", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->InstallerType = ConvertToInstallerTypeEnum(value.as<std::string>()); return {}; } },
+            { "PackageFamilyName", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->PackageFamilyName = value.as<std::string>(); return {}; } },
+            { "ProductCode", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->ProductCode = value.as<std::string>(); return {}; } },
         };
 
         // Additional version specific fields
@@ -169,8 +280,8 @@ namespace AppInstaller::Manifest
             // Root level and Localization node level
             std::vector<FieldProcessInfo> previewCommonFields =
             {
-                { "UpdateBehavior", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->UpdateBehavior = ConvertToUpdateBehaviorEnum(value.as<std::string>()); return {}; } },
-                { "Switches", [this](const YAML::Node& value)->ValidationErrors { m_p_switches = &(m_p_installer->Switches); return ValidateAndProcessFields(value, SwitchesFieldInfos); } },
+                { "UpdateBehavior", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->UpdateBehavior = ConvertToUpdateBehaviorEnum(value.as<std::string>()); return {}; } },
+                { "Switches", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_switches = &(populator.m_p_installer->Switches); return populator.ValidateAndProcessFields(value, populator.m_tables->Switches); } },
             };
 
             std::move(previewCommonFields.begin(), previewCommonFields.end(), std::inserter(result, result.end()));
@@ -180,17 +291,17 @@ namespace AppInstaller::Manifest
                 // Installer node only
                 std::vector<FieldProcessInfo> installerOnlyFields =
                 {
-                    { "Arch", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Arch = Utility::ConvertToArchitectureEnum(value.as<std::string>()); return {}; } },
-                    { "Url", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Url = value.as<std::string>(); return {}; } },
-                    { "Sha256", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Sha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
-                    { "SignatureSha256", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->SignatureSha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
-                    { "Language", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Locale = value.as<std::string>(); return {}; } },
-                    { "Scope", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Scope = ConvertToScopeEnum(value.as<std::string>()); return {}; } },
+                    { "Arch", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Arch = Utility::ConvertToArchitectureEnum(value.as<std::string>()); return {}; } },
+                    { "Url", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Url = value.as<std::string>(); return {}; } },
+                    { "Sha256", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Sha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
+                    { "SignatureSha256", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->SignatureSha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
+                    { "Language", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Locale = value.as<std::string>(); return {}; } },
+                    { "Scope", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Scope = ConvertToScopeEnum(value.as<std::string>()); return {}; } },
                 };
 
                 if (manifestVersion.HasExtension(s_MSStoreExtension))
                 {
-                    installerOnlyFields.emplace_back("ProductId", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->ProductId = value.as<std::string>(); return {}; });
+                    installerOnlyFields.emplace_back("ProductId", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->ProductId = value.as<std::string>(); return {}; });
                 }
 
                 std::move(installerOnlyFields.begin(), installerOnlyFields.end(), std::inserter(result, result.end()));
@@ -200,10 +311,10 @@ namespace AppInstaller::Manifest
                 // Root node only
                 std::vector<FieldProcessInfo> rootOnlyFields =
                 {
-                    { "MinOSVersion", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->MinOSVersion = value.as<std::string>(); return {}; } },
-                    { "Commands", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Commands = SplitMultiValueField(value.as<std::string>()); return {}; } },
-                    { "Protocols", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Protocols = SplitMultiValueField(value.as<std::string>()); return {}; } },
-                    { "FileExtensions", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->FileExtensions = SplitMultiValueField(value.as<std::string>()); return {}; } },
+                    { "MinOSVersion", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->MinOSVersion = value.as<std::string>(); return {}; } },
+                    { "Commands", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Commands = SplitMultiValueField(value.as<std::string>()); return {}; } },
+                    { "Protocols", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Protocols = SplitMultiValueField(value.as<std::string>()); return {}; } },
+                    { "FileExtensions", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->FileExtensions = SplitMultiValueField(value.as<std::string>()); return {}; } },
                 };
 
                 std::move(rootOnlyFields.begin(), rootOnlyFields.end(), std::inserter(result, result.end()));
@@ -217,20 +328,20 @@ namespace AppInstaller::Manifest
                 // Root level and Installer node level
                 std::vector<FieldProcessInfo> v1CommonFields =
                 {
-                    { "InstallerLocale", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Locale = value.as<std::string>(); return {}; } },
-                    { "Platform", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Platform = ProcessPlatformSequenceNode(value); return {}; } },
-                    { "MinimumOSVersion", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->MinOSVersion = value.as<std::string>(); return {}; } },
-                    { "Scope", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Scope = ConvertToScopeEnum(value.as<std::string>()); return {}; } },
-                    { "InstallModes", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->InstallModes = ProcessInstallModeSequenceNode(value); return {}; } },
-                    { "InstallerSwitches", [this](const YAML::Node& value)->ValidationErrors { m_p_switches = &(m_p_installer->Switches); return ValidateAndProcessFields(value, SwitchesFieldInfos); } },
-                    { "InstallerSuccessCodes", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->InstallerSuccessCodes = ProcessInstallerSuccessCodeSequenceNode(value); return {}; } },
-                    { "UpgradeBehavior", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->UpdateBehavior = ConvertToUpdateBehaviorEnum(value.as<std::string>()); return {}; } },
-                    { "Commands", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Commands = ProcessStringSequenceNode(value); return {}; } },
-                    { "Protocols", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Protocols = ProcessStringSequenceNode(value); return {}; } },
-                    { "FileExtensions", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->FileExtensions = ProcessStringSequenceNode(value); return {}; } },
-                    { "Dependencies", [this](const YAML::Node& value)->ValidationErrors { m_p_dependency = &(m_p_installer->Dependencies); return ValidateAndProcessFields(value, DependenciesFieldInfos); } },
-                    { "Capabilities", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Capabilities = ProcessStringSequenceNode(value); return {}; } },
-                    { "RestrictedCapabilities", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->RestrictedCapabilities = ProcessStringSequenceNode(value); return {}; } },
+                    { "InstallerLocale", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Locale = value.as<std::string>(); return {}; } },
+                    { "Platform", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Platform = ProcessPlatformSequenceNode(value); return {}; } },
+                    { "MinimumOSVersion", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->MinOSVersion = value.as<std::string>(); return {}; } },
+                    { "Scope", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Scope = ConvertToScopeEnum(value.as<std::string>()); return {}; } },
+                    { "InstallModes", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->InstallModes = ProcessInstallModeSequenceNode(value); return {}; } },
+                    { "InstallerSwitches", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_switches = &(populator.m_p_installer->Switches); return populator.ValidateAndProcessFields(value, populator.m_tables->Switches); } },
+                    { "InstallerSuccessCodes", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->InstallerSuccessCodes = ProcessInstallerSuccessCodeSequenceNode(value); return {}; } },
+                    { "UpgradeBehavior", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->UpdateBehavior = ConvertToUpdateBehaviorEnum(value.as<std::string>()); return {}; } },
+                    { "Commands", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Commands = ProcessStringSequenceNode(value); return {}; } },
+                    { "Protocols", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Protocols = ProcessStringSequenceNode(value); return {}; } },
+                    { "FileExtensions", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->FileExtensions = ProcessStringSequenceNode(value); return {}; } },
+                    { "Dependencies", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_dependency = &(populator.m_p_installer->Dependencies); return populator.ValidateAndProcessFields(value, populator.m_tables->Dependencies); } },
+                    { "Capabilities", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Capabilities = ProcessStringSequenceNode(value); return {}; } },
+                    { "RestrictedCapabilities", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->RestrictedCapabilities = ProcessStringSequenceNode(value); return {}; } },
                 };
 
                 std::move(v1CommonFields.begin(), v1CommonFields.end(), std::inserter(result, result.end()));
@@ -240,10 +351,10 @@ namespace AppInstaller::Manifest
                     // Installer level only fields
                     std::vector<FieldProcessInfo> v1InstallerFields =
                     {
-                        { "Architecture", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Arch = Utility::ConvertToArchitectureEnum(value.as<std::string>()); return {}; } },
-                        { "InstallerUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Url = value.as<std::string>(); return {}; } },
-                        { "InstallerSha256", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->Sha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
-                        { "SignatureSha256", [this](const YAML::Node& value)->ValidationErrors { m_p_installer->SignatureSha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
+                        { "Architecture", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Arch = Utility::ConvertToArchitectureEnum(value.as<std::string>()); return {}; } },
+                        { "InstallerUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Url = value.as<std::string>(); return {}; } },
+                        { "InstallerSha256", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->Sha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
+                        { "SignatureSha256", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_installer->SignatureSha256 = Utility::SHA256::ConvertToBytes(value.as<std::string>()); return {}; } },
                     };
 
                     std::move(v1InstallerFields.begin(), v1InstallerFields.end(), std::inserter(result, result.end()));
@@ -259,24 +370,24 @@ namespace AppInstaller::Manifest
         // Common fields across versions
         std::vector<FieldProcessInfo> result =
         {
-            { "Custom", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Custom] = value.as<std::string>(); return{}; } },
-            { "Silent", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Silent] = value.as<std::string>(); return{}; } },
-            { "SilentWithProgress", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::SilentWithProgress] = value.as<std::string>(); return{}; } },
-            { "Interactive", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Interactive] = value.as<std::string>(); return{}; } },
-            { "Log", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Log] = value.as<std::string>(); return{}; } },
-            { "InstallLocation", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::InstallLocation] = value.as<std::string>(); return{}; } },
+            { "Custom", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Custom] = value.as<std::string>(); return{}; } },
+            { "Silent", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Silent] = value.as<std::string>(); return{}; } },
+            { "SilentWithProgress", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::SilentWithProgress] = value.as<std::string>(); return{}; } },
+            { "Interactive", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Interactive] = value.as<std::string>(); return{}; } },
+            { "Log", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Log] = value.as<std::string>(); return{}; } },
+            { "InstallLocation", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::InstallLocation] = value.as<std::string>(); return{}; } },
         };
 
         // Additional version specific fields
         if (manifestVersion.Major() == 0)
         {
             // Language only exists in preview manifests. Though we don't use it in our code yet, keep it here to be consistent with schema.
-            result.emplace_back("Language", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Language] = value.as<std::string>(); return{}; });
-            result.emplace_back("Update", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Update] = value.as<std::string>(); return{}; });
+            result.emplace_back("Language", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Language] = value.as<std::string>(); return{}; });
+            result.emplace_back("Update", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Update] = value.as<std::string>(); return{}; });
         }
         else if (manifestVersion.Major() == 1)
         {
-            result.emplace_back("Upgrade", [this](const YAML::Node& value)->ValidationErrors { (*m_p_switches)[InstallerSwitchType::Update] = value.as<std::string>(); return{}; });
+            result.emplace_back("Upgrade", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { (*populator.m_p_switches)[InstallerSwitchType::Update] = value.as<std::string>(); return{}; });
         }
 
         return result;
@@ -287,31 +398,31 @@ namespace AppInstaller::Manifest
         // Common fields across versions
         std::vector<FieldProcessInfo> result =
         {
-            { "Description", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Description>(Utility::Trim(value.as<std::string>())); return {}; } },
-            { "LicenseUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::LicenseUrl>(value.as<std::string>()); return {}; } },
+            { "Description", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Description>(Utility::Trim(value.as<std::string>())); return {}; } },
+            { "LicenseUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::LicenseUrl>(value.as<std::string>()); return {}; } },
         };
 
         // Additional version specific fields
         if (manifestVersion.Major() == 0)
         {
             // Root level and Localization node level
-            result.emplace_back("Homepage", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PackageUrl>(value.as<std::string>()); return {}; });
+            result.emplace_back("Homepage", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PackageUrl>(value.as<std::string>()); return {}; });
 
             if (!forRootFields)
             {
                 // Localization node only
-                result.emplace_back("Language", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Locale = value.as<std::string>(); return {}; });
+                result.emplace_back("Language", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Locale = value.as<std::string>(); return {}; });
             }
             else
             {
                 // Root node only
                 std::vector<FieldProcessInfo> rootOnlyFields =
                 {
-                    { "Name", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PackageName>(Utility::Trim(value.as<std::string>())); return {}; } },
-                    { "Publisher", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Publisher>(value.as<std::string>()); return {}; } },
-                    { "Author", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Author>(value.as<std::string>()); return {}; } },
-                    { "License", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::License>(value.as<std::string>()); return {}; } },
-                    { "Tags", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Tags>(SplitMultiValueField(value.as<std::string>())); return {}; } },
+                    { "Name", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PackageName>(Utility::Trim(value.as<std::string>())); return {}; } },
+                    { "Publisher", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Publisher>(value.as<std::string>()); return {}; } },
+                    { "Author", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Author>(value.as<std::string>()); return {}; } },
+                    { "License", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::License>(value.as<std::string>()); return {}; } },
+                    { "Tags", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Tags>(SplitMultiValueField(value.as<std::string>())); return {}; } },
                 };
 
                 std::move(rootOnlyFields.begin(), rootOnlyFields.end(), std::inserter(result, result.end()));
@@ -325,19 +436,19 @@ namespace AppInstaller::Manifest
                 // Root level and Localization node level
                 std::vector<FieldProcessInfo> v1CommonFields =
                 {
-                    { "PackageLocale", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Locale = value.as<std::string>(); return {}; } },
-                    { "Publisher", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Publisher>(value.as<std::string>()); return {}; } },
-                    { "PublisherUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PublisherUrl>(value.as<std::string>()); return {}; } },
-                    { "PublisherSupportUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PublisherSupportUrl>(value.as<std::string>()); return {}; } },
-                    { "PrivacyUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PrivacyUrl>(value.as<std::string>()); return {}; } },
-                    { "Author", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Author>(value.as<std::string>()); return {}; } },
-                    { "PackageName", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PackageName>(Utility::Trim(value.as<std::string>())); return {}; } },
-                    { "PackageUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::PackageUrl>(value.as<std::string>()); return {}; } },
-                    { "License", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::License>(value.as<std::string>()); return {}; } },
-                    { "Copyright", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Copyright>(value.as<std::string>()); return {}; } },
-                    { "CopyrightUrl", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::CopyrightUrl>(value.as<std::string>()); return {}; } },
-                    { "ShortDescription", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::ShortDescription>(Utility::Trim(value.as<std::string>())); return {}; } },
-                    { "Tags", [this](const YAML::Node& value)->ValidationErrors { m_p_localization->Add<Localization::Tags>(ProcessStringSequenceNode(value)); return {}; } },
+                    { "PackageLocale", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Locale = value.as<std::string>(); return {}; } },
+                    { "Publisher", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Publisher>(value.as<std::string>()); return {}; } },
+                    { "PublisherUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PublisherUrl>(value.as<std::string>()); return {}; } },
+                    { "PublisherSupportUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PublisherSupportUrl>(value.as<std::string>()); return {}; } },
+                    { "PrivacyUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PrivacyUrl>(value.as<std::string>()); return {}; } },
+                    { "Author", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Author>(value.as<std::string>()); return {}; } },
+                    { "PackageName", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PackageName>(Utility::Trim(value.as<std::string>())); return {}; } },
+                    { "PackageUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::PackageUrl>(value.as<std::string>()); return {}; } },
+                    { "License", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::License>(value.as<std::string>()); return {}; } },
+                    { "Copyright", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Copyright>(value.as<std::string>()); return {}; } },
+                    { "CopyrightUrl", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::CopyrightUrl>(value.as<std::string>()); return {}; } },
+                    { "ShortDescription", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::ShortDescription>(Utility::Trim(value.as<std::string>())); return {}; } },
+                    { "Tags", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_localization->Add<Localization::Tags>(ProcessStringSequenceNode(value)); return {}; } },
                 };
 
                 std::move(v1CommonFields.begin(), v1CommonFields.end(), std::inserter(result, result.end()));
@@ -355,10 +466,10 @@ namespace AppInstaller::Manifest
         {
             result =
             {
-                { "WindowsFeatures", [this](const YAML::Node& value)->ValidationErrors { m_p_dependency->WindowsFeatures = ProcessStringSequenceNode(value); return {}; } },
-                { "WindowsLibraries", [this](const YAML::Node& value)->ValidationErrors { m_p_dependency->WindowsLibraries = ProcessStringSequenceNode(value); return {}; } },
-                { "PackageDependencies", [this](const YAML::Node& value)->ValidationErrors { return ProcessPackageDependenciesNode(value, m_p_dependency->PackageDependencies); } },
-                { "ExternalDependencies", [this](const YAML::Node& value)->ValidationErrors { m_p_dependency->ExternalDependencies = ProcessStringSequenceNode(value); return {}; } },
+                { "WindowsFeatures", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_dependency->WindowsFeatures = ProcessStringSequenceNode(value); return {}; } },
+                { "WindowsLibraries", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_dependency->WindowsLibraries = ProcessStringSequenceNode(value); return {}; } },
+                { "PackageDependencies", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { return populator.ProcessPackageDependenciesNode(value, populator.m_p_dependency->PackageDependencies); } },
+                { "ExternalDependencies", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_dependency->ExternalDependencies = ProcessStringSequenceNode(value); return {}; } },
             };
         }
 
@@ -373,8 +484,8 @@ namespace AppInstaller::Manifest
         {
             result =
             {
-                { "PackageIdentifier", [this](const YAML::Node& value)->ValidationErrors { m_p_packageDependency->Id = Utility::Trim(value.as<std::string>()); return {}; } },
-                { "MinimumVersion", [this](const YAML::Node& value)->ValidationErrors { m_p_packageDependency->MinVersion = Utility::Trim(value.as<std::string>()); return {}; } },
+                { "PackageIdentifier", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_packageDependency->Id = Utility::Trim(value.as<std::string>()); return {}; } },
+                { "MinimumVersion", [](ManifestYamlPopulator& populator, const YAML::Node& value)->ValidationErrors { populator.m_p_packageDependency->MinVersion = Utility::Trim(value.as<std::string>()); return {}; } },
             };
         }
 
@@ -383,7 +494,7 @@ namespace AppInstaller::Manifest
 
     ValidationErrors ManifestYamlPopulator::ValidateAndProcessFields(
         const YAML::Node& rootNode,
-        const std::vector<FieldProcessInfo>& fieldInfos)
+        const FieldProcessTable& fieldInfos)
     {
         ValidationErrors resultErrors;
 
@@ -393,47 +504,45 @@ namespace AppInstaller::Manifest
             return resultErrors;
         }
 
-        // Keeps track of already processed fields. Used to check duplicate fields.
-        std::set<std::string> processedFields;
+        // Keeps track of already processed fields, by their index in the table. Used to check duplicate fields.
+        std::bitset<FieldProcessTable::MaxFieldCount> processedFields;
 
         for (auto const& keyValuePair : rootNode.Mapping())
         {
-            std::string key = keyValuePair.first.as<std::string>();
+            std::string_view key = keyValuePair.first.as<std::string_view>();
             const YAML::Node& valueNode = keyValuePair.second;
 
             // We'll do case insensitive search first and validate correct case later.
-            auto fieldIter = std::find_if(fieldInfos.begin(), fieldInfos.end(),
-                [&](auto const& s)
-                {
-                    return Utility::CaseInsensitiveEquals(s.Name, key);
-                });
+            size_t fieldIndex = fieldInfos.Find(key);
 
-            if (fieldIter != fieldInfos.end())
+            if (fieldIndex != FieldProcessTable::npos)
             {
-                const FieldProcessInfo& fieldInfo = *fieldIter;
+                const FieldProcessInfo& fieldInfo = fieldInfos[fieldIndex];
 
                 // Make sure the found key is in Pascal Case
                 if (key != fieldInfo.Name)
                 {
-                    resultErrors.emplace_back(ManifestError::FieldIsNotPascalCase, key, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column);
+                    resultErrors.emplace_back(ManifestError::FieldIsNotPascalCase, std::string{ key }, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column);
                 }
 
                 // Make sure it's not a duplicate key
-                if (!processedFields.insert(fieldInfo.Name).second)
+                if (processedFields.test(fieldIndex))
                 {
-                    resultErrors.emplace_back(ManifestError::FieldDuplicate, fieldInfo.Name, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column);
+                    resultErrors.emplace_back(ManifestError::FieldDuplicate, std::string{ fieldInfo.Name }, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column);
                 }
 
+                processedFields.set(fieldIndex);
+
                 if (!valueNode.IsNull())
                 {
                     try
                     {
-                        auto errors = fieldInfo.ProcessFunc(valueNode);
+                        auto errors = fieldInfo.ProcessFunc(*this, valueNode);
                         std::move(errors.begin(), errors.end(), std::inserter(resultErrors, resultErrors.end()));
                     }
                     catch (const std::exception&)
                     {
-                        resultErrors.emplace_back(ManifestError::FieldFailedToProcess, fieldInfo.Name);
+                        resultErrors.emplace_back(ManifestError::FieldFailedToProcess, std::string{ fieldInfo.Name });
                     }
                 }
             }
@@ -442,7 +551,7 @@ namespace AppInstaller::Manifest
                 // For full validation, also reports unrecognized fields as warning
                 if (m_fullValidation)
                 {
-                    resultErrors.emplace_back(ManifestError::FieldUnknown, key, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column, ValidationError::Level::Warning);
+                    resultErrors.emplace_back(ManifestError::FieldUnknown, std::string{ key }, "", m_isMergedManifest ? 0 : keyValuePair.first.Mark().line, m_isMergedManifest ? 0 : keyValuePair.first.Mark().column, ValidationError::Level::Warning);
                 }
             }
         }
@@ -459,7 +568,7 @@ namespace AppInstaller::Manifest
         {
             PackageDependency packageDependency;
             m_p_packageDependency = &packageDependency;
-            auto errors = ValidateAndProcessFields(entry, PackageDependenciesFieldInfos);
+            auto errors = ValidateAndProcessFields(entry, m_tables->PackageDependencies);
             std::move(errors.begin(), errors.end(), std::inserter(resultErrors, resultErrors.end()));
             packageDependencies.emplace_back(std::move(std::move(packageDependency)));
         }
@@ -470,32 +579,27 @@ namespace AppInstaller::Manifest
     ValidationErrors ManifestYamlPopulator::PopulateManifestInternal(const YAML::Node& rootNode, Manifest& manifest, const ManifestVer& manifestVersion, bool fullValidation)
     {
         m_fullValidation = fullValidation;
-        m_isMergedManifest = !rootNode["ManifestType"sv].IsNull() && rootNode["ManifestType"sv].as<std::string>() == "merged";
+        m_isMergedManifest = !rootNode["ManifestType"sv].IsNull() && rootNode["ManifestType"sv].as<std::string_view>() == "merged"sv;
 
         ValidationErrors resultErrors;
         manifest.ManifestVersion = manifestVersion;
 
         // Prepare field infos
-        RootFieldInfos = GetRootFieldProcessInfo(manifestVersion);
-        InstallerFieldInfos = GetInstallerFieldProcessInfo(manifestVersion);
-        SwitchesFieldInfos = GetSwitchesFieldProcessInfo(manifestVersion);
-        DependenciesFieldInfos = GetDependenciesFieldProcessInfo(manifestVersion);
-        PackageDependenciesFieldInfos = GetPackageDependenciesFieldProcessInfo(manifestVersion);
-        LocalizationFieldInfos = GetLocalizationFieldProcessInfo(manifestVersion);
+        m_tables = &GetFieldProcessTables(manifestVersion);
 
         // Populate root
         m_p_manifest = &manifest;
         m_p_installer = &(manifest.DefaultInstallerInfo);
         m_p_localization = &(manifest.DefaultLocalization);
-        resultErrors = ValidateAndProcessFields(rootNode, RootFieldInfos);
+        resultErrors = ValidateAndProcessFields(rootNode, m_tables->Root);
 
-        if (!m_p_installersNode)
+        if (!m_installersNode)
         {
             return resultErrors;
         }
 
         // Populate installers
-        for (auto const& entry : m_p_installersNode->Sequence())
+        for (auto const& entry : m_installersNode.Sequence())
         {
             ManifestInstaller installer = manifest.DefaultInstallerInfo;
 
@@ -504,7 +608,7 @@ namespace AppInstaller::Manifest
             installer.ProductCode.clear();
 
             m_p_installer = &installer;
-            auto errors = ValidateAndProcessFields(entry, InstallerFieldInfos);
+            auto errors = ValidateAndProcessFields(entry, m_tables->Installer);
             std::move(errors.begin(), errors.end(), std::inserter(resultErrors, resultErrors.end()));
 
             // Copy in system reference strings from the root if not set in the installer and appropriate
@@ -532,13 +636,13 @@ namespace AppInstaller::Manifest
         }
 
         // Populate additional localizations
-        if (m_p_localizationsNode && m_p_localizationsNode->IsSequence())
+        if (m_localizationsNode.IsSequence())
         {
-            for (auto const& entry : m_p_localizationsNode->Sequence())
+            for (auto const& entry : m_localizationsNode.Sequence())
             {
                 ManifestLocalization localization;
                 m_p_localization = &localization;
-                auto errors = ValidateAndProcessFields(entry, LocalizationFieldInfos);
+                auto errors = ValidateAndProcessFields(entry, m_tables->Localization);
                 std::move(errors.begin(), errors.end(), std::inserter(resultErrors, resultErrors.end()));
                 manifest.Localizations.emplace_back(std::move(std::move(localization)));
             }
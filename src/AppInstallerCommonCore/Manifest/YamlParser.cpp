@@ -7,6 +7,9 @@
 #include "winget/ManifestYamlPopulator.h"
 #include "winget/ManifestYamlParser.h"
 
+#include <atomic>
+#include <thread>
+
 namespace AppInstaller::Manifest::YamlParser
 {
     namespace
@@ -132,48 +135,52 @@ namespace AppInstaller::Manifest::YamlParser
             // V1 manifest validations
             else
             {
-                // Check required fields used by later consistency check for better error message instead of
-                // Field Type Not Match error.
-                for (auto const& entry : input)
-                {
-                    ValidateV1ManifestInput(entry);
-                }
-
                 if (isMultifileManifest)
                 {
+                    // Check required fields used by later consistency check for better error message instead of
+                    // Field Type Not Match error.
+                    ValidateV1ManifestInput(firstYamlManifest);
+
                     // Populates the PackageIdentifier and PackageVersion from first doc for later consistency check
-                    std::string packageId = firstYamlManifest.Root["PackageIdentifier"].as<std::string>();
-                    std::string packageVersion = firstYamlManifest.Root["PackageVersion"].as<std::string>();
+                    std::string_view packageId = firstYamlManifest.Root["PackageIdentifier"].as<std::string_view>();
+                    std::string_view packageVersion = firstYamlManifest.Root["PackageVersion"].as<std::string_view>();
 
-                    std::set<std::string> localesSet;
+                    std::set<std::string_view> localesSet;
 
                     bool isVersionManifestFound = false;
                     bool isInstallerManifestFound = false;
                     bool isDefaultLocaleManifestFound = false;
-                    std::string defaultLocaleFromVersionManifest;
-                    std::string defaultLocaleFromDefaultLocaleManifest;
+                    std::string_view defaultLocaleFromVersionManifest;
+                    std::string_view defaultLocaleFromDefaultLocaleManifest;
 
+                    // A single pass over the files; a file that is missing required fields fails immediately, with only its own
+                    // errors, as it would if every file were checked for them before any of the consistency checks.
                     for (auto& entry : input)
                     {
-                        std::string localPackageId = entry.Root["PackageIdentifier"].as<std::string>();
+                        if (&entry != &firstYamlManifest)
+                        {
+                            ValidateV1ManifestInput(entry);
+                        }
+
+                        std::string_view localPackageId = entry.Root["PackageIdentifier"].as<std::string_view>();
                         if (localPackageId != packageId)
                         {
                             errors.emplace_back(ValidationError::MessageFieldValueWithFile(
-                                ManifestError::InconsistentMultiFileManifestFieldValue, "PackageIdentifier", localPackageId, entry.FileName));
+                                ManifestError::InconsistentMultiFileManifestFieldValue, "PackageIdentifier", std::string{ localPackageId }, entry.FileName));
                         }
 
-                        std::string localPackageVersion = entry.Root["PackageVersion"].as<std::string>();
+                        std::string_view localPackageVersion = entry.Root["PackageVersion"].as<std::string_view>();
                         if (localPackageVersion != packageVersion)
                         {
                             errors.emplace_back(ValidationError::MessageFieldValueWithFile(
-                                ManifestError::InconsistentMultiFileManifestFieldValue, "PackageVersion", localPackageVersion, entry.FileName));
+                                ManifestError::InconsistentMultiFileManifestFieldValue, "PackageVersion", std::string{ localPackageVersion }, entry.FileName));
                         }
 
-                        std::string localManifestVersion = entry.Root["ManifestVersion"].as<std::string>();
+                        std::string_view localManifestVersion = entry.Root["ManifestVersion"].as<std::string_view>();
                         if (localManifestVersion != manifestVersionStr)
                         {
                             errors.emplace_back(ValidationError::MessageFieldValueWithFile(
-                                ManifestError::InconsistentMultiFileManifestFieldValue, "ManifestVersion", localManifestVersion, entry.FileName));
+                                ManifestError::InconsistentMultiFileManifestFieldValue, "ManifestVersion", std::string{ localManifestVersion }, entry.FileName));
                         }
 
                         std::string manifestTypeStr = entry.Root["ManifestType"sv].as<std::string>();
@@ -191,7 +198,7 @@ namespace AppInstaller::Manifest::YamlParser
                             else
                             {
                                 isVersionManifestFound = true;
-                                defaultLocaleFromVersionManifest = entry.Root["DefaultLocale"sv].as<std::string>();
+                                defaultLocaleFromVersionManifest = entry.Root["DefaultLocale"sv].as<std::string_view>();
                             }
                             break;
                         case ManifestTypeEnum::Installer:
@@ -214,31 +221,23 @@ namespace AppInstaller::Manifest::YamlParser
                             else
                             {
                                 isDefaultLocaleManifestFound = true;
-                                auto packageLocale = entry.Root["PackageLocale"sv].as<std::string>();
+                                auto packageLocale = entry.Root["PackageLocale"sv].as<std::string_view>();
                                 defaultLocaleFromDefaultLocaleManifest = packageLocale;
 
-                                if (localesSet.find(packageLocale) != localesSet.end())
+                                if (!localesSet.insert(packageLocale).second)
                                 {
                                     errors.emplace_back(ValidationError::MessageFieldValueWithFile(
-                                        ManifestError::DuplicateMultiFileManifestLocale, "PackageLocale", packageLocale, entry.FileName));
-                                }
-                                else
-                                {
-                                    localesSet.insert(packageLocale);
+                                        ManifestError::DuplicateMultiFileManifestLocale, "PackageLocale", std::string{ packageLocale }, entry.FileName));
                                 }
                             }
                             break;
                         case ManifestTypeEnum::Locale:
                         {
-                            auto packageLocale = entry.Root["PackageLocale"sv].as<std::string>();
-                            if (localesSet.find(packageLocale) != localesSet.end())
+                            auto packageLocale = entry.Root["PackageLocale"sv].as<std::string_view>();
+                            if (!localesSet.insert(packageLocale).second)
                             {
                                 errors.emplace_back(ValidationError::MessageFieldValueWithFile(
-                                    ManifestError::DuplicateMultiFileManifestLocale, "PackageLocale", packageLocale, entry.FileName));
-                            }
-                            else
-                            {
-                                localesSet.insert(packageLocale);
+                                    ManifestError::DuplicateMultiFileManifestLocale, "PackageLocale", std::string{ packageLocale }, entry.FileName));
                             }
                         }
                         break;
@@ -260,6 +259,8 @@ namespace AppInstaller::Manifest::YamlParser
                 }
                 else
                 {
+                    ValidateV1ManifestInput(firstYamlManifest);
+
                     std::string manifestTypeStr = firstYamlManifest.Root["ManifestType"sv].as<std::string>();
                     ManifestTypeEnum manifestType = ConvertToManifestTypeEnum(manifestTypeStr);
                     firstYamlManifest.ManifestType = manifestType;
@@ -305,46 +306,51 @@ namespace AppInstaller::Manifest::YamlParser
             THROW_HR_IF(E_UNEXPECTED, !input.IsMap());
             THROW_HR_IF(E_UNEXPECTED, !destination.IsMap());
 
-            const std::vector<std::string> FieldsToIgnore = { "PackageIdentifier", "PackageVersion", "ManifestType", "ManifestVersion" };
+            const std::string_view FieldsToIgnore[] = { "PackageIdentifier"sv, "PackageVersion"sv, "ManifestType"sv, "ManifestVersion"sv };
 
             for (auto const& keyValuePair : input.Mapping())
             {
                 // We only support string type as key in our manifest
-                if (std::find(FieldsToIgnore.begin(), FieldsToIgnore.end(), keyValuePair.first.as<std::string>()) == FieldsToIgnore.end())
+                if (std::find(std::begin(FieldsToIgnore), std::end(FieldsToIgnore), keyValuePair.first.as<std::string_view>()) == std::end(FieldsToIgnore))
                 {
-                    YAML::Node key = keyValuePair.first;
-                    YAML::Node value = keyValuePair.second;
-                    destination.AddMappingNode(std::move(key), std::move(value));
+                    destination.AddMappingNode(keyValuePair.first, keyValuePair.second);
                 }
             }
         }
 
         YAML::Node MergeMultiFileManifest(const std::vector<YamlManifestInfo>& input)
         {
-            // Starts with installer manifest
-            YAML::Node result = FindUniqueRequiredDocFromMultiFileManifest(input, ManifestTypeEnum::Installer);
+            // Starts with a copy of the installer manifest; nodes refer to their document, so the input would otherwise be changed.
+            // The copies share the text of the input rather than copying it.
+            YAML::Node result{ YAML::Node::Type::Mapping, "", YAML::Mark() };
+            const YAML::Node& installerManifest = FindUniqueRequiredDocFromMultiFileManifest(input, ManifestTypeEnum::Installer);
+            THROW_HR_IF(E_UNEXPECTED, !installerManifest.IsMap());
+
+            for (auto const& keyValuePair : installerManifest.Mapping())
+            {
+                result.AddMappingNode(keyValuePair.first, keyValuePair.second);
+            }
 
             // Copy default locale manifest content into manifest root
             YAML::Node defaultLocaleManifest = FindUniqueRequiredDocFromMultiFileManifest(input, ManifestTypeEnum::DefaultLocale);
             MergeOneManifestToMultiFileManifest(defaultLocaleManifest, result);
 
-            // Copy additional locale manifests
-            YAML::Node localizations{ YAML::Node::Type::Sequence, "", YAML::Mark() };
-            for (const auto& entry : input)
-            {
-                if (entry.ManifestType == ManifestTypeEnum::Locale)
-                {
-                    YAML::Node localization{ YAML::Node::Type::Mapping, "", YAML::Mark() };
-                    MergeOneManifestToMultiFileManifest(entry.Root, localization);
-                    localizations.AddSequenceNode(std::move(localization));
-                }
-            }
-
-            if (localizations.size() > 0)
+            // Copy additional locale manifests, straight into the sequence in the result so that each is only copied once
+            bool hasLocaleManifests = std::any_of(input.begin(), input.end(), [](const YamlManifestInfo& entry) { return entry.ManifestType == ManifestTypeEnum::Locale; });
+            if (hasLocaleManifests)
             {
                 YAML::Node key{ YAML::Node::Type::Scalar, "", YAML::Mark() };
                 key.SetScalar("Localization");
-                result.AddMappingNode(std::move(key), std::move(localizations));
+                YAML::Node localizations = result.AddMappingNode(key, YAML::Node::Type::Sequence, "", YAML::Mark());
+
+                for (const auto& entry : input)
+                {
+                    if (entry.ManifestType == ManifestTypeEnum::Locale)
+                    {
+                        YAML::Node localization = localizations.AddSequenceNode(YAML::Node::Type::Mapping, "", YAML::Mark());
+                        MergeOneManifestToMultiFileManifest(entry.Root, localization);
+                    }
+                }
             }
 
             result["ManifestType"sv].SetScalar("merged");
@@ -377,7 +383,7 @@ namespace AppInstaller::Manifest::YamlParser
             }
             else if (input.IsScalar())
             {
-                emitter << input.as<std::string>();
+                emitter << input.as<std::string_view>();
             }
             else if (input.IsNull())
             {
@@ -454,44 +460,125 @@ namespace AppInstaller::Manifest::YamlParser
 
             return resultErrors;
         }
-    }
 
-    Manifest CreateFromPath(
-        const std::filesystem::path& inputPath,
-        bool fullValidation,
-        bool throwOnWarning,
-        const std::filesystem::path& mergedManifestPath,
-        bool schemaValidationOnly)
-    {
-        std::vector<YamlManifestInfo> docList;
+        // The number of files in a manifest directory from which they are loaded on the process thread pool.
+        // Most manifests have only a few files, which are loaded faster on the calling thread than it takes to start others.
+        constexpr size_t c_parallelLoadFileCount = 8;
 
-        try
+        void CALLBACK RunLoadManifestWorker(PTP_CALLBACK_INSTANCE, PVOID context, PTP_WORK)
+        {
+            (*static_cast<std::function<void()>*>(context))();
+        }
+
+        // Loads and hashes the files of a multi file manifest, concurrently on the process thread pool when there are enough of them.
+        // The files are kept in the order of the directory, and the error reported is the one from the first file to fail in that order.
+        std::vector<YamlManifestInfo> LoadManifestDirectory(const std::filesystem::path& inputPath)
         {
-            if (std::filesystem::is_directory(inputPath))
+            std::vector<std::filesystem::path> files;
+
+            // A subdirectory is only reported if none of the files before it failed to load
+            bool foundSubdirectory = false;
+            for (const auto& file : std::filesystem::directory_iterator(inputPath))
             {
-                for (const auto& file : std::filesystem::directory_iterator(inputPath))
+                if (std::filesystem::is_directory(file.path()))
                 {
-                    THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_DIRECTORY_NOT_SUPPORTED), std::filesystem::is_directory(file.path()), "Subdirectory not supported in manifest path");
+                    foundSubdirectory = true;
+                    break;
+                }
 
-                    YamlManifestInfo doc;
-                    doc.Root = YAML::Load(file.path());
-                    doc.FileName = file.path().filename().u8string();
-                    docList.emplace_back(std::move(doc));
+                files.emplace_back(file.path());
+            }
+
+            std::vector<YamlManifestInfo> docList(files.size());
+            std::vector<std::exception_ptr> loadErrors(files.size());
+            std::atomic<size_t> nextDoc = 0;
+
+            std::function<void()> worker = [&]()
+            {
+                for (size_t i = nextDoc++; i < docList.size(); i = nextDoc++)
+                {
+                    try
+                    {
+                        docList[i].Root = YAML::Load(files[i], docList[i].StreamSha256);
+                        docList[i].FileName = files[i].filename().u8string();
+                    }
+                    catch (...)
+                    {
+                        loadErrors[i] = std::current_exception();
+                    }
                 }
+            };
+
+            if (docList.size() >= c_parallelLoadFileCount)
+            {
+                // The calling thread works too, so it only waits for the pool once every file has been started
+                size_t workerCount = std::min<size_t>(docList.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+                wil::unique_threadpool_work_nocancel work{ CreateThreadpoolWork(RunLoadManifestWorker, &worker, nullptr) };
+                THROW_LAST_ERROR_IF(!work);
+
+                for (size_t i = 1; i < workerCount; ++i)
+                {
+                    SubmitThreadpoolWork(work.get());
+                }
+
+                worker();
+                WaitForThreadpoolWorkCallbacks(work.get(), FALSE);
             }
             else
             {
-                YamlManifestInfo doc;
-                doc.Root = YAML::Load(inputPath, doc.StreamSha256);
-                doc.FileName = inputPath.filename().u8string();
-                docList.emplace_back(std::move(doc));
+                worker();
             }
+
+            for (const auto& loadError : loadErrors)
+            {
+                if (loadError)
+                {
+                    std::rethrow_exception(loadError);
+                }
+            }
+
+            THROW_HR_IF_MSG(HRESULT_FROM_WIN32(ERROR_DIRECTORY_NOT_SUPPORTED), foundSubdirectory, "Subdirectory not supported in manifest path");
+
+            return docList;
         }
-        catch (const std::exception& e)
+
+        // Loads the manifest file, or every file in the manifest directory.
+        std::vector<YamlManifestInfo> LoadManifestDocuments(const std::filesystem::path& inputPath)
         {
-            THROW_EXCEPTION_MSG(ManifestException(), e.what());
+            std::vector<YamlManifestInfo> docList;
+
+            try
+            {
+                if (std::filesystem::is_directory(inputPath))
+                {
+                    docList = LoadManifestDirectory(inputPath);
+                }
+                else
+                {
+                    YamlManifestInfo doc;
+                    doc.Root = YAML::Load(inputPath, doc.StreamSha256);
+                    doc.FileName = inputPath.filename().u8string();
+                    docList.emplace_back(std::move(doc));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                THROW_EXCEPTION_MSG(ManifestException(), e.what());
+            }
+
+            return docList;
         }
+    }
 
+    Manifest CreateFromPath(
+        const std::filesystem::path& inputPath,
+        bool fullValidation,
+        bool throwOnWarning,
+        const std::filesystem::path& mergedManifestPath,
+        bool schemaValidationOnly)
+    {
+        std::vector<YamlManifestInfo> docList = LoadManifestDocuments(inputPath);
         return ParseManifest(docList, fullValidation, throwOnWarning, mergedManifestPath, schemaValidationOnly);
     }
 
@@ -111,6 +111,9 @@ namespace AppInstaller
             m_data[E].emplace<Variant::Index(E)>(v);
         }
 
+        // Removes a value from the map, if present.
+        void Remove(Enum e) { m_data.erase(e); }
+
         // Return a value indicating whether the given enum is stored in the map.
         bool Contains(Enum e) const { return (m_data.find(e) != m_data.end()); }
 
@@ -15,6 +15,7 @@ namespace AppInstaller::Utility {
     // Class used to compute SHA256 hashes over various sets of data.
     // Create one and Add data to it if the data is not all available,
     // or simply call ComputeHash if the data is all in memory.
+    // The SHA instructions of the processor are used when it has them; otherwise the platform implementation is used.
     class SHA256
     {
     public:
@@ -122,6 +122,9 @@ namespace AppInstaller::Logging
 
         void LogNonFatalDOError(std::string_view url, HRESULT hr) const noexcept;
 
+        // Logs the use of the response cache of a REST source.
+        void LogRestResponseCacheSummary(std::string_view sourceName, size_t hits, size_t revalidations, size_t misses, size_t evictions) const noexcept;
+
     protected:
         TelemetryTraceLogger();
 
@@ -180,6 +183,11 @@ namespace AppInstaller::Logging
     {
         SubExecutionTelemetryScope();
 
+        // Logs telemetry from the current thread only as the given sub execution, from CreateSubExecutionId.
+        // This allows the work of a sub execution to be spread over several scopes and threads, while other sub executions
+        // are active on other threads. Must be destroyed on the thread that created it.
+        explicit SubExecutionTelemetryScope(uint32_t subExecutionId);
+
         SubExecutionTelemetryScope(const SubExecutionTelemetryScope&) = delete;
         SubExecutionTelemetryScope& operator=(const SubExecutionTelemetryScope&) = delete;
 
@@ -188,7 +196,11 @@ namespace AppInstaller::Logging
 
         ~SubExecutionTelemetryScope();
 
+        // Gets the id of a new sub execution, for use with scopes on the threads that do its work.
+        static uint32_t CreateSubExecutionId();
+
     private:
+        bool m_currentThreadOnly = false;
         static std::atomic_uint32_t m_sessionId;
     };
 }
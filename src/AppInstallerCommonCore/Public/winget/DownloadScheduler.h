@@ -0,0 +1,125 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerDownloader.h>
+#include <AppInstallerProgress.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AppInstaller::Utility
+{
+    // Measurements of a single download.
+    struct DownloadMetrics
+    {
+        // The time spent waiting for the download to be allowed to start.
+        std::chrono::milliseconds QueueTime{};
+
+        // The time from the start of the download until now, or until it ended.
+        std::chrono::milliseconds TransferTime{};
+
+        // The part of the transfer time spent waiting to stay within the bandwidth limit.
+        std::chrono::milliseconds ThrottledTime{};
+
+        uint64_t Bytes = 0;
+
+        // Gets the average rate of the transfer, or 0 if nothing has been transferred.
+        uint64_t GetBytesPerSecond() const;
+    };
+
+    // Decides when downloads start and how fast they may receive data, across every download in the process.
+    // When the maximum number of downloads are already running, a new one waits for a slot; waiting downloads start
+    // in order of the priority of their type, then in the order they arrived. Running downloads share a single token
+    // bucket that limits their combined rate.
+    struct DownloadScheduler
+    {
+        struct Options
+        {
+            // The maximum number of downloads that run at once; 0 for no limit.
+            uint32_t MaxConcurrentDownloads = 0;
+
+            // The maximum combined rate of all downloads; 0 for no limit.
+            uint64_t MaxBytesPerSecond = 0;
+        };
+
+        // A download that has been allowed to start. Its slot is released, and its metrics logged, when it is destroyed.
+        struct Ticket
+        {
+            Ticket(const Ticket&) = delete;
+            Ticket& operator=(const Ticket&) = delete;
+
+            Ticket(Ticket&&) = delete;
+            Ticket& operator=(Ticket&&) = delete;
+
+            ~Ticket();
+
+            // Records data received by the download, waiting as long as needed to stay within the bandwidth limit.
+            // May be called from multiple threads, as by the segments of a single download.
+            void OnBytesReceived(size_t bytes);
+
+            DownloadMetrics GetMetrics() const;
+
+        private:
+            friend DownloadScheduler;
+
+            Ticket(DownloadScheduler& scheduler, DownloadType type, IProgressCallback& progress, std::chrono::milliseconds queueTime);
+
+            DownloadScheduler& m_scheduler;
+            DownloadType m_type;
+            IProgressCallback& m_progress;
+            std::chrono::milliseconds m_queueTime;
+            std::chrono::steady_clock::time_point m_start;
+            std::atomic<uint64_t> m_bytes = 0;
+            std::atomic<int64_t> m_throttledMilliseconds = 0;
+        };
+
+        explicit DownloadScheduler(Options options);
+
+        DownloadScheduler(const DownloadScheduler&) = delete;
+        DownloadScheduler& operator=(const DownloadScheduler&) = delete;
+
+        // Gets the scheduler for every download in the process, configured from the user settings.
+        static DownloadScheduler& Instance();
+
+        // Gets the priority of downloads of the given type; waiting downloads with a higher priority start first.
+        // Small downloads that the user is usually waiting on come before installers.
+        static uint32_t GetPriority(DownloadType type);
+
+        // Waits until a download of the given type may start.
+        // Returns null if the progress is cancelled while waiting.
+        std::unique_ptr<Ticket> Acquire(DownloadType type, IProgressCallback& progress);
+
+        // Gets the number of downloads that are running and waiting.
+        size_t GetRunningCount() const;
+        size_t GetWaitingCount() const;
+
+    private:
+        struct Waiter
+        {
+            uint32_t Priority = 0;
+            uint64_t Sequence = 0;
+        };
+
+        bool CanStart(const Waiter& waiter) const;
+        void Release();
+
+        // Takes tokens for the given number of bytes from the bucket, returning how long to wait before using them.
+        std::chrono::milliseconds Reserve(size_t bytes);
+
+        Options m_options;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_changed;
+        uint32_t m_running = 0;
+        std::vector<Waiter> m_waiting;
+        uint64_t m_nextSequence = 0;
+
+        std::mutex m_bucketMutex;
+        double m_tokens = 0;
+        std::chrono::steady_clock::time_point m_lastRefill;
+    };
+}
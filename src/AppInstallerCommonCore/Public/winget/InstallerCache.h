@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerSHA256.h>
+
+#include <filesystem>
+#include <vector>
+
+namespace AppInstaller::Utility
+{
+    // An on-disk cache of installers, addressed by the SHA256 hash of their contents.
+    // Installers are only added once their hash has been verified, and every file is published with a single rename so that
+    // other processes never observe a partial entry. The cache is kept within its maximum size by removing the least recently
+    // used installers. Failures to read or write the cache are logged and otherwise ignored; the cache is only an optimization.
+    struct InstallerCache
+    {
+        // An installer in the cache.
+        struct Entry
+        {
+            SHA256::HashBuffer Hash;
+            std::filesystem::path Path;
+            uint64_t Size = 0;
+            std::filesystem::file_time_type LastUsed;
+        };
+
+        InstallerCache(std::filesystem::path directory, uint64_t maxSizeInBytes);
+
+        // Gets the cache as configured in the user settings.
+        static InstallerCache FromUserSettings();
+
+        // Gets the directory where installers are cached.
+        static std::filesystem::path GetDefaultDirectory();
+
+        // Determines whether the cache stores anything at all.
+        bool IsEnabled() const { return m_maxSizeInBytes != 0; }
+
+        // Copies the cached installer with the given hash to the destination, returning false if there is none.
+        // The contents are not verified; callers must check the hash of the copy before using it.
+        bool CopyTo(const SHA256::HashBuffer& hash, const std::filesystem::path& destination);
+
+        // Adds a copy of the file, whose contents must have the given hash, evicting the least recently used installers if the cache grows too large.
+        void Add(const SHA256::HashBuffer& hash, const std::filesystem::path& file);
+
+        // Removes the installer with the given hash, if it is cached.
+        void Remove(const SHA256::HashBuffer& hash);
+
+        // Gets the installers in the cache, most recently used first.
+        std::vector<Entry> GetEntries() const;
+
+        // Removes every installer from the cache, returning the number removed.
+        size_t Clear();
+
+    private:
+        std::filesystem::path GetEntryPath(const SHA256::HashBuffer& hash) const;
+        void EnforceMaximumSize();
+
+        std::filesystem::path m_directory;
+        uint64_t m_maxSizeInBytes = 0;
+    };
+}
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <winget/Manifest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// A compact binary encoding of Manifest, for storing manifests that have already been parsed and validated.
+// The encoding starts with a magic value and a format version; data with a different format version is rejected, so that
+// stored manifests are simply parsed again from their source when the format changes.
+//
+// The rest is a sequence of fields in a fixed order, with no names:
+//  - Integers and enums are unsigned LEB128 varints; enums are first converted to their 32 bit value.
+//  - Strings and byte arrays are a varint length followed by their bytes.
+//  - Lists and maps are a varint count followed by their items.
+//  - Localizations are a count of the values that are present, each preceded by its Localization key.
+namespace AppInstaller::Manifest::BinarySerializer
+{
+    // The version of the format written by Serialize; incremented whenever the layout of the fields or the way a value is
+    // written changes. The ManifestBinarySerializer_FormatIsStable test fails until it is.
+    constexpr uint16_t s_FormatVersion = 2;
+
+    // Encodes the manifest.
+    std::string Serialize(const Manifest& manifest);
+
+    // Decodes a manifest encoded by Serialize.
+    // Throws HRESULT_FROM_WIN32(ERROR_INVALID_DATA) if the data is truncated, corrupt or from another format version.
+    Manifest Deserialize(std::string_view data);
+
+    // Reads the values of an encoded manifest in place; strings and byte arrays refer to the data rather than being copied.
+    // Every read checks that the data holds the value, throwing HRESULT_FROM_WIN32(ERROR_INVALID_DATA) if it does not.
+    struct Reader
+    {
+        Reader(std::string_view data) : m_data(data) {}
+
+        uint64_t ReadVarint();
+        uint32_t ReadUInt32();
+        std::string_view ReadString();
+
+        template <typename E>
+        E ReadEnum()
+        {
+            return static_cast<E>(static_cast<int32_t>(ReadUInt32()));
+        }
+
+        // Reads the header, checking that it is for the current format version.
+        void ReadHeader();
+
+        // Determines whether all of the data has been read.
+        bool AtEnd() const { return m_position == m_data.size(); }
+
+    private:
+        std::string_view m_data;
+        size_t m_position = 0;
+    };
+}
@@ -42,6 +42,9 @@ namespace AppInstaller::Manifest
 
         bool HasExtension(std::string_view extension) const;
 
+        // Gets the version string including its extensions; ToString only has the main version.
+        std::string ToStringWithExtensions() const;
+
     private:
         std::vector<Version> m_extensions;
     };
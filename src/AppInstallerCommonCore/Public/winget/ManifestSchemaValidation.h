@@ -6,6 +6,11 @@
 
 #include <json.h>
 
+namespace valijson
+{
+    class Schema;
+}
+
 namespace AppInstaller::Manifest::YamlParser
 {
     // Forward declarations
@@ -14,6 +19,10 @@ namespace AppInstaller::Manifest::YamlParser
     // Load manifest schema as parsed json doc
     Json::Value LoadSchemaDoc(const ManifestVer& manifestVersion, ManifestTypeEnum manifestType);
 
+    // Gets the compiled manifest schema. Each schema is compiled the first time it is needed and is shared,
+    // unchanged, by all threads for the lifetime of the process.
+    const valijson::Schema& GetManifestSchema(const ManifestVer& manifestVersion, ManifestTypeEnum manifestType);
+
     // Validate a list of individual manifests against schema
     std::vector<ValidationError> ValidateAgainstSchema(
         const std::vector<YamlManifestInfo>& manifestList,
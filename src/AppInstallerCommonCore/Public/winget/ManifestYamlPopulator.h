@@ -16,22 +16,60 @@ namespace AppInstaller::Manifest
         bool m_fullValidation = false;
         bool m_isMergedManifest = false;
 
+        // The population logic of a field; the pointers of the populator refer to the objects being populated.
+        using FieldProcessFunc = std::vector<ValidationError>(*)(ManifestYamlPopulator& populator, const YAML::Node& value);
+
         // Struct mapping a manifest field to its population logic
         struct FieldProcessInfo
         {
-            FieldProcessInfo(std::string name, std::function<std::vector<ValidationError>(const YAML::Node&)> func) :
-                Name(std::move(name)), ProcessFunc(func) {}
+            FieldProcessInfo(std::string_view name, FieldProcessFunc func) :
+                Name(name), ProcessFunc(func) {}
 
-            std::string Name;
-            std::function<std::vector<ValidationError>(const YAML::Node&)> ProcessFunc;
+            std::string_view Name;
+            FieldProcessFunc ProcessFunc;
         };
 
-        std::vector<FieldProcessInfo> RootFieldInfos;
-        std::vector<FieldProcessInfo> InstallerFieldInfos;
-        std::vector<FieldProcessInfo> SwitchesFieldInfos;
-        std::vector<FieldProcessInfo> DependenciesFieldInfos;
-        std::vector<FieldProcessInfo> PackageDependenciesFieldInfos;
-        std::vector<FieldProcessInfo> LocalizationFieldInfos;
+        // The fields allowed in a mapping, found by a perfect hash of their case folded names.
+        struct FieldProcessTable
+        {
+            // The most fields that a table can hold.
+            static constexpr size_t MaxFieldCount = 128;
+
+            // The result of Find when no field matches.
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            FieldProcessTable(std::vector<FieldProcessInfo> fieldInfos);
+
+            // Gets the index of the field whose name matches the key, ignoring case, or npos if there is none.
+            size_t Find(std::string_view key) const;
+
+            const FieldProcessInfo& operator[](size_t index) const { return m_fieldInfos[index]; }
+
+        private:
+            std::vector<FieldProcessInfo> m_fieldInfos;
+
+            // One more than the index of the field whose hash selects the slot; zero for an empty slot.
+            std::vector<uint8_t> m_slots;
+            uint32_t m_seed = 0;
+        };
+
+        // The tables for every mapping in a manifest, which only depend on the manifest version.
+        struct FieldProcessTables
+        {
+            FieldProcessTables(const ManifestVer& manifestVersion);
+
+            FieldProcessTable Root;
+            FieldProcessTable Installer;
+            FieldProcessTable Switches;
+            FieldProcessTable Dependencies;
+            FieldProcessTable PackageDependencies;
+            FieldProcessTable Localization;
+        };
+
+        // Gets the tables for the manifest version, building them the first time the version is seen by the process.
+        static const FieldProcessTables& GetFieldProcessTables(const ManifestVer& manifestVersion);
+
+        const FieldProcessTables* m_tables = nullptr;
 
         // These pointers are referenced in the processing functions in manifest field process info table.
         AppInstaller::Manifest::Manifest* m_p_manifest = nullptr;
@@ -42,15 +80,15 @@ namespace AppInstaller::Manifest
         AppInstaller::Manifest::ManifestLocalization* m_p_localization = nullptr;
 
         // Cache of Installers node and Localization node
-        YAML::Node const* m_p_installersNode = nullptr;
-        YAML::Node const* m_p_localizationsNode = nullptr;
+        YAML::Node m_installersNode;
+        YAML::Node m_localizationsNode;
 
-        std::vector<FieldProcessInfo> GetRootFieldProcessInfo(const ManifestVer& manifestVersion);
-        std::vector<FieldProcessInfo> GetInstallerFieldProcessInfo(const ManifestVer& manifestVersion, bool forRootFields = false);
-        std::vector<FieldProcessInfo> GetSwitchesFieldProcessInfo(const ManifestVer& manifestVersion);
-        std::vector<FieldProcessInfo> GetDependenciesFieldProcessInfo(const ManifestVer& manifestVersion);
-        std::vector<FieldProcessInfo> GetPackageDependenciesFieldProcessInfo(const ManifestVer& manifestVersion);
-        std::vector<FieldProcessInfo> GetLocalizationFieldProcessInfo(const ManifestVer& manifestVersion, bool forRootFields = false);
+        static std::vector<FieldProcessInfo> GetRootFieldProcessInfo(const ManifestVer& manifestVersion);
+        static std::vector<FieldProcessInfo> GetInstallerFieldProcessInfo(const ManifestVer& manifestVersion, bool forRootFields = false);
+        static std::vector<FieldProcessInfo> GetSwitchesFieldProcessInfo(const ManifestVer& manifestVersion);
+        static std::vector<FieldProcessInfo> GetDependenciesFieldProcessInfo(const ManifestVer& manifestVersion);
+        static std::vector<FieldProcessInfo> GetPackageDependenciesFieldProcessInfo(const ManifestVer& manifestVersion);
+        static std::vector<FieldProcessInfo> GetLocalizationFieldProcessInfo(const ManifestVer& manifestVersion, bool forRootFields = false);
 
         // This method takes YAML root node and list of manifest field info.
         // Yaml lib does not support case insensitive search and it allows duplicate keys. If duplicate keys exist,
@@ -58,7 +96,7 @@ namespace AppInstaller::Manifest
         // pair ourselves. This also helps with generating aggregated error rather than throwing on first failure.
         std::vector<ValidationError> ValidateAndProcessFields(
             const YAML::Node& rootNode,
-            const std::vector<FieldProcessInfo>& fieldInfos);
+            const FieldProcessTable& fieldInfos);
 
         std::vector<ValidationError> ProcessPackageDependenciesNode(const YAML::Node& rootNode, std::vector<PackageDependency>& packageDependencies);
 
@@ -52,6 +52,7 @@ namespace AppInstaller::Settings
         Default,
         WinInet,
         DeliveryOptimization,
+        Segmented,
     };
 
     // Enum of settings.
@@ -73,8 +74,21 @@ namespace AppInstaller::Settings
         InstallScopeRequirement,
         NetworkDownloader,
         NetworkDOProgressTimeoutInSeconds,
+        NetworkDownloadSegmentCount,
+        NetworkMaxConcurrentDownloads,
+        NetworkMaxDownloadRateInKBps,
+        NetworkRestMaxConnectionsPerServer,
+        NetworkRestConnectionIdleTimeoutInSeconds,
+        NetworkRestCacheMaxSizeInMB,
+        NetworkRestCacheTimeToLiveInSeconds,
+        NetworkRestCacheSourceTimeToLiveInSeconds,
+        NetworkRestCompressionDisabledSources,
+        NetworkInstallerCacheMaxSizeInMB,
+        NetworkPackageStreamCacheMaxSizeInMB,
+        NetworkManifestCacheMaxSizeInMB,
         InstallLocalePreference,
         InstallLocaleRequirement,
+        InstallDownloadAheadCount,
         EFPackagedAPI,
         Max
     };
@@ -119,8 +133,21 @@ namespace AppInstaller::Settings
         SETTINGMAPPING_SPECIALIZATION(Setting::InstallScopeRequirement, std::string, ScopePreference, ScopePreference::None, ".installBehavior.requirements.scope"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::NetworkDownloader, std::string, InstallerDownloader, InstallerDownloader::Default, ".network.downloader"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::NetworkDOProgressTimeoutInSeconds, uint32_t, std::chrono::seconds, 60s, ".network.doProgressTimeoutInSeconds"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkDownloadSegmentCount, uint32_t, uint32_t, 4, ".network.downloadSegmentCount"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkMaxConcurrentDownloads, uint32_t, uint32_t, 4, ".network.maxConcurrentDownloads"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkMaxDownloadRateInKBps, uint32_t, uint32_t, 0, ".network.maxDownloadRateInKBps"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestMaxConnectionsPerServer, uint32_t, uint32_t, 4, ".network.restMaxConnectionsPerServer"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestConnectionIdleTimeoutInSeconds, uint32_t, std::chrono::seconds, 60s, ".network.restConnectionIdleTimeoutInSeconds"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestCacheMaxSizeInMB, uint32_t, uint32_t, 50, ".network.restCache.maxSizeInMB"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestCacheTimeToLiveInSeconds, uint32_t, std::chrono::seconds, 0s, ".network.restCache.timeToLiveInSeconds"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestCacheSourceTimeToLiveInSeconds, std::map<std::string, uint32_t>, std::map<std::string, std::chrono::seconds>, {}, ".network.restCache.sourceTimeToLiveInSeconds"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkRestCompressionDisabledSources, std::vector<std::string>, std::vector<std::string>, {}, ".network.restCompressionDisabledSources"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkInstallerCacheMaxSizeInMB, uint32_t, uint32_t, 1024, ".network.installerCache.maxSizeInMB"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkPackageStreamCacheMaxSizeInMB, uint32_t, uint32_t, 50, ".network.packageStreamCache.maxSizeInMB"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::NetworkManifestCacheMaxSizeInMB, uint32_t, uint32_t, 20, ".network.manifestCache.maxSizeInMB"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::InstallLocalePreference, std::vector<std::string>, std::vector<std::string>, {}, ".installBehavior.preferences.locale"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::InstallLocaleRequirement, std::vector<std::string>, std::vector<std::string>, {}, ".installBehavior.requirements.locale"sv);
+        SETTINGMAPPING_SPECIALIZATION(Setting::InstallDownloadAheadCount, uint32_t, uint32_t, 2, ".installBehavior.downloadAheadCount"sv);
         SETTINGMAPPING_SPECIALIZATION(Setting::EFPackagedAPI, bool, bool, false, ".experimentalFeatures.packagedAPI"sv);
 
         // Used to deduce the SettingVariant type; making a variant that includes std::monostate and all SettingMapping types.
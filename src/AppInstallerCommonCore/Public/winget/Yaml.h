@@ -4,6 +4,7 @@
 #include <AppInstallerSHA256.h>
 
 #include <fstream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
@@ -59,7 +60,19 @@ namespace AppInstaller::YAML
         std::string m_what;
     };
 
+    namespace details
+    {
+        // The flat storage shared by all of the nodes of a document.
+        struct NodeStorage;
+    }
+
+    template <typename Value>
+    struct NodeChildRange;
+
     // A YAML node.
+    // A node is a handle to an entry in the flat storage of its document. Copying a node copies the handle, not the node:
+    // the copies refer to the same node, and changes made through any of them are visible to all of them. Use Clone to get
+    // a node that can be changed independently. Scalars are views of the text retained by the storage.
     struct Node
     {
         // The node's type.
@@ -72,30 +85,31 @@ namespace AppInstaller::YAML
             Mapping
         };
 
-        Node() : m_type(Type::Invalid) {}
+        Node() = default;
         Node(Type type, std::string tag, const Mark& mark);
 
         // Sets the scalar value of the node.
         void SetScalar(std::string value);
 
-        // Adds a child node to the sequence.
+        // Creates a copy of the node, and all of its children, in a storage of its own.
+        Node Clone() const;
+
+        // Adds a copy of the child node to the end of the sequence, returning the new child.
         template <typename... Args>
-        Node& AddSequenceNode(Args&&... args)
+        Node AddSequenceNode(Args&&... args)
         {
-            Require(Type::Sequence);
-            return m_sequence->emplace_back(std::forward<Args>(args)...);
+            return AppendToSequence(Node(std::forward<Args>(args)...));
         }
 
-        // Adds a child node to the mapping.
+        // Adds a copy of the key and child node to the mapping, returning the new child.
         template <typename... Args>
-        Node& AddMappingNode(Node&& key, Args&&... args)
+        Node AddMappingNode(const Node& key, Args&&... args)
         {
-            Require(Type::Mapping);
-            return m_mapping->emplace(std::move(key), Node(std::forward<Args>(args)...))->second;
+            return AppendToMapping(key, Node(std::forward<Args>(args)...));
         }
 
         bool IsDefined() const { return m_type != Type::Invalid; }
-        bool IsNull() const { return m_type == Type::Invalid || m_type == Type::None || (m_type == Type::Scalar && m_scalar.empty()); }
+        bool IsNull() const { return m_type == Type::Invalid || m_type == Type::None || (m_type == Type::Scalar && GetScalar().empty()); }
         bool IsScalar() const { return m_type == Type::Scalar; }
         bool IsSequence() const { return m_type == Type::Sequence; }
         bool IsMap() const { return m_type == Type::Mapping; }
@@ -103,6 +117,7 @@ namespace AppInstaller::YAML
         explicit operator bool() const { return IsDefined(); }
 
         // Gets the scalar value as the requested type.
+        // A std::string_view result refers to the storage of the document, and is only valid as long as a node of it is.
         template <typename T>
         T as() const
         {
@@ -113,44 +128,129 @@ namespace AppInstaller::YAML
 
         bool operator<(const Node& other) const;
 
-        // Gets a child node from the mapping by its name.
-        Node& operator[](std::string_view key);
-        const Node& operator[](std::string_view key) const;
+        // Gets a child node from the mapping by its name; the result is not defined if there is no such child.
+        Node operator[](std::string_view key) const;
 
         // Gets a child node from the sequence by its index.
-        Node& operator[](size_t index);
-        const Node& operator[](size_t index) const;
+        Node operator[](size_t index) const;
 
         // Gets the number of child nodes.
         size_t size() const;
 
         // Gets the mark for this node.
-        const Mark& Mark() const { return m_mark; }
+        const Mark& Mark() const;
 
         // Gets the nodes in the sequence.
-        const std::vector<Node>& Sequence() const;
+        NodeChildRange<Node> Sequence() const;
 
-        // Gets the nodes in the mapping.
-        const std::multimap<Node, Node>& Mapping() const;
+        // Gets the key and value nodes in the mapping, ordered by key.
+        NodeChildRange<std::pair<Node, Node>> Mapping() const;
 
     private:
-        Node(std::string_view key) : m_type(Type::Scalar), m_scalar(key) {}
+        template <typename Value>
+        friend struct NodeChildRange;
+        friend details::NodeStorage;
+
+        Node(std::shared_ptr<details::NodeStorage> storage, uint32_t index);
 
         // Require certain node types to; throwing if the requirement is not met.
         void Require(Type type) const;
 
+        // Gets the scalar value, or an empty value if this is not a scalar.
+        std::string_view GetScalar() const;
+
+        // Makes this node refer to the child of the parent at the given position.
+        void BindToChild(const Node& parent, size_t position);
+
+        Node AppendToSequence(const Node& child);
+        Node AppendToMapping(const Node& key, const Node& value);
+
         // The workers for the as function.
         std::string as_dispatch(std::string*) const;
+        std::string_view as_dispatch(std::string_view*) const;
         int64_t as_dispatch(int64_t*) const;
         int as_dispatch(int*) const;
         bool as_dispatch(bool*) const;
 
-        Type m_type;
-        std::string m_tag;
-        YAML::Mark m_mark;
-        std::string m_scalar;
-        std::optional<std::vector<Node>> m_sequence;
-        std::optional<std::multimap<Node, Node>> m_mapping;
+        std::shared_ptr<details::NodeStorage> m_storage;
+        uint32_t m_index = 0;
+        Type m_type = Type::Invalid;
+    };
+
+    // The children of a sequence or mapping node, visited in order without copying the document.
+    // For a mapping, each value is a pair of the key and value nodes.
+    template <typename Value>
+    struct NodeChildRange
+    {
+        struct iterator
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Value*;
+            using reference = const Value&;
+
+            iterator(const Node& parent, size_t position, size_t size) :
+                m_parent(parent), m_position(position), m_size(size)
+            {
+                Bind();
+            }
+
+            reference operator*() const { return m_value; }
+            pointer operator->() const { return &m_value; }
+
+            iterator& operator++()
+            {
+                ++m_position;
+                Bind();
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator result = *this;
+                ++(*this);
+                return result;
+            }
+
+            bool operator==(const iterator& other) const { return m_position == other.m_position; }
+            bool operator!=(const iterator& other) const { return m_position != other.m_position; }
+
+        private:
+            // The value is rebound in place so that stepping does not copy the storage reference.
+            void Bind()
+            {
+                if (m_position < m_size)
+                {
+                    if constexpr (std::is_same_v<Value, Node>)
+                    {
+                        m_value.BindToChild(m_parent, m_position);
+                    }
+                    else
+                    {
+                        m_value.first.BindToChild(m_parent, m_position * 2);
+                        m_value.second.BindToChild(m_parent, m_position * 2 + 1);
+                    }
+                }
+            }
+
+            Node m_parent;
+            size_t m_position = 0;
+            size_t m_size = 0;
+            Value m_value;
+        };
+
+        NodeChildRange(const Node& parent) : m_parent(parent), m_size(parent.size()) {}
+
+        iterator begin() const { return { m_parent, 0, m_size }; }
+        iterator end() const { return { m_parent, m_size, m_size }; }
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+    private:
+        Node m_parent;
+        size_t m_size;
     };
 
     // Loads from the input; returns the root node of the first document.
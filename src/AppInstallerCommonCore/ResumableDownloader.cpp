@@ -0,0 +1,320 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/AppInstallerDownloader.h"
+#include "Public/AppInstallerErrors.h"
+#include "Public/AppInstallerSHA256.h"
+#include "Public/AppInstallerLogging.h"
+#include "DownloadPipeline.h"
+#include "ResumableDownloader.h"
+#include "WinINetUtil.h"
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Utility
+{
+    using namespace WinINet;
+
+    namespace
+    {
+        constexpr DWORD s_BufferSize = 1024 * 1024; // 1MB
+
+        // How much is written between updates of the sidecar; at most this much is downloaded again if the process ends abruptly.
+        constexpr uint64_t s_SidecarInterval = 16 << 20;
+
+        constexpr std::string_view s_SidecarExtension = ".resume"sv;
+
+        // The contents of the sidecar file.
+        struct ResumeState
+        {
+            std::string Url;
+            std::string Validator;
+            uint64_t Length = 0;
+        };
+
+        std::optional<ResumeState> ReadSidecar(const std::filesystem::path& path)
+        {
+            std::ifstream stream{ path, std::ios_base::in | std::ios_base::binary };
+            if (!stream)
+            {
+                return {};
+            }
+
+            Json::Value json;
+            Json::CharReaderBuilder charReaderBuilder;
+            Json::String jsonErrors;
+            if (!Json::parseFromStream(charReaderBuilder, stream, &json, &jsonErrors))
+            {
+                AICLI_LOG(Core, Warning, << "Download sidecar does not contain valid JSON: " << jsonErrors);
+                return {};
+            }
+
+            if (!json.isObject() || !json["Url"].isString() || !json["Validator"].isString() || !json["Length"].isUInt64())
+            {
+                AICLI_LOG(Core, Warning, << "Download sidecar is missing values");
+                return {};
+            }
+
+            ResumeState result;
+            result.Url = json["Url"].asString();
+            result.Validator = json["Validator"].asString();
+            result.Length = json["Length"].asUInt64();
+            return result;
+        }
+
+        void WriteSidecar(const std::filesystem::path& path, const ResumeState& state)
+        {
+            Json::Value json{ Json::ValueType::objectValue };
+            json["Url"] = state.Url;
+            json["Validator"] = state.Validator;
+            json["Length"] = Json::UInt64{ state.Length };
+
+            Json::StreamWriterBuilder writerBuilder;
+            writerBuilder.settings_["indentation"] = "";
+            std::string contents = Json::writeString(writerBuilder, json);
+
+            std::filesystem::path tempPath = path;
+            tempPath += ".tmp";
+
+            {
+                std::ofstream stream{ tempPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+                stream.write(contents.c_str(), contents.size());
+                stream.flush();
+                THROW_HR_IF(E_FAIL, !stream);
+            }
+
+            // Replace the sidecar in a single step so that it never describes a partially written state
+            std::filesystem::rename(tempPath, path);
+        }
+
+        // Gets the value to send in If-Range to continue downloading this response; only a strong ETag or a date can be used.
+        std::string GetValidator(HINTERNET request)
+        {
+            std::string etag = GetHeader(request, HTTP_QUERY_ETAG);
+            if (!etag.empty() && etag.rfind("W/", 0) != 0)
+            {
+                return etag;
+            }
+
+            return GetHeader(request, HTTP_QUERY_LAST_MODIFIED);
+        }
+
+        void HashPrefix(const std::filesystem::path& file, uint64_t length, SHA256& hashEngine)
+        {
+            std::ifstream stream{ file, std::ios_base::in | std::ios_base::binary };
+            auto buffer = std::make_unique<char[]>(s_BufferSize);
+
+            for (uint64_t remaining = length; remaining > 0;)
+            {
+                std::streamsize toRead = static_cast<std::streamsize>(std::min<uint64_t>(s_BufferSize, remaining));
+                stream.read(buffer.get(), toRead);
+                THROW_HR_IF(E_UNEXPECTED, stream.gcount() != toRead);
+
+                hashEngine.Add(reinterpret_cast<const uint8_t*>(buffer.get()), static_cast<size_t>(toRead));
+                remaining -= toRead;
+            }
+        }
+    }
+
+    std::filesystem::path GetResumeSidecarPath(const std::filesystem::path& dest)
+    {
+        std::filesystem::path result = dest;
+        result += s_SidecarExtension;
+        return result;
+    }
+
+    std::optional<std::vector<BYTE>> ResumableDownload(
+        const std::string& url,
+        const std::filesystem::path& dest,
+        IProgressCallback& progress,
+        bool computeHash,
+        DownloadScheduler::Ticket* ticket)
+    {
+        AICLI_LOG(Core, Info, << "WinINet downloading from url: " << url);
+
+        std::filesystem::path sidecarPath = GetResumeSidecarPath(dest);
+        wil::unique_hinternet session = OpenSession();
+
+        wil::unique_hinternet request;
+        DWORD requestStatus = 0;
+        uint64_t offset = 0;
+
+        std::optional<ResumeState> previous = ReadSidecar(sidecarPath);
+        std::error_code error;
+        if (previous && previous->Url == url && !previous->Validator.empty() && previous->Length > 0 &&
+            std::filesystem::file_size(dest, error) >= previous->Length && !error)
+        {
+            AICLI_LOG(Core, Info, << "Resuming download after " << previous->Length << " bytes");
+
+            request = OpenUrl(session.get(), url, "Range: bytes=" + std::to_string(previous->Length) + "-\r\nIf-Range: " + previous->Validator + "\r\n");
+            requestStatus = GetStatusCode(request.get());
+
+            std::optional<ContentRange> contentRange;
+            if (requestStatus == HTTP_STATUS_PARTIAL_CONTENT)
+            {
+                contentRange = ParseContentRange(GetHeader(request.get(), HTTP_QUERY_CONTENT_RANGE));
+            }
+
+            if (contentRange && contentRange->First == previous->Length)
+            {
+                // Anything after the recorded length may not have been completely written
+                std::filesystem::resize_file(dest, previous->Length);
+                offset = previous->Length;
+            }
+            else
+            {
+                // The file has changed or the server does not support ranges; either way, the existing part cannot be used
+                AICLI_LOG(Core, Info, << "Server did not resume the download. Returned status: " << requestStatus);
+
+                if (requestStatus != HTTP_STATUS_OK)
+                {
+                    request.reset();
+                }
+            }
+        }
+
+        if (offset == 0)
+        {
+            // Start over with an empty file, marked before anything is written to it
+            std::ofstream emptyDestFile(dest);
+            emptyDestFile.close();
+            ApplyMotwIfApplicable(dest, URLZONE_INTERNET);
+
+            if (!request)
+            {
+                request = OpenUrl(session.get(), url);
+                requestStatus = GetStatusCode(request.get());
+            }
+
+            if (requestStatus != HTTP_STATUS_OK)
+            {
+                AICLI_LOG(Core, Error, << "Download request failed. Returned status: " << requestStatus);
+                THROW_HR_MSG(MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, requestStatus), "Download request status is not success.");
+            }
+        }
+
+        AICLI_LOG(Core, Verbose, << "Download request status success.");
+
+        // The existing part of the file is hashed once, so that the hash continues from where it left off
+        SHA256 hashEngine;
+        if (computeHash && offset > 0)
+        {
+            HashPrefix(dest, offset, hashEngine);
+        }
+
+        ResumeState state;
+        state.Url = url;
+        state.Validator = GetValidator(request.get());
+        state.Length = offset;
+
+        if (state.Validator.empty() && previous && offset > 0)
+        {
+            state.Validator = previous->Validator;
+        }
+
+        uint64_t contentLength = GetContentLength(request.get());
+        uint64_t totalLength = contentLength > 0 ? offset + contentLength : 0;
+        AICLI_LOG(Core, Verbose, << "Download size: " << totalLength);
+
+        // Use std::ofstream::app to append to the existing file so that it will not clear the motw.
+        std::ofstream outfile(dest, std::ofstream::binary | std::ofstream::app);
+
+        // Records how much of the file has been written, so that a later attempt can continue from there.
+        // Without a validator there is no way to know that the rest of the file would match, so nothing is recorded.
+        // This is only called by the write stage of the pipeline, or once the pipeline has been flushed.
+        uint64_t lastSaved = state.Length;
+        auto saveState = [&]()
+        {
+            if (state.Validator.empty())
+            {
+                return;
+            }
+
+            try
+            {
+                outfile.flush();
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_WRITE_FAULT), !outfile);
+                WriteSidecar(sidecarPath, state);
+                lastSaved = state.Length;
+            }
+            CATCH_LOG();
+        };
+
+        // The sidecar only ever covers what the write stage has written, which may be behind what has been read
+        DownloadPipeline pipeline{
+            [&](const BYTE* data, size_t size)
+            {
+                outfile.write(reinterpret_cast<const char*>(data), size);
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_WRITE_FAULT), !outfile);
+
+                state.Length += size;
+
+                if (state.Length - lastSaved >= s_SidecarInterval)
+                {
+                    saveState();
+                }
+            },
+            computeHash ? &hashEngine : nullptr };
+
+        uint64_t bytesDownloaded = offset;
+        DWORD bytesRead = 0;
+
+        try
+        {
+            do
+            {
+                if (progress.IsCancelled())
+                {
+                    AICLI_LOG(Core, Info, << "Download cancelled.");
+                    pipeline.Flush();
+                    saveState();
+                    return {};
+                }
+
+                BYTE* buffer = pipeline.AcquireBuffer();
+                THROW_LAST_ERROR_IF_MSG(!InternetReadFile(request.get(), buffer, static_cast<DWORD>(pipeline.GetBufferSize()), &bytesRead), "InternetReadFile() failed.");
+                pipeline.Submit(bytesRead);
+
+                if (ticket)
+                {
+                    ticket->OnBytesReceived(bytesRead);
+                }
+
+                bytesDownloaded += bytesRead;
+
+                if (bytesRead != 0)
+                {
+                    progress.OnProgress(bytesDownloaded, totalLength, ProgressType::Bytes);
+                }
+            } while (bytesRead != 0);
+
+            pipeline.Complete();
+            outfile.flush();
+
+            // Check download size matches if content length is provided in response header
+            if (totalLength > 0)
+            {
+                THROW_HR_IF(APPINSTALLER_CLI_ERROR_DOWNLOAD_SIZE_MISMATCH, state.Length != totalLength);
+            }
+        }
+        catch (...)
+        {
+            pipeline.Flush();
+            saveState();
+            throw;
+        }
+
+        std::filesystem::remove(sidecarPath, error);
+
+        std::vector<BYTE> result;
+        if (computeHash)
+        {
+            result = hashEngine.Get();
+            AICLI_LOG(Core, Info, << "Download hash: " << SHA256::ConvertToString(result));
+        }
+
+        AICLI_LOG(Core, Info, << "Download completed.");
+
+        return result;
+    }
+}
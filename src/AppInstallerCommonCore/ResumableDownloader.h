@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerProgress.h>
+#include <winget/DownloadScheduler.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace AppInstaller::Utility
+{
+    // Downloads a file from the given URL and places it in the given location, continuing from where an earlier
+    // attempt to download the same file to the same location stopped.
+    // While the download is incomplete, a sidecar file next to the destination records the url, the validator
+    // (ETag or Last-Modified) of the response and the length of the file known to have been written. A later call
+    // asks only for the rest of the file, using If-Range so that the server sends the entire file instead if it has
+    // changed. The existing part of the file is hashed again once, so the hash still covers the entire file.
+    //   url: The url to be downloaded from. http->https redirection is allowed.
+    //   dest: The path to local file to be downloaded to.
+    //   computeHash: Indicates if SHA256 hash should be calculated when downloading.
+    //   ticket: Optional. Given the data received, to stay within the bandwidth limit.
+    std::optional<std::vector<BYTE>> ResumableDownload(
+        const std::string& url,
+        const std::filesystem::path& dest,
+        IProgressCallback& progress,
+        bool computeHash,
+        DownloadScheduler::Ticket* ticket = nullptr);
+
+    // Gets the path of the sidecar file that describes a partial download to the given location.
+    std::filesystem::path GetResumeSidecarPath(const std::filesystem::path& dest);
+}
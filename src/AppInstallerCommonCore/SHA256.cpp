@@ -3,16 +3,52 @@
 #include <pch.h>
 #define WIN32_NO_STATUS
 #include <bcrypt.h>
+#include <atomic>
+#include <optional>
 #include "Public/AppInstallerSHA256.h"
 #include "Public/AppInstallerRuntime.h"
 #include "Public/AppInstallerErrors.h"
+#include "SHA256Accelerated.h"
 
 using namespace AppInstaller::Runtime;
 
 namespace AppInstaller::Utility {
 
+    namespace
+    {
+#ifndef AICLI_DISABLE_TEST_HOOKS
+        // Set by tests to force the processor instructions (1) or the platform implementation (0).
+        static std::atomic<int> s_SHA256_TestHook_ForcedImplementation = -1;
+#endif
+
+        SHA256Accelerated::TransformFunction GetAcceleratedTransform()
+        {
+#ifndef AICLI_DISABLE_TEST_HOOKS
+            int forced = s_SHA256_TestHook_ForcedImplementation;
+            if (forced == 0)
+            {
+                return nullptr;
+            }
+            else if (forced == 1)
+            {
+                auto transform = SHA256Accelerated::GetTransform();
+                THROW_HR_IF(E_NOTIMPL, !transform);
+                return transform;
+            }
+#endif
+            return SHA256Accelerated::GetTransform();
+        }
+    }
+
     struct SHA256Context
     {
+        // Set when the processor has SHA instructions; the remaining values are then used instead of the platform handles.
+        SHA256Accelerated::TransformFunction transform = nullptr;
+        uint32_t state[SHA256Accelerated::StateWords] = {};
+        uint8_t block[SHA256Accelerated::BlockSizeInBytes] = {};
+        size_t blockLength = 0;
+        uint64_t messageLength = 0;
+
         wil::unique_bcrypt_algorithm algHandle;
         wil::unique_bcrypt_hash hashHandle;
         DWORD hashLength = 0;
@@ -20,6 +56,13 @@ namespace AppInstaller::Utility {
 
     SHA256::SHA256() : context(new SHA256Context{})
     {
+        context->transform = GetAcceleratedTransform();
+        if (context->transform)
+        {
+            std::copy(std::begin(SHA256Accelerated::InitialState), std::end(SHA256Accelerated::InitialState), context->state);
+            return;
+        }
+
         BCRYPT_ALG_HANDLE algHandleT{};
         BCRYPT_HASH_HANDLE hashHandleT;
         DWORD resultLength = 0;
@@ -65,6 +108,47 @@ namespace AppInstaller::Utility {
     {
         EnsureNotFinished();
 
+        if (context->transform)
+        {
+            constexpr size_t blockSize = SHA256Accelerated::BlockSizeInBytes;
+            context->messageLength += cbBuffer;
+
+            // Complete a block started by a previous call first
+            if (context->blockLength > 0)
+            {
+                size_t toCopy = std::min(cbBuffer, blockSize - context->blockLength);
+                memcpy(context->block + context->blockLength, buffer, toCopy);
+                context->blockLength += toCopy;
+                buffer += toCopy;
+                cbBuffer -= toCopy;
+
+                if (context->blockLength < blockSize)
+                {
+                    return;
+                }
+
+                context->transform(context->state, context->block, 1);
+                context->blockLength = 0;
+            }
+
+            // Whole blocks are processed directly from the buffer
+            size_t blockCount = cbBuffer / blockSize;
+            if (blockCount > 0)
+            {
+                context->transform(context->state, buffer, blockCount);
+                buffer += blockCount * blockSize;
+                cbBuffer -= blockCount * blockSize;
+            }
+
+            if (cbBuffer > 0)
+            {
+                memcpy(context->block, buffer, cbBuffer);
+                context->blockLength = cbBuffer;
+            }
+
+            return;
+        }
+
         // Add the data
         THROW_IF_NTSTATUS_FAILED_MSG(
             BCryptHashData(context->hashHandle.get(), const_cast<PUCHAR>(buffer), static_cast<ULONG>(cbBuffer), 0),
@@ -75,6 +159,19 @@ namespace AppInstaller::Utility {
     {
         EnsureNotFinished();
 
+        if (context->transform)
+        {
+            uint8_t finalBlocks[2 * SHA256Accelerated::BlockSizeInBytes];
+            size_t blockCount = SHA256Accelerated::Pad(context->block, context->blockLength, context->messageLength, finalBlocks);
+            context->transform(context->state, finalBlocks, blockCount);
+
+            hash.resize(HashBufferSizeInBytes);
+            SHA256Accelerated::WriteHash(context->state, hash.data());
+
+            context.reset();
+            return;
+        }
+
         // Size the hash buffer appropriately
         hash.resize(context->hashLength);
 
@@ -178,4 +275,16 @@ namespace AppInstaller::Utility {
             THROW_HR_MSG(E_UNEXPECTED, "The hash is already finished");
         }
     }
+
+#ifndef AICLI_DISABLE_TEST_HOOKS
+    void TestHook_ForceSHA256Implementation(std::optional<bool> processorInstructions)
+    {
+        s_SHA256_TestHook_ForcedImplementation = processorInstructions ? static_cast<int>(*processorInstructions) : -1;
+    }
+
+    bool TestHook_HasSHA256ProcessorInstructions()
+    {
+        return SHA256Accelerated::GetTransform() != nullptr;
+    }
+#endif
 }
\ No newline at end of file
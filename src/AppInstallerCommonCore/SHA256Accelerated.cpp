@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "SHA256Accelerated.h"
+
+#if defined(_M_X64) || defined(_M_IX86)
+#define AICLI_SHA256_X86
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(_M_ARM64)
+#define AICLI_SHA256_ARM64
+#include <arm64_neon.h>
+#endif
+
+#include <utility>
+
+namespace AppInstaller::Utility::SHA256Accelerated
+{
+    const uint32_t InitialState[StateWords] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+
+    namespace
+    {
+        alignas(16) const uint32_t s_RoundConstants[64] =
+        {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        struct ProcessorFeatures
+        {
+            bool ShaExtensions = false;
+            bool ArmCrypto = false;
+        };
+
+        const ProcessorFeatures& GetProcessorFeatures()
+        {
+            static ProcessorFeatures s_features = []()
+            {
+                ProcessorFeatures result;
+#if defined(AICLI_SHA256_X86)
+                int info[4];
+                __cpuid(info, 0);
+
+                if (info[0] >= 7)
+                {
+                    __cpuid(info, 1);
+                    bool ssse3 = (info[2] & (1 << 9)) != 0;
+                    bool sse41 = (info[2] & (1 << 19)) != 0;
+
+                    __cpuidex(info, 7, 0);
+                    result.ShaExtensions = ssse3 && sse41 && (info[1] & (1 << 29)) != 0;
+                }
+#elif defined(AICLI_SHA256_ARM64)
+                result.ArmCrypto = IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != FALSE;
+#endif
+                return result;
+            }();
+
+            return s_features;
+        }
+
+#if defined(AICLI_SHA256_X86)
+        // Four rounds with the SHA extensions, which also extend the message schedule for the rounds that follow.
+        // The rounds are expanded at compile time so that the message schedule stays in registers.
+        template <size_t R>
+        __forceinline void ShaExtensionsRounds(__m128i& state0, __m128i& state1, __m128i (&w)[4])
+        {
+            __m128i& current = w[R % 4];
+            __m128i message = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(&s_RoundConstants[R * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+
+            if constexpr (R >= 3 && R < 15)
+            {
+                __m128i& next = w[(R + 1) % 4];
+                next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(current, w[(R + 3) % 4], 4)), current);
+            }
+
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(message, 0x0E));
+
+            if constexpr (R >= 1 && R < 13)
+            {
+                w[(R + 3) % 4] = _mm_sha256msg1_epu32(w[(R + 3) % 4], current);
+            }
+        }
+
+        template <size_t... R>
+        __forceinline void ShaExtensionsBlock(__m128i& state0, __m128i& state1, __m128i (&w)[4], std::index_sequence<R...>)
+        {
+            (ShaExtensionsRounds<R>(state0, state1, w), ...);
+        }
+
+        void TransformShaExtensions(uint32_t* state, const uint8_t* blocks, size_t blockCount)
+        {
+            const __m128i byteSwap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+            // The instructions operate on the state as ABEF and CDGH
+            __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+            __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+            __m128i state0 = _mm_alignr_epi8(cdab, efgh, 8);
+            __m128i state1 = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+            for (; blockCount > 0; --blockCount, blocks += BlockSizeInBytes)
+            {
+                __m128i savedState0 = state0;
+                __m128i savedState1 = state1;
+
+                __m128i w[4];
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + i * 16)), byteSwap);
+                }
+
+                ShaExtensionsBlock(state0, state1, w, std::make_index_sequence<16>{});
+
+                state0 = _mm_add_epi32(state0, savedState0);
+                state1 = _mm_add_epi32(state1, savedState1);
+            }
+
+            __m128i feba = _mm_shuffle_epi32(state0, 0x1B);
+            __m128i dchg = _mm_shuffle_epi32(state1, 0xB1);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+        }
+#elif defined(AICLI_SHA256_ARM64)
+        // Four rounds with the cryptography extension, which also extend the message schedule for the rounds that follow.
+        // The rounds are expanded at compile time so that the message schedule stays in registers.
+        template <size_t R>
+        __forceinline void ArmCryptoRounds(uint32x4_t& state0, uint32x4_t& state1, uint32x4_t (&w)[4])
+        {
+            uint32x4_t message = vaddq_u32(w[R % 4], vld1q_u32(&s_RoundConstants[R * 4]));
+
+            if constexpr (R < 12)
+            {
+                w[R % 4] = vsha256su1q_u32(vsha256su0q_u32(w[R % 4], w[(R + 1) % 4]), w[(R + 2) % 4], w[(R + 3) % 4]);
+            }
+
+            uint32x4_t previous = state0;
+            state0 = vsha256hq_u32(state0, state1, message);
+            state1 = vsha256h2q_u32(state1, previous, message);
+        }
+
+        template <size_t... R>
+        __forceinline void ArmCryptoBlock(uint32x4_t& state0, uint32x4_t& state1, uint32x4_t (&w)[4], std::index_sequence<R...>)
+        {
+            (ArmCryptoRounds<R>(state0, state1, w), ...);
+        }
+
+        void TransformArmCrypto(uint32_t* state, const uint8_t* blocks, size_t blockCount)
+        {
+            uint32x4_t state0 = vld1q_u32(&state[0]);
+            uint32x4_t state1 = vld1q_u32(&state[4]);
+
+            for (; blockCount > 0; --blockCount, blocks += BlockSizeInBytes)
+            {
+                uint32x4_t savedState0 = state0;
+                uint32x4_t savedState1 = state1;
+
+                uint32x4_t w[4];
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+                }
+
+                ArmCryptoBlock(state0, state1, w, std::make_index_sequence<16>{});
+
+                state0 = vaddq_u32(state0, savedState0);
+                state1 = vaddq_u32(state1, savedState1);
+            }
+
+            vst1q_u32(&state[0], state0);
+            vst1q_u32(&state[4], state1);
+        }
+#endif
+    }
+
+    TransformFunction GetTransform()
+    {
+#if defined(AICLI_SHA256_X86)
+        if (GetProcessorFeatures().ShaExtensions)
+        {
+            return TransformShaExtensions;
+        }
+#elif defined(AICLI_SHA256_ARM64)
+        if (GetProcessorFeatures().ArmCrypto)
+        {
+            return TransformArmCrypto;
+        }
+#endif
+        return nullptr;
+    }
+
+    size_t Pad(const uint8_t* tail, size_t tailLength, uint64_t messageLength, uint8_t* blocks)
+    {
+        // The message is followed by a single 1 bit, then zeros up to the length of the message in bits as a 64 bit big-endian value
+        size_t blockCount = tailLength < BlockSizeInBytes - sizeof(uint64_t) ? 1 : 2;
+        size_t paddedLength = blockCount * BlockSizeInBytes;
+
+        if (tailLength)
+        {
+            memcpy(blocks, tail, tailLength);
+        }
+
+        blocks[tailLength] = 0x80;
+        memset(blocks + tailLength + 1, 0, paddedLength - tailLength - 1 - sizeof(uint64_t));
+
+        uint64_t messageBits = messageLength * 8;
+        for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        {
+            blocks[paddedLength - 1 - i] = static_cast<uint8_t>(messageBits >> (i * 8));
+        }
+
+        return blockCount;
+    }
+
+    void WriteHash(const uint32_t* state, uint8_t* hash)
+    {
+        for (size_t i = 0; i < StateWords; ++i)
+        {
+            uint32_t word = state[i];
+            hash[i * 4] = static_cast<uint8_t>(word >> 24);
+            hash[i * 4 + 1] = static_cast<uint8_t>(word >> 16);
+            hash[i * 4 + 2] = static_cast<uint8_t>(word >> 8);
+            hash[i * 4 + 3] = static_cast<uint8_t>(word);
+        }
+    }
+}
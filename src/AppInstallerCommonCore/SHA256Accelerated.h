@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Implementations of the SHA256 compression function that use processor instructions.
+// These are used in place of the platform implementation when the processor supports them.
+namespace AppInstaller::Utility::SHA256Accelerated
+{
+    constexpr size_t BlockSizeInBytes = 64;
+    constexpr size_t StateWords = 8;
+
+    // The state of a hash before any data is added.
+    extern const uint32_t InitialState[StateWords];
+
+    // Processes whole blocks of a message, updating the state.
+    using TransformFunction = void(*)(uint32_t* state, const uint8_t* blocks, size_t blockCount);
+
+    // Gets the transform that uses the SHA instructions of the processor (the SHA extensions on x86/x64 or
+    // the cryptography extension on ARMv8), or null if it has none.
+    TransformFunction GetTransform();
+
+    // Pads the final part of a message, which must be shorter than a block, into one or two blocks.
+    // Returns the number of blocks written; blocks must have room for two.
+    size_t Pad(const uint8_t* tail, size_t tailLength, uint64_t messageLength, uint8_t* blocks);
+
+    // Writes the hash from a state.
+    void WriteHash(const uint32_t* state, uint8_t* hash);
+}
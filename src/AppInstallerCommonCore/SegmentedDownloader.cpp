@@ -0,0 +1,441 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Public/AppInstallerErrors.h"
+#include "Public/AppInstallerSHA256.h"
+#include "Public/AppInstallerLogging.h"
+#include "DownloadPipeline.h"
+#include "SegmentedDownloader.h"
+#include "WinINetUtil.h"
+
+#include <thread>
+
+namespace AppInstaller::Utility
+{
+    using namespace WinINet;
+
+    namespace
+    {
+        constexpr DWORD s_BufferSize = 1024 * 1024; // 1MB
+
+        // The part of the file downloaded over one connection.
+        struct Segment
+        {
+            uint64_t Offset = 0;
+            uint64_t Length = 0;
+
+            // The number of bytes from the start of the segment that have been written to the file.
+            std::atomic<uint64_t> Written = 0;
+        };
+
+        // The file is opened for overlapped I/O, as the segments write to it concurrently. Each operation has its own event
+        // to wait on, since other operations complete on the same handle.
+        template <typename Operation>
+        void TransferAt(HANDLE file, uint64_t offset, DWORD size, Operation&& operation)
+        {
+            wil::unique_event completed{ wil::EventOptions::ManualReset };
+
+            OVERLAPPED overlapped{};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            overlapped.hEvent = completed.get();
+
+            if (!operation(&overlapped))
+            {
+                THROW_LAST_ERROR_IF(GetLastError() != ERROR_IO_PENDING);
+            }
+
+            DWORD transferred = 0;
+            THROW_LAST_ERROR_IF(!GetOverlappedResult(file, &overlapped, &transferred, TRUE));
+            THROW_HR_IF(E_UNEXPECTED, transferred != size);
+        }
+
+        void WriteAt(HANDLE file, uint64_t offset, const BYTE* buffer, DWORD size)
+        {
+            TransferAt(file, offset, size, [&](OVERLAPPED* overlapped) { return WriteFile(file, buffer, size, nullptr, overlapped); });
+        }
+
+        void ReadAt(HANDLE file, uint64_t offset, BYTE* buffer, DWORD size)
+        {
+            TransferAt(file, offset, size, [&](OVERLAPPED* overlapped) { return ReadFile(file, buffer, size, nullptr, overlapped); });
+        }
+
+        void SetFileLength(HANDLE file, uint64_t length)
+        {
+            FILE_END_OF_FILE_INFO endOfFile{};
+            endOfFile.EndOfFile.QuadPart = static_cast<LONGLONG>(length);
+            THROW_LAST_ERROR_IF(!SetFileInformationByHandle(file, FileEndOfFileInfo, &endOfFile, sizeof(endOfFile)));
+        }
+
+        // Raises the WinINet limit on connections to a single server, which would otherwise serialize the segments.
+        // The limit can only be set for the whole process, so it is restored once the last segmented download that raised it is done.
+        struct ConnectionsPerServerScope
+        {
+            ConnectionsPerServerScope(DWORD count)
+            {
+                std::lock_guard<std::mutex> guard{ s_lock };
+
+                DWORD current = 0;
+                DWORD cbCurrent = sizeof(current);
+                if (InternetQueryOptionA(NULL, INTERNET_OPTION_MAX_CONNS_PER_SERVER, &current, &cbCurrent) && current < count)
+                {
+                    if (LOG_LAST_ERROR_IF(!InternetSetOptionA(NULL, INTERNET_OPTION_MAX_CONNS_PER_SERVER, &count, sizeof(count))))
+                    {
+                        return;
+                    }
+
+                    if (!s_original)
+                    {
+                        s_original = current;
+                    }
+                }
+
+                m_active = true;
+                ++s_activeCount;
+            }
+
+            ConnectionsPerServerScope(const ConnectionsPerServerScope&) = delete;
+            ConnectionsPerServerScope& operator=(const ConnectionsPerServerScope&) = delete;
+
+            ~ConnectionsPerServerScope()
+            {
+                if (!m_active)
+                {
+                    return;
+                }
+
+                std::lock_guard<std::mutex> guard{ s_lock };
+
+                if (--s_activeCount == 0 && s_original)
+                {
+                    DWORD original = s_original.value();
+                    LOG_LAST_ERROR_IF(!InternetSetOptionA(NULL, INTERNET_OPTION_MAX_CONNS_PER_SERVER, &original, sizeof(original)));
+                    s_original.reset();
+                }
+            }
+
+        private:
+            static inline std::mutex s_lock;
+            static inline size_t s_activeCount = 0;
+            static inline std::optional<DWORD> s_original;
+
+            bool m_active = false;
+        };
+
+        // Writes the entire body of the response to the file, as WinINetDownloadToStream does.
+        std::optional<std::vector<BYTE>> DownloadSingleStream(
+            HINTERNET request,
+            HANDLE file,
+            IProgressCallback& progress,
+            bool computeHash,
+            DownloadScheduler::Ticket* ticket)
+        {
+            uint64_t contentLength = GetContentLength(request);
+            AICLI_LOG(Core, Verbose, << "Download size: " << contentLength);
+
+            SHA256 hashEngine;
+            uint64_t bytesWritten = 0;
+            DownloadPipeline pipeline{
+                [&](const BYTE* data, size_t size)
+                {
+                    WriteAt(file, bytesWritten, data, static_cast<DWORD>(size));
+                    bytesWritten += size;
+                },
+                computeHash ? &hashEngine : nullptr };
+
+            DWORD bytesRead = 0;
+            uint64_t bytesDownloaded = 0;
+
+            do
+            {
+                if (progress.IsCancelled())
+                {
+                    AICLI_LOG(Core, Info, << "Download cancelled.");
+                    return {};
+                }
+
+                BYTE* buffer = pipeline.AcquireBuffer();
+                THROW_LAST_ERROR_IF_MSG(!InternetReadFile(request, buffer, static_cast<DWORD>(pipeline.GetBufferSize()), &bytesRead), "InternetReadFile() failed.");
+                pipeline.Submit(bytesRead);
+
+                if (ticket)
+                {
+                    ticket->OnBytesReceived(bytesRead);
+                }
+
+                bytesDownloaded += bytesRead;
+
+                if (bytesRead != 0)
+                {
+                    progress.OnProgress(bytesDownloaded, contentLength, ProgressType::Bytes);
+                }
+            } while (bytesRead != 0);
+
+            pipeline.Complete();
+            SetFileLength(file, bytesDownloaded);
+
+            if (contentLength > 0)
+            {
+                THROW_HR_IF(APPINSTALLER_CLI_ERROR_DOWNLOAD_SIZE_MISMATCH, bytesDownloaded != contentLength);
+            }
+
+            std::vector<BYTE> result;
+            if (computeHash)
+            {
+                result = hashEngine.Get();
+            }
+
+            return result;
+        }
+
+        // Downloads one segment into its place in the file.
+        void DownloadSegment(
+            HINTERNET session,
+            const std::string& url,
+            const std::string& etag,
+            HANDLE file,
+            Segment& segment,
+            const std::atomic<bool>& stop,
+            std::condition_variable& segmentProgress,
+            DownloadScheduler::Ticket* ticket)
+        {
+            std::string headers = "Range: bytes=" + std::to_string(segment.Offset) + '-' + std::to_string(segment.Offset + segment.Length - 1) + "\r\n";
+
+            // Should the file change between requests, the server sends all of it rather than a range of the new file
+            if (!etag.empty())
+            {
+                headers += "If-Range: " + etag + "\r\n";
+            }
+
+            wil::unique_hinternet request = OpenUrl(session, url, headers);
+
+            DWORD requestStatus = GetStatusCode(request.get());
+            if (requestStatus != HTTP_STATUS_PARTIAL_CONTENT)
+            {
+                AICLI_LOG(Core, Error, << "Download range request failed. Returned status: " << requestStatus);
+                THROW_HR_MSG(MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, requestStatus), "Download range request status is not partial content.");
+            }
+
+            auto buffer = std::make_unique<BYTE[]>(s_BufferSize);
+
+            while (segment.Written < segment.Length && !stop)
+            {
+                DWORD toRead = static_cast<DWORD>(std::min<uint64_t>(s_BufferSize, segment.Length - segment.Written));
+                DWORD bytesRead = 0;
+                THROW_LAST_ERROR_IF_MSG(!InternetReadFile(request.get(), buffer.get(), toRead, &bytesRead), "InternetReadFile() failed.");
+                THROW_HR_IF_MSG(APPINSTALLER_CLI_ERROR_DOWNLOAD_SIZE_MISMATCH, bytesRead == 0, "Download range ended early.");
+
+                WriteAt(file, segment.Offset + segment.Written, buffer.get(), bytesRead);
+                segment.Written += bytesRead;
+                segmentProgress.notify_all();
+
+                if (ticket)
+                {
+                    ticket->OnBytesReceived(bytesRead);
+                }
+            }
+        }
+    }
+
+    std::optional<std::vector<BYTE>> SegmentedDownload(
+        const std::string& url,
+        const std::filesystem::path& dest,
+        IProgressCallback& progress,
+        bool computeHash,
+        const SegmentedDownloadOptions& options,
+        DownloadScheduler::Ticket* ticket)
+    {
+        AICLI_LOG(Core, Info, << "Segmented downloading from url: " << url);
+
+        wil::unique_hinternet session = OpenSession();
+
+        wil::unique_hfile file{ CreateFileW(dest.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        // Asking for the first byte determines both whether ranges are supported and the size of the file
+        wil::unique_hinternet probe = OpenUrl(session.get(), url, "Range: bytes=0-0\r\n");
+        DWORD requestStatus = GetStatusCode(probe.get());
+
+        if (requestStatus == HTTP_STATUS_OK)
+        {
+            // The server ignored the range and is sending the entire file, so use that
+            AICLI_LOG(Core, Info, << "Server does not support range requests; downloading as a single stream.");
+            auto result = DownloadSingleStream(probe.get(), file.get(), progress, computeHash, ticket);
+            AICLI_LOG(Core, Info, << "Download completed.");
+            return result;
+        }
+
+        if (requestStatus != HTTP_STATUS_PARTIAL_CONTENT)
+        {
+            AICLI_LOG(Core, Error, << "Download request failed. Returned status: " << requestStatus);
+            THROW_HR_MSG(MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, requestStatus), "Download request status is not success.");
+        }
+
+        std::optional<uint64_t> completeLength;
+        std::optional<ContentRange> contentRange = ParseContentRange(GetHeader(probe.get(), HTTP_QUERY_CONTENT_RANGE));
+        if (contentRange)
+        {
+            completeLength = contentRange->CompleteLength;
+        }
+
+        std::string etag = GetHeader(probe.get(), HTTP_QUERY_ETAG);
+        probe.reset();
+
+        uint64_t segmentCount = 1;
+        if (completeLength)
+        {
+            segmentCount = std::clamp<uint64_t>(completeLength.value() / std::max<uint64_t>(options.MinimumSegmentSize, 1), 1, std::max<uint32_t>(options.SegmentCount, 1));
+        }
+
+        if (segmentCount == 1)
+        {
+            AICLI_LOG(Core, Info, << "File is not split; downloading as a single stream.");
+            wil::unique_hinternet request = OpenUrl(session.get(), url);
+
+            requestStatus = GetStatusCode(request.get());
+            if (requestStatus != HTTP_STATUS_OK)
+            {
+                AICLI_LOG(Core, Error, << "Download request failed. Returned status: " << requestStatus);
+                THROW_HR_MSG(MAKE_HRESULT(SEVERITY_ERROR, FACILITY_HTTP, requestStatus), "Download request status is not success.");
+            }
+
+            auto result = DownloadSingleStream(request.get(), file.get(), progress, computeHash, ticket);
+            AICLI_LOG(Core, Info, << "Download completed.");
+            return result;
+        }
+
+        uint64_t totalLength = completeLength.value();
+        AICLI_LOG(Core, Info, << "Download size: " << totalLength << ", in " << segmentCount << " segments");
+
+        // Allocate the entire file up front so that each segment can be written in place
+        SetFileLength(file.get(), totalLength);
+
+        std::vector<Segment> segments(static_cast<size_t>(segmentCount));
+        uint64_t segmentLength = totalLength / segmentCount;
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            segments[i].Offset = i * segmentLength;
+            segments[i].Length = (i == segments.size() - 1) ? totalLength - segments[i].Offset : segmentLength;
+        }
+
+        ConnectionsPerServerScope connectionsPerServer{ static_cast<DWORD>(segmentCount) };
+
+        std::atomic<bool> stop = false;
+        std::mutex lock;
+        std::condition_variable segmentProgress;
+        std::exception_ptr segmentError;
+
+        std::vector<std::thread> workers;
+        auto joinWorkers = wil::scope_exit([&]()
+            {
+                stop = true;
+                for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+            });
+
+        for (auto& segment : segments)
+        {
+            workers.emplace_back([&, segmentToDownload = &segment, sessionHandle = session.get(), fileHandle = file.get()]()
+                {
+                    try
+                    {
+                        DownloadSegment(sessionHandle, url, etag, fileHandle, *segmentToDownload, stop, segmentProgress, ticket);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> errorLock{ lock };
+                        if (!segmentError)
+                        {
+                            segmentError = std::current_exception();
+                        }
+
+                        stop = true;
+                        segmentProgress.notify_all();
+                    }
+                });
+        }
+
+        // Hash the file in order, as far as the segments have been completed from its start
+        SHA256 hashEngine;
+        auto buffer = std::make_unique<BYTE[]>(s_BufferSize);
+        uint64_t hashed = 0;
+        size_t current = 0;
+        bool cancelled = false;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> waitLock{ lock };
+                segmentProgress.wait_for(waitLock, std::chrono::milliseconds(100), [&]()
+                    {
+                        return stop || segments[current].Offset + segments[current].Written > hashed;
+                    });
+            }
+
+            if (stop)
+            {
+                break;
+            }
+
+            if (progress.IsCancelled())
+            {
+                AICLI_LOG(Core, Info, << "Download cancelled.");
+                cancelled = true;
+                break;
+            }
+
+            uint64_t available = segments[current].Offset + segments[current].Written;
+            while (hashed < available)
+            {
+                DWORD toHash = static_cast<DWORD>(std::min<uint64_t>(s_BufferSize, available - hashed));
+                if (computeHash)
+                {
+                    ReadAt(file.get(), hashed, buffer.get(), toHash);
+                    hashEngine.Add(buffer.get(), toHash);
+                }
+
+                hashed += toHash;
+            }
+
+            uint64_t downloaded = 0;
+            for (const auto& segment : segments)
+            {
+                downloaded += segment.Written;
+            }
+
+            progress.OnProgress(downloaded, totalLength, ProgressType::Bytes);
+
+            if (hashed == segments[current].Offset + segments[current].Length && ++current == segments.size())
+            {
+                break;
+            }
+        }
+
+        joinWorkers.reset();
+
+        if (segmentError)
+        {
+            std::rethrow_exception(segmentError);
+        }
+
+        if (cancelled)
+        {
+            return {};
+        }
+
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_DOWNLOAD_SIZE_MISMATCH, hashed != totalLength);
+
+        std::vector<BYTE> result;
+        if (computeHash)
+        {
+            result = hashEngine.Get();
+            AICLI_LOG(Core, Info, << "Download hash: " << SHA256::ConvertToString(result));
+        }
+
+        AICLI_LOG(Core, Info, << "Download completed.");
+
+        return result;
+    }
+}
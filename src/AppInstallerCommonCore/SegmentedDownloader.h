@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerProgress.h>
+#include <winget/DownloadScheduler.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace AppInstaller::Utility
+{
+    // Options that control how a file is split by SegmentedDownload.
+    struct SegmentedDownloadOptions
+    {
+        // The maximum number of segments, each of which is downloaded over its own connection.
+        uint32_t SegmentCount = 4;
+
+        // The minimum size of a segment; smaller files are split into fewer segments, or not at all.
+        uint64_t MinimumSegmentSize = 1 << 20;
+    };
+
+    // Downloads a file from the given URL and places it in the given location, fetching ranges of it concurrently.
+    // The size of the file and whether the server supports range requests are determined first; if either is not
+    // available, the file is downloaded as a single stream instead. The SHA256 hash is computed in order as the
+    // start of the file is completed, rather than after the entire download.
+    //   url: The url to be downloaded from. http->https redirection is allowed.
+    //   dest: The path to local file to be downloaded to. An existing file is overwritten in place, keeping its alternate streams.
+    //   computeHash: Indicates if SHA256 hash should be calculated when downloading.
+    //   ticket: Optional. Given the data received by every segment, to stay within the bandwidth limit.
+    std::optional<std::vector<BYTE>> SegmentedDownload(
+        const std::string& url,
+        const std::filesystem::path& dest,
+        IProgressCallback& progress,
+        bool computeHash,
+        const SegmentedDownloadOptions& options = {},
+        DownloadScheduler::Ticket* ticket = nullptr);
+}
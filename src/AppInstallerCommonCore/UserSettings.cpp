@@ -69,6 +69,33 @@ namespace AppInstaller::Settings
             return convertedValue;
         }
 
+        template<>
+        inline std::string GetValueString(std::map<std::string, uint32_t> value)
+        {
+            std::string convertedValue = "{";
+
+            bool first = true;
+            for (auto const& entry : value)
+            {
+                if (first)
+                {
+                    first = false;
+                }
+                else
+                {
+                    convertedValue += ", ";
+                }
+
+                convertedValue += entry.first;
+                convertedValue += ": ";
+                convertedValue += std::to_string(entry.second);
+            }
+
+            convertedValue += '}';
+
+            return convertedValue;
+        }
+
         std::optional<Json::Value> ParseFile(const StreamDefinition& setting, std::vector<UserSettings::Warning>& warnings)
         {
             auto stream = GetSettingStream(setting);
@@ -268,11 +295,22 @@ namespace AppInstaller::Settings
             return SettingMapping<Setting::InstallLocalePreference>::Validate(value);
         }
 
+        WINGET_VALIDATE_SIGNATURE(InstallDownloadAheadCount)
+        {
+            if (value > 16)
+            {
+                return {};
+            }
+
+            return value;
+        }
+
         WINGET_VALIDATE_SIGNATURE(NetworkDownloader)
         {
             static constexpr std::string_view s_downloader_default = "default";
             static constexpr std::string_view s_downloader_wininet = "wininet";
             static constexpr std::string_view s_downloader_do = "do";
+            static constexpr std::string_view s_downloader_segmented = "segmented";
 
             if (Utility::CaseInsensitiveEquals(value, s_downloader_default))
             {
@@ -286,6 +324,10 @@ namespace AppInstaller::Settings
             {
                 return InstallerDownloader::DeliveryOptimization;
             }
+            else if (Utility::CaseInsensitiveEquals(value, s_downloader_segmented))
+            {
+                return InstallerDownloader::Segmented;
+            }
 
             return {};
         }
@@ -294,6 +336,75 @@ namespace AppInstaller::Settings
         {
             return std::chrono::seconds(value);
         }
+
+        WINGET_VALIDATE_SIGNATURE(NetworkDownloadSegmentCount)
+        {
+            if (value < 1 || value > 16)
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        WINGET_VALIDATE_SIGNATURE(NetworkMaxConcurrentDownloads)
+        {
+            if (value < 1 || value > 16)
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkMaxDownloadRateInKBps)
+
+        WINGET_VALIDATE_SIGNATURE(NetworkRestMaxConnectionsPerServer)
+        {
+            if (value < 1 || value > 64)
+            {
+                return {};
+            }
+
+            return value;
+        }
+
+        WINGET_VALIDATE_SIGNATURE(NetworkRestConnectionIdleTimeoutInSeconds)
+        {
+            if (value < 1 || value > 3600)
+            {
+                return {};
+            }
+
+            return std::chrono::seconds(value);
+        }
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkRestCacheMaxSizeInMB)
+
+        WINGET_VALIDATE_SIGNATURE(NetworkRestCacheTimeToLiveInSeconds)
+        {
+            return std::chrono::seconds(value);
+        }
+
+        WINGET_VALIDATE_SIGNATURE(NetworkRestCacheSourceTimeToLiveInSeconds)
+        {
+            std::map<std::string, std::chrono::seconds> result;
+
+            for (auto const& entry : value)
+            {
+                result.emplace(entry.first, std::chrono::seconds(entry.second));
+            }
+
+            return result;
+        }
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkRestCompressionDisabledSources)
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkInstallerCacheMaxSizeInMB)
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkPackageStreamCacheMaxSizeInMB)
+
+        WINGET_VALIDATE_PASS_THROUGH(NetworkManifestCacheMaxSizeInMB)
     }
 
 #ifndef AICLI_DISABLE_TEST_HOOKS
@@ -0,0 +1,139 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "WinINetUtil.h"
+
+#include <charconv>
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Utility::WinINet
+{
+    namespace
+    {
+        // This allows http->https redirection, and keeps ranges of a file out of the WinINet cache
+        constexpr DWORD s_RequestFlags = INTERNET_FLAG_IGNORE_REDIRECT_TO_HTTPS | INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE;
+
+        bool ParseNumber(std::string_view value, uint64_t& result)
+        {
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+            return error == std::errc{} && end == value.data() + value.size();
+        }
+    }
+
+    wil::unique_hinternet OpenSession()
+    {
+        wil::unique_hinternet session(InternetOpenA(
+            "winget-cli",
+            INTERNET_OPEN_TYPE_PRECONFIG,
+            NULL,
+            NULL,
+            0));
+        THROW_LAST_ERROR_IF_NULL_MSG(session, "InternetOpen() failed.");
+        return session;
+    }
+
+    wil::unique_hinternet OpenUrl(HINTERNET session, const std::string& url, const std::string& headers)
+    {
+        wil::unique_hinternet result(InternetOpenUrlA(
+            session,
+            url.c_str(),
+            headers.empty() ? NULL : headers.c_str(),
+            headers.empty() ? 0 : static_cast<DWORD>(-1L),
+            s_RequestFlags,
+            0));
+        THROW_LAST_ERROR_IF_NULL_MSG(result, "InternetOpenUrl() failed.");
+        return result;
+    }
+
+    DWORD GetStatusCode(HINTERNET request)
+    {
+        DWORD requestStatus = 0;
+        DWORD cbRequestStatus = sizeof(requestStatus);
+
+        THROW_LAST_ERROR_IF_MSG(!HttpQueryInfoA(request,
+            HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER,
+            &requestStatus,
+            &cbRequestStatus,
+            nullptr), "Query download request status failed.");
+
+        return requestStatus;
+    }
+
+    std::string GetHeader(HINTERNET request, DWORD infoLevel)
+    {
+        std::string result(256, '\0');
+        DWORD size = static_cast<DWORD>(result.size());
+
+        if (!HttpQueryInfoA(request, infoLevel, result.data(), &size, nullptr))
+        {
+            if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+            {
+                return {};
+            }
+
+            result.resize(size);
+            if (!HttpQueryInfoA(request, infoLevel, result.data(), &size, nullptr))
+            {
+                return {};
+            }
+        }
+
+        result.resize(size);
+        return result;
+    }
+
+    uint64_t GetContentLength(HINTERNET request)
+    {
+        LONGLONG contentLength = 0;
+        DWORD cbContentLength = sizeof(contentLength);
+
+        HttpQueryInfoA(
+            request,
+            HTTP_QUERY_CONTENT_LENGTH | HTTP_QUERY_FLAG_NUMBER64,
+            &contentLength,
+            &cbContentLength,
+            nullptr);
+
+        return contentLength > 0 ? static_cast<uint64_t>(contentLength) : 0;
+    }
+
+    std::optional<ContentRange> ParseContentRange(std::string_view value)
+    {
+        constexpr std::string_view unit = "bytes "sv;
+        if (value.substr(0, unit.size()) != unit)
+        {
+            return {};
+        }
+
+        value = value.substr(unit.size());
+        size_t dash = value.find('-');
+        size_t slash = value.find('/');
+        if (dash == std::string_view::npos || slash == std::string_view::npos || slash < dash)
+        {
+            return {};
+        }
+
+        ContentRange result;
+        if (!ParseNumber(value.substr(0, dash), result.First) ||
+            !ParseNumber(value.substr(dash + 1, slash - dash - 1), result.Last) ||
+            result.Last < result.First)
+        {
+            return {};
+        }
+
+        std::string_view completeLength = value.substr(slash + 1);
+        if (completeLength != "*"sv)
+        {
+            uint64_t length = 0;
+            if (!ParseNumber(completeLength, length) || length <= result.Last)
+            {
+                return {};
+            }
+
+            result.CompleteLength = length;
+        }
+
+        return result;
+    }
+}
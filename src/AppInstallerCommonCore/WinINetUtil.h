@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <wil/resource.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace AppInstaller::Utility::WinINet
+{
+    // The value of a Content-Range response header.
+    struct ContentRange
+    {
+        uint64_t First = 0;
+        uint64_t Last = 0;
+
+        // Not present if the server reported the length of the file as unknown.
+        std::optional<uint64_t> CompleteLength;
+    };
+
+    // Opens a WinINet session configured as all downloads are.
+    wil::unique_hinternet OpenSession();
+
+    // Sends a GET request for the url, with the given additional headers, each terminated by "\r\n".
+    // Responses are neither served from nor added to the WinINet cache, as they may be ranges of the file.
+    wil::unique_hinternet OpenUrl(HINTERNET session, const std::string& url, const std::string& headers = {});
+
+    // Gets the HTTP status code of the response.
+    DWORD GetStatusCode(HINTERNET request);
+
+    // Gets the value of a response header, or an empty string if it is not present.
+    std::string GetHeader(HINTERNET request, DWORD infoLevel);
+
+    // Gets the Content-Length of the response, or 0 if it is not present.
+    uint64_t GetContentLength(HINTERNET request);
+
+    // Parses a Content-Range value such as "bytes 0-99/12345".
+    std::optional<ContentRange> ParseContentRange(std::string_view value);
+}
@@ -15,8 +15,6 @@ namespace AppInstaller::YAML
 
     namespace
     {
-        Node s_globalInvalidNode;
-
         std::string_view GetExceptionTypeStringView(Exception::Type type)
         {
             switch (type)
@@ -128,76 +126,296 @@ namespace AppInstaller::YAML
         return m_what.c_str();
     }
 
-    Node::Node(Type type, std::string tag, const YAML::Mark& mark) :
-        m_type(type), m_tag(std::move(tag)), m_mark(mark)
+    namespace details
     {
-        if (m_type == Type::Sequence)
+        Node NodeStorage::GetNode(std::shared_ptr<NodeStorage> storage, uint32_t node)
+        {
+            return { std::move(storage), node };
+        }
+
+        std::string_view NodeStorage::AddString(std::string value)
+        {
+            // Empty text still refers to valid memory, like the text that libyaml produces
+            if (value.empty())
+            {
+                return ""sv;
+            }
+
+            return Text->Strings.emplace_back(std::move(value));
+        }
+
+        void NodeStorage::AllocateTextBlock(size_t size)
+        {
+            // Not value initialized, as every byte is written before it is read
+            TextBlockNext = Text->TextBlocks.emplace_back(new char[size]).get();
+            TextBlockAvailable = size;
+        }
+
+        std::string_view NodeStorage::AddText(std::string_view value)
+        {
+            constexpr size_t c_minimumTextBlockSize = 16 << 10;
+
+            if (value.empty())
+            {
+                return ""sv;
+            }
+
+            if (value.size() > TextBlockAvailable)
+            {
+                AllocateTextBlock(std::max(value.size(), c_minimumTextBlockSize));
+            }
+
+            std::memcpy(TextBlockNext, value.data(), value.size());
+            std::string_view result{ TextBlockNext, value.size() };
+
+            TextBlockNext += value.size();
+            TextBlockAvailable -= value.size();
+
+            return result;
+        }
+
+        uint32_t NodeStorage::AddNode(Node::Type type, std::string_view tag, const YAML::Mark& mark)
+        {
+            Nodes.emplace_back(type, tag, mark);
+            return static_cast<uint32_t>(Nodes.size() - 1);
+        }
+
+        uint32_t NodeStorage::AllocateChildren(uint32_t node, uint32_t count)
+        {
+            uint32_t result = static_cast<uint32_t>(Children.size());
+            Children.resize(Children.size() + count);
+
+            Nodes[node].ChildStart = result;
+            Nodes[node].ChildCount = count;
+            Nodes[node].ChildCapacity = count;
+
+            return result;
+        }
+
+        void NodeStorage::SortMapping(uint32_t node)
+        {
+            const NodeData& data = Nodes[node];
+
+            std::vector<std::pair<uint32_t, uint32_t>> entries;
+            entries.reserve(data.ChildCount / 2);
+
+            for (uint32_t i = data.ChildStart; i < data.ChildStart + data.ChildCount; i += 2)
+            {
+                entries.emplace_back(Children[i], Children[i + 1]);
+            }
+
+            std::stable_sort(entries.begin(), entries.end(),
+                [&](const auto& a, const auto& b) { return Nodes[a.first].Scalar < Nodes[b.first].Scalar; });
+
+            uint32_t position = data.ChildStart;
+            for (const auto& entry : entries)
+            {
+                Children[position++] = entry.first;
+                Children[position++] = entry.second;
+            }
+        }
+
+        uint32_t NodeStorage::AddCopy(const NodeStorage& source, uint32_t node)
+        {
+            // The source may not live as long as this storage, but the text that its nodes refer to will
+            if (&source != this)
+            {
+                ShareText(source.Text);
+                for (const auto& text : source.SharedText)
+                {
+                    ShareText(text);
+                }
+            }
+
+            auto copyNode = [&](uint32_t sourceNode)
+            {
+                // A copy of the data, since adding to this storage can move the nodes of the source
+                NodeData data = source.Nodes[sourceNode];
+                uint32_t result = AddNode(data.Type, data.Tag, data.Mark);
+                Nodes[result].Scalar = data.Scalar;
+                return result;
+            };
+
+            uint32_t result = copyNode(node);
+
+            std::stack<std::pair<uint32_t, uint32_t>> containers;
+            containers.emplace(node, result);
+
+            while (!containers.empty())
+            {
+                uint32_t sourceNode = containers.top().first;
+                uint32_t copy = containers.top().second;
+                containers.pop();
+
+                uint32_t sourceStart = source.Nodes[sourceNode].ChildStart;
+                uint32_t count = source.Nodes[sourceNode].ChildCount;
+                uint32_t copyStart = AllocateChildren(copy, count);
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    uint32_t sourceChild = source.Children[sourceStart + i];
+                    uint32_t child = copyNode(sourceChild);
+                    Children[copyStart + i] = child;
+
+                    if (source.Nodes[sourceChild].ChildCount != 0)
+                    {
+                        containers.emplace(sourceChild, child);
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        void NodeStorage::ShareText(const std::shared_ptr<const NodeText>& text)
+        {
+            if (text != Text && std::find(SharedText.begin(), SharedText.end(), text) == SharedText.end())
+            {
+                SharedText.emplace_back(text);
+            }
+        }
+
+        void NodeStorage::InsertChildren(uint32_t node, uint32_t position, std::initializer_list<uint32_t> children)
         {
-            m_sequence = decltype(m_sequence)::value_type{};
+            constexpr uint32_t c_minimumChildCapacity = 8;
+
+            NodeData& data = Nodes[node];
+            uint32_t count = static_cast<uint32_t>(children.size());
+            uint32_t required = data.ChildCount + count;
+
+            if (required > data.ChildCapacity)
+            {
+                if (data.ChildStart + data.ChildCapacity == Children.size())
+                {
+                    // The range is already at the end, so it can simply grow
+                    Children.resize(data.ChildStart + required);
+                    data.ChildCapacity = required;
+                }
+                else
+                {
+                    // Move the children to the end, with room to grow so that adding to the node again does not move them again
+                    uint32_t capacity = std::max(2 * required, c_minimumChildCapacity);
+                    uint32_t start = static_cast<uint32_t>(Children.size());
+                    Children.resize(Children.size() + capacity);
+                    std::copy_n(Children.begin() + data.ChildStart, data.ChildCount, Children.begin() + start);
+
+                    UnusedChildren += data.ChildCapacity;
+                    data.ChildStart = start;
+                    data.ChildCapacity = capacity;
+                }
+            }
+
+            auto begin = Children.begin() + data.ChildStart;
+            std::move_backward(begin + position, begin + data.ChildCount, begin + required);
+            std::copy(children.begin(), children.end(), begin + position);
+            data.ChildCount = required;
+
+            // The old ranges are reclaimed once they make up most of Children
+            if (UnusedChildren > Children.size() / 2)
+            {
+                CompactChildren();
+            }
         }
-        else if (m_type == Type::Mapping)
+
+        void NodeStorage::CompactChildren()
         {
-            m_mapping = decltype(m_mapping)::value_type{};
+            std::vector<uint32_t> children;
+            children.reserve(Children.size() - UnusedChildren);
+
+            for (NodeData& data : Nodes)
+            {
+                uint32_t start = static_cast<uint32_t>(children.size());
+                children.insert(children.end(), Children.begin() + data.ChildStart, Children.begin() + data.ChildStart + data.ChildCount);
+                data.ChildStart = start;
+                data.ChildCapacity = data.ChildCount;
+            }
+
+            Children = std::move(children);
+            UnusedChildren = 0;
         }
     }
 
-    void Node::SetScalar(std::string value)
+    Node::Node(Type type, std::string tag, const YAML::Mark& mark) :
+        m_storage(std::make_shared<details::NodeStorage>()), m_type(type)
     {
-        Require(Type::Scalar);
-        m_scalar = std::move(value);
+        m_index = m_storage->AddNode(type, m_storage->AddString(std::move(tag)), mark);
     }
 
-    bool Node::operator<(const Node& other) const
+    Node::Node(std::shared_ptr<details::NodeStorage> storage, uint32_t index) :
+        m_storage(std::move(storage)), m_index(index)
     {
-        Require(Type::Scalar);
-        other.Require(Type::Scalar);
-        return this->m_scalar < other.m_scalar;
+        m_type = m_storage->Nodes[m_index].Type;
     }
 
-    Node& Node::operator[](std::string_view key)
+    void Node::SetScalar(std::string value)
     {
-        Require(Type::Mapping);
-        auto itrs = m_mapping->equal_range(key);
+        Require(Type::Scalar);
+        m_storage->Nodes[m_index].Scalar = m_storage->AddString(std::move(value));
+    }
 
-        if (itrs.first == itrs.second)
+    Node Node::Clone() const
+    {
+        if (!m_storage)
         {
-            return s_globalInvalidNode;
+            return {};
         }
 
-        Node& result = itrs.first->second;
-
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, ++itrs.first != itrs.second);
+        auto storage = std::make_shared<details::NodeStorage>();
+        uint32_t index = storage->AddCopy(*m_storage, m_index);
+        return { std::move(storage), index };
+    }
 
-        return result;
+    bool Node::operator<(const Node& other) const
+    {
+        Require(Type::Scalar);
+        other.Require(Type::Scalar);
+        return GetScalar() < other.GetScalar();
     }
 
-    const Node& Node::operator[](std::string_view key) const
+    Node Node::operator[](std::string_view key) const
     {
         Require(Type::Mapping);
-        auto itrs = m_mapping->equal_range(key);
 
-        if (itrs.first == itrs.second)
+        const details::NodeData& data = m_storage->Nodes[m_index];
+        const uint32_t* entries = m_storage->Children.data() + data.ChildStart;
+        size_t count = data.ChildCount / 2;
+
+        auto getKey = [&](size_t entry) { return m_storage->Nodes[entries[2 * entry]].Scalar; };
+
+        // The entries are ordered by key, so the first match is found with a binary search
+        size_t low = 0;
+        size_t high = count;
+        while (low < high)
         {
-            return s_globalInvalidNode;
+            size_t middle = low + (high - low) / 2;
+            if (getKey(middle) < key)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
         }
 
-        const Node& result = itrs.first->second;
+        if (low == count || getKey(low) != key)
+        {
+            return {};
+        }
 
-        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, ++itrs.first != itrs.second);
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_DUPLICATE_MAPPING_KEY, low + 1 < count && getKey(low + 1) == key);
 
-        return result;
+        return { m_storage, entries[2 * low + 1] };
     }
 
-    Node& Node::operator[](size_t index)
+    Node Node::operator[](size_t index) const
     {
         Require(Type::Sequence);
-        return m_sequence.value()[index];
-    }
 
-    const Node& Node::operator[](size_t index) const
-    {
-        Require(Type::Sequence);
-        return m_sequence.value()[index];
+        const details::NodeData& data = m_storage->Nodes[m_index];
+        THROW_HR_IF(E_BOUNDS, index >= data.ChildCount);
+
+        return { m_storage, m_storage->Children[data.ChildStart + index] };
     }
 
     size_t Node::size() const
@@ -209,24 +427,30 @@ namespace AppInstaller::YAML
         case Type::Scalar:
             return 0;
         case Type::Sequence:
-            return m_sequence->size();
+            return m_storage->Nodes[m_index].ChildCount;
         case Type::Mapping:
-            return m_mapping->size();
+            return m_storage->Nodes[m_index].ChildCount / 2;
         }
 
         THROW_HR(E_UNEXPECTED);
     }
 
-    const std::vector<Node>& Node::Sequence() const
+    const Mark& Node::Mark() const
+    {
+        static const YAML::Mark s_noMark;
+        return m_storage ? m_storage->Nodes[m_index].Mark : s_noMark;
+    }
+
+    NodeChildRange<Node> Node::Sequence() const
     {
         Require(Type::Sequence);
-        return m_sequence.value();
+        return { *this };
     }
 
-    const std::multimap<Node, Node>& Node::Mapping() const
+    NodeChildRange<std::pair<Node, Node>> Node::Mapping() const
     {
         Require(Type::Mapping);
-        return m_mapping.value();
+        return { *this };
     }
 
     void Node::Require(Type type) const
@@ -234,29 +458,94 @@ namespace AppInstaller::YAML
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INVALID_OPERATION, m_type != type);
     }
 
+    std::string_view Node::GetScalar() const
+    {
+        return m_type == Type::Scalar ? m_storage->Nodes[m_index].Scalar : std::string_view{};
+    }
+
+    void Node::BindToChild(const Node& parent, size_t position)
+    {
+        if (!m_storage)
+        {
+            m_storage = parent.m_storage;
+        }
+
+        const details::NodeData& data = m_storage->Nodes[parent.m_index];
+        m_index = m_storage->Children[data.ChildStart + position];
+        m_type = m_storage->Nodes[m_index].Type;
+    }
+
+    Node Node::AppendToSequence(const Node& child)
+    {
+        Require(Type::Sequence);
+
+        uint32_t childIndex = child.m_storage ? m_storage->AddCopy(*child.m_storage, child.m_index) : m_storage->AddNode(Type::Invalid, {}, {});
+        m_storage->InsertChildren(m_index, m_storage->Nodes[m_index].ChildCount, { childIndex });
+
+        return { m_storage, childIndex };
+    }
+
+    Node Node::AppendToMapping(const Node& key, const Node& value)
+    {
+        Require(Type::Mapping);
+        key.Require(Type::Scalar);
+
+        uint32_t keyIndex = m_storage->AddCopy(*key.m_storage, key.m_index);
+        uint32_t valueIndex = value.m_storage ? m_storage->AddCopy(*value.m_storage, value.m_index) : m_storage->AddNode(Type::Invalid, {}, {});
+
+        // The entry goes after any with the same key, keeping the mapping ordered as SortMapping would
+        const details::NodeData& data = m_storage->Nodes[m_index];
+        std::string_view keyScalar = m_storage->Nodes[keyIndex].Scalar;
+        uint32_t low = 0;
+        uint32_t high = data.ChildCount / 2;
+        while (low < high)
+        {
+            uint32_t middle = low + (high - low) / 2;
+            if (keyScalar < m_storage->Nodes[m_storage->Children[data.ChildStart + 2 * middle]].Scalar)
+            {
+                high = middle;
+            }
+            else
+            {
+                low = middle + 1;
+            }
+        }
+
+        m_storage->InsertChildren(m_index, 2 * low, { keyIndex, valueIndex });
+
+        return { m_storage, valueIndex };
+    }
+
     std::string Node::as_dispatch(std::string*) const
     {
-        return m_scalar;
+        return std::string{ GetScalar() };
+    }
+
+    std::string_view Node::as_dispatch(std::string_view*) const
+    {
+        return GetScalar();
     }
 
     int64_t Node::as_dispatch(int64_t*) const
     {
-        return std::stoll(m_scalar);
+        return std::stoll(std::string{ GetScalar() });
     }
 
     int Node::as_dispatch(int*) const
     {
         // To allow HResult representation
-        return static_cast<int>(std::stoll(m_scalar, 0, 0));
+        return static_cast<int>(std::stoll(std::string{ GetScalar() }, 0, 0));
     }
 
     bool Node::as_dispatch(bool*) const
     {
-        if (Utility::CaseInsensitiveEquals(m_scalar, "true"))
+        std::string_view scalar = GetScalar();
+
+        if (Utility::CaseInsensitiveEquals(scalar, "true"))
         {
             return true;
         }
-        else if (Utility::CaseInsensitiveEquals(m_scalar, "false"))
+        else if (Utility::CaseInsensitiveEquals(scalar, "false"))
         {
             return false;
         }
@@ -269,16 +558,7 @@ namespace AppInstaller::YAML
     Node Load(std::string_view input)
     {
         Wrapper::Parser parser(input);
-        Wrapper::Document document = parser.Load();
-
-        if (document.HasRoot())
-        {
-            return document.GetRoot();
-        }
-        else
-        {
-            return {};
-        }
+        return parser.Load();
     }
 
     Node Load(const std::string& input)
@@ -289,16 +569,7 @@ namespace AppInstaller::YAML
     Node Load(std::istream& input, Utility::SHA256::HashBuffer* hashOut)
     {
         Wrapper::Parser parser(input, hashOut);
-        Wrapper::Document document = parser.Load();
-
-        if (document.HasRoot())
-        {
-            return document.GetRoot();
-        }
-        else
-        {
-            return {};
-        }
+        return parser.Load();
     }
 
     Node Load(const std::filesystem::path& input, Utility::SHA256::HashBuffer* hashOut)
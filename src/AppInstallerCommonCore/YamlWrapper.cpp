@@ -12,23 +12,6 @@ namespace AppInstaller::YAML::Wrapper
 {
     namespace
     {
-        Node::Type ConvertNodeType(yaml_node_type_t type)
-        {
-            switch (type)
-            {
-            case YAML_NO_NODE:
-                return Node::Type::None;
-            case YAML_SCALAR_NODE:
-                return Node::Type::Scalar;
-            case YAML_SEQUENCE_NODE:
-                return Node::Type::Sequence;
-            case YAML_MAPPING_NODE:
-                return Node::Type::Mapping;
-            }
-
-            THROW_HR(E_UNEXPECTED);
-        }
-
         Exception::Type ConvertErrorType(yaml_error_type_t type)
         {
             switch (type)
@@ -54,26 +37,33 @@ namespace AppInstaller::YAML::Wrapper
             THROW_HR(E_UNEXPECTED);
         }
 
-        std::string ConvertYamlString(yaml_char_t* string, size_t length = std::string::npos)
+        Mark ConvertMark(const yaml_mark_t& mark)
         {
-            if (length == std::string::npos)
-            {
-                return { reinterpret_cast<char*>(string) };
-            }
-            else
-            {
-                return { reinterpret_cast<char*>(string), length };
-            }
+            return { mark.line + 1, mark.column + 1 };
         }
 
-        std::string ConvertScalarToString(yaml_node_t* node)
+        // An event produced by the parser, deleted when it goes out of scope.
+        struct ParsedEvent
         {
-            return ConvertYamlString(node->data.scalar.value, node->data.scalar.length);
-        }
+            ParsedEvent() = default;
 
-        Mark ConvertMark(const yaml_mark_t& mark)
+            ParsedEvent(const ParsedEvent&) = delete;
+            ParsedEvent& operator=(const ParsedEvent&) = delete;
+
+            ~ParsedEvent()
+            {
+                yaml_event_delete(&Event);
+            }
+
+            yaml_event_t Event = {};
+        };
+
+        // Gets the tag of a node as the composer would give it; the default tag for its type if it has none, or a non-specific one.
+        // Tags from the event are copied into the storage, as they are deleted with the event.
+        std::string_view GetTag(details::NodeStorage& storage, yaml_char_t* tag, const char* defaultTag)
         {
-            return { mark.line + 1, mark.column + 1 };
+            std::string_view tagView = tag ? std::string_view{ reinterpret_cast<char*>(tag) } : std::string_view{};
+            return (tagView.empty() || tagView == "!") ? std::string_view{ defaultTag } : storage.AddText(tagView);
         }
     }
 
@@ -102,99 +92,6 @@ namespace AppInstaller::YAML::Wrapper
         }
     }
 
-    bool Document::HasRoot()
-    {
-        return yaml_document_get_root_node(&m_document) != nullptr;
-    }
-
-    Node Document::GetRoot()
-    {
-        yaml_node_t* root = yaml_document_get_root_node(&m_document);
-
-        if (!root)
-        {
-            return {};
-        }
-
-        Node result(ConvertNodeType(root->type), ConvertYamlString(root->tag), ConvertMark(root->start_mark));
-
-        struct StackItem
-        {
-            StackItem(yaml_node_t* yn, Node* n) :
-                yamlNode(yn), node(n) {}
-
-            yaml_node_t* yamlNode = nullptr;
-            Node* node = nullptr;
-            size_t childOffset = 0;
-        };
-
-        std::stack<StackItem> resultStack;
-        resultStack.emplace(root, &result);
-
-        while (!resultStack.empty())
-        {
-            StackItem& stackItem = resultStack.top();
-            bool pop = false;
-
-            switch (stackItem.yamlNode->type)
-            {
-            case YAML_NO_NODE:
-                pop = true;
-                break;
-            case YAML_SCALAR_NODE:
-                stackItem.node->SetScalar(ConvertScalarToString(stackItem.yamlNode));
-                pop = true;
-                break;
-            case YAML_SEQUENCE_NODE:
-            {
-                yaml_node_item_t* child = stackItem.yamlNode->data.sequence.items.start + stackItem.childOffset++;
-                if (child < stackItem.yamlNode->data.sequence.items.top)
-                {
-                    yaml_node_t* childYamlNode = GetNode(*child);
-                    Node& childNode = stackItem.node->AddSequenceNode(ConvertNodeType(childYamlNode->type), ConvertYamlString(childYamlNode->tag), ConvertMark(childYamlNode->start_mark));
-                    resultStack.emplace(childYamlNode, &childNode);
-                }
-                else
-                {
-                    // We've reached the end of the sequence
-                    pop = true;
-                }
-                break;
-            }
-            case YAML_MAPPING_NODE:
-            {
-                yaml_node_pair_t* child = stackItem.yamlNode->data.mapping.pairs.start + stackItem.childOffset++;
-                if (child < stackItem.yamlNode->data.mapping.pairs.top)
-                {
-                    yaml_node_t* keyYamlNode = GetNode(child->key);
-                    THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INVALID_MAPPING_KEY, keyYamlNode->type != YAML_SCALAR_NODE);
-
-                    Node keyNode(ConvertNodeType(keyYamlNode->type), ConvertYamlString(keyYamlNode->tag), ConvertMark(keyYamlNode->start_mark));
-                    keyNode.SetScalar(ConvertScalarToString(keyYamlNode));
-
-                    yaml_node_t* valueYamlNode = GetNode(child->value);
-
-                    Node& childNode = stackItem.node->AddMappingNode(std::move(keyNode), ConvertNodeType(valueYamlNode->type), ConvertYamlString(valueYamlNode->tag), ConvertMark(valueYamlNode->start_mark));
-                    resultStack.emplace(valueYamlNode, &childNode);
-                }
-                else
-                {
-                    // We've reached the end of the mapping
-                    pop = true;
-                }
-                break;
-            }
-            }
-
-            if (pop)
-            {
-                resultStack.pop();
-            }
-        }
-
-        return result;
-    }
-
     int Document::AddScalar(std::string_view value)
     {
         int result = yaml_document_add_scalar(&m_document, NULL, reinterpret_cast<const yaml_char_t*>(value.data()), static_cast<int>(value.size()), YAML_ANY_SCALAR_STYLE);
@@ -232,13 +129,6 @@ namespace AppInstaller::YAML::Wrapper
         }
     }
 
-    yaml_node_t* Document::GetNode(yaml_node_item_t index)
-    {
-        yaml_node_t* result = yaml_document_get_node(&m_document, index);
-        THROW_HR_IF(E_BOUNDS, !result);
-        return result;
-    }
-
     Parser::Parser(std::string_view input) : m_token(true), m_input(input)
     {
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INIT_FAILED, !yaml_parser_initialize(&m_parser));
@@ -251,11 +141,48 @@ namespace AppInstaller::YAML::Wrapper
     {
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INIT_FAILED, !yaml_parser_initialize(&m_parser));
 
-        m_input = Utility::ReadEntireStream(input);
+        std::streampos currentPos = input.tellg();
+        input.seekg(0, std::ios_base::end);
+
+        auto offset = input.tellg() - currentPos;
+        input.seekg(currentPos);
+
+        // Don't allow use of this API for reading very large streams.
+        THROW_HR_IF(E_OUTOFMEMORY, offset > static_cast<std::streamoff>(std::numeric_limits<uint32_t>::max()));
+        m_input.resize(static_cast<size_t>(offset));
 
+        // The input is hashed a chunk at a time as it is read, rather than in a second pass over all of it
+        constexpr size_t c_chunkSize = 64 << 10;
+        std::optional<Utility::SHA256> hasher;
         if (hashOut)
         {
-            *hashOut = Utility::SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(m_input.data()), static_cast<uint32_t>(m_input.size()));
+            hasher.emplace();
+        }
+
+        size_t position = 0;
+        while (position < m_input.size())
+        {
+            size_t toRead = std::min(c_chunkSize, m_input.size() - position);
+            input.read(&m_input[position], static_cast<std::streamsize>(toRead));
+            size_t read = static_cast<size_t>(input.gcount());
+
+            if (hasher)
+            {
+                hasher->Add(reinterpret_cast<const uint8_t*>(m_input.data() + position), read);
+            }
+
+            position += read;
+
+            if (read < toRead)
+            {
+                m_input.resize(position);
+                break;
+            }
+        }
+
+        if (hasher)
+        {
+            *hashOut = hasher->Get();
         }
 
         PrepareInput();
@@ -270,30 +197,197 @@ namespace AppInstaller::YAML::Wrapper
         }
     }
 
-    Document Parser::Load()
+    Node Parser::Load()
     {
-        Document result;
+        auto parse = [&](ParsedEvent& event)
+        {
+            if (!yaml_parser_parse(&m_parser, &event.Event))
+            {
+                ThrowError();
+            }
+        };
 
-        if (!yaml_parser_load(&m_parser, &result))
+        // Mirrors yaml_parser_load, which skips the start of the stream and produces no document at its end
+        if (!m_parser.stream_start_produced)
         {
-            Exception::Type type = ConvertErrorType(m_parser.error);
+            ParsedEvent streamStart;
+            parse(streamStart);
+        }
 
-            switch (type)
+        if (m_parser.stream_end_produced)
+        {
+            return {};
+        }
+
+        {
+            ParsedEvent documentStart;
+            parse(documentStart);
+
+            if (documentStart.Event.type == YAML_STREAM_END_EVENT)
+            {
+                return {};
+            }
+        }
+
+        auto storage = std::make_shared<details::NodeStorage>();
+
+        // The decoded text is never longer than the input, other than for UTF-16 input, so one block is almost always enough
+        storage->AllocateTextBlock(m_input.size() + 1);
+
+        // The children of the containers that have not ended yet; each container is given a single block for all of its
+        // children when it ends.
+        struct OpenContainer
+        {
+            uint32_t Node;
+            size_t FirstChild;
+        };
+
+        std::vector<OpenContainer> containers;
+        std::vector<uint32_t> children;
+        std::optional<uint32_t> root;
+
+        // Anchors are registered when their node starts, as the composer does
+        struct Anchor
+        {
+            uint32_t Node;
+            YAML::Mark Mark;
+        };
+
+        std::map<std::string, Anchor, std::less<>> anchors;
+        bool invalidMappingKey = false;
+
+        auto addChild = [&](uint32_t node)
+        {
+            if (containers.empty())
+            {
+                root = node;
+            }
+            else
+            {
+                children.emplace_back(node);
+            }
+        };
+
+        auto registerAnchor = [&](yaml_char_t* anchor, uint32_t node, const yaml_mark_t& mark)
+        {
+            if (!anchor)
+            {
+                return;
+            }
+
+            auto [itr, inserted] = anchors.emplace(reinterpret_cast<char*>(anchor), Anchor{ node, ConvertMark(mark) });
+            if (!inserted)
+            {
+                THROW_EXCEPTION(Exception(Exception::Type::Composer, "second occurrence", ConvertMark(mark), "found duplicate anchor; first occurrence", itr->second.Mark));
+            }
+        };
+
+        for (bool documentEnded = false; !documentEnded;)
+        {
+            ParsedEvent event;
+            parse(event);
+            const yaml_event_t& yamlEvent = event.Event;
+
+            switch (yamlEvent.type)
+            {
+            case YAML_ALIAS_EVENT:
+            {
+                auto itr = anchors.find(std::string_view{ reinterpret_cast<char*>(yamlEvent.data.alias.anchor) });
+                if (itr == anchors.end())
+                {
+                    THROW_EXCEPTION(Exception(Exception::Type::Composer, "found undefined alias", ConvertMark(yamlEvent.start_mark)));
+                }
+
+                // A container that refers to itself can't be copied
+                uint32_t anchorNode = itr->second.Node;
+                if (std::any_of(containers.begin(), containers.end(), [&](const OpenContainer& container) { return container.Node == anchorNode; }))
+                {
+                    THROW_EXCEPTION(Exception(Exception::Type::Composer, "found recursive alias", ConvertMark(yamlEvent.start_mark)));
+                }
+
+                // As with yaml_parser_load, every alias is a separate copy of its node
+                addChild(storage->AddCopy(*storage, anchorNode));
+                break;
+            }
+            case YAML_SCALAR_EVENT:
+            {
+                uint32_t node = storage->AddNode(Node::Type::Scalar, GetTag(*storage, yamlEvent.data.scalar.tag, YAML_DEFAULT_SCALAR_TAG), ConvertMark(yamlEvent.start_mark));
+                storage->Nodes[node].Scalar = storage->AddText({ reinterpret_cast<char*>(yamlEvent.data.scalar.value), yamlEvent.data.scalar.length });
+                registerAnchor(yamlEvent.data.scalar.anchor, node, yamlEvent.start_mark);
+                addChild(node);
+                break;
+            }
+            case YAML_SEQUENCE_START_EVENT:
+            case YAML_MAPPING_START_EVENT:
             {
-            case Exception::Type::Memory:
-                THROW_EXCEPTION(Exception(type));
-            case Exception::Type::Reader:
-                THROW_EXCEPTION(Exception(type, m_parser.problem, m_parser.problem_offset, m_parser.problem_value));
-            case Exception::Type::Scanner:
-            case Exception::Type::Parser:
-            case Exception::Type::Composer:
-                THROW_EXCEPTION(Exception(type, m_parser.problem, ConvertMark(m_parser.problem_mark), m_parser.context, ConvertMark(m_parser.context_mark)));
+                bool isSequence = (yamlEvent.type == YAML_SEQUENCE_START_EVENT);
+                uint32_t node = storage->AddNode(
+                    isSequence ? Node::Type::Sequence : Node::Type::Mapping,
+                    isSequence ? GetTag(*storage, yamlEvent.data.sequence_start.tag, YAML_DEFAULT_SEQUENCE_TAG) : GetTag(*storage, yamlEvent.data.mapping_start.tag, YAML_DEFAULT_MAPPING_TAG),
+                    ConvertMark(yamlEvent.start_mark));
+                registerAnchor(isSequence ? yamlEvent.data.sequence_start.anchor : yamlEvent.data.mapping_start.anchor, node, yamlEvent.start_mark);
+                addChild(node);
+                containers.emplace_back(OpenContainer{ node, children.size() });
+                break;
+            }
+            case YAML_SEQUENCE_END_EVENT:
+            case YAML_MAPPING_END_EVENT:
+            {
+                OpenContainer container = containers.back();
+                containers.pop_back();
+
+                uint32_t childCount = static_cast<uint32_t>(children.size() - container.FirstChild);
+                uint32_t childStart = storage->AllocateChildren(container.Node, childCount);
+                std::copy(children.begin() + container.FirstChild, children.end(), storage->Children.begin() + childStart);
+                children.resize(container.FirstChild);
+
+                if (yamlEvent.type == YAML_MAPPING_END_EVENT)
+                {
+                    // Reported once the whole document has been parsed, as the composer does
+                    for (uint32_t i = 0; i < childCount; i += 2)
+                    {
+                        invalidMappingKey = invalidMappingKey || storage->Nodes[storage->Children[childStart + i]].Type != Node::Type::Scalar;
+                    }
+
+                    storage->SortMapping(container.Node);
+                }
+                break;
+            }
+            case YAML_DOCUMENT_END_EVENT:
+                documentEnded = true;
+                break;
             default:
-                THROW_EXCEPTION(Exception(type, "An unexpected error type occurred in Parser::Load"));
+                THROW_HR(E_UNEXPECTED);
             }
         }
 
-        return result;
+        THROW_HR_IF(APPINSTALLER_CLI_ERROR_YAML_INVALID_MAPPING_KEY, invalidMappingKey);
+
+        if (!root)
+        {
+            return {};
+        }
+
+        return details::NodeStorage::GetNode(std::move(storage), root.value());
+    }
+
+    void Parser::ThrowError()
+    {
+        Exception::Type type = ConvertErrorType(m_parser.error);
+
+        switch (type)
+        {
+        case Exception::Type::Memory:
+            THROW_EXCEPTION(Exception(type));
+        case Exception::Type::Reader:
+            THROW_EXCEPTION(Exception(type, m_parser.problem, m_parser.problem_offset, m_parser.problem_value));
+        case Exception::Type::Scanner:
+        case Exception::Type::Parser:
+        case Exception::Type::Composer:
+            THROW_EXCEPTION(Exception(type, m_parser.problem, ConvertMark(m_parser.problem_mark), m_parser.context, ConvertMark(m_parser.context_mark)));
+        default:
+            THROW_EXCEPTION(Exception(type, "An unexpected error type occurred in Parser::Load"));
+        }
     }
 
     void Parser::PrepareInput()
@@ -6,7 +6,9 @@
 #include "AppInstallerLanguageUtilities.h"
 #include "AppInstallerSHA256.h"
 
+#include <deque>
 #include <iostream>
+#include <optional>
 #include <string_view>
 #include <vector>
 
@@ -34,12 +36,6 @@ namespace AppInstaller::YAML::Wrapper
         // it has been handed off to the emitter.
         void Detach() { m_token = false; }
 
-        // Determines whether the document has a root node.
-        bool HasRoot();
-
-        // Gets the root node of the document, if it has one.
-        Node GetRoot();
-
         // Adds a scalar node to the document.
         int AddScalar(std::string_view value);
 
@@ -56,12 +52,101 @@ namespace AppInstaller::YAML::Wrapper
         void AppendMappingPair(int mapping, int key, int value);
 
     private:
-        // Gets the node referenced by the index.
-        yaml_node_t* GetNode(yaml_node_item_t index);
-
         DestructionToken m_token;
         yaml_document_t m_document;
     };
+}
+
+namespace AppInstaller::YAML::details
+{
+    // An entry in the node storage.
+    struct NodeData
+    {
+        NodeData(Node::Type type, std::string_view tag, const YAML::Mark& mark) :
+            Type(type), Tag(tag), Mark(mark) {}
+
+        Node::Type Type;
+        std::string_view Tag;
+        YAML::Mark Mark;
+        std::string_view Scalar;
+
+        // The range of Children that holds the indices of the child nodes; a mapping has a key and a value per entry.
+        // The range has room for ChildCapacity children before it needs to be moved.
+        uint32_t ChildStart = 0;
+        uint32_t ChildCount = 0;
+        uint32_t ChildCapacity = 0;
+    };
+
+    // The text that the nodes of a storage refer to; text is only ever added, so it never moves or goes away.
+    // Kept separately from the nodes so that copies of nodes in other storages can refer to it rather than copying it.
+    struct NodeText
+    {
+        // The text of nodes that were created or changed after loading.
+        std::deque<std::string> Strings;
+
+        // Blocks of the text of nodes built from parser events.
+        std::vector<std::unique_ptr<char[]>> TextBlocks;
+    };
+
+    // The nodes of a document, stored in a single vector and referring to each other by index.
+    // The children of a node are always contiguous, and the entries of a mapping are kept ordered by key.
+    struct NodeStorage
+    {
+        // Gets a handle to the node.
+        static Node GetNode(std::shared_ptr<NodeStorage> storage, uint32_t node);
+
+        std::vector<NodeData> Nodes;
+        std::vector<uint32_t> Children;
+
+        // The number of entries in Children that are no longer in the range of any node.
+        size_t UnusedChildren = 0;
+
+        // The text owned by this storage.
+        std::shared_ptr<NodeText> Text = std::make_shared<NodeText>();
+
+        // The text of the other storages that nodes were copied from, which the copies still refer to.
+        std::vector<std::shared_ptr<const NodeText>> SharedText;
+
+        // The unused part of the last text block.
+        char* TextBlockNext = nullptr;
+        size_t TextBlockAvailable = 0;
+
+        // Takes ownership of the text.
+        std::string_view AddString(std::string value);
+
+        // Starts a new text block with room for at least the given amount of text.
+        void AllocateTextBlock(size_t size);
+
+        // Copies the text into the current text block, starting another if it does not fit.
+        std::string_view AddText(std::string_view value);
+
+        // Adds a node without any children.
+        uint32_t AddNode(Node::Type type, std::string_view tag, const YAML::Mark& mark);
+
+        // Sets the range of children of the node to a new block at the end of Children.
+        uint32_t AllocateChildren(uint32_t node, uint32_t count);
+
+        // Orders the entries of the mapping by key, keeping entries with equal keys in their original order.
+        void SortMapping(uint32_t node);
+
+        // Adds a copy of the node, and all of its children, from the source storage.
+        // The copies refer to the text of the source, which is kept alive by this storage.
+        uint32_t AddCopy(const NodeStorage& source, uint32_t node);
+
+        // Keeps the text alive as long as this storage is.
+        void ShareText(const std::shared_ptr<const NodeText>& text);
+
+        // Inserts the children into the node at the given position. If the node has no room for them, its children are moved
+        // to a larger range at the end of Children.
+        void InsertChildren(uint32_t node, uint32_t position, std::initializer_list<uint32_t> children);
+
+        // Packs the ranges of all of the nodes together, dropping the unused entries of Children.
+        void CompactChildren();
+    };
+}
+
+namespace AppInstaller::YAML::Wrapper
+{
 
     // A libyaml yaml_parser_t.
     // The core parser construct for reading bytes directly.
@@ -80,10 +165,14 @@ namespace AppInstaller::YAML::Wrapper
 
         yaml_parser_t* operator&() { return &m_parser; }
 
-        // Loads the next document from the input, if one exists.
-        Document Load();
+        // Loads the root node of the next document from the input, building the nodes directly from the parser events.
+        // Returns an undefined node if there is no document.
+        Node Load();
 
     private:
+        // Throws the error that the parser failed with.
+        [[noreturn]] void ThrowError();
+
         // Determines the type of encoding in use, transforming the input as necessary.
         void PrepareInput();
 
@@ -30,6 +30,52 @@ namespace AppInstaller::Repository
             return false;
         }
 
+        // Chooses the available package to correlate with an installed package from the matches a source found for it.
+        std::shared_ptr<IPackage> SelectAvailablePackage(
+            SearchResult& availableResult, IPackageVersion* installedVersion, const ISource& source, const SearchRequest& systemReferenceSearch)
+        {
+            std::shared_ptr<IPackage> availablePackage;
+
+            if (availableResult.Matches.size() == 1)
+            {
+                availablePackage = std::move(availableResult.Matches[0].Package);
+            }
+            else // availableResult.Matches.size() > 1
+            {
+                AICLI_LOG(Repo, Info,
+                    << "Found multiple matches for installed package [" << installedVersion->GetProperty(PackageVersionProperty::Id) <<
+                    "] in source [" << source.GetIdentifier() << "] when searching for [" << systemReferenceSearch.ToString() << "]");
+
+                // More than one match found for the system reference; run some heuristics to check for a match
+                for (auto&& availableMatch : availableResult.Matches)
+                {
+                    AICLI_LOG(Repo, Info, << "  Checking match with package id: " <<
+                        availableMatch.Package->GetLatestAvailableVersion()->GetProperty(PackageVersionProperty::Id));
+
+                    if (IsStrongMatchField(availableMatch.MatchCriteria.Field))
+                    {
+                        if (!availablePackage)
+                        {
+                            availablePackage = std::move(availableMatch.Package);
+                        }
+                        else
+                        {
+                            AICLI_LOG(Repo, Info, << "  Found multiple packages with strong match fields");
+                            availablePackage.reset();
+                            break;
+                        }
+                    }
+                }
+
+                if (!availablePackage)
+                {
+                    AICLI_LOG(Repo, Warning, << "  Appropriate available package could not be determined");
+                }
+            }
+
+            return availablePackage;
+        }
+
         // A composite package for the CompositeSource.
         struct CompositePackage : public IPackage
         {
@@ -444,82 +490,75 @@ namespace AppInstaller::Repository
             SearchResult installedResult = m_installedSource->Search(request);
             result.Truncated = installedResult.Truncated;
 
+            // Create a search request for each installed package to run against the available sources
+            std::vector<std::shared_ptr<CompositePackage>> compositePackages;
+            std::vector<SearchRequest> systemReferenceSearches;
+
             for (auto&& match : installedResult.Matches)
             {
                 auto compositePackage = std::make_shared<CompositePackage>(std::move(match.Package));
-
-                // Create a search request to run against all available sources
-                // TODO: Determine if we should create a single search or one for each installed package.
                 SearchRequest systemReferenceSearch;
 
-                auto installedVersion = compositePackage->GetInstalledVersion();
-                auto installedPackageData = result.GetSystemReferenceStrings(installedVersion.get());
+                auto installedPackageData = result.GetSystemReferenceStrings(compositePackage->GetInstalledVersion().get());
+                for (const auto& srs : installedPackageData.SystemReferenceStrings)
+                {
+                    srs.AddToFilters(systemReferenceSearch.Inclusions);
+                }
+
+                compositePackages.emplace_back(std::move(compositePackage));
+                systemReferenceSearches.emplace_back(std::move(systemReferenceSearch));
+            }
 
-                if (!installedPackageData.SystemReferenceStrings.empty())
+            // The packages that no source has found matches for yet
+            std::vector<size_t> uncorrelated;
+            for (size_t i = 0; i < systemReferenceSearches.size(); ++i)
+            {
+                if (!systemReferenceSearches[i].Inclusions.empty())
                 {
-                    for (const auto& srs : installedPackageData.SystemReferenceStrings)
-                    {
-                        srs.AddToFilters(systemReferenceSearch.Inclusions);
-                    }
+                    uncorrelated.emplace_back(i);
+                }
+            }
 
-                    std::shared_ptr<IPackage> availablePackage;
+            // Search each source for all of the packages that the sources before it did not find; once a source finds some
+            // matching packages for an installed package, the later sources are not searched for it.
+            for (const auto& source : m_availableSources)
+            {
+                if (uncorrelated.empty())
+                {
+                    break;
+                }
 
-                    // Search sources and add to result
-                    for (const auto& source : m_availableSources)
-                    {
-                        SearchResult availableResult = source->Search(systemReferenceSearch);
+                // Some sources, such as REST sources, can combine the searches into far fewer calls
+                std::vector<SearchRequest> requests;
+                for (size_t index : uncorrelated)
+                {
+                    requests.emplace_back(systemReferenceSearches[index]);
+                }
 
-                        if (availableResult.Matches.empty())
-                        {
-                            continue;
-                        }
+                std::vector<SearchResult> availableResults = source->SearchMultiple(requests);
 
-                        if (availableResult.Matches.size() == 1)
-                        {
-                            availablePackage = std::move(availableResult.Matches[0].Package);
-                        }
-                        else // availableResult.Matches.size() > 1
-                        {
-                            AICLI_LOG(Repo, Info,
-                                << "Found multiple matches for installed package [" << installedVersion->GetProperty(PackageVersionProperty::Id) <<
-                                "] in source [" << source->GetIdentifier() << "] when searching for [" << systemReferenceSearch.ToString() << "]");
-
-                            // More than one match found for the system reference; run some heuristics to check for a match
-                            for (auto&& availableMatch : availableResult.Matches)
-                            {
-                                AICLI_LOG(Repo, Info, << "  Checking match with package id: " <<
-                                    availableMatch.Package->GetLatestAvailableVersion()->GetProperty(PackageVersionProperty::Id));
-
-                                if (IsStrongMatchField(availableMatch.MatchCriteria.Field))
-                                {
-                                    if (!availablePackage)
-                                    {
-                                        availablePackage = std::move(availableMatch.Package);
-                                    }
-                                    else
-                                    {
-                                        AICLI_LOG(Repo, Info, << "  Found multiple packages with strong match fields");
-                                        availablePackage.reset();
-                                        break;
-                                    }
-                                }
-                            }
-
-                            if (!availablePackage)
-                            {
-                                AICLI_LOG(Repo, Warning, << "  Appropriate available package could not be determined");
-                            }
-                        }
+                std::vector<size_t> stillUncorrelated;
+                for (size_t i = 0; i < uncorrelated.size(); ++i)
+                {
+                    size_t index = uncorrelated[i];
 
-                        // We found some matching packages here, don't keep going
-                        break;
+                    if (availableResults[i].Matches.empty())
+                    {
+                        stillUncorrelated.emplace_back(index);
+                        continue;
                     }
 
-                    compositePackage->SetAvailablePackage(std::move(availablePackage));
+                    compositePackages[index]->SetAvailablePackage(SelectAvailablePackage(
+                        availableResults[i], compositePackages[index]->GetInstalledVersion().get(), *source, systemReferenceSearches[index]));
                 }
 
-                // Move the installed result into the composite result
-                result.Matches.emplace_back(std::move(compositePackage), std::move(match.MatchCriteria));
+                uncorrelated = std::move(stillUncorrelated);
+            }
+
+            // Move the installed result into the composite result
+            for (size_t i = 0; i < compositePackages.size(); ++i)
+            {
+                result.Matches.emplace_back(std::move(compositePackages[i]), std::move(installedResult.Matches[i].MatchCriteria));
             }
 
             // Optimization for the "everything installed" case, no need to allow for reverse correlations
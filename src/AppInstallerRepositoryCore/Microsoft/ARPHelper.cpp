@@ -351,4 +351,69 @@ namespace AppInstaller::Repository::Microsoft
             }
         }
     }
+
+    std::vector<ARPEntryVersion> ARPHelper::GetEntryVersions() const
+    {
+        std::vector<ARPEntryVersion> entries;
+
+        for (auto scope : { Manifest::ScopeEnum::Machine, Manifest::ScopeEnum::User })
+        {
+            for (auto architecture : Utility::GetApplicableArchitectures())
+            {
+                Registry::Key arpRootKey = GetARPKey(scope, architecture);
+
+                if (arpRootKey)
+                {
+                    AddEntryVersionsFromKey(entries, arpRootKey);
+                }
+            }
+        }
+
+        // As in the index, the first entry for a product code wins over any duplicates in later locations
+        std::set<std::string> productCodes;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+            [&](const ARPEntryVersion& entry) { return !productCodes.emplace(entry.ProductCode).second; }), entries.end());
+
+        return entries;
+    }
+
+    void ARPHelper::AddEntryVersionsFromKey(std::vector<ARPEntryVersion>& entries, const Registry::Key& key) const
+    {
+        for (const auto& arpEntry : key)
+        {
+            std::string productCode;
+
+            try
+            {
+                productCode = arpEntry.Name();
+
+                Registry::Key arpKey = arpEntry.Open();
+
+                // Apply the same filters as PopulateIndexFromKey
+                if (GetBoolValue(arpKey, SystemComponent))
+                {
+                    continue;
+                }
+
+                auto displayName = arpKey[DisplayName];
+                if (!displayName || displayName->GetType() != Registry::Value::Type::String || displayName->GetValue<Registry::Value::Type::String>().empty())
+                {
+                    continue;
+                }
+
+                std::string version = DetermineVersion(arpKey);
+                if (version.empty())
+                {
+                    continue;
+                }
+
+                entries.emplace_back(ARPEntryVersion{ std::move(productCode), std::move(version) });
+            }
+            catch (...)
+            {
+                AICLI_LOG(Repo, Warning, << "Failed to read ARP entry version, ignoring it: " << productCode);
+                LOG_CAUGHT_EXCEPTION();
+            }
+        }
+    }
 }
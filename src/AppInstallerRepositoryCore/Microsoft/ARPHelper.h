@@ -2,12 +2,14 @@
 // Licensed under the MIT License.
 #pragma once
 #include "Microsoft/SQLiteIndex.h"
+#include "Public/AppInstallerRepositorySource.h"
 #include <AppInstallerArchitecture.h>
 #include <winget/Registry.h>
 #include <winget/ManifestInstaller.h>
 #include <wil/resource.h>
 
 #include <string>
+#include <vector>
 
 namespace AppInstaller::Repository::Microsoft
 {
@@ -77,5 +79,12 @@ namespace AppInstaller::Repository::Microsoft
         // This entry point is primarily to allow unit tests to operate of arbitrary keys;
         // product code should use PopulateIndexFromARP.
         void PopulateIndexFromKey(SQLiteIndex& index, const Registry::Key& key, std::string_view scope, std::string_view architecture) const;
+
+        // Gets the product code and version of the entries that PopulateIndexFromARP would add to an index,
+        // for all scopes and architectures, without reading any of the other values.
+        std::vector<ARPEntryVersion> GetEntryVersions() const;
+
+        // Appends the product code and version of the entries that PopulateIndexFromKey would add to an index.
+        void AddEntryVersionsFromKey(std::vector<ARPEntryVersion>& entries, const Registry::Key& key) const;
     };
 }
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "Microsoft/ManifestCache.h"
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Repository::Microsoft
+{
+    namespace
+    {
+        constexpr std::string_view s_CacheDirectoryName = "ManifestCache"sv;
+        constexpr std::string_view s_EntryExtension = ".bin"sv;
+
+        // The extension of the entries from before they were stored in binary form; these are removed rather than read.
+        constexpr std::string_view s_ObsoleteEntryExtension = ".yaml"sv;
+    }
+
+    ManifestCache::ManifestCache(std::filesystem::path directory, uint64_t maxSizeInBytes) :
+        m_directory(std::move(directory)), m_maxSizeInBytes(maxSizeInBytes) {}
+
+    ManifestCache ManifestCache::FromUserSettings()
+    {
+        return { GetDefaultDirectory(), static_cast<uint64_t>(Settings::User().Get<Settings::Setting::NetworkManifestCacheMaxSizeInMB>()) << 20 };
+    }
+
+    std::filesystem::path ManifestCache::GetDefaultDirectory()
+    {
+        return Runtime::GetPathTo(Runtime::PathName::LocalState) / s_CacheDirectoryName;
+    }
+
+    std::optional<std::string> ManifestCache::Find(const Utility::SHA256::HashBuffer& hash)
+    {
+        if (!IsEnabled() || hash.size() != Utility::SHA256::HashBufferSizeInBytes)
+        {
+            return {};
+        }
+
+        try
+        {
+            std::filesystem::path entryPath = GetEntryPath(hash);
+
+            std::ifstream stream{ entryPath, std::ios_base::in | std::ios_base::binary };
+            if (!stream)
+            {
+                return {};
+            }
+
+            std::ostringstream contents;
+            contents << stream.rdbuf();
+            stream.close();
+
+            // Mark the entry as recently used so that it is the last to be evicted
+            std::error_code error;
+            std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+
+            AICLI_LOG(Repo, Info, << "Found manifest in the cache: " << entryPath);
+            return contents.str();
+        }
+        CATCH_LOG();
+
+        return {};
+    }
+
+    void ManifestCache::Add(const Utility::SHA256::HashBuffer& hash, const std::string& contents)
+    {
+        if (!IsEnabled() || hash.size() != Utility::SHA256::HashBufferSizeInBytes)
+        {
+            return;
+        }
+
+        try
+        {
+            std::filesystem::create_directories(m_directory);
+
+            // The temporary name is unique to this process so that concurrent writers of the same manifest do not collide
+            std::filesystem::path entryPath = GetEntryPath(hash);
+            std::filesystem::path tempPath = entryPath;
+            tempPath += "." + std::to_string(GetCurrentProcessId());
+            tempPath += ".tmp";
+
+            {
+                std::ofstream stream{ tempPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+                THROW_LAST_ERROR_IF(!stream);
+                stream.write(contents.c_str(), contents.size());
+                stream.flush();
+                THROW_LAST_ERROR_IF(!stream);
+            }
+
+            // Publish the entry in a single step so that other processes never observe a partially written manifest
+            std::error_code error;
+            std::filesystem::rename(tempPath, entryPath, error);
+            if (error)
+            {
+                std::filesystem::remove(tempPath, error);
+                return;
+            }
+
+            EnforceMaximumSize();
+        }
+        CATCH_LOG();
+    }
+
+    void ManifestCache::Remove(const Utility::SHA256::HashBuffer& hash)
+    {
+        if (hash.size() != Utility::SHA256::HashBufferSizeInBytes)
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::remove(GetEntryPath(hash), error);
+    }
+
+    std::filesystem::path ManifestCache::GetEntryPath(const Utility::SHA256::HashBuffer& hash) const
+    {
+        std::filesystem::path result = m_directory / Utility::SHA256::ConvertToString(hash);
+        result += s_EntryExtension;
+        return result;
+    }
+
+    void ManifestCache::EnforceMaximumSize()
+    {
+        struct FileInfo
+        {
+            std::filesystem::path Path;
+            std::filesystem::file_time_type LastUsed;
+            uint64_t Size;
+        };
+
+        std::vector<FileInfo> files;
+        uint64_t totalSize = 0;
+
+        for (const auto& file : std::filesystem::directory_iterator{ m_directory })
+        {
+            if (file.is_regular_file() && file.path().extension() == s_EntryExtension)
+            {
+                files.emplace_back(FileInfo{ file.path(), file.last_write_time(), file.file_size() });
+                totalSize += files.back().Size;
+            }
+            else if (file.is_regular_file() && file.path().extension() == s_ObsoleteEntryExtension)
+            {
+                std::error_code error;
+                std::filesystem::remove(file.path(), error);
+            }
+        }
+
+        if (totalSize <= m_maxSizeInBytes)
+        {
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.LastUsed < b.LastUsed; });
+
+        for (const auto& file : files)
+        {
+            if (totalSize <= m_maxSizeInBytes)
+            {
+                break;
+            }
+
+            std::error_code error;
+            if (std::filesystem::remove(file.Path, error))
+            {
+                totalSize -= file.Size;
+            }
+        }
+    }
+}
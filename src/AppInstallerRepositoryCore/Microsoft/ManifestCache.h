@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <AppInstallerSHA256.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace AppInstaller::Repository::Microsoft
+{
+    // An on-disk cache of the manifests downloaded for index-backed sources, keyed by the SHA256 hash that the index
+    // provides for each of them. Entries are stored already parsed, in the form written by Manifest::BinarySerializer.
+    // A manifest is only added after its hash is verified, and each entry is published with a single rename, so its
+    // contents are not checked again when read. The least recently used entries are removed to keep the cache within
+    // its maximum size. Failures to read or write the cache are logged and otherwise ignored.
+    struct ManifestCache
+    {
+        ManifestCache(std::filesystem::path directory, uint64_t maxSizeInBytes);
+
+        // Gets the cache as configured in the user settings.
+        static ManifestCache FromUserSettings();
+
+        // Gets the directory where manifests are cached.
+        static std::filesystem::path GetDefaultDirectory();
+
+        // Determines whether the cache stores anything at all.
+        bool IsEnabled() const { return m_maxSizeInBytes != 0; }
+
+        // Gets the contents of the manifest with the given hash, if it is cached.
+        std::optional<std::string> Find(const Utility::SHA256::HashBuffer& hash);
+
+        // Adds the manifest, whose contents must have the given hash.
+        // Evicts the least recently used manifests if the cache grows too large.
+        void Add(const Utility::SHA256::HashBuffer& hash, const std::string& contents);
+
+        // Removes the manifest with the given hash, if it is cached.
+        void Remove(const Utility::SHA256::HashBuffer& hash);
+
+    private:
+        std::filesystem::path GetEntryPath(const Utility::SHA256::HashBuffer& hash) const;
+        void EnforceMaximumSize();
+
+        std::filesystem::path m_directory;
+        uint64_t m_maxSizeInBytes = 0;
+    };
+}
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 #include "pch.h"
 #include "Microsoft/SQLiteIndexSource.h"
+#include "Microsoft/ManifestCache.h"
 #include "Microsoft/PreIndexedPackageSourceFactory.h"
+#include <winget/ManifestBinarySerializer.h>
 #include <winget/ManifestYamlParser.h>
 
 
@@ -112,6 +114,25 @@ namespace AppInstaller::Repository::Microsoft
 
                 if (Utility::IsUrlRemote(fullPath))
                 {
+                    // The cache only holds manifests whose hash was verified, so a hit needs neither the download nor the check
+                    ManifestCache manifestCache = ManifestCache::FromUserSettings();
+                    if (!expectedHash.empty())
+                    {
+                        auto cachedContents = manifestCache.Find(expectedHash);
+                        if (cachedContents)
+                        {
+                            try
+                            {
+                                return Manifest::BinarySerializer::Deserialize(cachedContents.value());
+                            }
+                            catch (...)
+                            {
+                                LOG_CAUGHT_EXCEPTION_MSG("Failed to read cached manifest, downloading it again: %hs", fullPath.c_str());
+                                manifestCache.Remove(expectedHash);
+                            }
+                        }
+                    }
+
                     std::ostringstream manifestStream;
 
                     AICLI_LOG(Repo, Info, << "Downloading manifest");
@@ -155,7 +176,14 @@ namespace AppInstaller::Repository::Microsoft
                     std::string manifestContents = manifestStream.str();
                     AICLI_LOG(Repo, Verbose, << "Manifest contents: " << manifestContents);
 
-                    return Manifest::YamlParser::Create(manifestContents);
+                    Manifest::Manifest result = Manifest::YamlParser::Create(manifestContents);
+
+                    if (!expectedHash.empty())
+                    {
+                        manifestCache.Add(expectedHash, Manifest::BinarySerializer::Serialize(result));
+                    }
+
+                    return result;
                 }
                 else
                 {
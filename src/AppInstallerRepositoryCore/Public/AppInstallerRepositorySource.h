@@ -87,6 +87,25 @@ namespace AppInstaller::Repository
 
         // Execute a search on the source.
         virtual SearchResult Search(const SearchRequest& request) const = 0;
+
+        // Execute a search for each of the given requests, returning the results in the same order.
+        // Sources may combine the requests into fewer operations.
+        virtual std::vector<SearchResult> SearchMultiple(const std::vector<SearchRequest>& requests) const
+        {
+            std::vector<SearchResult> results;
+            results.reserve(requests.size());
+
+            for (const auto& request : requests)
+            {
+                results.emplace_back(Search(request));
+            }
+
+            return results;
+        }
+
+        // Retrieves the manifests of the given versions from this source ahead of their use, for later calls to GetManifest.
+        // Only sources that make a request for each manifest need to; the others retrieve them locally when asked.
+        virtual void PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>&, IProgressCallback&) const {}
     };
 
     // Interface extension to ISource for locally installed packages.
@@ -147,6 +166,18 @@ namespace AppInstaller::Repository
     // These sources are not under the direct control of the user, such as packages installed on the system.
     std::shared_ptr<ISource> OpenPredefinedSource(PredefinedSource source, IProgressCallback& progress);
 
+    // The identity and version of an entry in ARP.
+    struct ARPEntryVersion
+    {
+        // The product code, which is also the package identifier in the ARP source.
+        std::string ProductCode;
+        std::string Version;
+    };
+
+    // Reads the identity and version of every entry that the ARP predefined source would contain.
+    // This reads only the registry values needed to do so, which is much cheaper than opening the source.
+    std::vector<ARPEntryVersion> GetARPEntryVersions();
+
     // Search behavior for composite sources.
     // Only relevant for composite sources with an installed source, not for aggregates of multiple available sources.
     // Installed and available packages in the result are always correlated when possible.
@@ -186,4 +217,11 @@ namespace AppInstaller::Repository
     // Return value indicates whether the named source was found.
     // Passing an empty string drops all sources.
     bool DropSource(std::string_view name);
+
+    // Retrieves the manifests of the given package versions ahead of their use, so that the requests to remote sources
+    // are made concurrently rather than one at a time as each manifest is needed. Later calls to GetManifest are served
+    // from the retrieved manifests. Versions whose source retrieves manifests locally are ignored.
+    // This returns only once every manifest has been retrieved, or abandoned on cancellation; it saves time by making the
+    // requests together, not by overlapping them with the caller's work.
+    void PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>& versions, IProgressCallback& progress);
 }
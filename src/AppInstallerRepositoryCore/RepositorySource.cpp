@@ -5,6 +5,7 @@
 
 #include "CompositeSource.h"
 #include "SourceFactory.h"
+#include "Microsoft/ARPHelper.h"
 #include "Microsoft/PredefinedInstalledSourceFactory.h"
 #include "Microsoft/PreIndexedPackageSourceFactory.h"
 #include "Rest/RestSourceFactory.h"
@@ -563,6 +564,7 @@ namespace AppInstaller::Repository
 
 #ifndef AICLI_DISABLE_TEST_HOOKS
         static std::map<std::string, std::function<std::unique_ptr<ISourceFactory>()>> s_Sources_TestHook_SourceFactories;
+        static std::function<std::vector<ARPEntryVersion>()> s_Sources_TestHook_ARPEntryVersions;
 #endif
 
         std::unique_ptr<ISourceFactory> GetFactoryForType(std::string_view type)
@@ -1064,6 +1066,18 @@ namespace AppInstaller::Repository
         return CreateSourceFromDetails(details, progress);
     }
 
+    std::vector<ARPEntryVersion> GetARPEntryVersions()
+    {
+#ifndef AICLI_DISABLE_TEST_HOOKS
+        if (s_Sources_TestHook_ARPEntryVersions)
+        {
+            return s_Sources_TestHook_ARPEntryVersions();
+        }
+#endif
+
+        return Microsoft::ARPHelper{}.GetEntryVersions();
+    }
+
     SourceDetails GetPredefinedSourceDetails(PredefinedSource source)
     {
         SourceDetails details;
@@ -1240,6 +1254,45 @@ namespace AppInstaller::Repository
         }
     }
 
+    void PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>& versions, IProgressCallback& progress)
+    {
+        // Each source is given all of its versions at once, so that it can retrieve them together
+        std::vector<std::pair<std::shared_ptr<const ISource>, std::vector<std::shared_ptr<IPackageVersion>>>> sourceVersions;
+
+        for (const auto& version : versions)
+        {
+            if (!version)
+            {
+                continue;
+            }
+
+            auto source = version->GetSource();
+            if (!source)
+            {
+                continue;
+            }
+
+            auto itr = std::find_if(sourceVersions.begin(), sourceVersions.end(), [&](const auto& entry) { return entry.first == source; });
+            if (itr == sourceVersions.end())
+            {
+                sourceVersions.emplace_back(source, std::vector<std::shared_ptr<IPackageVersion>>{});
+                itr = std::prev(sourceVersions.end());
+            }
+
+            itr->second.emplace_back(version);
+        }
+
+        for (const auto& entry : sourceVersions)
+        {
+            if (progress.IsCancelled())
+            {
+                break;
+            }
+
+            entry.first->PrefetchManifests(entry.second, progress);
+        }
+    }
+
     bool SearchRequest::IsForEverything() const
     {
         return (!Query.has_value() && Inclusions.empty() && Filters.empty());
@@ -1307,5 +1360,10 @@ namespace AppInstaller::Repository
     {
         s_Sources_TestHook_SourceFactories.clear();
     }
+
+    void TestHook_SetARPEntryVersionsOverride(std::function<std::vector<ARPEntryVersion>()>&& entryVersions)
+    {
+        s_Sources_TestHook_ARPEntryVersions = std::move(entryVersions);
+    }
 #endif
 }
@@ -3,16 +3,101 @@
 #include "pch.h"
 #include "HttpClientHelper.h"
 
+#include <winhttp.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
 namespace AppInstaller::Repository::Rest
 {
-    HttpClientHelper::HttpClientHelper(std::optional<std::shared_ptr<web::http::http_pipeline_stage>> stage) : m_defaultRequestHandlerStage(stage) {}
+    namespace
+    {
+        // Makes the request conditional on the cached response having changed, if the response has validators.
+        void AddConditionalHeaders(std::unordered_map<utility::string_t, utility::string_t>& headers, const std::optional<HttpResponseCache::Entry>& cached)
+        {
+            if (cached)
+            {
+                if (!cached->ETag.empty())
+                {
+                    headers[web::http::header_names::if_none_match] = cached->ETag;
+                }
+
+                if (!cached->LastModified.empty())
+                {
+                    headers[web::http::header_names::if_modified_since] = cached->LastModified;
+                }
+            }
+        }
+
+        std::optional<web::json::value> ParseJson(const std::optional<std::string>& text)
+        {
+            if (!text)
+            {
+                return {};
+            }
+
+            // An empty body is a null value, as it is from http_response::extract_json
+            if (text->empty())
+            {
+                return web::json::value{};
+            }
+
+            return web::json::value::parse(utility::conversions::to_string_t(text.value()));
+        }
+    }
+
+    // Clients are shared by all copies of a helper so that connections to a server are kept alive between requests.
+    struct HttpClientHelper::ClientPool
+    {
+        struct Entry
+        {
+            web::http::client::http_client Client;
+            std::chrono::steady_clock::time_point LastUsed;
+        };
+
+        ClientPool(PoolOptions options) : Options(options) {}
+
+        PoolOptions Options;
+        std::mutex Lock;
+        std::map<utility::string_t, Entry> Clients;
+        size_t CreationCount = 0;
+        std::atomic<uint64_t> WireBytes = 0;
+        std::atomic<uint64_t> DecodedBytes = 0;
+    };
+
+    HttpClientHelper::PoolOptions HttpClientHelper::PoolOptions::FromUserSettings(std::string_view sourceName)
+    {
+        PoolOptions result;
+        result.MaxConnectionsPerServer = Settings::User().Get<Settings::Setting::NetworkRestMaxConnectionsPerServer>();
+        result.IdleTimeout = Settings::User().Get<Settings::Setting::NetworkRestConnectionIdleTimeoutInSeconds>();
+
+        if (!sourceName.empty())
+        {
+            for (const auto& disabledSource : Settings::User().Get<Settings::Setting::NetworkRestCompressionDisabledSources>())
+            {
+                if (Utility::CaseInsensitiveEquals(disabledSource, sourceName))
+                {
+                    result.RequestCompression = false;
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    HttpClientHelper::HttpClientHelper(std::optional<std::shared_ptr<web::http::http_pipeline_stage>> stage, PoolOptions poolOptions) :
+        m_defaultRequestHandlerStage(stage), m_clientPool(std::make_shared<ClientPool>(poolOptions)) {}
 
     pplx::task<web::http::http_response> HttpClientHelper::Post(
         const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
     {
         AICLI_LOG(Repo, Verbose, << "Sending http POST request to: " << utility::conversions::to_utf8string(uri));
-        web::http::client::http_client client = GetClient(uri);
+        web::uri relativeUri;
+        web::http::client::http_client client = GetClient(uri, relativeUri);
         web::http::http_request request{ web::http::methods::POST };
+        request.set_request_uri(relativeUri);
         request.headers().set_content_type(web::http::details::mime_types::application_json);
         request.set_body(body.serialize());
 
@@ -28,22 +113,55 @@ namespace AppInstaller::Repository::Rest
     std::optional<web::json::value> HttpClientHelper::HandlePost(
         const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
     {
-        web::http::http_response httpResponse;
-        HttpClientHelper::Post(uri, body, headers).then([&httpResponse](const web::http::http_response& response)
+        return HandlePostAsync(uri, body, headers).get();
+    }
+
+    pplx::task<std::optional<web::json::value>> HttpClientHelper::HandlePostAsync(
+        const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
+    {
+        return HandlePostUtf8Async(uri, body, headers).then([](const std::optional<std::string>& text)
             {
-                AICLI_LOG(Repo, Verbose, << "Response status: " << response.status_code());
-                httpResponse = response;
-            }).wait();
+                return ParseJson(text);
+            });
+    }
 
-            return ValidateAndExtractResponse(httpResponse);
+    pplx::task<std::optional<std::string>> HttpClientHelper::HandlePostUtf8Async(
+        const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
+    {
+        std::string cacheKey;
+        std::optional<HttpResponseCache::Entry> cached;
+        std::unordered_map<utility::string_t, utility::string_t> requestHeaders = headers;
+
+        if (m_responseCache && m_responseCache->IsEnabled())
+        {
+            cacheKey = HttpResponseCache::GetKey(web::http::methods::POST, uri, headers, body.serialize());
+            cached = m_responseCache->Find(cacheKey);
+
+            if (cached && cached->IsFresh)
+            {
+                AICLI_LOG(Repo, Verbose, << "Using cached response for http POST request to: " << utility::conversions::to_utf8string(uri));
+                return pplx::task_from_result(std::optional<std::string>{ std::move(cached->Body) });
+            }
+
+            AddConditionalHeaders(requestHeaders, cached);
+        }
+
+        // Capture a copy so that the continuation does not depend on the lifetime of this object
+        return HttpClientHelper::Post(uri, body, requestHeaders).then([helper = *this, cacheKey, cached](const web::http::http_response& response)
+            {
+                AICLI_LOG(Repo, Verbose, << "Response status: " << response.status_code());
+                return helper.ValidateAndExtractUtf8Response(response, cacheKey, cached);
+            });
     }
 
     pplx::task<web::http::http_response> HttpClientHelper::Get(
         const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
     {
         AICLI_LOG(Repo, Verbose, << "Sending http GET request to: " << utility::conversions::to_utf8string(uri));
-        web::http::client::http_client client = GetClient(uri);
+        web::uri relativeUri;
+        web::http::client::http_client client = GetClient(uri, relativeUri);
         web::http::http_request request{ web::http::methods::GET };
+        request.set_request_uri(relativeUri);
         request.headers().set_content_type(web::http::details::mime_types::application_json);
 
         // Add headers
@@ -58,36 +176,127 @@ namespace AppInstaller::Repository::Rest
     std::optional<web::json::value> HttpClientHelper::HandleGet(
         const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
     {
+        return ParseJson(HandleGetUtf8(uri, headers));
+    }
+
+    std::optional<std::string> HttpClientHelper::HandleGetUtf8(
+        const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers) const
+    {
+        std::string cacheKey;
+        std::optional<HttpResponseCache::Entry> cached;
+        std::unordered_map<utility::string_t, utility::string_t> requestHeaders = headers;
+
+        if (m_responseCache && m_responseCache->IsEnabled())
+        {
+            cacheKey = HttpResponseCache::GetKey(web::http::methods::GET, uri, headers);
+            cached = m_responseCache->Find(cacheKey);
+
+            if (cached && cached->IsFresh)
+            {
+                AICLI_LOG(Repo, Verbose, << "Using cached response for http GET request to: " << utility::conversions::to_utf8string(uri));
+                return std::move(cached->Body);
+            }
+
+            AddConditionalHeaders(requestHeaders, cached);
+        }
+
         web::http::http_response httpResponse;
-        Get(uri, headers).then([&httpResponse](const web::http::http_response& response)
+        Get(uri, requestHeaders).then([&httpResponse](const web::http::http_response& response)
             {
                 AICLI_LOG(Repo, Verbose, << "Response status: " << response.status_code());
                 httpResponse = response;
             }).wait();
 
-            return ValidateAndExtractResponse(httpResponse);
+            return ValidateAndExtractUtf8Response(httpResponse, cacheKey, cached);
+    }
+
+    size_t HttpClientHelper::GetClientCreationCount() const
+    {
+        std::lock_guard<std::mutex> lock{ m_clientPool->Lock };
+        return m_clientPool->CreationCount;
+    }
+
+    HttpClientHelper::BytesReceived HttpClientHelper::GetBytesReceived() const
+    {
+        BytesReceived result;
+        result.Wire = m_clientPool->WireBytes;
+        result.Decoded = m_clientPool->DecodedBytes;
+        return result;
     }
 
-    web::http::client::http_client HttpClientHelper::GetClient(const utility::string_t& uri) const
+    web::http::client::http_client HttpClientHelper::GetClient(const utility::string_t& uri, web::uri& relativeUri) const
     {
-        web::http::client::http_client client{ uri };
+        web::uri fullUri{ uri };
+        web::uri authority = fullUri.authority();
+        relativeUri = fullUri.resource();
 
-        // Add default custom handlers if any.
-        if (m_defaultRequestHandlerStage)
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock{ m_clientPool->Lock };
+
+        // Discard idle clients; their connections have likely been dropped by the server anyway
+        for (auto itr = m_clientPool->Clients.begin(); itr != m_clientPool->Clients.end();)
         {
-            client.add_handler(m_defaultRequestHandlerStage.value());
+            if (now - itr->second.LastUsed > m_clientPool->Options.IdleTimeout)
+            {
+                itr = m_clientPool->Clients.erase(itr);
+            }
+            else
+            {
+                ++itr;
+            }
         }
 
-        return client;
+        auto itr = m_clientPool->Clients.find(authority.to_string());
+        if (itr == m_clientPool->Clients.end())
+        {
+            web::http::client::http_client_config config;
+
+            DWORD maxConnections = m_clientPool->Options.MaxConnectionsPerServer;
+            bool requestCompression = m_clientPool->Options.RequestCompression;
+            if (maxConnections || requestCompression)
+            {
+                config.set_nativesessionhandle_options([maxConnections, requestCompression](web::http::client::native_handle handle) mutable
+                    {
+                        if (maxConnections)
+                        {
+                            LOG_LAST_ERROR_IF(!WinHttpSetOption(handle, WINHTTP_OPTION_MAX_CONNS_PER_SERVER, &maxConnections, sizeof(maxConnections)));
+                        }
+
+                        // WinHTTP sends Accept-Encoding and decompresses the body as it is read, so everything above it sees the decoded body.
+                        // This leaves the cpprest compression support, which would need zlib, turned off.
+                        if (requestCompression)
+                        {
+                            DWORD decompression = WINHTTP_DECOMPRESSION_FLAG_ALL;
+                            LOG_LAST_ERROR_IF(!WinHttpSetOption(handle, WINHTTP_OPTION_DECOMPRESSION, &decompression, sizeof(decompression)));
+                        }
+                    });
+            }
+
+            web::http::client::http_client client{ authority, config };
+
+            // Add default custom handlers if any.
+            if (m_defaultRequestHandlerStage)
+            {
+                client.add_handler(m_defaultRequestHandlerStage.value());
+            }
+
+            AICLI_LOG(Repo, Verbose, << "Creating http client for: " << utility::conversions::to_utf8string(authority.to_string()));
+            itr = m_clientPool->Clients.emplace(authority.to_string(), ClientPool::Entry{ std::move(client), now }).first;
+            ++m_clientPool->CreationCount;
+        }
+
+        itr->second.LastUsed = now;
+        return itr->second.Client;
     }
 
-    std::optional<web::json::value> HttpClientHelper::ValidateAndExtractResponse(const web::http::http_response& response) const
+    std::optional<std::string> HttpClientHelper::ValidateAndExtractUtf8Response(const web::http::http_response& response) const
     {
-        std::optional<web::json::value> result;
+        std::optional<std::string> result;
         switch (response.status_code())
         {
         case web::http::status_codes::OK:
-            result = ExtractJsonResponse(response);
+            result = ExtractUtf8Response(response);
             break;
 
         case web::http::status_codes::NotFound:
@@ -107,13 +316,60 @@ namespace AppInstaller::Repository::Rest
         return result;
     }
 
-    std::optional<web::json::value> HttpClientHelper::ExtractJsonResponse(const web::http::http_response& response) const
+    std::optional<std::string> HttpClientHelper::ValidateAndExtractUtf8Response(
+        const web::http::http_response& response, const std::string& cacheKey, const std::optional<HttpResponseCache::Entry>& cached) const
+    {
+        if (cached && response.status_code() == web::http::status_codes::NotModified)
+        {
+            m_responseCache->Refresh(cacheKey, cached.value());
+            return cached->Body;
+        }
+
+        std::optional<std::string> result = ValidateAndExtractUtf8Response(response);
+
+        if (result && !cacheKey.empty() && response.status_code() == web::http::status_codes::OK)
+        {
+            m_responseCache->Store(cacheKey, result.value(), response.headers());
+        }
+
+        return result;
+    }
+
+    std::string HttpClientHelper::ExtractUtf8Response(const web::http::http_response& response) const
     {
         utility::string_t contentType = response.headers().content_type();
 
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_RESTSOURCE_UNSUPPORTED_MIME_TYPE,
             !contentType._Starts_with(web::http::details::mime_types::application_json));
 
-        return response.extract_json().get();
+        // The content type has been checked above, and the body is only ever decoded by the caller
+        std::string result = response.extract_utf8string(true).get();
+
+        // WinHTTP leaves the headers as the server sent them, so the content length is that of the compressed body
+        uint64_t wireBytes = result.size();
+        utility::string_t contentEncoding;
+        if (response.headers().match(web::http::header_names::content_encoding, contentEncoding) &&
+            !Utility::CaseInsensitiveEquals(utility::conversions::to_utf8string(contentEncoding), "identity"))
+        {
+            uint64_t contentLength = 0;
+            if (!response.headers().match(web::http::header_names::content_length, contentLength))
+            {
+                // A chunked response does not say how many bytes it took, and only the decoded body is visible here.
+                // Leave it out of the counts entirely rather than skew the wire count with the decoded size.
+                AICLI_LOG(Repo, Verbose, << "Received an unknown number of bytes of " << utility::conversions::to_utf8string(contentEncoding) <<
+                    " encoded response, decoded to " << result.size() << " bytes");
+                return result;
+            }
+
+            wireBytes = contentLength;
+
+            AICLI_LOG(Repo, Verbose, << "Received " << wireBytes << " bytes of " << utility::conversions::to_utf8string(contentEncoding) <<
+                " encoded response, decoded to " << result.size() << " bytes");
+        }
+
+        m_clientPool->WireBytes += wireBytes;
+        m_clientPool->DecodedBytes += result.size();
+
+        return result;
     }
 }
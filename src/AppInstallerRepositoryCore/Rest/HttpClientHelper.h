@@ -1,9 +1,12 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 #pragma once
+#include "Rest/HttpResponseCache.h"
 #include <cpprest/http_client.h>
 #include <cpprest/json.h>
 
+#include <chrono>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -11,24 +14,80 @@ namespace AppInstaller::Repository::Rest
 {
     struct HttpClientHelper
     {
-        HttpClientHelper(std::optional<std::shared_ptr<web::http::http_pipeline_stage>> = {});
+        // Options for the pool of clients shared between a helper and all of its copies.
+        struct PoolOptions
+        {
+            // The maximum number of simultaneous connections to a single server; 0 leaves the system default.
+            uint32_t MaxConnectionsPerServer = 0;
+
+            // A client that has not been used for this long is discarded, closing its connections.
+            std::chrono::seconds IdleTimeout = std::chrono::seconds(60);
+
+            // Whether responses are requested with compression, to be decompressed as they are received.
+            bool RequestCompression = true;
+
+            // Gets the options as configured in the user settings, for the named source if given.
+            static PoolOptions FromUserSettings(std::string_view sourceName = {});
+        };
+
+        // The number of response body bytes received by a helper and all of its copies.
+        // Encoded responses without a content length are left out of both counts, as their size on the wire is not known.
+        struct BytesReceived
+        {
+            // As sent by the server, which may be compressed.
+            uint64_t Wire = 0;
+
+            // After decompression.
+            uint64_t Decoded = 0;
+        };
+
+        HttpClientHelper(std::optional<std::shared_ptr<web::http::http_pipeline_stage>> = {}, PoolOptions poolOptions = PoolOptions::FromUserSettings());
 
         pplx::task<web::http::http_response> Post(const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t> &headers = {}) const;
 
         std::optional<web::json::value> HandlePost(const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
 
+        // Same as HandlePost, but does not wait for the response.
+        // The returned task remains valid even if this helper is destroyed before it completes.
+        pplx::task<std::optional<web::json::value>> HandlePostAsync(const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
+
+        // Same as HandlePostAsync, but returns the UTF-8 text of the response body rather than parsing it.
+        pplx::task<std::optional<std::string>> HandlePostUtf8Async(const utility::string_t& uri, const web::json::value& body, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
+
         pplx::task<web::http::http_response> Get(const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
 
         std::optional<web::json::value> HandleGet(const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
-    
+
+        // Same as HandleGet, but returns the UTF-8 text of the response body rather than parsing it.
+        std::optional<std::string> HandleGetUtf8(const utility::string_t& uri, const std::unordered_map<utility::string_t, utility::string_t>& headers = {}) const;
+
+        // Sets the cache used by GET and POST requests made through this helper and its copies made afterward.
+        void SetResponseCache(std::shared_ptr<HttpResponseCache> responseCache) { m_responseCache = std::move(responseCache); }
+
+        // Gets the number of clients created by this helper and its copies.
+        // Each client owns its own connections, so this is an upper bound on the connection handshakes performed.
+        size_t GetClientCreationCount() const;
+
+        // Gets the number of response body bytes received by this helper and its copies.
+        BytesReceived GetBytesReceived() const;
+
     protected:
-        std::optional<web::json::value> ValidateAndExtractResponse(const web::http::http_response& response) const;
+        std::optional<std::string> ValidateAndExtractUtf8Response(const web::http::http_response& response) const;
+
+        std::string ExtractUtf8Response(const web::http::http_response& response) const;
 
-        std::optional<web::json::value> ExtractJsonResponse(const web::http::http_response& response) const;
+        // Handles the response to a request that may have been made conditional on a cached response.
+        std::optional<std::string> ValidateAndExtractUtf8Response(
+            const web::http::http_response& response, const std::string& cacheKey, const std::optional<HttpResponseCache::Entry>& cached) const;
 
     private:
-        web::http::client::http_client GetClient(const utility::string_t& uri) const;
+        struct ClientPool;
+
+        // Gets a client for the scheme, host and port of the uri, along with the request uri relative to that client.
+        web::http::client::http_client GetClient(const utility::string_t& uri, web::uri& relativeUri) const;
 
         std::optional<std::shared_ptr<web::http::http_pipeline_stage>> m_defaultRequestHandlerStage;
+        std::shared_ptr<ClientPool> m_clientPool;
+        std::shared_ptr<HttpResponseCache> m_responseCache;
     };
 }
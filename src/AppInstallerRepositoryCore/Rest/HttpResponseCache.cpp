@@ -0,0 +1,322 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "HttpResponseCache.h"
+
+#include <vector>
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Repository::Rest
+{
+    namespace
+    {
+        constexpr std::string_view s_CacheDirectoryName = "RestCache"sv;
+        constexpr std::string_view s_EntryExtension = ".response"sv;
+
+        // An entry file is a single line of JSON with these fields, followed by the response body exactly as it was received.
+        constexpr utility::char_t s_ETagField[] = U("ETag");
+        constexpr utility::char_t s_LastModifiedField[] = U("LastModified");
+        constexpr utility::char_t s_StoredTimeField[] = U("StoredTime");
+
+        utility::string_t GetStringField(const web::json::value& value, const utility::char_t* field)
+        {
+            if (value.has_string_field(field))
+            {
+                return value.at(field).as_string();
+            }
+
+            return {};
+        }
+    }
+
+    HttpResponseCache::Options HttpResponseCache::Options::FromUserSettings(std::string_view sourceName)
+    {
+        Options result;
+        result.MaxSizeInBytes = static_cast<uint64_t>(Settings::User().Get<Settings::Setting::NetworkRestCacheMaxSizeInMB>()) << 20;
+        result.TimeToLive = Settings::User().Get<Settings::Setting::NetworkRestCacheTimeToLiveInSeconds>();
+
+        // Source names are case insensitive, so the settings are matched to them the same way
+        for (const auto& sourceTimeToLive : Settings::User().Get<Settings::Setting::NetworkRestCacheSourceTimeToLiveInSeconds>())
+        {
+            if (Utility::CaseInsensitiveEquals(sourceTimeToLive.first, sourceName))
+            {
+                result.TimeToLive = sourceTimeToLive.second;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    HttpResponseCache::HttpResponseCache(std::filesystem::path directory, Options options, std::string sourceName) :
+        m_directory(std::move(directory)), m_options(options), m_sourceName(std::move(sourceName)) {}
+
+    HttpResponseCache::~HttpResponseCache()
+    {
+        Statistics statistics = GetStatistics();
+        if (statistics.Hits || statistics.Revalidations || statistics.Misses)
+        {
+            Logging::Telemetry().LogRestResponseCacheSummary(m_sourceName, statistics.Hits, statistics.Revalidations, statistics.Misses, statistics.Evictions);
+        }
+    }
+
+    std::filesystem::path HttpResponseCache::GetDefaultDirectory()
+    {
+        return Runtime::GetPathTo(Runtime::PathName::LocalState) / s_CacheDirectoryName;
+    }
+
+    std::string HttpResponseCache::GetKey(
+        const web::http::method& method,
+        const utility::string_t& uri,
+        const std::unordered_map<utility::string_t, utility::string_t>& headers,
+        const utility::string_t& body)
+    {
+        // Headers are sorted so that the key does not depend on the iteration order of the map
+        std::vector<std::pair<utility::string_t, utility::string_t>> sortedHeaders{ headers.begin(), headers.end() };
+        std::sort(sortedHeaders.begin(), sortedHeaders.end());
+
+        std::ostringstream stream;
+        stream << utility::conversions::to_utf8string(method) << '\n' << utility::conversions::to_utf8string(uri) << '\n';
+
+        for (const auto& header : sortedHeaders)
+        {
+            stream << utility::conversions::to_utf8string(header.first) << ':' << utility::conversions::to_utf8string(header.second) << '\n';
+        }
+
+        stream << '\n' << utility::conversions::to_utf8string(body);
+
+        std::string keyData = stream.str();
+        auto hash = Utility::SHA256::ComputeHash(reinterpret_cast<const uint8_t*>(keyData.c_str()), static_cast<uint32_t>(keyData.size()));
+        return Utility::SHA256::ConvertToString(hash);
+    }
+
+    std::optional<HttpResponseCache::Entry> HttpResponseCache::Find(const std::string& key)
+    {
+        if (!IsEnabled())
+        {
+            return {};
+        }
+
+        try
+        {
+            std::filesystem::path entryPath = GetEntryPath(key);
+
+            std::string contents;
+            {
+                std::lock_guard<std::mutex> lock{ m_lock };
+
+                std::ifstream stream{ entryPath, std::ios_base::in | std::ios_base::binary };
+                if (!stream)
+                {
+                    ++m_misses;
+                    return {};
+                }
+
+                std::ostringstream buffer;
+                buffer << stream.rdbuf();
+                contents = buffer.str();
+                stream.close();
+
+                // Mark the entry as recently used so that it is the last to be evicted
+                std::error_code error;
+                std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+            }
+
+            size_t headerEnd = contents.find('\n');
+            THROW_HR_IF(E_UNEXPECTED, headerEnd == std::string::npos);
+
+            web::json::value value = web::json::value::parse(utility::conversions::to_string_t(contents.substr(0, headerEnd)));
+
+            Entry result;
+            result.Body = contents.substr(headerEnd + 1);
+            result.ETag = GetStringField(value, s_ETagField);
+            result.LastModified = GetStringField(value, s_LastModifiedField);
+
+            auto storedTime = Utility::ConvertUnixEpochToSystemClock(value.at(s_StoredTimeField).as_number().to_int64());
+            result.IsFresh = std::chrono::system_clock::now() - storedTime < m_options.TimeToLive;
+
+            if (result.IsFresh)
+            {
+                ++m_hits;
+            }
+            else
+            {
+                ++m_misses;
+            }
+
+            return result;
+        }
+        CATCH_LOG();
+
+        ++m_misses;
+        return {};
+    }
+
+    void HttpResponseCache::Store(const std::string& key, const std::string& body, const utility::string_t& etag, const utility::string_t& lastModified)
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        // Without a validator the response can only ever be used while it is fresh
+        if (etag.empty() && lastModified.empty() && m_options.TimeToLive.count() == 0)
+        {
+            return;
+        }
+
+        try
+        {
+            Write(key, body, etag, lastModified);
+            EnforceMaximumSize();
+        }
+        CATCH_LOG();
+    }
+
+    void HttpResponseCache::Store(const std::string& key, const std::string& body, const web::http::http_headers& headers)
+    {
+        utility::string_t etag;
+        utility::string_t lastModified;
+        headers.match(web::http::header_names::etag, etag);
+        headers.match(web::http::header_names::last_modified, lastModified);
+
+        Store(key, body, etag, lastModified);
+    }
+
+    void HttpResponseCache::Refresh(const std::string& key, const Entry& entry)
+    {
+        ++m_revalidations;
+
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        try
+        {
+            Write(key, entry.Body, entry.ETag, entry.LastModified);
+        }
+        CATCH_LOG();
+    }
+
+    HttpResponseCache::Statistics HttpResponseCache::GetStatistics() const
+    {
+        Statistics result;
+        result.Hits = m_hits;
+        result.Revalidations = m_revalidations;
+        result.Misses = m_misses;
+        result.Evictions = m_evictions;
+        return result;
+    }
+
+    std::filesystem::path HttpResponseCache::GetEntryPath(const std::string& key) const
+    {
+        std::filesystem::path result = m_directory / key;
+        result += s_EntryExtension;
+        return result;
+    }
+
+    void HttpResponseCache::Write(const std::string& key, const std::string& body, const utility::string_t& etag, const utility::string_t& lastModified)
+    {
+        web::json::value value = web::json::value::object();
+        value[s_ETagField] = web::json::value::string(etag);
+        value[s_LastModifiedField] = web::json::value::string(lastModified);
+        value[s_StoredTimeField] = web::json::value::number(Utility::GetCurrentUnixEpoch());
+
+        // The serialized header never contains a raw newline, so the first one separates it from the body
+        std::string contents = utility::conversions::to_utf8string(value.serialize());
+        contents += '\n';
+        contents += body;
+
+        std::lock_guard<std::mutex> lock{ m_lock };
+
+        std::filesystem::create_directories(m_directory);
+
+        std::filesystem::path entryPath = GetEntryPath(key);
+        std::filesystem::path tempPath = entryPath;
+        tempPath += "." + std::to_string(GetCurrentProcessId()) + "." + std::to_string(GetCurrentThreadId()) + ".tmp";
+
+        {
+            std::ofstream stream{ tempPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+            THROW_LAST_ERROR_IF(!stream);
+            stream.write(contents.c_str(), contents.size());
+            stream.flush();
+            THROW_LAST_ERROR_IF(!stream);
+        }
+
+        std::error_code error;
+        uint64_t previousSize = std::filesystem::file_size(entryPath, error);
+        if (error)
+        {
+            previousSize = 0;
+        }
+
+        // Replace the entry in a single step so that other processes never observe a partially written entry
+        std::filesystem::rename(tempPath, entryPath);
+
+        if (m_totalSize)
+        {
+            uint64_t totalSize = *m_totalSize + contents.size();
+            m_totalSize = totalSize > previousSize ? totalSize - previousSize : 0;
+        }
+    }
+
+    void HttpResponseCache::EnforceMaximumSize()
+    {
+        struct FileInfo
+        {
+            std::filesystem::path Path;
+            std::filesystem::file_time_type LastUsed;
+            uint64_t Size;
+        };
+
+        std::lock_guard<std::mutex> lock{ m_lock };
+
+        // The running total is seeded from the directory once and then kept up to date by Write and the evictions below,
+        // so the directory is only walked again when the total says the cache has grown too large.
+        if (m_totalSize && *m_totalSize <= m_options.MaxSizeInBytes)
+        {
+            return;
+        }
+
+        std::vector<FileInfo> files;
+        uint64_t totalSize = 0;
+
+        for (const auto& file : std::filesystem::directory_iterator{ m_directory })
+        {
+            if (file.is_regular_file() && file.path().extension() == s_EntryExtension)
+            {
+                files.emplace_back(FileInfo{ file.path(), file.last_write_time(), file.file_size() });
+                totalSize += files.back().Size;
+            }
+        }
+
+        // Other processes share the directory, so the walk also corrects any drift in the running total
+        m_totalSize = totalSize;
+
+        if (totalSize <= m_options.MaxSizeInBytes)
+        {
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.LastUsed < b.LastUsed; });
+
+        for (const auto& file : files)
+        {
+            if (totalSize <= m_options.MaxSizeInBytes)
+            {
+                break;
+            }
+
+            std::error_code error;
+            if (std::filesystem::remove(file.Path, error))
+            {
+                totalSize -= file.Size;
+                ++m_evictions;
+            }
+        }
+
+        m_totalSize = totalSize;
+    }
+}
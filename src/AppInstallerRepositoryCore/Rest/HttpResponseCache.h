@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <cpprest/http_msg.h>
+#include <cpprest/json.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace AppInstaller::Repository::Rest
+{
+    // An on-disk cache of the JSON responses from REST sources.
+    // Each response is stored with the ETag and Last-Modified values returned by the server, so that once it
+    // is no longer fresh it can be revalidated with a conditional request rather than downloaded again.
+    // Failures to read or write the cache are logged and otherwise ignored; the cache is only an optimization.
+    struct HttpResponseCache
+    {
+        // Options that control the behavior of the cache.
+        struct Options
+        {
+            // A cached response is used without contacting the server for this long after it was stored or revalidated.
+            std::chrono::seconds TimeToLive = std::chrono::seconds(0);
+
+            // The maximum total size of the cached responses; 0 disables the cache.
+            uint64_t MaxSizeInBytes = 0;
+
+            // Gets the options as configured in the user settings for the given source.
+            static Options FromUserSettings(std::string_view sourceName);
+        };
+
+        // A cached response.
+        struct Entry
+        {
+            // The UTF-8 JSON text of the response body.
+            std::string Body;
+            utility::string_t ETag;
+            utility::string_t LastModified;
+
+            // Whether the entry can be used without revalidating it with the server.
+            bool IsFresh = false;
+        };
+
+        // Counts of the cache operations performed, reported to telemetry when the cache is destroyed.
+        struct Statistics
+        {
+            // Lookups that found a fresh response.
+            size_t Hits = 0;
+            // Stale responses that the server reported as not modified.
+            size_t Revalidations = 0;
+            // Lookups that found no response, or only a stale one.
+            size_t Misses = 0;
+            // Responses removed to keep the cache within its maximum size.
+            size_t Evictions = 0;
+        };
+
+        HttpResponseCache(std::filesystem::path directory, Options options, std::string sourceName = {});
+
+        HttpResponseCache(const HttpResponseCache&) = delete;
+        HttpResponseCache& operator=(const HttpResponseCache&) = delete;
+
+        HttpResponseCache(HttpResponseCache&&) = delete;
+        HttpResponseCache& operator=(HttpResponseCache&&) = delete;
+
+        ~HttpResponseCache();
+
+        // Gets the directory shared by the caches of all REST sources.
+        static std::filesystem::path GetDefaultDirectory();
+
+        // Determines whether the cache stores anything at all.
+        bool IsEnabled() const { return m_options.MaxSizeInBytes != 0; }
+
+        // Gets the key identifying a request; the body should be the same serialized value sent to the server.
+        static std::string GetKey(
+            const web::http::method& method,
+            const utility::string_t& uri,
+            const std::unordered_map<utility::string_t, utility::string_t>& headers,
+            const utility::string_t& body = {});
+
+        // Gets the cached response for the key, if any.
+        std::optional<Entry> Find(const std::string& key);
+
+        // Stores a response, evicting the least recently used responses if the cache grows too large.
+        void Store(const std::string& key, const std::string& body, const utility::string_t& etag, const utility::string_t& lastModified);
+
+        // Stores a response; the validators are taken from the headers of the response.
+        void Store(const std::string& key, const std::string& body, const web::http::http_headers& headers);
+
+        // Marks a cached response as fresh again after the server reported it has not been modified.
+        void Refresh(const std::string& key, const Entry& entry);
+
+        Statistics GetStatistics() const;
+
+    private:
+        std::filesystem::path GetEntryPath(const std::string& key) const;
+        void Write(const std::string& key, const std::string& body, const utility::string_t& etag, const utility::string_t& lastModified);
+        void EnforceMaximumSize();
+
+        std::filesystem::path m_directory;
+        Options m_options;
+        std::string m_sourceName;
+        std::mutex m_lock;
+
+        // The total size of the entries in the directory, once it has been read; guarded by m_lock.
+        std::optional<uint64_t> m_totalSize;
+
+        std::atomic<size_t> m_hits = 0;
+        std::atomic<size_t> m_revalidations = 0;
+        std::atomic<size_t> m_misses = 0;
+        std::atomic<size_t> m_evictions = 0;
+    };
+}
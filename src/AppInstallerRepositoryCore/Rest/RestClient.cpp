@@ -10,6 +10,11 @@
 #include "Rest/Schema/CommonRestConstants.h"
 #include "Rest/Schema/RestHelper.h"
 
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
 using namespace AppInstaller::Repository::Rest::Schema;
 using namespace AppInstaller::Repository::Rest::Schema::V1_0;
 using namespace AppInstaller::Repository::Rest::Schema::V1_0::Json;
@@ -20,21 +25,151 @@ namespace AppInstaller::Repository::Rest
     // Supported versions
     std::set<Version> WingetSupportedContracts = { Version_1_0_0 };
 
+    // The number of concurrent manifest requests when the connections to a server are left to the system default.
+    constexpr size_t s_DefaultPrefetchRequestCount = 4;
+
+    // The manifests requested through PrefetchManifests, whether or not they have been retrieved yet.
+    struct RestClient::PrefetchedManifests
+    {
+        std::mutex Lock;
+        std::map<ManifestKey, std::shared_future<std::optional<Manifest::Manifest>>> Manifests;
+    };
+
+    bool RestClient::ManifestKey::operator<(const ManifestKey& other) const
+    {
+        return std::tie(PackageId, Version, Channel) < std::tie(other.PackageId, other.Version, other.Channel);
+    }
+
     RestClient::RestClient(std::unique_ptr<Schema::IRestClient> supportedInterface, std::string sourceIdentifier)
-        : m_interface(std::move(supportedInterface)), m_sourceIdentifier(std::move(sourceIdentifier))
+        : m_interface(std::move(supportedInterface)), m_sourceIdentifier(std::move(sourceIdentifier)), m_prefetchedManifests(std::make_shared<PrefetchedManifests>())
     {
     }
 
     std::optional<Manifest::Manifest> RestClient::GetManifestByVersion(const std::string& packageId, const std::string& version, const std::string& channel) const
     {
+        std::shared_future<std::optional<Manifest::Manifest>> prefetched;
+
+        {
+            std::lock_guard<std::mutex> lock{ m_prefetchedManifests->Lock };
+            auto itr = m_prefetchedManifests->Manifests.find(ManifestKey{ packageId, version, channel });
+            if (itr != m_prefetchedManifests->Manifests.end())
+            {
+                prefetched = itr->second;
+            }
+        }
+
+        if (prefetched.valid())
+        {
+            try
+            {
+                return prefetched.get();
+            }
+            catch (...)
+            {
+                // The prefetch was abandoned; make the request here so that any error is reported as usual
+                LOG_CAUGHT_EXCEPTION();
+            }
+        }
+
         return m_interface->GetManifestByVersion(packageId, version, channel);
     }
 
+    void RestClient::PrefetchManifests(const std::vector<ManifestKey>& manifests, IProgressCallback& progress) const
+    {
+        using promise_t = std::promise<std::optional<Manifest::Manifest>>;
+        std::vector<std::pair<ManifestKey, promise_t>> pending;
+
+        {
+            std::lock_guard<std::mutex> lock{ m_prefetchedManifests->Lock };
+
+            for (const auto& key : manifests)
+            {
+                if (m_prefetchedManifests->Manifests.find(key) == m_prefetchedManifests->Manifests.end())
+                {
+                    promise_t promise;
+                    m_prefetchedManifests->Manifests.emplace(key, promise.get_future().share());
+                    pending.emplace_back(key, std::move(promise));
+                }
+            }
+        }
+
+        if (pending.empty())
+        {
+            return;
+        }
+
+        AICLI_LOG(Repo, Verbose, << "Prefetching " << pending.size() << " manifests");
+
+        std::atomic_bool cancelled = progress.IsCancelled();
+        auto removeCancel = progress.SetCancellationFunction([&]() { cancelled = true; });
+
+        // Forgets a manifest that was not retrieved, so that GetManifestByVersion requests it itself
+        auto abandon = [&](const ManifestKey& key, promise_t& promise, std::exception_ptr exception)
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_prefetchedManifests->Lock };
+                m_prefetchedManifests->Manifests.erase(key);
+            }
+
+            promise.set_exception(exception);
+        };
+
+        std::atomic<size_t> next = 0;
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < pending.size(); i = next++)
+            {
+                auto& [key, promise] = pending[i];
+
+                if (cancelled)
+                {
+                    abandon(key, promise, std::make_exception_ptr(wil::ResultException(E_ABORT)));
+                    continue;
+                }
+
+                try
+                {
+                    promise.set_value(m_interface->GetManifestByVersion(key.PackageId, key.Version, key.Channel));
+                }
+                catch (...)
+                {
+                    LOG_CAUGHT_EXCEPTION_MSG("Failed to prefetch manifest for package: %hs", key.PackageId.c_str());
+                    abandon(key, promise, std::current_exception());
+                }
+            }
+        };
+
+        // There is no benefit in more requests than the connections allowed to the server
+        uint32_t maxConnections = HttpClientHelper::PoolOptions::FromUserSettings().MaxConnectionsPerServer;
+        size_t threadCount = std::min<size_t>(pending.size(), maxConnections ? maxConnections : s_DefaultPrefetchRequestCount);
+
+        std::vector<std::thread> threads;
+        auto joinThreads = wil::scope_exit([&]()
+            {
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            });
+
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+    }
+
     RestClient::SearchResult RestClient::Search(const SearchRequest& request) const
     {
         return m_interface->Search(request);
     }
 
+    std::vector<RestClient::SearchResult> RestClient::SearchMultiple(const std::vector<SearchRequest>& requests) const
+    {
+        return m_interface->SearchMultiple(requests);
+    }
+
     std::string RestClient::GetSourceIdentifier() const
     {
         return m_sourceIdentifier;
@@ -80,11 +215,11 @@ namespace AppInstaller::Repository::Rest
         return *commonVersions.rbegin();
     }
 
-    std::unique_ptr<Schema::IRestClient> RestClient::GetSupportedInterface(const std::string& api, const Version& version)
+    std::unique_ptr<Schema::IRestClient> RestClient::GetSupportedInterface(const std::string& api, const Version& version, const HttpClientHelper& helper)
     {
         if (version == Version_1_0_0)
         {
-            return std::make_unique<Schema::V1_0::Interface>(api);
+            return std::make_unique<Schema::V1_0::Interface>(api, helper);
         }
        
         THROW_HR(APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_VERSION);
@@ -99,7 +234,8 @@ namespace AppInstaller::Repository::Rest
         std::optional<Version> latestCommonVersion = GetLatestCommonVersion(information, WingetSupportedContracts);
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_UNSUPPORTED_RESTSOURCE, !latestCommonVersion);
 
-        std::unique_ptr<Schema::IRestClient> supportedInterface = GetSupportedInterface(utility::conversions::to_utf8string(restEndpoint), latestCommonVersion.value());
+        // The interface shares the helper's client pool, so the connection opened for the information request is reused
+        std::unique_ptr<Schema::IRestClient> supportedInterface = GetSupportedInterface(utility::conversions::to_utf8string(restEndpoint), latestCommonVersion.value(), helper);
         return RestClient{ std::move(supportedInterface), information.SourceIdentifier };
     }
 }
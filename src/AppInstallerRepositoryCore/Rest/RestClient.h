@@ -6,6 +6,10 @@
 #include "Rest/Schema/IRestClient.h"
 #include "Rest/HttpClientHelper.h"
 #include "cpprest/json.h"
+#include <AppInstallerProgress.h>
+
+#include <memory>
+#include <vector>
 
 namespace AppInstaller::Repository::Rest
 {
@@ -16,6 +20,16 @@ namespace AppInstaller::Repository::Rest
         // The return type of Search
         using SearchResult = Rest::Schema::IRestClient::SearchResult;
 
+        // Identifies a manifest to retrieve.
+        struct ManifestKey
+        {
+            std::string PackageId;
+            std::string Version;
+            std::string Channel;
+
+            bool operator<(const ManifestKey& other) const;
+        };
+
         RestClient(const RestClient&) = delete;
         RestClient& operator=(const RestClient&) = delete;
 
@@ -25,8 +39,17 @@ namespace AppInstaller::Repository::Rest
         // Performs a search based on the given criteria.
         Schema::IRestClient::SearchResult Search(const SearchRequest& request) const;
 
+        // Performs a search for each of the given requests, returning the results in the same order.
+        std::vector<Schema::IRestClient::SearchResult> SearchMultiple(const std::vector<SearchRequest>& requests) const;
+
+        // Gets a manifest; one that has been prefetched is returned without another request.
         std::optional<Manifest::Manifest> GetManifestByVersion(const std::string& packageId, const std::string& version, const std::string& channel) const;
 
+        // Retrieves the given manifests with a bounded number of concurrent requests, keeping them for later calls to GetManifestByVersion.
+        // Manifests that have already been requested are not requested again.
+        // Once progress is cancelled no further requests are started, and the manifests not yet retrieved are left to GetManifestByVersion.
+        void PrefetchManifests(const std::vector<ManifestKey>& manifests, IProgressCallback& progress) const;
+
         std::string GetSourceIdentifier() const;
 
         static std::optional<AppInstaller::Utility::Version> GetLatestCommonVersion(const AppInstaller::Repository::Rest::Schema::IRestClient::Information& information, const std::set<AppInstaller::Utility::Version>& wingetSupportedVersions);
@@ -35,12 +58,15 @@ namespace AppInstaller::Repository::Rest
 
         static Schema::IRestClient::Information GetInformation(const utility::string_t& restApi, const HttpClientHelper& httpClientHelper);
 
-        static std::unique_ptr<Schema::IRestClient> GetSupportedInterface(const std::string& restApi, const AppInstaller::Utility::Version& version);
+        static std::unique_ptr<Schema::IRestClient> GetSupportedInterface(const std::string& restApi, const AppInstaller::Utility::Version& version, const HttpClientHelper& helper = {});
 
         static RestClient Create(const std::string& restApi, const HttpClientHelper& helper = {});
 
     private:
+        struct PrefetchedManifests;
+
         std::unique_ptr<Schema::IRestClient> m_interface;
         std::string m_sourceIdentifier;
+        std::shared_ptr<PrefetchedManifests> m_prefetchedManifests;
     };
 }
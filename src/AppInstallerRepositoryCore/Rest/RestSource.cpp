@@ -119,8 +119,8 @@ namespace AppInstaller::Repository::Rest
                     return m_versionInfo.Manifest.value();
                 }
 
-                std::optional<Manifest::Manifest> manifest = GetReferenceSource()->GetRestClient().GetManifestByVersion(
-                    m_packageInfo.PackageIdentifier, m_versionInfo.VersionAndChannel.GetVersion().ToString(), m_versionInfo.VersionAndChannel.GetChannel().ToString());
+                RestClient::ManifestKey key = GetManifestKey();
+                std::optional<Manifest::Manifest> manifest = GetReferenceSource()->GetRestClient().GetManifestByVersion(key.PackageId, key.Version, key.Channel);
 
                 if (!manifest)
                 {
@@ -143,6 +143,17 @@ namespace AppInstaller::Repository::Rest
                 return result;
             }
 
+            // Determines whether GetManifest needs to request the manifest from the source.
+            bool IsManifestRequestNeeded() const
+            {
+                return !m_versionInfo.Manifest.has_value();
+            }
+
+            RestClient::ManifestKey GetManifestKey() const
+            {
+                return { m_packageInfo.PackageIdentifier, m_versionInfo.VersionAndChannel.GetVersion().ToString(), m_versionInfo.VersionAndChannel.GetChannel().ToString() };
+            }
+
         private:
             template<AppInstaller::Manifest::Localization Field>
             void BuildPackageVersionMultiPropertyWithFallback(std::vector<Utility::LocIndString>& result) const
@@ -334,7 +345,22 @@ namespace AppInstaller::Repository::Rest
 
     SearchResult RestSource::Search(const SearchRequest& request) const
     {
-        RestClient::SearchResult results = m_restClient.Search(request);
+        return ConvertSearchResult(m_restClient.Search(request));
+    }
+
+    std::vector<SearchResult> RestSource::SearchMultiple(const std::vector<SearchRequest>& requests) const
+    {
+        std::vector<SearchResult> result;
+        for (auto& restResult : m_restClient.SearchMultiple(requests))
+        {
+            result.emplace_back(ConvertSearchResult(std::move(restResult)));
+        }
+
+        return result;
+    }
+
+    SearchResult RestSource::ConvertSearchResult(RestClient::SearchResult&& results) const
+    {
         SearchResult searchResult;
 
         std::shared_ptr<const RestSource> sharedThis = shared_from_this();
@@ -355,4 +381,20 @@ namespace AppInstaller::Repository::Rest
     {
         return (other && GetIdentifier() == other->GetIdentifier());
     }
+
+    void RestSource::PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>& versions, IProgressCallback& progress) const
+    {
+        std::vector<RestClient::ManifestKey> manifests;
+
+        for (const auto& version : versions)
+        {
+            const PackageVersion* restVersion = dynamic_cast<const PackageVersion*>(version.get());
+            if (restVersion && restVersion->IsManifestRequestNeeded())
+            {
+                manifests.emplace_back(restVersion->GetManifestKey());
+            }
+        }
+
+        m_restClient.PrefetchManifests(manifests, progress);
+    }
 }
@@ -33,10 +33,20 @@ namespace AppInstaller::Repository::Rest
         // Execute a search on the source.
         SearchResult Search(const SearchRequest& request) const override;
 
+        // Executes a search for each of the given requests, returning the results in the same order.
+        // Requests may be combined into fewer calls to the server.
+        std::vector<SearchResult> SearchMultiple(const std::vector<SearchRequest>& requests) const override;
+
         // Determines if the other source refers to the same as this.
         bool IsSame(const RestSource* other) const;
 
+        // Retrieves the manifests of the given versions from this source that are not already known.
+        void PrefetchManifests(const std::vector<std::shared_ptr<IPackageVersion>>& versions, IProgressCallback& progress) const override;
+
     private:
+        // Wraps the packages of a rest client search result for this source.
+        SearchResult ConvertSearchResult(RestClient::SearchResult&& results) const;
+
         SourceDetails m_details;
         RestClient m_restClient;
     };
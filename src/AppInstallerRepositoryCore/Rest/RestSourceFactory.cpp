@@ -19,7 +19,11 @@ namespace AppInstaller::Repository::Rest
             {
                 THROW_HR_IF(E_INVALIDARG, !Utility::CaseInsensitiveEquals(details.Type, RestSourceFactory::Type()));
 
-                RestClient restClient = RestClient::Create(details.Arg);
+                HttpClientHelper helper{ {}, HttpClientHelper::PoolOptions::FromUserSettings(details.Name) };
+                helper.SetResponseCache(std::make_shared<HttpResponseCache>(
+                    HttpResponseCache::GetDefaultDirectory(), HttpResponseCache::Options::FromUserSettings(details.Name), details.Name));
+
+                RestClient restClient = RestClient::Create(details.Arg, helper);
 
                 return std::make_shared<RestSource>(details, restClient.GetSourceIdentifier(), std::move(restClient));
             }
@@ -13,6 +13,8 @@
 #include "Rest/Schema/1_0/Json/SearchResponseDeserializer.h"
 #include "Rest/Schema/1_0/Json/SearchRequestSerializer.h"
 
+#include <limits>
+
 using namespace std::string_view_literals;
 using namespace AppInstaller::Repository::Rest::Schema::V1_0::Json;
 
@@ -50,9 +52,65 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0
             // Create the endpoint with query parameters
             return RestHelper::AppendQueryParamsToUri(packageIdPath, queryParameters);
         }
+
+        // Returns true for exact lookups of the values that identify an installed package.
+        bool IsCorrelationInclusion(const PackageMatchFilter& inclusion)
+        {
+            return inclusion.Type == MatchType::Exact &&
+                (inclusion.Field == PackageMatchField::ProductCode || inclusion.Field == PackageMatchField::PackageFamilyName);
+        }
+
+        // Gets the part of the request that can be combined with other requests, if any.
+        std::optional<SearchRequest> GetCorrelationRequest(const SearchRequest& request)
+        {
+            if (request.Query || !request.Filters.empty() || request.MaximumResults)
+            {
+                return {};
+            }
+
+            SearchRequest result;
+            for (const auto& inclusion : request.Inclusions)
+            {
+                if (IsCorrelationInclusion(inclusion))
+                {
+                    result.Inclusions.emplace_back(inclusion);
+                }
+            }
+
+            if (result.Inclusions.empty())
+            {
+                return {};
+            }
+
+            return result;
+        }
+
+        bool ContainsValue(const std::vector<std::string>& values, std::string_view value)
+        {
+            return std::any_of(values.begin(), values.end(), [&](const std::string& v) { return Utility::CaseInsensitiveEquals(v, value); });
+        }
+
+        // Determines whether a version of the package has a value that one of the inclusions looks for.
+        bool PackageMatchesInclusions(const IRestClient::Package& package, const std::vector<PackageMatchFilter>& inclusions)
+        {
+            for (const auto& version : package.Versions)
+            {
+                for (const auto& inclusion : inclusions)
+                {
+                    if ((inclusion.Field == PackageMatchField::PackageFamilyName && ContainsValue(version.PackageFamilyNames, inclusion.Value)) ||
+                        (inclusion.Field == PackageMatchField::ProductCode && ContainsValue(version.ProductCodes, inclusion.Value)))
+                    {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
     }
 
-    Interface::Interface(const std::string& restApi, const HttpClientHelper& httpClientHelper) : m_restApiUri(restApi), m_httpClientHelper(httpClientHelper)
+    Interface::Interface(const std::string& restApi, const HttpClientHelper& httpClientHelper) : m_restApiUri(restApi), m_httpClientHelper(httpClientHelper),
+        m_multipleInclusionSupport(std::make_shared<std::atomic<MultipleInclusionSupport>>(MultipleInclusionSupport::Unknown))
     {
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_URL, !RestHelper::IsValidUri(JsonHelper::GetUtilityString(restApi)));
 
@@ -76,37 +134,221 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0
         return SearchInternal(request);
     }
 
+    std::vector<IRestClient::SearchResult> Interface::SearchMultiple(const std::vector<SearchRequest>& requests) const
+    {
+        std::vector<SearchResult> results(requests.size());
+
+        // The product code and package family name lookups of each request, which are combined with those of other requests
+        std::vector<SearchRequest> correlationRequests(requests.size());
+        std::vector<size_t> combinable;
+
+        // Whether the result of a request came from searching for the whole request
+        std::vector<bool> searchedAsIs(requests.size());
+
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            std::optional<SearchRequest> correlationRequest = GetCorrelationRequest(requests[i]);
+            if (correlationRequest)
+            {
+                correlationRequests[i] = std::move(correlationRequest.value());
+                combinable.emplace_back(i);
+            }
+            else
+            {
+                results[i] = Search(requests[i]);
+                searchedAsIs[i] = true;
+            }
+        }
+
+        std::vector<size_t> chunk;
+        size_t chunkInclusions = 0;
+
+        auto searchChunk = [&]()
+        {
+            if (!SearchCombined(correlationRequests, chunk, results))
+            {
+                for (size_t index : chunk)
+                {
+                    results[index] = Search(requests[index]);
+                    searchedAsIs[index] = true;
+                }
+            }
+
+            chunk.clear();
+            chunkInclusions = 0;
+        };
+
+        for (size_t index : combinable)
+        {
+            size_t inclusions = correlationRequests[index].Inclusions.size();
+            if (!chunk.empty() && chunkInclusions + inclusions > MaximumInclusionsPerSearch)
+            {
+                searchChunk();
+            }
+
+            chunk.emplace_back(index);
+            chunkInclusions += inclusions;
+        }
+
+        if (!chunk.empty())
+        {
+            searchChunk();
+        }
+
+        // A package found by its product code or family name is the correlation; when none is found, the request is searched
+        // as a whole so that its other inclusions are still used.
+        for (size_t index : combinable)
+        {
+            if (!searchedAsIs[index] && results[index].Matches.empty() &&
+                correlationRequests[index].Inclusions.size() != requests[index].Inclusions.size())
+            {
+                results[index] = Search(requests[index]);
+            }
+        }
+
+        return results;
+    }
+
+    bool Interface::SearchCombined(const std::vector<SearchRequest>& requests, const std::vector<size_t>& chunk, std::vector<IRestClient::SearchResult>& results) const
+    {
+        if (m_multipleInclusionSupport->load() == MultipleInclusionSupport::Unsupported)
+        {
+            return false;
+        }
+
+        if (chunk.size() == 1)
+        {
+            results[chunk[0]] = Search(requests[chunk[0]]);
+            return true;
+        }
+
+        SearchRequest combined;
+        for (size_t index : chunk)
+        {
+            for (const auto& inclusion : requests[index].Inclusions)
+            {
+                bool present = std::any_of(combined.Inclusions.begin(), combined.Inclusions.end(), [&](const PackageMatchFilter& existing)
+                    {
+                        return existing.Field == inclusion.Field && Utility::CaseInsensitiveEquals(existing.Value, inclusion.Value);
+                    });
+
+                if (!present)
+                {
+                    combined.Inclusions.emplace_back(inclusion);
+                }
+            }
+        }
+
+        AICLI_LOG(Repo, Verbose, << "Combining " << chunk.size() << " searches into one with " << combined.Inclusions.size() << " inclusions");
+        SearchResult combinedResult = SearchInternal(combined);
+
+        // Give each package to every request that it matches
+        std::vector<SearchResult> chunkResults(chunk.size());
+        for (const auto& package : combinedResult.Matches)
+        {
+            bool matched = false;
+            for (size_t i = 0; i < chunk.size(); ++i)
+            {
+                if (PackageMatchesInclusions(package, requests[chunk[i]].Inclusions))
+                {
+                    chunkResults[i].Matches.emplace_back(package);
+                    matched = true;
+                }
+            }
+
+            if (!matched)
+            {
+                AICLI_LOG(Repo, Info, << "Combined search returned package [" << package.PackageInformation.PackageIdentifier <<
+                    "] that matches none of its inclusions; searches will not be combined");
+                m_multipleInclusionSupport->store(MultipleInclusionSupport::Unsupported);
+                return false;
+            }
+        }
+
+        if (m_multipleInclusionSupport->load() == MultipleInclusionSupport::Unknown)
+        {
+            auto matchedRequests = std::count_if(chunkResults.begin(), chunkResults.end(), [](const SearchResult& result) { return !result.Matches.empty(); });
+
+            if (matchedRequests > 1)
+            {
+                AICLI_LOG(Repo, Verbose, << "Combined search matched multiple inclusions; searches will be combined");
+                m_multipleInclusionSupport->store(MultipleInclusionSupport::Supported);
+            }
+            else
+            {
+                // A server that only uses one of the inclusions, or requires all of them, returns no more than this.
+                // The server has not shown that it takes the union, so this chunk is checked individually and
+                // searches are not combined from here on; checking every chunk would cost more than it saves.
+                AICLI_LOG(Repo, Info, << "Combined search did not show that the server takes the union of inclusions; searches will not be combined");
+                m_multipleInclusionSupport->store(MultipleInclusionSupport::Unsupported);
+
+                for (size_t i = 0; i < chunk.size(); ++i)
+                {
+                    chunkResults[i] = Search(requests[chunk[i]]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < chunk.size(); ++i)
+        {
+            results[chunk[i]] = std::move(chunkResults[i]);
+        }
+
+        return true;
+    }
+
     IRestClient::SearchResult Interface::SearchInternal(const SearchRequest& request) const
     {
         SearchResult results;
-        utility::string_t continuationToken;
+        web::json::value searchBody = GetSearchBody(request);
         std::unordered_map<utility::string_t, utility::string_t> searchHeaders = m_requiredRestApiHeaders;
-        do
+
+        SearchResponseDeserializer searchResponseDeserializer;
+
+        // Pages are deserialized straight from their text; large pages spend most of their time building a web::json::value otherwise
+        std::optional<pplx::task<std::optional<std::string>>> pendingPage = m_httpClientHelper.HandlePostUtf8Async(m_searchEndpoint, searchBody, searchHeaders);
+
+        // If we leave early due to an error, the request for the next page may still be in flight
+        auto observePendingPage = wil::scope_exit([&]()
+            {
+                if (pendingPage)
+                {
+                    try
+                    {
+                        pendingPage->wait();
+                    }
+                    CATCH_LOG();
+                }
+            });
+
+        while (pendingPage)
         {
-            if (!continuationToken.empty())
+            auto currentPage = std::move(pendingPage.value());
+            pendingPage.reset();
+
+            std::optional<std::string> pageText = currentPage.get();
+            if (!pageText)
             {
-                AICLI_LOG(Repo, Verbose, << "Received continuation token. Retrieving more results.");
-                searchHeaders.insert_or_assign(JsonHelper::GetUtilityString(ContinuationToken), continuationToken);
+                break;
             }
 
-            std::optional<web::json::value> jsonObject = m_httpClientHelper.HandlePost(m_searchEndpoint, GetSearchBody(request), searchHeaders);
+            // The deserializer either takes every entry on the page or fails, so the raw count is the number of matches
+            SearchResponseDeserializer::PageInfo pageInfo = searchResponseDeserializer.GetPageInfo(pageText.value());
+            size_t remaining = !request.MaximumResults ? std::numeric_limits<size_t>::max() : request.MaximumResults - results.Matches.size();
 
-            utility::string_t ct;
-            if (jsonObject)
+            // Only once we know that the next page will be needed, put it in flight while this one is deserialized
+            if (!pageInfo.ContinuationToken.empty() && pageInfo.DataCount < remaining)
             {
-                SearchResponseDeserializer searchResponseDeserializer;
-                SearchResult currentResult = searchResponseDeserializer.Deserialize(jsonObject.value());
-                
-                size_t insertElements = !request.MaximumResults ? currentResult.Matches.size() :
-                    std::min(currentResult.Matches.size(), request.MaximumResults - results.Matches.size());
-
-                std::move(currentResult.Matches.begin(), std::next(currentResult.Matches.begin(), insertElements), std::inserter(results.Matches, results.Matches.end()));
-                ct = RestHelper::GetContinuationToken(jsonObject.value()).value_or(L"");
+                AICLI_LOG(Repo, Verbose, << "Received continuation token. Retrieving more results.");
+                searchHeaders.insert_or_assign(JsonHelper::GetUtilityString(ContinuationToken), utility::conversions::to_string_t(pageInfo.ContinuationToken));
+                pendingPage = m_httpClientHelper.HandlePostUtf8Async(m_searchEndpoint, searchBody, searchHeaders);
             }
 
-            continuationToken = ct;
+            SearchResult currentResult = searchResponseDeserializer.Deserialize(std::string_view{ pageText.value() });
 
-        } while (!continuationToken.empty() && (!request.MaximumResults || results.Matches.size() < request.MaximumResults));
+            size_t insertElements = std::min(currentResult.Matches.size(), remaining);
+            std::move(currentResult.Matches.begin(), std::next(currentResult.Matches.begin(), insertElements), std::inserter(results.Matches, results.Matches.end()));
+        }
 
         if (results.Matches.empty())
         {
@@ -212,17 +454,17 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0
     std::vector<Manifest::Manifest> Interface::GetManifests(const std::string& packageId, const std::map<std::string_view, std::string>& params) const
     {
         std::vector<Manifest::Manifest> results;
-        std::optional<web::json::value> jsonObject = m_httpClientHelper.HandleGet(GetManifestByVersionEndpoint(m_restApiUri, packageId, params), m_requiredRestApiHeaders);
+        std::optional<std::string> manifestText = m_httpClientHelper.HandleGetUtf8(GetManifestByVersionEndpoint(m_restApiUri, packageId, params), m_requiredRestApiHeaders);
 
-        if (!jsonObject)
+        if (!manifestText)
         {
             AICLI_LOG(Repo, Verbose, << "No results were returned by the rest source for package id: " << packageId);
             return results;
         }
 
-        // Parse json and return Manifests
+        // Manifests are deserialized straight from the text, as search pages are
         ManifestDeserializer manifestDeserializer;
-        std::vector<Manifest::Manifest> manifests = manifestDeserializer.Deserialize(jsonObject.value());
+        std::vector<Manifest::Manifest> manifests = manifestDeserializer.Deserialize(std::string_view{ manifestText.value() });
 
         // Manifest validation
         for (auto& manifestItem : manifests)
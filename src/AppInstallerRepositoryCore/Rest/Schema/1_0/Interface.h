@@ -5,6 +5,8 @@
 #include <cpprest/json.h>
 #include "cpprest/json.h"
 #include "Rest/HttpClientHelper.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 
 namespace AppInstaller::Repository::Rest::Schema::V1_0
@@ -22,6 +24,10 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0
 
         Utility::Version GetVersion() const override;
         IRestClient::SearchResult Search(const SearchRequest& request) const override;
+
+        // Exact product code and package family name lookups, as made to correlate installed packages, are combined into
+        // searches with many inclusions. The matches are then given back to the requests whose values they contain.
+        std::vector<IRestClient::SearchResult> SearchMultiple(const std::vector<SearchRequest>& requests) const override;
         std::optional<Manifest::Manifest> GetManifestByVersion(const std::string& packageId, const std::string& version, const std::string& channel) const override;
         std::vector<Manifest::Manifest> GetManifests(const std::string& packageId, const std::map<std::string_view, std::string>& params = {}) const override;
    
@@ -30,10 +36,26 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0
         IRestClient::SearchResult OptimizedSearch(const SearchRequest& request) const;
         IRestClient::SearchResult SearchInternal(const SearchRequest& request) const;
 
+        // The most inclusions put in a single combined search.
+        static constexpr size_t MaximumInclusionsPerSearch = 50;
+
+        // Whether the server returns the union of the inclusions in a search; not all servers do.
+        enum class MultipleInclusionSupport
+        {
+            Unknown,
+            Supported,
+            Unsupported,
+        };
+
     private:
+        // Searches for a chunk of the requests in a single call, or individually once combining is found not to work.
+        // Returns false if the chunk could not be searched as a whole, leaving its results untouched.
+        bool SearchCombined(const std::vector<SearchRequest>& requests, const std::vector<size_t>& chunk, std::vector<IRestClient::SearchResult>& results) const;
+
         std::string m_restApiUri;
         utility::string_t m_searchEndpoint;
         std::unordered_map<utility::string_t, utility::string_t> m_requiredRestApiHeaders;
         HttpClientHelper m_httpClientHelper;
+        std::shared_ptr<std::atomic<MultipleInclusionSupport>> m_multipleInclusionSupport;
     };
 }
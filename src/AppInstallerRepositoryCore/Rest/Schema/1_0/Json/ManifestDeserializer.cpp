@@ -95,152 +95,378 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
     }
 
-    std::vector<Manifest::Manifest> ManifestDeserializer::Deserialize(const web::json::value& dataJsonObject) const
+    std::vector<Manifest::Manifest> ManifestDeserializer::Deserialize(std::string_view dataJson) const
     {
-        // Get manifest from json output.
-        std::optional<std::vector<Manifest::Manifest>> manifests = DeserializeVersion(dataJsonObject);
+        std::optional<std::vector<Manifest::Manifest>> manifests = DeserializeVersion(dataJson);
 
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA, !manifests);
 
         return manifests.value();
     }
 
-    std::optional<std::vector<Manifest::Manifest>> ManifestDeserializer::DeserializeVersion(const web::json::value& dataJsonObject) const
+    std::optional<std::vector<Manifest::Manifest>> ManifestDeserializer::DeserializeVersion(std::string_view dataJson) const
     {
-        if (dataJsonObject.is_null())
-        {
-            AICLI_LOG(Repo, Error, << "Missing json object.");
-            return {};
-        }
-
         std::vector<Manifest::Manifest> manifests;
         try
         {
-            std::optional<std::reference_wrapper<const web::json::value>> manifestObject =
-                JsonHelper::GetJsonValueFromNode(dataJsonObject, JsonHelper::GetUtilityString(Data));
+            JsonReader reader{ dataJson };
 
-            if (!manifestObject || manifestObject.value().get().is_null())
+            switch (reader.PeekType())
             {
+            case JsonReader::ValueType::Null:
+                AICLI_LOG(Repo, Error, << "Missing json object.");
+                return {};
+            case JsonReader::ValueType::Object:
+                break;
+            default:
+                reader.SkipValue();
+                reader.EndDocument();
                 AICLI_LOG(Repo, Verbose, << "No manifest results returned.");
                 return manifests;
             }
 
-            auto& manifestJsonObject = manifestObject.value().get();
-            std::optional<std::string> id = JsonHelper::GetRawStringValueFromJsonNode(manifestJsonObject, JsonHelper::GetUtilityString(PackageIdentifier));
-            if (!JsonHelper::IsValidNonEmptyStringValue(id))
+            bool dataValid = true;
+
+            std::string name;
+            reader.BeginObject();
+            while (reader.NextMember(name))
             {
-                AICLI_LOG(Repo, Error, << "Missing package identifier.");
-                return {};
+                if (name == Data)
+                {
+                    if (reader.PeekType() == JsonReader::ValueType::Null)
+                    {
+                        reader.SkipValue();
+                        manifests.clear();
+                        dataValid = true;
+                        continue;
+                    }
+
+                    std::optional<std::vector<Manifest::Manifest>> package = DeserializePackage(reader);
+                    dataValid = package.has_value();
+                    manifests = std::move(package).value_or(std::vector<Manifest::Manifest>{});
+                }
+                else
+                {
+                    reader.SkipValue();
+                }
             }
 
-            std::optional<std::reference_wrapper<const web::json::array>> versions = JsonHelper::GetRawJsonArrayFromJsonNode(manifestJsonObject, JsonHelper::GetUtilityString(Versions));
-            if (!versions || versions.value().get().size() == 0)
+            reader.EndDocument();
+
+            if (!dataValid)
             {
-                AICLI_LOG(Repo, Error, << "Missing versions in package: " << id.value());
                 return {};
             }
 
-            const web::json::array versionNodes = versions.value().get();
-            for (auto& versionItem : versionNodes)
+            if (manifests.empty())
             {
-                Manifest::Manifest manifest;
-                manifest.Id = id.value();
+                AICLI_LOG(Repo, Verbose, << "No manifest results returned.");
+            }
 
-                std::optional<std::string> packageVersion = JsonHelper::GetRawStringValueFromJsonNode(versionItem, JsonHelper::GetUtilityString(PackageVersion));
-                if (!JsonHelper::IsValidNonEmptyStringValue(packageVersion))
-                {
-                    AICLI_LOG(Repo, Error, << "Missing package version in package: " << manifest.Id);
-                    return {};
-                }
-                manifest.Version = std::move(packageVersion.value());
+            return manifests;
+        }
+        catch (const std::exception& e)
+        {
+            AICLI_LOG(Repo, Error, << "Error encountered while deserializing manifest. Reason: " << e.what());
+        }
+        catch (...)
+        {
+            AICLI_LOG(Repo, Error, << "Error encountered while deserializing manifest...");
+        }
 
-                manifest.Channel = JsonHelper::GetRawStringValueFromJsonNode(versionItem, JsonHelper::GetUtilityString(Channel)).value_or("");
+        return {};
+    }
 
-                // Default locale
-                std::optional<std::reference_wrapper<const web::json::value>> defaultLocale =
-                    JsonHelper::GetJsonValueFromNode(versionItem, JsonHelper::GetUtilityString(DefaultLocale));
-                if (!defaultLocale)
-                {
-                    AICLI_LOG(Repo, Error, << "Missing default locale in package: " << manifest.Id);
-                    return {};
-                }
-                else
+    std::optional<std::vector<Manifest::Manifest>> ManifestDeserializer::DeserializePackage(JsonReader& reader) const
+    {
+        if (reader.PeekType() != JsonReader::ValueType::Object)
+        {
+            reader.SkipValue();
+            AICLI_LOG(Repo, Error, << "Missing package identifier.");
+            return {};
+        }
+
+        std::optional<std::string> id;
+        std::vector<Manifest::Manifest> manifests;
+        bool hasVersions = false;
+        bool versionsValid = true;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == PackageIdentifier)
+            {
+                id = reader.ReadOptionalString();
+            }
+            else if (name == Versions && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                manifests.clear();
+                hasVersions = false;
+                versionsValid = true;
+
+                reader.BeginArray();
+                while (reader.NextElement())
                 {
-                    std::optional<Manifest::ManifestLocalization> defaultLocaleObject = DeserializeLocale(defaultLocale.value().get());
-                    if (!defaultLocaleObject)
+                    hasVersions = true;
+
+                    // Keep reading to the end of the package so that the error reports the package identifier
+                    if (!versionsValid)
                     {
-                        AICLI_LOG(Repo, Error, << "Missing default locale in package: " << manifest.Id);
-                        return {};
+                        reader.SkipValue();
+                        continue;
                     }
-                    manifest.DefaultLocalization = std::move(defaultLocaleObject.value());
 
-                    // Moniker is in Default locale
-                    manifest.Moniker = JsonHelper::GetRawStringValueFromJsonNode(defaultLocale.value().get(), JsonHelper::GetUtilityString(Moniker)).value_or("");
+                    std::optional<Manifest::Manifest> manifest = DeserializeManifest(reader);
+                    if (manifest)
+                    {
+                        manifests.emplace_back(std::move(manifest.value()));
+                    }
+                    else
+                    {
+                        versionsValid = false;
+                    }
                 }
+            }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
 
-                // Installers
-                std::optional<std::reference_wrapper<const web::json::array>> installers = JsonHelper::GetRawJsonArrayFromJsonNode(versionItem, JsonHelper::GetUtilityString(Installers));
-                if (!installers || installers.value().get().size() == 0)
-                {
-                    AICLI_LOG(Repo, Error, << "Missing installers in package: " << manifest.Id);
-                    return {};
-                }
+        if (!JsonHelper::IsValidNonEmptyStringValue(id))
+        {
+            AICLI_LOG(Repo, Error, << "Missing package identifier.");
+            return {};
+        }
+
+        if (!hasVersions)
+        {
+            AICLI_LOG(Repo, Error, << "Missing versions in package: " << id.value());
+            return {};
+        }
+
+        if (!versionsValid)
+        {
+            AICLI_LOG(Repo, Error, << "Received invalid version in package: " << id.value());
+            return {};
+        }
+
+        for (auto& manifest : manifests)
+        {
+            manifest.Id = id.value();
+        }
+
+        return manifests;
+    }
+
+    std::optional<Manifest::Manifest> ManifestDeserializer::DeserializeManifest(JsonReader& reader) const
+    {
+        if (reader.PeekType() != JsonReader::ValueType::Object)
+        {
+            reader.SkipValue();
+            AICLI_LOG(Repo, Error, << "Missing package version.");
+            return {};
+        }
+
+        Manifest::Manifest manifest;
+        std::optional<std::string> packageVersion;
+        bool hasDefaultLocale = false;
+        std::optional<Manifest::ManifestLocalization> defaultLocale;
+        std::string moniker;
+        bool hasInstallers = false;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == PackageVersion)
+            {
+                packageVersion = reader.ReadOptionalString();
+            }
+            else if (name == Channel)
+            {
+                manifest.Channel = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == DefaultLocale)
+            {
+                hasDefaultLocale = true;
+                moniker.clear();
+                defaultLocale = DeserializeLocale(reader, &moniker);
+            }
+            else if (name == Installers && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                manifest.Installers.clear();
+                hasInstallers = false;
 
-                for (auto& installer : installers.value().get())
+                reader.BeginArray();
+                while (reader.NextElement())
                 {
-                    std::optional<Manifest::ManifestInstaller> installerObject = DeserializeInstaller(installer);
-                    if (installerObject)
+                    hasInstallers = true;
+
+                    std::optional<Manifest::ManifestInstaller> installer = DeserializeInstaller(reader);
+                    if (installer)
                     {
-                        manifest.Installers.emplace_back(std::move(installerObject.value()));
+                        manifest.Installers.emplace_back(std::move(installer.value()));
                     }
                 }
+            }
+            else if (name == Locales && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                manifest.Localizations.clear();
 
-                if (manifest.Installers.size() == 0)
-                {
-                    AICLI_LOG(Repo, Error, << "Missing valid installers in package: " << manifest.Id);
-                    return {};
-                }
-
-                // Other locales
-                std::optional<std::reference_wrapper<const web::json::array>> locales = JsonHelper::GetRawJsonArrayFromJsonNode(versionItem, JsonHelper::GetUtilityString(Locales));
-                if (locales)
+                reader.BeginArray();
+                while (reader.NextElement())
                 {
-                    for (auto& locale : locales.value().get())
+                    std::optional<Manifest::ManifestLocalization> locale = DeserializeLocale(reader);
+                    if (locale)
                     {
-                        std::optional<Manifest::ManifestLocalization> localeObject = DeserializeLocale(locale);
-                        if (localeObject)
-                        {
-                            manifest.Localizations.emplace_back(std::move(localeObject.value()));
-                        }
+                        manifest.Localizations.emplace_back(std::move(locale.value()));
                     }
                 }
-
-                manifests.emplace_back(std::move(manifest));
             }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
 
-            return manifests;
+        if (!JsonHelper::IsValidNonEmptyStringValue(packageVersion))
+        {
+            AICLI_LOG(Repo, Error, << "Missing package version.");
+            return {};
         }
-        catch (const std::exception& e)
+        manifest.Version = std::move(packageVersion.value());
+
+        if (!hasDefaultLocale || !defaultLocale)
         {
-            AICLI_LOG(Repo, Error, << "Error encountered while deserializing manifest. Reason: " << e.what());
+            AICLI_LOG(Repo, Error, << "Missing default locale in package version: " << manifest.Version);
+            return {};
         }
-        catch (...)
+        manifest.DefaultLocalization = std::move(defaultLocale.value());
+        manifest.Moniker = std::move(moniker);
+
+        if (!hasInstallers)
         {
-            AICLI_LOG(Repo, Error, << "Error encountered while deserializing manifest...");
+            AICLI_LOG(Repo, Error, << "Missing installers in package version: " << manifest.Version);
+            return {};
         }
 
-        return {};
+        if (manifest.Installers.size() == 0)
+        {
+            AICLI_LOG(Repo, Error, << "Missing valid installers in package version: " << manifest.Version);
+            return {};
+        }
+
+        return manifest;
     }
 
-    std::optional<Manifest::ManifestLocalization> ManifestDeserializer::DeserializeLocale(const web::json::value& localeJsonObject) const
+    std::optional<Manifest::ManifestLocalization> ManifestDeserializer::DeserializeLocale(JsonReader& reader, std::string* moniker) const
     {
-        if (localeJsonObject.is_null())
+        if (reader.PeekType() != JsonReader::ValueType::Object)
         {
+            if (reader.PeekType() != JsonReader::ValueType::Null)
+            {
+                AICLI_LOG(Repo, Error, << "Missing package locale.");
+            }
+
+            reader.SkipValue();
             return {};
         }
 
+        // The optional fields are present, if empty, even when they are not in the response
         Manifest::ManifestLocalization locale;
-        std::optional<std::string> packageLocale = JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PackageLocale));
+        locale.Add<AppInstaller::Manifest::Localization::PublisherUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::PublisherSupportUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::PrivacyUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::Author>("");
+        locale.Add<AppInstaller::Manifest::Localization::PackageUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::License>("");
+        locale.Add<AppInstaller::Manifest::Localization::LicenseUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::Copyright>("");
+        locale.Add<AppInstaller::Manifest::Localization::CopyrightUrl>("");
+        locale.Add<AppInstaller::Manifest::Localization::Description>("");
+        locale.Add<AppInstaller::Manifest::Localization::Tags>(std::vector<Manifest::string_t>{});
+
+        std::optional<std::string> packageLocale;
+        std::optional<std::string> packageName;
+        std::optional<std::string> publisher;
+        std::optional<std::string> shortDescription;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == PackageLocale)
+            {
+                packageLocale = reader.ReadOptionalString();
+            }
+            else if (name == PackageName)
+            {
+                packageName = reader.ReadOptionalString();
+            }
+            else if (name == Publisher)
+            {
+                publisher = reader.ReadOptionalString();
+            }
+            else if (name == ShortDescription)
+            {
+                shortDescription = reader.ReadOptionalString();
+            }
+            else if (name == PublisherUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::PublisherUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == PublisherSupportUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::PublisherSupportUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == PrivacyUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::PrivacyUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == Author)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::Author>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == PackageUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::PackageUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == License)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::License>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == LicenseUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::LicenseUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == Copyright)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::Copyright>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == CopyrightUrl)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::CopyrightUrl>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == Description)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::Description>(reader.ReadOptionalString().value_or(""));
+            }
+            else if (name == Tags)
+            {
+                locale.Add<AppInstaller::Manifest::Localization::Tags>(ConvertToManifestStringArray(reader.ReadStringArray()));
+            }
+            else if (name == Moniker && moniker)
+            {
+                *moniker = reader.ReadOptionalString().value_or("");
+            }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
+
         if (!JsonHelper::IsValidNonEmptyStringValue(packageLocale))
         {
             AICLI_LOG(Repo, Error, << "Missing package locale.");
@@ -248,7 +474,6 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         locale.Locale = std::move(packageLocale.value());
 
-        std::optional<std::string> packageName = JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PackageName));
         if (!JsonHelper::IsValidNonEmptyStringValue(packageName))
         {
             AICLI_LOG(Repo, Error, << "Missing package name.");
@@ -256,7 +481,6 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         locale.Add<AppInstaller::Manifest::Localization::PackageName>(std::move(packageName.value()));
 
-        std::optional<std::string> publisher = JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(Publisher));
         if (!JsonHelper::IsValidNonEmptyStringValue(publisher))
         {
             AICLI_LOG(Repo, Error, << "Missing publisher.");
@@ -264,7 +488,6 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         locale.Add<AppInstaller::Manifest::Localization::Publisher>(std::move(publisher.value()));
 
-        std::optional<std::string> shortDescription = JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(ShortDescription));
         if (!JsonHelper::IsValidNonEmptyStringValue(shortDescription))
         {
             AICLI_LOG(Repo, Error, << "Missing short description.");
@@ -272,30 +495,186 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         locale.Add<AppInstaller::Manifest::Localization::ShortDescription>(std::move(shortDescription.value()));
 
-        locale.Add<AppInstaller::Manifest::Localization::PublisherUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PublisherUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::PublisherSupportUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PublisherSupportUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::PrivacyUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PrivacyUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::Author>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(Author)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::PackageUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(PackageUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::License>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(License)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::LicenseUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(LicenseUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::Copyright>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(Copyright)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::CopyrightUrl>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(CopyrightUrl)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::Description>(JsonHelper::GetRawStringValueFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(Description)).value_or(""));
-        locale.Add<AppInstaller::Manifest::Localization::Tags>(ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(localeJsonObject, JsonHelper::GetUtilityString(Tags))));
-
         return locale;
     }
 
-    std::optional<Manifest::ManifestInstaller> ManifestDeserializer::DeserializeInstaller(const web::json::value& installerJsonObject) const
+    std::optional<Manifest::ManifestInstaller> ManifestDeserializer::DeserializeInstaller(JsonReader& reader) const
     {
-        if (installerJsonObject.is_null())
+        if (reader.PeekType() != JsonReader::ValueType::Object)
         {
+            reader.SkipValue();
             return {};
         }
 
+        // The values that need converting are only converted once the required fields are known to be valid, as conversion may throw
         Manifest::ManifestInstaller installer;
-        std::optional<std::string> url = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerUrl));
+        std::optional<std::string> url;
+        std::optional<std::string> sha256;
+        std::optional<std::string> arch;
+        std::optional<std::string> installerType;
+        std::vector<std::string> platforms;
+        std::optional<std::string> scope;
+        std::optional<std::string> signatureSha256;
+        std::vector<std::string> installModes;
+        std::optional<std::string> updateBehavior;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == InstallerUrl)
+            {
+                url = reader.ReadOptionalString();
+            }
+            else if (name == InstallerSha256)
+            {
+                sha256 = reader.ReadOptionalString();
+            }
+            else if (name == Architecture)
+            {
+                arch = reader.ReadOptionalString();
+            }
+            else if (name == InstallerType)
+            {
+                installerType = reader.ReadOptionalString();
+            }
+            else if (name == InstallerLocale)
+            {
+                installer.Locale = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == Platform)
+            {
+                platforms = reader.ReadStringArray();
+            }
+            else if (name == MinimumOSVersion)
+            {
+                installer.MinOSVersion = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == Scope)
+            {
+                scope = reader.ReadOptionalString();
+            }
+            else if (name == SignatureSha256)
+            {
+                signatureSha256 = reader.ReadOptionalString();
+            }
+            else if (name == InstallModes)
+            {
+                installModes = reader.ReadStringArray();
+            }
+            else if (name == InstallerSwitches)
+            {
+                // Every switch is present, if empty, as long as the switches are
+                installer.Switches.clear();
+                installer.Switches[InstallerSwitchType::Silent] = "";
+                installer.Switches[InstallerSwitchType::SilentWithProgress] = "";
+                installer.Switches[InstallerSwitchType::Interactive] = "";
+                installer.Switches[InstallerSwitchType::InstallLocation] = "";
+                installer.Switches[InstallerSwitchType::Log] = "";
+                installer.Switches[InstallerSwitchType::Update] = "";
+                installer.Switches[InstallerSwitchType::Custom] = "";
+
+                if (reader.PeekType() != JsonReader::ValueType::Object)
+                {
+                    reader.SkipValue();
+                    continue;
+                }
+
+                reader.BeginObject();
+                while (reader.NextMember(name))
+                {
+                    if (name == Silent)
+                    {
+                        installer.Switches[InstallerSwitchType::Silent] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == SilentWithProgress)
+                    {
+                        installer.Switches[InstallerSwitchType::SilentWithProgress] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == Interactive)
+                    {
+                        installer.Switches[InstallerSwitchType::Interactive] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == InstallLocation)
+                    {
+                        installer.Switches[InstallerSwitchType::InstallLocation] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == Log)
+                    {
+                        installer.Switches[InstallerSwitchType::Log] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == Upgrade)
+                    {
+                        installer.Switches[InstallerSwitchType::Update] = reader.ReadOptionalString().value_or("");
+                    }
+                    else if (name == Custom)
+                    {
+                        installer.Switches[InstallerSwitchType::Custom] = reader.ReadOptionalString().value_or("");
+                    }
+                    else
+                    {
+                        reader.SkipValue();
+                    }
+                }
+            }
+            else if (name == InstallerSuccessCodes && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                installer.InstallerSuccessCodes.clear();
+
+                reader.BeginArray();
+                while (reader.NextElement())
+                {
+                    std::optional<int64_t> code = reader.ReadOptionalInteger();
+                    if (code)
+                    {
+                        // Truncated to 32 bits, which keeps the value of negative codes
+                        installer.InstallerSuccessCodes.emplace_back(static_cast<int>(code.value()));
+                    }
+                }
+            }
+            else if (name == UpgradeBehavior)
+            {
+                updateBehavior = reader.ReadOptionalString();
+            }
+            else if (name == Commands)
+            {
+                installer.Commands = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == Protocols)
+            {
+                installer.Protocols = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == FileExtensions)
+            {
+                installer.FileExtensions = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == Dependencies)
+            {
+                std::optional<Manifest::Dependency> dependency = DeserializeDependency(reader);
+                installer.Dependencies = std::move(dependency).value_or(Manifest::Dependency{});
+            }
+            else if (name == PackageFamilyName)
+            {
+                installer.PackageFamilyName = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == ProductCode)
+            {
+                installer.ProductCode = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == Capabilities)
+            {
+                installer.Capabilities = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == RestrictedCapabilities)
+            {
+                installer.RestrictedCapabilities = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
+
         if (!JsonHelper::IsValidNonEmptyStringValue(url))
         {
             AICLI_LOG(Repo, Error, << "Missing installer url.");
@@ -303,7 +682,6 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         installer.Url = std::move(url.value());
 
-        std::optional<std::string> sha256 = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerSha256));
         if (!JsonHelper::IsValidNonEmptyStringValue(sha256))
         {
             AICLI_LOG(Repo, Error, << "Missing installer SHA256.");
@@ -311,7 +689,6 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         installer.Sha256 = Utility::SHA256::ConvertToBytes(sha256.value());
 
-        std::optional<std::string> arch = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Architecture));
         if (!JsonHelper::IsValidNonEmptyStringValue(arch))
         {
             AICLI_LOG(Repo, Error, << "Missing installer architecture.");
@@ -319,141 +696,116 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         }
         installer.Arch = Utility::ConvertToArchitectureEnum(arch.value());
 
-        std::optional<std::string> installerType = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerType));
         if (!JsonHelper::IsValidNonEmptyStringValue(installerType))
         {
             AICLI_LOG(Repo, Error, << "Missing installer type.");
             return {};
         }
         installer.InstallerType = Manifest::ConvertToInstallerTypeEnum(installerType.value());
-        installer.Locale = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerLocale)).value_or("");
 
-        // platform
-        std::optional<std::reference_wrapper<const web::json::array>> platforms = JsonHelper::GetRawJsonArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Platform));
-        if (platforms)
+        for (const auto& platform : platforms)
         {
-            for (auto& platform : platforms.value().get())
-            {
-                std::optional<std::string> platformValue = JsonHelper::GetRawStringValueFromJsonValue(platform);
-                if (platformValue)
-                {
-                    installer.Platform.emplace_back(Manifest::ConvertToPlatformEnum(platformValue.value()));
-                }
-            }
+            installer.Platform.emplace_back(Manifest::ConvertToPlatformEnum(platform));
         }
 
-        installer.MinOSVersion = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(MinimumOSVersion)).value_or("");
-        std::optional<std::string> scope = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Scope));
         if (scope)
         {
             installer.Scope = Manifest::ConvertToScopeEnum(scope.value());
         }
 
-        std::optional<std::string> signatureSha256 = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(SignatureSha256));
         if (signatureSha256)
         {
             installer.SignatureSha256 = Utility::SHA256::ConvertToBytes(signatureSha256.value());
         }
 
-        // Install modes
-        std::optional<std::reference_wrapper<const web::json::array>> installModes = JsonHelper::GetRawJsonArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallModes));
-        if (installModes)
+        for (const auto& mode : installModes)
         {
-            for (auto& mode : installModes.value().get())
-            {
-                std::optional<std::string> modeObject = JsonHelper::GetRawStringValueFromJsonValue(mode);
-                if (modeObject)
-                {
-                    installer.InstallModes.emplace_back(Manifest::ConvertToInstallModeEnum(modeObject.value()));
-                }
-            }
-        }
-
-        // Installer Switches
-        std::optional<std::reference_wrapper<const web::json::value>> switches =
-            JsonHelper::GetJsonValueFromNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerSwitches));
-        if (switches)
-        {
-            auto& installerSwitches = switches.value().get();
-            installer.Switches[InstallerSwitchType::Silent] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(Silent)).value_or("");
-            installer.Switches[InstallerSwitchType::SilentWithProgress] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(SilentWithProgress)).value_or("");
-            installer.Switches[InstallerSwitchType::Interactive] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(Interactive)).value_or("");
-            installer.Switches[InstallerSwitchType::InstallLocation] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(InstallLocation)).value_or("");
-            installer.Switches[InstallerSwitchType::Log] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(Log)).value_or("");
-            installer.Switches[InstallerSwitchType::Update] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(Upgrade)).value_or("");
-            installer.Switches[InstallerSwitchType::Custom] = JsonHelper::GetRawStringValueFromJsonNode(installerSwitches, JsonHelper::GetUtilityString(Custom)).value_or("");
-        }
-
-        // Installer SuccessCodes
-        std::optional<std::reference_wrapper<const web::json::array>> installSuccessCodes = JsonHelper::GetRawJsonArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(InstallerSuccessCodes));
-        if (installSuccessCodes)
-        {
-            for (auto& code : installSuccessCodes.value().get())
-            {
-                std::optional<int> codeValue = JsonHelper::GetRawIntValueFromJsonValue(code);
-                if (codeValue)
-                {
-                    installer.InstallerSuccessCodes.emplace_back(std::move(codeValue.value()));
-                }
-            }
+            installer.InstallModes.emplace_back(Manifest::ConvertToInstallModeEnum(mode));
         }
 
-        std::optional<std::string> updateBehavior = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(UpgradeBehavior));
         if (updateBehavior)
         {
             installer.UpdateBehavior = Manifest::ConvertToUpdateBehaviorEnum(updateBehavior.value());
         }
 
-        installer.Commands = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Commands)));
-        installer.Protocols = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Protocols)));
-        installer.FileExtensions = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(FileExtensions)));
-
-        // Dependencies
-        std::optional<std::reference_wrapper<const web::json::value>> dependenciesObject =
-            JsonHelper::GetJsonValueFromNode(installerJsonObject, JsonHelper::GetUtilityString(Dependencies));
-        if (dependenciesObject)
-        {
-            std::optional<Manifest::Dependency> dependency = DeserializeDependency(dependenciesObject.value().get());
-            if (dependency)
-            {
-                installer.Dependencies = std::move(dependency.value());
-            }
-        }
-
-        installer.PackageFamilyName = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(PackageFamilyName)).value_or("");
-        installer.ProductCode = JsonHelper::GetRawStringValueFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(ProductCode)).value_or("");
-        installer.Capabilities = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(Capabilities)));
-        installer.RestrictedCapabilities = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(installerJsonObject, JsonHelper::GetUtilityString(RestrictedCapabilities)));
-
         return installer;
     }
 
-    std::optional<Manifest::Dependency> ManifestDeserializer::DeserializeDependency(const web::json::value& dependenciesObject) const
+    std::optional<Manifest::Dependency> ManifestDeserializer::DeserializeDependency(JsonReader& reader) const
     {
-        if (dependenciesObject.is_null())
+        if (reader.PeekType() == JsonReader::ValueType::Null)
         {
+            reader.SkipValue();
             return {};
         }
 
         Manifest::Dependency dependency;
 
-        dependency.WindowsFeatures = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(dependenciesObject, JsonHelper::GetUtilityString(WindowsFeatures)));
-        dependency.WindowsLibraries = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(dependenciesObject, JsonHelper::GetUtilityString(WindowsLibraries)));
-        dependency.ExternalDependencies = ConvertToManifestStringArray(JsonHelper::GetRawStringArrayFromJsonNode(dependenciesObject, JsonHelper::GetUtilityString(ExternalDependencies)));
+        if (reader.PeekType() != JsonReader::ValueType::Object)
+        {
+            reader.SkipValue();
+            return dependency;
+        }
 
-        // Package Dependencies
-        std::optional<std::reference_wrapper<const web::json::array>> packageDependencies = JsonHelper::GetRawJsonArrayFromJsonNode(dependenciesObject, JsonHelper::GetUtilityString(PackageDependencies));
-        if (packageDependencies)
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
         {
-            for (auto& packageDependency : packageDependencies.value().get())
+            if (name == WindowsFeatures)
             {
-                std::optional<std::string> id = JsonHelper::GetRawStringValueFromJsonNode(packageDependency, JsonHelper::GetUtilityString(PackageIdentifier));
-                if (id)
+                dependency.WindowsFeatures = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == WindowsLibraries)
+            {
+                dependency.WindowsLibraries = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == ExternalDependencies)
+            {
+                dependency.ExternalDependencies = ConvertToManifestStringArray(reader.ReadStringArray());
+            }
+            else if (name == PackageDependencies && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                dependency.PackageDependencies.clear();
+
+                reader.BeginArray();
+                while (reader.NextElement())
                 {
-                    PackageDependency pkg{ std::move(id.value()) ,  JsonHelper::GetRawStringValueFromJsonNode(packageDependency, JsonHelper::GetUtilityString(MinimumVersion)).value_or("") };
-                    dependency.PackageDependencies.emplace_back(std::move(pkg));
+                    if (reader.PeekType() != JsonReader::ValueType::Object)
+                    {
+                        reader.SkipValue();
+                        continue;
+                    }
+
+                    std::optional<std::string> id;
+                    std::string minVersion;
+
+                    reader.BeginObject();
+                    while (reader.NextMember(name))
+                    {
+                        if (name == PackageIdentifier)
+                        {
+                            id = reader.ReadOptionalString();
+                        }
+                        else if (name == MinimumVersion)
+                        {
+                            minVersion = reader.ReadOptionalString().value_or("");
+                        }
+                        else
+                        {
+                            reader.SkipValue();
+                        }
+                    }
+
+                    if (id)
+                    {
+                        dependency.PackageDependencies.emplace_back(PackageDependency{ std::move(id.value()), std::move(minVersion) });
+                    }
                 }
             }
+            else
+            {
+                reader.SkipValue();
+            }
         }
 
         return dependency;
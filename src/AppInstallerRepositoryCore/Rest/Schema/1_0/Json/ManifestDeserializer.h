@@ -2,23 +2,31 @@
 // Licensed under the MIT License.
 #pragma once
 #include <winget/Manifest.h>
-#include <cpprest/json.h>
+#include "Rest/Schema/JsonReader.h"
+
+#include <string_view>
 
 namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
 {
     // Manifest Deserializer.
     struct ManifestDeserializer
     {
-        // Gets the manifest from the given json object
-        std::vector<Manifest::Manifest> Deserialize(const web::json::value& dataJsonObject) const;
+        // Gets the manifest directly from the UTF-8 text of the response, without building a web::json::value.
+        std::vector<Manifest::Manifest> Deserialize(std::string_view dataJson) const;
 
     protected:
-        std::optional<std::vector<Manifest::Manifest>> DeserializeVersion(const web::json::value& dataJsonObject) const;
+        std::optional<std::vector<Manifest::Manifest>> DeserializeVersion(std::string_view dataJson) const;
+
+        std::optional<std::vector<Manifest::Manifest>> DeserializePackage(JsonReader& reader) const;
+
+        // Always reads the entire value, even when it is not a valid version.
+        std::optional<Manifest::Manifest> DeserializeManifest(JsonReader& reader) const;
 
-        std::optional<Manifest::ManifestLocalization> DeserializeLocale(const web::json::value& localeJsonObject) const;
+        // The moniker, which is only in the default locale, is also read if requested.
+        std::optional<Manifest::ManifestLocalization> DeserializeLocale(JsonReader& reader, std::string* moniker = nullptr) const;
 
-        std::optional<Manifest::ManifestInstaller> DeserializeInstaller(const web::json::value& installerJsonObject) const;
+        std::optional<Manifest::ManifestInstaller> DeserializeInstaller(JsonReader& reader) const;
 
-        std::optional<Manifest::Dependency> DeserializeDependency(const web::json::value& dependenciesJsonObject) const;
+        std::optional<Manifest::Dependency> DeserializeDependency(JsonReader& reader) const;
     };
 }
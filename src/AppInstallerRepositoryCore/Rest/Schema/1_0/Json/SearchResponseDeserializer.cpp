@@ -22,79 +22,106 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
         constexpr std::string_view Channel = "Channel"sv;
     }
 
-    IRestClient::SearchResult SearchResponseDeserializer::Deserialize(const web::json::value& searchResponseObject) const
+    IRestClient::SearchResult SearchResponseDeserializer::Deserialize(std::string_view searchResponseJson) const
     {
-        std::optional<IRestClient::SearchResult> response = DeserializeSearchResult(searchResponseObject);
+        std::optional<IRestClient::SearchResult> response = DeserializeSearchResult(searchResponseJson);
 
         THROW_HR_IF(APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA, !response);
 
         return response.value();
     }
 
-    std::optional<IRestClient::SearchResult> SearchResponseDeserializer::DeserializeSearchResult(const web::json::value& searchResponseObject) const
+    SearchResponseDeserializer::PageInfo SearchResponseDeserializer::GetPageInfo(std::string_view searchResponseJson) const
     {
-        // Make search result from json output.
-        if (searchResponseObject.is_null())
+        PageInfo result;
+        JsonReader reader{ searchResponseJson };
+
+        if (reader.PeekType() != JsonReader::ValueType::Object)
         {
-            AICLI_LOG(Repo, Error, << "Missing json object.");
-            return {};
+            reader.SkipValue();
+            reader.EndDocument();
+            return result;
+        }
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == Data && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                result.DataCount = 0;
+                reader.BeginArray();
+                while (reader.NextElement())
+                {
+                    reader.SkipValue();
+                    ++result.DataCount;
+                }
+            }
+            else if (name == ContinuationToken)
+            {
+                result.ContinuationToken = reader.ReadOptionalString().value_or("");
+            }
+            else
+            {
+                reader.SkipValue();
+            }
         }
 
+        reader.EndDocument();
+        return result;
+    }
+
+    std::optional<IRestClient::SearchResult> SearchResponseDeserializer::DeserializeSearchResult(std::string_view searchResponseJson) const
+    {
         IRestClient::SearchResult result;
         try
         {
-            std::optional<std::reference_wrapper<const web::json::array>> dataArray = JsonHelper::GetRawJsonArrayFromJsonNode(searchResponseObject, JsonHelper::GetUtilityString(Data));
-            if (!dataArray || dataArray.value().get().size() == 0)
+            JsonReader reader{ searchResponseJson };
+
+            switch (reader.PeekType())
             {
+            case JsonReader::ValueType::Null:
+                AICLI_LOG(Repo, Error, << "Missing json object.");
+                return {};
+            case JsonReader::ValueType::Object:
+                break;
+            default:
+                reader.SkipValue();
+                reader.EndDocument();
                 AICLI_LOG(Repo, Verbose, << "No search results returned.");
                 return result;
             }
 
-            for (auto& manifestItem : dataArray.value().get())
+            std::string name;
+            reader.BeginObject();
+            while (reader.NextMember(name))
             {
-                std::optional<std::string> packageId = JsonHelper::GetRawStringValueFromJsonNode(manifestItem, JsonHelper::GetUtilityString(PackageIdentifier));
-                std::optional<std::string> packageName = JsonHelper::GetRawStringValueFromJsonNode(manifestItem, JsonHelper::GetUtilityString(PackageName));
-                std::optional<std::string> publisher = JsonHelper::GetRawStringValueFromJsonNode(manifestItem, JsonHelper::GetUtilityString(Publisher));
-
-                if (!JsonHelper::IsValidNonEmptyStringValue(packageId) || !JsonHelper::IsValidNonEmptyStringValue(packageName) || !JsonHelper::IsValidNonEmptyStringValue(publisher))
-                {
-                    AICLI_LOG(Repo, Error, << "Missing required package fields in manifest search results.");
-                    return {};
-                }
-
-                std::optional<std::reference_wrapper<const web::json::array>> versionValue = JsonHelper::GetRawJsonArrayFromJsonNode(manifestItem, JsonHelper::GetUtilityString(Versions));
-                std::vector<IRestClient::VersionInfo> versionList;
-
-                if (versionValue)
+                if (name == Data && reader.PeekType() == JsonReader::ValueType::Array)
                 {
-                    for (auto& versionItem : versionValue.value().get())
+                    result.Matches.clear();
+                    reader.BeginArray();
+                    while (reader.NextElement())
                     {
-                        std::optional<std::string> version = JsonHelper::GetRawStringValueFromJsonNode(versionItem, JsonHelper::GetUtilityString(PackageVersion));
-                        if (!JsonHelper::IsValidNonEmptyStringValue(version))
+                        std::optional<IRestClient::Package> package = DeserializePackage(reader);
+                        if (!package)
                         {
-                            AICLI_LOG(Repo, Error, << "Received incomplete package version in package: " << packageId.value());
                             return {};
                         }
 
-                        std::string channel = JsonHelper::GetRawStringValueFromJsonNode(versionItem, JsonHelper::GetUtilityString(Channel)).value_or("");
-                        std::vector<std::string> packageFamilyNames = RestHelper::GetUniqueItems(JsonHelper::GetRawStringArrayFromJsonNode(versionItem, JsonHelper::GetUtilityString(PackageFamilyNames)));
-                        std::vector<std::string> productCodes = RestHelper::GetUniqueItems(JsonHelper::GetRawStringArrayFromJsonNode(versionItem, JsonHelper::GetUtilityString(ProductCodes)));
-
-                        versionList.emplace_back(IRestClient::VersionInfo{
-                                AppInstaller::Utility::VersionAndChannel{std::move(version.value()), std::move(channel)}, {}, std::move(packageFamilyNames), std::move(productCodes)});
+                        result.Matches.emplace_back(std::move(package.value()));
                     }
                 }
-
-                if (versionList.size() == 0)
+                else
                 {
-                    AICLI_LOG(Repo, Error, << "Received no versions in package: " << packageId.value());
-                    return {};
+                    reader.SkipValue();
                 }
+            }
+
+            reader.EndDocument();
 
-                IRestClient::PackageInfo packageInfo{
-                        std::move(packageId.value()), std::move(packageName.value()), std::move(publisher.value()) };
-                IRestClient::Package package{ std::move(packageInfo), std::move(versionList) };
-                result.Matches.emplace_back(std::move(package));
+            if (result.Matches.empty())
+            {
+                AICLI_LOG(Repo, Verbose, << "No search results returned.");
             }
 
             return result;
@@ -110,4 +137,135 @@ namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
 
         return {};
     }
+
+    std::optional<IRestClient::Package> SearchResponseDeserializer::DeserializePackage(JsonReader& reader) const
+    {
+        if (reader.PeekType() != JsonReader::ValueType::Object)
+        {
+            AICLI_LOG(Repo, Error, << "Missing required package fields in manifest search results.");
+            return {};
+        }
+
+        std::optional<std::string> packageId;
+        std::optional<std::string> packageName;
+        std::optional<std::string> publisher;
+        std::vector<IRestClient::VersionInfo> versionList;
+        bool versionsValid = true;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == PackageIdentifier)
+            {
+                packageId = reader.ReadOptionalString();
+            }
+            else if (name == PackageName)
+            {
+                packageName = reader.ReadOptionalString();
+            }
+            else if (name == Publisher)
+            {
+                publisher = reader.ReadOptionalString();
+            }
+            else if (name == Versions && reader.PeekType() == JsonReader::ValueType::Array)
+            {
+                versionList.clear();
+                reader.BeginArray();
+                while (reader.NextElement())
+                {
+                    // Keep reading to the end of the package so that the error reports the package identifier
+                    if (!versionsValid)
+                    {
+                        reader.SkipValue();
+                        continue;
+                    }
+
+                    std::optional<IRestClient::VersionInfo> version = DeserializeVersion(reader);
+                    if (version)
+                    {
+                        versionList.emplace_back(std::move(version.value()));
+                    }
+                    else
+                    {
+                        versionsValid = false;
+                    }
+                }
+            }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
+
+        if (!JsonHelper::IsValidNonEmptyStringValue(packageId) || !JsonHelper::IsValidNonEmptyStringValue(packageName) || !JsonHelper::IsValidNonEmptyStringValue(publisher))
+        {
+            AICLI_LOG(Repo, Error, << "Missing required package fields in manifest search results.");
+            return {};
+        }
+
+        if (!versionsValid)
+        {
+            AICLI_LOG(Repo, Error, << "Received incomplete package version in package: " << packageId.value());
+            return {};
+        }
+
+        if (versionList.size() == 0)
+        {
+            AICLI_LOG(Repo, Error, << "Received no versions in package: " << packageId.value());
+            return {};
+        }
+
+        IRestClient::PackageInfo packageInfo{
+                std::move(packageId.value()), std::move(packageName.value()), std::move(publisher.value()) };
+        return IRestClient::Package{ std::move(packageInfo), std::move(versionList) };
+    }
+
+    std::optional<IRestClient::VersionInfo> SearchResponseDeserializer::DeserializeVersion(JsonReader& reader) const
+    {
+        if (reader.PeekType() != JsonReader::ValueType::Object)
+        {
+            reader.SkipValue();
+            return {};
+        }
+
+        std::optional<std::string> version;
+        std::string channel;
+        std::vector<std::string> packageFamilyNames;
+        std::vector<std::string> productCodes;
+
+        std::string name;
+        reader.BeginObject();
+        while (reader.NextMember(name))
+        {
+            if (name == PackageVersion)
+            {
+                version = reader.ReadOptionalString();
+            }
+            else if (name == Channel)
+            {
+                channel = reader.ReadOptionalString().value_or("");
+            }
+            else if (name == PackageFamilyNames)
+            {
+                packageFamilyNames = RestHelper::GetUniqueItems(reader.ReadStringArray());
+            }
+            else if (name == ProductCodes)
+            {
+                productCodes = RestHelper::GetUniqueItems(reader.ReadStringArray());
+            }
+            else
+            {
+                reader.SkipValue();
+            }
+        }
+
+        if (!JsonHelper::IsValidNonEmptyStringValue(version))
+        {
+            return {};
+        }
+
+        return IRestClient::VersionInfo{
+                AppInstaller::Utility::VersionAndChannel{std::move(version.value()), std::move(channel)}, {}, std::move(packageFamilyNames), std::move(productCodes) };
+    }
 }
@@ -1,18 +1,37 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 #pragma once
-#include <cpprest/json.h>
 #include "Rest/Schema/IRestClient.h"
+#include "Rest/Schema/JsonReader.h"
+
+#include <string_view>
 
 namespace AppInstaller::Repository::Rest::Schema::V1_0::Json
 {
     // Search Result Deserializer.
     struct SearchResponseDeserializer
     {
-        // Gets the search result for given version
-        IRestClient::SearchResult Deserialize(const web::json::value& searchResultJsonObject) const;
+        // The parts of a page of results that are needed to request the next page.
+        struct PageInfo
+        {
+            std::string ContinuationToken;
+
+            // The number of entries in the data of the page.
+            size_t DataCount = 0;
+        };
+
+        // Gets the search result directly from the UTF-8 text of the response, without building a web::json::value.
+        IRestClient::SearchResult Deserialize(std::string_view searchResultJson) const;
+
+        // Gets the continuation token and entry count of a page, skipping over the entries rather than deserializing them.
+        PageInfo GetPageInfo(std::string_view searchResultJson) const;
 
     protected:
-        std::optional<IRestClient::SearchResult> DeserializeSearchResult(const web::json::value& searchResultJsonObject) const;
+        std::optional<IRestClient::SearchResult> DeserializeSearchResult(std::string_view searchResultJson) const;
+
+        std::optional<IRestClient::Package> DeserializePackage(JsonReader& reader) const;
+
+        // Always reads the entire value, even when it is not a valid version.
+        std::optional<IRestClient::VersionInfo> DeserializeVersion(JsonReader& reader) const;
     };
 }
@@ -65,6 +65,21 @@ namespace AppInstaller::Repository::Rest::Schema
     // Performs a search based on the given criteria.
     virtual SearchResult Search(const SearchRequest& request) const = 0;
 
+    // Performs a search for each of the given requests, returning the results in the same order.
+    // Implementations may combine the requests into fewer calls to the server.
+    virtual std::vector<SearchResult> SearchMultiple(const std::vector<SearchRequest>& requests) const
+    {
+        std::vector<SearchResult> results;
+        results.reserve(requests.size());
+
+        for (const auto& request : requests)
+        {
+            results.emplace_back(Search(request));
+        }
+
+        return results;
+    }
+
     // Gets the manifest for given version
     virtual std::optional<Manifest::Manifest> GetManifestByVersion(const std::string& packageId, const std::string& version, const std::string& channel) const = 0;
     
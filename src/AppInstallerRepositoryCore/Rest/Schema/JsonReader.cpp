@@ -0,0 +1,511 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "pch.h"
+#include "JsonReader.h"
+
+#include <charconv>
+
+using namespace std::string_view_literals;
+
+namespace AppInstaller::Repository::Rest::Schema
+{
+    namespace
+    {
+        // Guards against running out of stack on deeply nested input.
+        constexpr size_t s_MaximumDepth = 256;
+
+        bool IsWhitespace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        void AppendUtf8(std::string& result, uint32_t codePoint)
+        {
+            if (codePoint < 0x80)
+            {
+                result += static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                result += static_cast<char>(0xC0 | (codePoint >> 6));
+                result += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                result += static_cast<char>(0xE0 | (codePoint >> 12));
+                result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                result += static_cast<char>(0xF0 | (codePoint >> 18));
+                result += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                result += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                result += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+    }
+
+    JsonReader::JsonReader(std::string_view json) : m_json(json)
+    {
+        // Skip a byte order mark, which some servers send
+        if (m_json.substr(0, 3) == "\xEF\xBB\xBF"sv)
+        {
+            m_position = 3;
+        }
+    }
+
+    JsonReader::ValueType JsonReader::PeekType()
+    {
+        switch (PeekNonWhitespace())
+        {
+        case '{':
+            return ValueType::Object;
+        case '[':
+            return ValueType::Array;
+        case '"':
+            return ValueType::String;
+        case 't':
+        case 'f':
+            return ValueType::Boolean;
+        case 'n':
+            return ValueType::Null;
+        case '-':
+            return ValueType::Number;
+        default:
+            if (IsDigit(m_json[m_position]))
+            {
+                return ValueType::Number;
+            }
+
+            ThrowInvalid("unexpected character");
+        }
+    }
+
+    void JsonReader::BeginObject()
+    {
+        Expect('{');
+
+        if (m_firstInContainer.size() >= s_MaximumDepth)
+        {
+            ThrowInvalid("nested too deeply");
+        }
+
+        m_firstInContainer.push_back(true);
+    }
+
+    bool JsonReader::NextMember(std::string& name)
+    {
+        if (!NextInContainer('}'))
+        {
+            return false;
+        }
+
+        if (PeekNonWhitespace() != '"')
+        {
+            ThrowInvalid("expected member name");
+        }
+
+        name.clear();
+        ReadStringInto(name);
+        Expect(':');
+        return true;
+    }
+
+    void JsonReader::BeginArray()
+    {
+        Expect('[');
+
+        if (m_firstInContainer.size() >= s_MaximumDepth)
+        {
+            ThrowInvalid("nested too deeply");
+        }
+
+        m_firstInContainer.push_back(true);
+    }
+
+    bool JsonReader::NextElement()
+    {
+        return NextInContainer(']');
+    }
+
+    std::string JsonReader::ReadString()
+    {
+        if (PeekNonWhitespace() != '"')
+        {
+            ThrowInvalid("expected string");
+        }
+
+        std::string result;
+        ReadStringInto(result);
+        return result;
+    }
+
+    std::optional<std::string> JsonReader::ReadOptionalString()
+    {
+        if (PeekType() != ValueType::String)
+        {
+            SkipValue();
+            return {};
+        }
+
+        return ReadString();
+    }
+
+    std::optional<int64_t> JsonReader::ReadOptionalInteger()
+    {
+        if (PeekType() != ValueType::Number)
+        {
+            SkipValue();
+            return {};
+        }
+
+        size_t start = m_position;
+        SkipNumber();
+        std::string_view number = m_json.substr(start, m_position - start);
+
+        if (number.find_first_of(".eE"sv) != std::string_view::npos)
+        {
+            return {};
+        }
+
+        int64_t result = 0;
+        auto [end, error] = std::from_chars(number.data(), number.data() + number.size(), result);
+        if (error != std::errc{} || end != number.data() + number.size())
+        {
+            return {};
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> JsonReader::ReadStringArray()
+    {
+        std::vector<std::string> result;
+
+        if (PeekType() != ValueType::Array)
+        {
+            SkipValue();
+            return result;
+        }
+
+        BeginArray();
+        while (NextElement())
+        {
+            std::optional<std::string> item = ReadOptionalString();
+            if (item)
+            {
+                result.emplace_back(std::move(item.value()));
+            }
+        }
+
+        return result;
+    }
+
+    void JsonReader::SkipValue()
+    {
+        switch (PeekType())
+        {
+        case ValueType::Object:
+        {
+            std::string name;
+            BeginObject();
+            while (NextMember(name))
+            {
+                SkipValue();
+            }
+            break;
+        }
+        case ValueType::Array:
+            BeginArray();
+            while (NextElement())
+            {
+                SkipValue();
+            }
+            break;
+        case ValueType::String:
+        {
+            std::string ignored;
+            ReadStringInto(ignored);
+            break;
+        }
+        case ValueType::Boolean:
+            SkipLiteral(m_json[m_position] == 't' ? "true"sv : "false"sv);
+            break;
+        case ValueType::Null:
+            SkipLiteral("null"sv);
+            break;
+        case ValueType::Number:
+            SkipNumber();
+            break;
+        }
+    }
+
+    void JsonReader::EndDocument()
+    {
+        while (m_position < m_json.size() && IsWhitespace(m_json[m_position]))
+        {
+            ++m_position;
+        }
+
+        if (m_position != m_json.size() || !m_firstInContainer.empty())
+        {
+            ThrowInvalid("unexpected content after value");
+        }
+    }
+
+    char JsonReader::PeekNonWhitespace()
+    {
+        while (m_position < m_json.size() && IsWhitespace(m_json[m_position]))
+        {
+            ++m_position;
+        }
+
+        if (m_position == m_json.size())
+        {
+            ThrowInvalid("unexpected end of text");
+        }
+
+        return m_json[m_position];
+    }
+
+    void JsonReader::Expect(char c)
+    {
+        if (PeekNonWhitespace() != c)
+        {
+            ThrowInvalid(std::string{ "expected '" } + c + '\'');
+        }
+
+        ++m_position;
+    }
+
+    bool JsonReader::NextInContainer(char end)
+    {
+        if (m_firstInContainer.empty())
+        {
+            ThrowInvalid("not in a container");
+        }
+
+        if (PeekNonWhitespace() == end)
+        {
+            ++m_position;
+            m_firstInContainer.pop_back();
+            return false;
+        }
+
+        if (m_firstInContainer.back())
+        {
+            m_firstInContainer.back() = false;
+        }
+        else
+        {
+            Expect(',');
+        }
+
+        return true;
+    }
+
+    void JsonReader::ReadStringInto(std::string& result)
+    {
+        // Skip the opening quote
+        ++m_position;
+
+        for (;;)
+        {
+            // Copy runs of unescaped characters at once
+            size_t runStart = m_position;
+            while (m_position < m_json.size() && m_json[m_position] != '"' && m_json[m_position] != '\\')
+            {
+                if (static_cast<unsigned char>(m_json[m_position]) < 0x20)
+                {
+                    ThrowInvalid("control character in string");
+                }
+
+                ++m_position;
+            }
+
+            result.append(m_json.substr(runStart, m_position - runStart));
+
+            if (m_position == m_json.size())
+            {
+                ThrowInvalid("unterminated string");
+            }
+
+            if (m_json[m_position] == '"')
+            {
+                ++m_position;
+                return;
+            }
+
+            AppendEscape(result);
+        }
+    }
+
+    void JsonReader::AppendEscape(std::string& result)
+    {
+        // Skip the backslash
+        ++m_position;
+
+        if (m_position == m_json.size())
+        {
+            ThrowInvalid("unterminated string");
+        }
+
+        char c = m_json[m_position++];
+        switch (c)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            result += c;
+            break;
+        case 'b':
+            result += '\b';
+            break;
+        case 'f':
+            result += '\f';
+            break;
+        case 'n':
+            result += '\n';
+            break;
+        case 'r':
+            result += '\r';
+            break;
+        case 't':
+            result += '\t';
+            break;
+        case 'u':
+        {
+            uint32_t codePoint = ReadHexCodeUnit();
+
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+            {
+                // A high surrogate must be followed by an escaped low surrogate
+                if (m_json.substr(m_position, 2) != "\\u"sv)
+                {
+                    ThrowInvalid("unpaired surrogate");
+                }
+
+                m_position += 2;
+                uint32_t low = ReadHexCodeUnit();
+                if (low < 0xDC00 || low > 0xDFFF)
+                {
+                    ThrowInvalid("unpaired surrogate");
+                }
+
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            }
+            else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+            {
+                ThrowInvalid("unpaired surrogate");
+            }
+
+            AppendUtf8(result, codePoint);
+            break;
+        }
+        default:
+            ThrowInvalid("invalid escape");
+        }
+    }
+
+    uint32_t JsonReader::ReadHexCodeUnit()
+    {
+        if (m_json.size() - m_position < 4)
+        {
+            ThrowInvalid("unterminated string");
+        }
+
+        uint32_t result = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            char c = m_json[m_position++];
+            result <<= 4;
+
+            if (IsDigit(c))
+            {
+                result |= c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                result |= c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                result |= c - 'A' + 10;
+            }
+            else
+            {
+                ThrowInvalid("invalid escape");
+            }
+        }
+
+        return result;
+    }
+
+    void JsonReader::SkipLiteral(std::string_view literal)
+    {
+        if (m_json.substr(m_position, literal.size()) != literal)
+        {
+            ThrowInvalid("invalid literal");
+        }
+
+        m_position += literal.size();
+    }
+
+    void JsonReader::SkipNumber()
+    {
+        if (m_json[m_position] == '-')
+        {
+            ++m_position;
+        }
+
+        if (m_position < m_json.size() && m_json[m_position] == '0')
+        {
+            ++m_position;
+        }
+        else
+        {
+            SkipDigits();
+        }
+
+        if (m_position < m_json.size() && m_json[m_position] == '.')
+        {
+            ++m_position;
+            SkipDigits();
+        }
+
+        if (m_position < m_json.size() && (m_json[m_position] == 'e' || m_json[m_position] == 'E'))
+        {
+            ++m_position;
+            if (m_position < m_json.size() && (m_json[m_position] == '+' || m_json[m_position] == '-'))
+            {
+                ++m_position;
+            }
+
+            SkipDigits();
+        }
+    }
+
+    void JsonReader::SkipDigits()
+    {
+        if (m_position == m_json.size() || !IsDigit(m_json[m_position]))
+        {
+            ThrowInvalid("invalid number");
+        }
+
+        while (m_position < m_json.size() && IsDigit(m_json[m_position]))
+        {
+            ++m_position;
+        }
+    }
+
+    void JsonReader::ThrowInvalid(std::string_view reason) const
+    {
+        THROW_HR_MSG(APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA, "Invalid JSON at offset %zu: %.*hs", m_position, static_cast<int>(reason.size()), reason.data());
+    }
+}
@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#pragma once
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AppInstaller::Repository::Rest::Schema
+{
+    // A forward only reader over UTF-8 JSON text.
+    // This allows a deserializer to fill its result as the text is read, rather than first building a web::json::value for the
+    // entire response and then copying everything out of it. Malformed text throws APPINSTALLER_CLI_ERROR_RESTSOURCE_INVALID_DATA.
+    struct JsonReader
+    {
+        // The type of a JSON value.
+        enum class ValueType
+        {
+            Null,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+        // The text must outlive the reader.
+        JsonReader(std::string_view json);
+
+        // Gets the type of the next value without reading it.
+        ValueType PeekType();
+
+        // Reads the start of an object; its members are then read with NextMember.
+        void BeginObject();
+
+        // Reads the name of the next member of the current object, leaving the reader at its value.
+        // Returns false once the end of the object has been read.
+        bool NextMember(std::string& name);
+
+        // Reads the start of an array; its elements are then read with NextElement.
+        void BeginArray();
+
+        // Moves to the next element of the current array, leaving the reader at its value.
+        // Returns false once the end of the array has been read.
+        bool NextElement();
+
+        // Reads a string value.
+        std::string ReadString();
+
+        // Reads a string value; a value of any other type is skipped and results in an empty optional.
+        std::optional<std::string> ReadOptionalString();
+
+        // Reads an integer value; any other value, including a number with a fraction or exponent or one that does not fit, is skipped
+        // and results in an empty optional.
+        std::optional<int64_t> ReadOptionalInteger();
+
+        // Reads an array, keeping only the elements that are strings; a value of any other type is skipped.
+        std::vector<std::string> ReadStringArray();
+
+        // Reads a value of any type, including everything nested within it, without keeping it.
+        void SkipValue();
+
+        // Ensures that nothing other than whitespace follows the value that was read.
+        void EndDocument();
+
+    private:
+        char PeekNonWhitespace();
+        void Expect(char c);
+        bool NextInContainer(char end);
+        void ReadStringInto(std::string& result);
+        void AppendEscape(std::string& result);
+        uint32_t ReadHexCodeUnit();
+        void SkipLiteral(std::string_view literal);
+        void SkipNumber();
+        void SkipDigits();
+        [[noreturn]] void ThrowInvalid(std::string_view reason) const;
+
+        std::string_view m_json;
+        size_t m_position = 0;
+
+        // Whether the next item in each of the containers currently being read is the first in that container.
+        std::vector<bool> m_firstInContainer;
+    };
+}